@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+"""
+Compare the benchmark results of two firmware builds.
+
+Build both images with CONFIG_SYSTEM_BENCHMARK=y (idf.py menuconfig, Home
+Monitor; see components/benchmark/benchmark.h), capture the serial output of
+each run and compare:
+
+    idf.py flash monitor | tee baseline.log      # old firmware
+    idf.py flash monitor | tee candidate.log     # new firmware
+    python3 bench_compare.py baseline.log candidate.log
+
+The host benchmarks in test/host print the same lines:
+
+    cmake -S test/host -B build-host && cmake --build build-host
+    build-host/host_bench | tee candidate.log
+
+Every "BENCH {...}" line is one result. A benchmark regresses when its
+per_op_ns grew by more than the threshold (default 10%) or when it reports
+failures. The exit status is 1 if anything regressed, so the script can gate
+a release. With a single log it just prints the results.
+
+Requirements: Python 3.6+, no additional dependencies.
+"""
+
+import argparse
+import json
+import sys
+
+MARKER = 'BENCH {'
+
+def load_results(path):
+    """Return {name: result} from a serial capture; the last run wins."""
+    results = {}
+    with open(path, encoding='utf-8', errors='replace') as log:
+        for line in log:
+            start = line.find(MARKER)
+            if start < 0:
+                continue
+            try:
+                result = json.loads(line[start + len('BENCH '):].strip())
+            except ValueError:
+                continue    # Line cut short by a reset or mixed with other output
+            results[result['name']] = result
+    return results
+
+def format_ns(ns):
+    if ns >= 1000000:
+        return f"{ns / 1000000:.2f} ms"
+    if ns >= 1000:
+        return f"{ns / 1000:.2f} us"
+    return f"{ns} ns"
+
+def print_results(results):
+    print(f"{'benchmark':<32} {'per op':>12} {'throughput':>20} {'failures':>9}")
+    for name, r in sorted(results.items()):
+        print(f"{name:<32} {format_ns(r['per_op_ns']):>12} "
+              f"{r['throughput']:>12} {r['unit']:<7} {r['failures']:>9}")
+
+def compare(baseline, candidate, threshold):
+    regressions = 0
+    build_a = next(iter(baseline.values()), {}).get('build', '?')
+    build_b = next(iter(candidate.values()), {}).get('build', '?')
+    print(f"{'benchmark':<32} {build_a:>12} {build_b:>12} {'change':>9}")
+    for name in sorted(set(baseline) | set(candidate)):
+        a, b = baseline.get(name), candidate.get(name)
+        if a is None or b is None:
+            print(f"{name:<32} {'-' if a is None else format_ns(a['per_op_ns']):>12} "
+                  f"{'-' if b is None else format_ns(b['per_op_ns']):>12} {'n/a':>9}")
+            continue
+        change = (b['per_op_ns'] - a['per_op_ns']) / max(a['per_op_ns'], 1)
+        flag = ''
+        if change > threshold:
+            flag = '  REGRESSION'
+        if b['failures'] > 0:
+            flag += f"  {b['failures']} FAILURES"
+        if flag:
+            regressions += 1
+        print(f"{name:<32} {format_ns(a['per_op_ns']):>12} {format_ns(b['per_op_ns']):>12} "
+              f"{change:>+8.1%}{flag}")
+    return regressions
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[1])
+    parser.add_argument('baseline', help='serial log of the reference build')
+    parser.add_argument('candidate', nargs='?', help='serial log of the build under test')
+    parser.add_argument('--threshold', type=float, default=10.0,
+                        help='allowed per_op_ns increase in percent (default 10)')
+    args = parser.parse_args()
+
+    baseline = load_results(args.baseline)
+    if not baseline:
+        sys.exit(f"No BENCH lines in {args.baseline}")
+    if args.candidate is None:
+        print_results(baseline)
+        return 0
+
+    candidate = load_results(args.candidate)
+    if not candidate:
+        sys.exit(f"No BENCH lines in {args.candidate}")
+    regressions = compare(baseline, candidate, args.threshold / 100.0)
+    print(f"\n{regressions} regression(s) above {args.threshold:g}%")
+    return 1 if regressions else 0
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,314 @@
+/**
+ * @file benchmark.c
+ * @brief On-device benchmarks, see benchmark.h
+ *
+ * Every benchmark is a loop of one operation timed as a whole with
+ * esp_timer_get_time(), so the per-iteration cost of reading the timer does
+ * not distort sub-microsecond operations. Results go to stdout with
+ * printf() rather than ESP_LOG so that the lines carry no log prefix or
+ * colour codes.
+ */
+
+#include "benchmark.h"
+#include "st7789.h"
+#include "dht11_capture.h"
+#include "wifi_manager.h"
+#include "device_config.h"
+#include "telemetry_codec.h"
+#include "esp_app_desc.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "BENCHMARK";
+
+static char build_id[9] = "unknown";
+
+/**
+ * @brief Print one result line
+ *
+ * @param work_per_op Units of work per iteration (pixels, bytes, ...)
+ * @param unit        Unit of the throughput figure ("px/s")
+ */
+static void report(const char *name, uint32_t iterations, int64_t total_us,
+                   uint32_t work_per_op, const char *unit, uint32_t failures)
+{
+    if (total_us <= 0)
+    {
+        total_us = 1;
+    }
+    uint64_t per_op_ns = (uint64_t)total_us * 1000 / iterations;
+    uint64_t throughput = (uint64_t)work_per_op * iterations * 1000000 / (uint64_t)total_us;
+
+    printf("BENCH {\"build\":\"%s\",\"name\":\"%s\",\"iterations\":%" PRIu32
+           ",\"per_op_ns\":%" PRIu64 ",\"throughput\":%" PRIu64 ",\"unit\":\"%s\""
+           ",\"failures\":%" PRIu32 "}\n",
+           build_id, name, iterations, per_op_ns, throughput, unit, failures);
+}
+
+/*----------------------------------------------------------------------------*/
+/* Display */
+
+#define BENCH_RECT_SIZE         120
+#define BENCH_RECT_ITERATIONS   200
+#define BENCH_CLEAR_ITERATIONS  100
+#define BENCH_STRING            "23.5C"
+#define BENCH_STRING_ITERATIONS 500
+#define BENCH_PANEL_ITERATIONS  20
+#define BENCH_SCREEN_PIXELS     (240 * 240)
+
+// Alternate colours so every iteration really changes the pixels
+static uint16_t bench_color(uint32_t i)
+{
+    return (i & 1) ? ST7789_BLUE : ST7789_RED;
+}
+
+static void draw_rect(uint32_t i)
+{
+    st7789_fill_rect(60, 60, BENCH_RECT_SIZE, BENCH_RECT_SIZE, bench_color(i));
+}
+
+static void draw_clear(uint32_t i)
+{
+    st7789_clear_screen(bench_color(i));
+}
+
+static void draw_string(uint32_t i)
+{
+    st7789_draw_large_string(40, 50, BENCH_STRING, bench_color(i), ST7789_BLACK);
+}
+
+static void draw_text_32(uint32_t i)
+{
+    st7789_draw_text(40, 100, BENCH_STRING, ST7789_FONT_32, bench_color(i), ST7789_BLACK);
+}
+
+static void bench_display(const char *name, void (*draw)(uint32_t), uint32_t pixels,
+                          uint32_t iterations)
+{
+    char panel_name[40];
+
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        draw(i);
+    }
+    report(name, iterations, esp_timer_get_time() - start, pixels, "px/s", 0);
+
+    // Discard what the render-only loop left dirty before timing the bus
+    st7789_flush();
+
+    snprintf(panel_name, sizeof(panel_name), "%s_panel", name);
+    start = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCH_PANEL_ITERATIONS; i++)
+    {
+        draw(i);
+        st7789_flush();
+    }
+    report(panel_name, BENCH_PANEL_ITERATIONS, esp_timer_get_time() - start, pixels, "px/s", 0);
+}
+
+/*----------------------------------------------------------------------------*/
+/* DHT11 decode */
+
+#define BENCH_DECODE_ITERATIONS 2000
+
+#if !DHT11_USE_LEGACY_BITBANG
+/**
+ * @brief Build an RMT capture of a frame the way the receiver records it
+ *
+ * 80/80 µs acknowledge, then per bit 50 µs low and a 24-30 µs ('0') or
+ * 67-73 µs ('1') high pulse with deterministic jitter, then the final low
+ * and the zero-length idle terminator.
+ */
+static size_t build_trace(const uint8_t frame[DHT11_FRAME_BYTES], rmt_symbol_word_t *trace)
+{
+    static const int8_t jitter[] = { 0, 3, -2, 1, -3, 2, -1 };
+    size_t n = 0;
+
+    trace[n++] = (rmt_symbol_word_t) { .level0 = 0, .duration0 = 80, .level1 = 1, .duration1 = 80 };
+    for (int bit = 0; bit < DHT11_FRAME_BITS; bit++)
+    {
+        bool one = (frame[bit / 8] >> (7 - bit % 8)) & 1;
+        uint16_t high = (uint16_t)((one ? 70 : 27) + jitter[bit % sizeof(jitter)]);
+        trace[n++] = (rmt_symbol_word_t) { .level0 = 0, .duration0 = 50, .level1 = 1, .duration1 = high };
+    }
+    trace[n++] = (rmt_symbol_word_t) { .level0 = 0, .duration0 = 50, .level1 = 1, .duration1 = 0 };
+    return n;
+}
+
+static esp_err_t bench_decode(void)
+{
+    // 55 % RH, 23.5 °C, checksum
+    static const uint8_t frame[DHT11_FRAME_BYTES] = { 0x37, 0x00, 0x17, 0x05, 0x53 };
+    rmt_symbol_word_t trace[DHT11_FRAME_BITS + 2];
+    size_t symbols = build_trace(frame, trace);
+
+    uint32_t failures = 0;
+    uint8_t raw[DHT11_FRAME_BYTES];
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCH_DECODE_ITERATIONS; i++)
+    {
+        if (dht11_capture_decode_symbols(trace, symbols, raw) != ESP_OK ||
+            memcmp(raw, frame, sizeof(raw)) != 0)
+        {
+            failures++;
+        }
+    }
+    report("dht11_decode", BENCH_DECODE_ITERATIONS, esp_timer_get_time() - start,
+           1, "frames/s", failures);
+    return failures ? ESP_FAIL : ESP_OK;
+}
+#else
+static esp_err_t bench_decode(void)
+{
+    // The legacy backend decodes while it samples the pin; there is no trace
+    ESP_LOGI(TAG, "dht11_decode skipped: legacy bit-bang backend");
+    return ESP_OK;
+}
+#endif
+
+/*----------------------------------------------------------------------------*/
+/* Payload encoding */
+
+#define BENCH_ENCODE_ITERATIONS 1000
+
+static sensor_sample_t bench_samples[WIFI_BATCH_MAX_SAMPLES];
+
+static void fill_samples(void)
+{
+    for (int i = 0; i < WIFI_BATCH_MAX_SAMPLES; i++)
+    {
+        bench_samples[i] = (sensor_sample_t) {
+            .timestamp = 1760000000u + (uint32_t)i * 300,
+            .temperature = 21.0f + (float)(i % 7) * 0.5f,
+            .humidity = 40.0f + (float)(i % 5),
+        };
+        // Every other sample stands for a 5-minute window, as the aggregator sends them
+        if (i & 1)
+        {
+            bench_samples[i].rollup = (sample_rollup_t) {
+                .count = 30,
+                .temperature_min = 2050, .temperature_max = 2150, .temperature_mean = 2100,
+                .humidity_min = 3900, .humidity_max = 4400, .humidity_mean = 4120,
+            };
+        }
+    }
+}
+
+static esp_err_t bench_encode(void)
+{
+    static char json[WIFI_BATCH_JSON_MAX_SIZE];
+    static uint8_t binary[TELEMETRY_BINARY_MAX_SIZE(WIFI_BATCH_MAX_SAMPLES)];
+    sensor_data_t data = { .temperature = 23.5f, .humidity = 55.0f, .timestamp = 1760000000u };
+    strncpy(data.device_id, BENCHMARK_DEVICE_ID, sizeof(data.device_id) - 1);
+    uint32_t failures = 0;
+
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCH_ENCODE_ITERATIONS; i++)
+    {
+        failures += (wifi_manager_format_json(&data, json, sizeof(json)) != ESP_OK);
+    }
+    report("format_json", BENCH_ENCODE_ITERATIONS, esp_timer_get_time() - start,
+           (uint32_t)strlen(json), "B/s", failures);
+
+    uint32_t batch_failures = 0;
+    start = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCH_ENCODE_ITERATIONS / 10; i++)
+    {
+        batch_failures += (wifi_manager_format_batch_json(BENCHMARK_DEVICE_ID, bench_samples,
+                                                          WIFI_BATCH_MAX_SAMPLES, json,
+                                                          sizeof(json)) != ESP_OK);
+    }
+    report("format_batch_json", BENCH_ENCODE_ITERATIONS / 10, esp_timer_get_time() - start,
+           WIFI_BATCH_MAX_SAMPLES, "samples/s", batch_failures);
+    failures += batch_failures;
+
+    uint32_t binary_failures = 0;
+    size_t length = 0;
+    start = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCH_ENCODE_ITERATIONS; i++)
+    {
+        binary_failures += (telemetry_codec_encode_binary(BENCHMARK_DEVICE_ID, -60, bench_samples,
+                                                          WIFI_BATCH_MAX_SAMPLES, binary,
+                                                          sizeof(binary), &length) != ESP_OK);
+    }
+    report("encode_binary_batch", BENCH_ENCODE_ITERATIONS, esp_timer_get_time() - start,
+           WIFI_BATCH_MAX_SAMPLES, "samples/s", binary_failures);
+    failures += binary_failures;
+
+    return failures ? ESP_FAIL : ESP_OK;
+}
+
+/*----------------------------------------------------------------------------*/
+
+static void load_build_id(void)
+{
+    // 8 hex digits of the ELF SHA-256, like the boot log's "ELF file SHA256"
+    esp_app_get_elf_sha256(build_id, sizeof(build_id));
+    ESP_LOGI(TAG, "Benchmarks for %s %s (build %s)", esp_app_get_description()->project_name,
+             esp_app_get_description()->version, build_id);
+}
+
+esp_err_t benchmark_run_local(void)
+{
+    load_build_id();
+    fill_samples();
+
+    bench_display("st7789_fill_rect", draw_rect, BENCH_RECT_SIZE * BENCH_RECT_SIZE,
+                  BENCH_RECT_ITERATIONS);
+    bench_display("st7789_clear_screen", draw_clear, BENCH_SCREEN_PIXELS,
+                  BENCH_CLEAR_ITERATIONS);
+    bench_display("st7789_draw_large_string", draw_string,
+                  (uint32_t)strlen(BENCH_STRING) * ST7789_LARGE_FONT_WIDTH * ST7789_LARGE_FONT_HEIGHT,
+                  BENCH_STRING_ITERATIONS);
+    bench_display("st7789_draw_text_32", draw_text_32,
+                  (uint32_t)strlen(BENCH_STRING) * ST7789_FONT_32_ADVANCE * 32, BENCH_STRING_ITERATIONS);
+    st7789_clear_screen(ST7789_BLACK);
+    st7789_flush();
+
+    esp_err_t decode = bench_decode();
+    esp_err_t encode = bench_encode();
+    return (decode == ESP_OK && encode == ESP_OK) ? ESP_OK : ESP_FAIL;
+}
+
+esp_err_t benchmark_run_network(void)
+{
+    if (!wifi_manager_is_ready())
+    {
+        ESP_LOGW(TAG, "Upload benchmarks skipped: WiFi not connected");
+        return ESP_ERR_INVALID_STATE;
+    }
+    fill_samples();
+
+    sensor_data_t data = { .temperature = 23.5f, .humidity = 55.0f, .timestamp = 1760000000u };
+    strncpy(data.device_id, BENCHMARK_DEVICE_ID, sizeof(data.device_id) - 1);
+
+    // Open the kept-alive connection first so only steady-state requests are timed
+    wifi_manager_send_data(&data);
+
+    uint32_t failures = 0;
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCHMARK_NETWORK_ITERATIONS; i++)
+    {
+        failures += (wifi_manager_send_data(&data) != ESP_OK);
+    }
+    wifi_manager_flush(HTTP_TIMEOUT_MS);
+    report("send_data", BENCHMARK_NETWORK_ITERATIONS, esp_timer_get_time() - start,
+           1, "req/s", failures);
+
+    uint32_t batch_failures = 0;
+    start = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCHMARK_NETWORK_ITERATIONS; i++)
+    {
+        batch_failures += (wifi_manager_send_batch(BENCHMARK_DEVICE_ID, bench_samples,
+                                                   WIFI_BATCH_MAX_SAMPLES) != ESP_OK);
+    }
+    wifi_manager_flush(HTTP_TIMEOUT_MS);
+    report("send_batch", BENCHMARK_NETWORK_ITERATIONS, esp_timer_get_time() - start,
+           WIFI_BATCH_MAX_SAMPLES, "samples/s", batch_failures);
+
+    return (failures + batch_failures) ? ESP_FAIL : ESP_OK;
+}
@@ -0,0 +1,65 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "esp_err.h"
+
+/**
+ * @file benchmark.h
+ * @brief On-device benchmarks of the display, sensor decode and upload paths
+ *
+ * Built into every image but only run when CONFIG_SYSTEM_BENCHMARK is set
+ * (menuconfig: Home Monitor, see system_manager.c); normal operation follows
+ * once they are done. Each benchmark repeats one operation a fixed number
+ * of times on the real hardware and prints one machine-readable line:
+ *
+ *   BENCH {"build":"1a2b3c4d","name":"st7789_fill_rect","iterations":200,
+ *          "per_op_ns":812000,"throughput":17733,"unit":"px/s","failures":0}
+ *
+ * "build" is the start of the application ELF SHA-256, so results of two
+ * firmware builds can be told apart. Capture the serial output of both
+ * runs and compare them with bench_compare.py, which flags every benchmark
+ * whose per_op_ns got worse by more than a threshold.
+ *
+ * Display benchmarks come in two forms: "<name>" only renders into the
+ * off-screen buffer (CPU cost, no bus traffic), "<name>_panel" also flushes
+ * every iteration to the panel over the configured ST7789 transport.
+ *
+ * The display, decode, encoding, aggregation and firmware image benchmarks
+ * also run on a development machine, against a counting stand-in for the
+ * ST7789 transport (test/host).
+ */
+
+/**
+ * @brief Iterations of each upload benchmark (one request each)
+ */
+#define BENCHMARK_NETWORK_ITERATIONS    10
+
+/**
+ * @brief Device id used by the upload benchmarks, so servers can drop them
+ *
+ * Fixed at build time (device_config.h), whatever id the unit is provisioned with.
+ */
+#define BENCHMARK_DEVICE_ID             DEVICE_CONFIG_DEFAULT_DEVICE_ID "_BENCH"
+
+/**
+ * @brief Run the display, DHT11 decode and payload encoding benchmarks
+ *
+ * Draws directly through the st7789 API, so call it after st7789_init()
+ * and before anything is posted to the display manager. Leaves the screen
+ * cleared to black.
+ *
+ * @return ESP_OK, or ESP_FAIL if a benchmark produced wrong results
+ */
+esp_err_t benchmark_run_local(void);
+
+/**
+ * @brief Time single-reading and batch uploads against the configured server
+ *
+ * Needs a connected WiFi link (point server_url at test_server.py).
+ *
+ * @return ESP_OK, ESP_ERR_INVALID_STATE without a link, or ESP_FAIL if
+ *         any upload failed
+ */
+esp_err_t benchmark_run_network(void);
+
+#endif // BENCHMARK_H
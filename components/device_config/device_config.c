@@ -0,0 +1,676 @@
+/**
+ * @file device_config.c
+ * @brief NVS-backed runtime configuration, see device_config.h
+ *
+ * Three copies of the configuration are kept:
+ * - active: what the getters return, published through the seqlock. Only
+ *   the writer side (init, push, trial outcome) changes it, from one task,
+ *   so that side reads it directly.
+ * - stored: mirror of the NVS keys, so that only changed keys are written.
+ * - fallback: the active configuration before a server URL trial, restored
+ *   on rollback.
+ *
+ * The configuration is a few hundred bytes, more than a seqlock usually
+ * protects. Full snapshots are only taken on a change or when a URL is
+ * needed; the periodic readers use the one-word getters.
+ *
+ * Every field is described once in config_fields[]; loading, storing and
+ * applying a push all walk that table.
+ */
+
+#include "device_config.h"
+#include "sample_aggregator.h"      // Deadband and heartbeat defaults
+#include "seqlock.h"
+#include "nvs.h"
+#include "nvs_flash.h"
+#include "esp_log.h"
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "DEVICE_CONFIG";
+
+#define CONFIG_NAMESPACE    "device_config"
+#define CONFIG_JSON_DEPTH   8       ///< Deepest nesting skipped in a response
+#define CONFIG_KEY_SIZE     32      ///< Longest JSON member name read, plus null
+
+typedef enum {
+    FIELD_STRING,       ///< char[size]; min is the shortest length
+    FIELD_U32,          ///< uint32_t in [min, max]
+    FIELD_CENTI,        ///< float, stored as uint32_t hundredths in [min, max]
+} field_type_t;
+
+typedef struct {
+    const char *key;        ///< NVS key and JSON member name (at most 15 characters)
+    field_type_t type;
+    uint16_t offset;        ///< Within device_config_t
+    uint16_t size;          ///< Bytes at offset
+    uint32_t min;
+    uint32_t max;
+    bool remote;            ///< May be set by a server push
+} config_field_t;
+
+#define CONFIG_FIELD(key, member, type, min, max, remote) \
+    { key, type, offsetof(device_config_t, member), sizeof(((device_config_t *)0)->member), \
+      min, max, remote }
+
+static const config_field_t config_fields[] = {
+    CONFIG_FIELD("ssid",          ssid,                 FIELD_STRING, 1,    0,          false),
+    CONFIG_FIELD("password",      password,             FIELD_STRING, 0,    0,          false),
+    CONFIG_FIELD("server_url",    server_url,           FIELD_STRING, 8,    0,          true),
+    CONFIG_FIELD("mqtt_uri",      mqtt_uri,             FIELD_STRING, 8,    0,          false),
+    CONFIG_FIELD("device_id",     device_id,            FIELD_STRING, 1,    0,          false),
+    CONFIG_FIELD("firmware_url",  firmware_url,         FIELD_STRING, 0,    0,          true),
+    CONFIG_FIELD("read_ms",       read_interval_ms,     FIELD_U32,    1000, 3600000,    true),
+    CONFIG_FIELD("transmit_ms",   transmit_interval_ms, FIELD_U32,    5000, 3600000,    true),
+    CONFIG_FIELD("temp_deadband", temperature_deadband, FIELD_CENTI,  0,    1000,       true),
+    CONFIG_FIELD("hum_deadband",  humidity_deadband,    FIELD_CENTI,  0,    2000,       true),
+    CONFIG_FIELD("heartbeat_s",   heartbeat_s,          FIELD_U32,    1,    86400,      true),
+    CONFIG_FIELD("version",       version,              FIELD_U32,    0,    UINT32_MAX, true),
+};
+
+#define CONFIG_FIELD_COUNT  (sizeof(config_fields) / sizeof(config_fields[0]))
+
+#define CONFIG_DEFAULTS { \
+    .ssid = DEVICE_CONFIG_DEFAULT_SSID, \
+    .password = DEVICE_CONFIG_DEFAULT_PASSWORD, \
+    .server_url = DEVICE_CONFIG_DEFAULT_SERVER_URL, \
+    .mqtt_uri = DEVICE_CONFIG_DEFAULT_MQTT_URI, \
+    .device_id = DEVICE_CONFIG_DEFAULT_DEVICE_ID, \
+    .firmware_url = "", \
+    .read_interval_ms = DEVICE_CONFIG_DEFAULT_READ_INTERVAL_MS, \
+    .transmit_interval_ms = DEVICE_CONFIG_DEFAULT_TRANSMIT_INTERVAL_MS, \
+    .temperature_deadband = AGGREGATOR_TEMPERATURE_DEADBAND, \
+    .humidity_deadband = AGGREGATOR_HUMIDITY_DEADBAND, \
+    .heartbeat_s = AGGREGATOR_HEARTBEAT_S, \
+    .version = 0, \
+}
+
+static const device_config_t defaults = CONFIG_DEFAULTS;
+static device_config_t active = CONFIG_DEFAULTS;
+static seqlock_t active_lock = SEQLOCK_INITIALIZER;
+static uint32_t generation = 0;
+
+static device_config_t stored = CONFIG_DEFAULTS;
+static device_config_t fallback;
+static bool on_trial = false;
+static uint32_t trial_failures = 0;
+static bool has_rejected = false;
+static uint32_t rejected_version = 0;
+
+static device_config_listener_t change_listener = NULL;
+static void *listener_ctx = NULL;
+
+// ============================================================================
+// Field access
+// ============================================================================
+
+static inline void *field_ptr(device_config_t *config, const config_field_t *field)
+{
+    return (uint8_t *)config + field->offset;
+}
+
+static inline const void *field_cptr(const device_config_t *config, const config_field_t *field)
+{
+    return (const uint8_t *)config + field->offset;
+}
+
+static const config_field_t *find_field(const char *key)
+{
+    for (size_t i = 0; i < CONFIG_FIELD_COUNT; i++)
+    {
+        if (strcmp(config_fields[i].key, key) == 0)
+        {
+            return &config_fields[i];
+        }
+    }
+    return NULL;
+}
+
+// Numeric field in its stored form (hundredths for CENTI)
+static uint32_t get_number(const device_config_t *config, const config_field_t *field)
+{
+    if (field->type == FIELD_CENTI)
+    {
+        float value;
+        memcpy(&value, field_cptr(config, field), sizeof(value));
+        return (uint32_t)lroundf(value * 100.0f);
+    }
+    uint32_t value;
+    memcpy(&value, field_cptr(config, field), sizeof(value));
+    return value;
+}
+
+// Check and assign a value read from NVS or a push; false leaves config unchanged
+static bool set_number(device_config_t *config, const config_field_t *field, uint32_t value)
+{
+    if (value < field->min || value > field->max)
+    {
+        return false;
+    }
+    if (field->type == FIELD_CENTI)
+    {
+        float scaled = (float)value / 100.0f;
+        memcpy(field_ptr(config, field), &scaled, sizeof(scaled));
+    }
+    else
+    {
+        memcpy(field_ptr(config, field), &value, sizeof(value));
+    }
+    return true;
+}
+
+static bool set_string(device_config_t *config, const config_field_t *field, const char *value)
+{
+    size_t length = strlen(value);
+    if (length < field->min || length >= field->size)
+    {
+        return false;
+    }
+    memcpy(field_ptr(config, field), value, length + 1);
+    return true;
+}
+
+static bool field_equal(const device_config_t *a, const device_config_t *b, const config_field_t *field)
+{
+    if (field->type == FIELD_STRING)
+    {
+        return strcmp(field_cptr(a, field), field_cptr(b, field)) == 0;
+    }
+    return get_number(a, field) == get_number(b, field);
+}
+
+// ============================================================================
+// Publication and storage
+// ============================================================================
+
+static void publish(const device_config_t *config)
+{
+    seqlock_store(&active_lock, &active, config, sizeof(active));
+    __atomic_add_fetch(&generation, 1, __ATOMIC_RELEASE);
+
+    if (change_listener != NULL)
+    {
+        change_listener(config, listener_ctx);
+    }
+}
+
+// Write the keys that differ from NVS; nothing is written for an unchanged configuration
+static esp_err_t store(const device_config_t *config)
+{
+    nvs_handle_t handle;
+    esp_err_t ret = nvs_open(CONFIG_NAMESPACE, NVS_READWRITE, &handle);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Cannot open NVS namespace: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    unsigned written = 0;
+    for (size_t i = 0; i < CONFIG_FIELD_COUNT && ret == ESP_OK; i++)
+    {
+        const config_field_t *field = &config_fields[i];
+        if (field_equal(config, &stored, field))
+        {
+            continue;
+        }
+        ret = (field->type == FIELD_STRING) ?
+              nvs_set_str(handle, field->key, field_cptr(config, field)) :
+              nvs_set_u32(handle, field->key, get_number(config, field));
+        written++;
+    }
+    if (ret == ESP_OK && written > 0)
+    {
+        ret = nvs_commit(handle);
+    }
+    nvs_close(handle);
+
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to store configuration: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    stored = *config;
+    ESP_LOGI(TAG, "Stored configuration version %lu (%u keys)", (unsigned long)config->version, written);
+    return ESP_OK;
+}
+
+static void load(device_config_t *config)
+{
+    *config = defaults;
+
+    nvs_handle_t handle;
+    if (nvs_open(CONFIG_NAMESPACE, NVS_READONLY, &handle) != ESP_OK)
+    {
+        ESP_LOGI(TAG, "Not provisioned - using build defaults");
+        return;
+    }
+
+    for (size_t i = 0; i < CONFIG_FIELD_COUNT; i++)
+    {
+        const config_field_t *field = &config_fields[i];
+        esp_err_t ret;
+        bool valid;
+        if (field->type == FIELD_STRING)
+        {
+            char value[DEVICE_CONFIG_URL_SIZE];
+            size_t length = sizeof(value);
+            ret = nvs_get_str(handle, field->key, value, &length);
+            valid = (ret == ESP_OK) && set_string(config, field, value);
+        }
+        else
+        {
+            uint32_t value;
+            ret = nvs_get_u32(handle, field->key, &value);
+            valid = (ret == ESP_OK) && set_number(config, field, value);
+        }
+
+        if (ret != ESP_ERR_NVS_NOT_FOUND && !valid)
+        {
+            ESP_LOGW(TAG, "Stored %s is invalid - using the default", field->key);
+        }
+    }
+    nvs_close(handle);
+}
+
+// ============================================================================
+// Minimal JSON reader for server responses
+// ============================================================================
+
+typedef struct {
+    const char *pos;
+    const char *end;
+} json_cursor_t;
+
+static char peek(json_cursor_t *c)
+{
+    while (c->pos < c->end && (*c->pos == ' ' || *c->pos == '\t' || *c->pos == '\r' || *c->pos == '\n'))
+    {
+        c->pos++;
+    }
+    return (c->pos < c->end) ? *c->pos : '\0';
+}
+
+static bool consume(json_cursor_t *c, char expected)
+{
+    if (peek(c) != expected)
+    {
+        return false;
+    }
+    c->pos++;
+    return true;
+}
+
+/**
+ * @brief Read a string into out (or skip it with out == NULL)
+ *
+ * \uXXXX escapes are not supported; URLs and ids do not need them.
+ */
+static bool read_string(json_cursor_t *c, char *out, size_t size)
+{
+    if (!consume(c, '"'))
+    {
+        return false;
+    }
+
+    size_t length = 0;
+    while (c->pos < c->end)
+    {
+        char ch = *c->pos++;
+        if (ch == '"')
+        {
+            if (out != NULL)
+            {
+                out[length] = '\0';
+            }
+            return true;
+        }
+        if ((unsigned char)ch < 0x20)
+        {
+            return false;
+        }
+        if (ch == '\\')
+        {
+            if (c->pos == c->end)
+            {
+                return false;
+            }
+            switch (ch = *c->pos++)
+            {
+                case '"': case '\\': case '/': break;
+                case 'n': ch = '\n'; break;
+                case 'r': ch = '\r'; break;
+                case 't': ch = '\t'; break;
+                default: return false;
+            }
+        }
+        if (out != NULL)
+        {
+            if (length + 1 >= size)
+            {
+                return false;
+            }
+            out[length] = ch;
+        }
+        length++;
+    }
+    return false;
+}
+
+// Copy a number or literal token into out
+static bool read_token(json_cursor_t *c, char *out, size_t size)
+{
+    peek(c);
+    size_t length = 0;
+    while (c->pos < c->end && length + 1 < size &&
+           ((*c->pos >= '0' && *c->pos <= '9') || (*c->pos >= 'a' && *c->pos <= 'z') ||
+            *c->pos == '-' || *c->pos == '+' || *c->pos == '.' || *c->pos == 'E'))
+    {
+        out[length++] = *c->pos++;
+    }
+    out[length] = '\0';
+    return length > 0;
+}
+
+static bool skip_value(json_cursor_t *c, int depth)
+{
+    char ch = peek(c);
+    if (ch == '"')
+    {
+        return read_string(c, NULL, 0);
+    }
+    if (ch == '{' || ch == '[')
+    {
+        char close = (ch == '{') ? '}' : ']';
+        c->pos++;
+        if (depth == 0)
+        {
+            return false;
+        }
+        if (consume(c, close))
+        {
+            return true;
+        }
+        do
+        {
+            if (ch == '{' && (!read_string(c, NULL, 0) || !consume(c, ':')))
+            {
+                return false;
+            }
+            if (!skip_value(c, depth - 1))
+            {
+                return false;
+            }
+        } while (consume(c, ','));
+        return consume(c, close);
+    }
+    char token[24];
+    return read_token(c, token, sizeof(token));
+}
+
+typedef bool (*json_member_fn_t)(json_cursor_t *c, const char *key, void *ctx);
+
+// Walk an object's members; on_member must read or skip each value
+static bool read_object(json_cursor_t *c, json_member_fn_t on_member, void *ctx)
+{
+    if (!consume(c, '{'))
+    {
+        return false;
+    }
+    if (consume(c, '}'))
+    {
+        return true;
+    }
+    do
+    {
+        char key[CONFIG_KEY_SIZE];
+        if (!read_string(c, key, sizeof(key)) || !consume(c, ':') || !on_member(c, key, ctx))
+        {
+            return false;
+        }
+    } while (consume(c, ','));
+    return consume(c, '}');
+}
+
+// ============================================================================
+// Server push
+// ============================================================================
+
+typedef struct {
+    device_config_t config;     ///< Active configuration with the push applied
+    bool found;                 ///< The response has a "config" object
+    bool has_version;
+} config_push_t;
+
+static bool parse_number(const config_field_t *field, const char *token, uint32_t *value)
+{
+    char *end;
+    if (field->type == FIELD_CENTI)
+    {
+        float number = strtof(token, &end);
+        if (end == token || *end != '\0' || !(number >= 0.0f && number < 1e6f))
+        {
+            return false;
+        }
+        *value = (uint32_t)lroundf(number * 100.0f);
+        return true;
+    }
+
+    errno = 0;
+    unsigned long number = strtoul(token, &end, 10);
+    if (token[0] == '-' || end == token || *end != '\0' || errno != 0)
+    {
+        return false;   // Negative, fractional or out of range
+    }
+    *value = (uint32_t)number;
+    return true;
+}
+
+static bool read_config_member(json_cursor_t *c, const char *key, void *ctx)
+{
+    config_push_t *push = ctx;
+    const config_field_t *field = find_field(key);
+    if (field == NULL)
+    {
+        // A newer server may know more keys than this firmware
+        ESP_LOGW(TAG, "Ignoring unknown configuration key '%s'", key);
+        return skip_value(c, CONFIG_JSON_DEPTH);
+    }
+
+    bool valid;
+    if (field->type == FIELD_STRING)
+    {
+        char value[DEVICE_CONFIG_URL_SIZE];
+        valid = read_string(c, value, sizeof(value)) && field->remote &&
+                set_string(&push->config, field, value);
+    }
+    else
+    {
+        char token[24];
+        uint32_t value;
+        valid = read_token(c, token, sizeof(token)) && field->remote &&
+                parse_number(field, token, &value) && set_number(&push->config, field, value);
+    }
+
+    if (!valid)
+    {
+        ESP_LOGW(TAG, "Configuration push rejected: %s %s", key,
+                 field->remote ? "is invalid" : "is local only");
+        return false;
+    }
+    if (strcmp(key, "version") == 0)
+    {
+        push->has_version = true;
+    }
+    return true;
+}
+
+static bool read_response_member(json_cursor_t *c, const char *key, void *ctx)
+{
+    config_push_t *push = ctx;
+    if (strcmp(key, "config") != 0)
+    {
+        return skip_value(c, CONFIG_JSON_DEPTH);
+    }
+    push->found = true;
+    return read_object(c, read_config_member, push);
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+void device_config_set_listener(device_config_listener_t listener, void *ctx)
+{
+    change_listener = listener;
+    listener_ctx = ctx;
+}
+
+esp_err_t device_config_init(void)
+{
+    esp_err_t ret = nvs_flash_init();
+    if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND)
+    {
+        // Partition full or written by a newer NVS version
+        ESP_LOGW(TAG, "NVS partition needs to be erased");
+        ret = nvs_flash_erase();
+        if (ret == ESP_OK)
+        {
+            ret = nvs_flash_init();
+        }
+    }
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "NVS initialization failed: %s - using build defaults", esp_err_to_name(ret));
+        return ret;
+    }
+
+    device_config_t config;
+    load(&config);
+    stored = config;
+    publish(&config);
+
+    ESP_LOGI(TAG, "Device %s, configuration version %lu: read every %lu ms, upload every %lu ms",
+             config.device_id, (unsigned long)config.version,
+             (unsigned long)config.read_interval_ms, (unsigned long)config.transmit_interval_ms);
+    return ESP_OK;
+}
+
+void device_config_get(device_config_t *config)
+{
+    seqlock_load(&active_lock, &active, config, sizeof(*config));
+}
+
+uint32_t device_config_generation(void)
+{
+    return __atomic_load_n(&generation, __ATOMIC_ACQUIRE);
+}
+
+// One word of the active configuration, consistent with the rest of the snapshot
+static uint32_t load_word(const uint32_t *word)
+{
+    uint32_t sequence;
+    uint32_t value;
+    do
+    {
+        sequence = seqlock_read_begin(&active_lock);
+        value = *(const volatile uint32_t *)word;
+    } while (seqlock_read_retry(&active_lock, sequence));
+    return value;
+}
+
+uint32_t device_config_read_interval_ms(void)
+{
+    return load_word(&active.read_interval_ms);
+}
+
+uint32_t device_config_transmit_interval_ms(void)
+{
+    return load_word(&active.transmit_interval_ms);
+}
+
+uint32_t device_config_version(void)
+{
+    return load_word(&active.version);
+}
+
+esp_err_t device_config_apply_json(const char *body, size_t length)
+{
+    if (body == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    config_push_t push = { .config = active };
+    json_cursor_t cursor = { .pos = body, .end = body + length };
+    bool parsed = read_object(&cursor, read_response_member, &push);
+    if (!push.found)
+    {
+        return ESP_ERR_NOT_FOUND;   // Also for bodies that are not JSON at all
+    }
+    if (!parsed)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!push.has_version)
+    {
+        ESP_LOGW(TAG, "Configuration push without version ignored");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (push.config.version == active.version)
+    {
+        return ESP_OK;
+    }
+    if (has_rejected && push.config.version == rejected_version)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    bool moves_server = strcmp(push.config.server_url, active.server_url) != 0;
+    ESP_LOGI(TAG, "Applying configuration version %lu (was %lu)%s",
+             (unsigned long)push.config.version, (unsigned long)active.version,
+             moves_server ? ", new server URL on trial" : "");
+
+    // A push during a trial joins it; the fallback stays the last confirmed one
+    if (moves_server && !on_trial)
+    {
+        fallback = active;
+        on_trial = true;
+    }
+    trial_failures = 0;
+    publish(&push.config);
+
+    if (!on_trial)
+    {
+        store(&push.config);
+    }
+    return ESP_OK;
+}
+
+void device_config_upload_result(bool delivered)
+{
+    if (!on_trial)
+    {
+        return;
+    }
+
+    if (delivered)
+    {
+        ESP_LOGI(TAG, "Server %s confirmed", active.server_url);
+        on_trial = false;
+        store(&active);
+        return;
+    }
+
+    if (++trial_failures < DEVICE_CONFIG_TRIAL_FAILURES)
+    {
+        return;
+    }
+    ESP_LOGW(TAG, "%d uploads to %s failed - rolling back to configuration version %lu",
+             DEVICE_CONFIG_TRIAL_FAILURES, active.server_url, (unsigned long)fallback.version);
+    has_rejected = true;
+    rejected_version = active.version;
+    on_trial = false;
+    publish(&fallback);
+}
@@ -0,0 +1,196 @@
+#ifndef DEVICE_CONFIG_H
+#define DEVICE_CONFIG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+/**
+ * @file device_config.h
+ * @brief Runtime device configuration stored in NVS, updated by the server
+ *
+ * Everything that differs between units or deployments (network
+ * credentials, server addresses, device id, intervals, reporting
+ * deadbands) lives here instead of in compile-time #defines. The values
+ * below are only the defaults of a unit that was never provisioned.
+ *
+ * Storage:
+ * Each field is its own key in the "device_config" NVS namespace, so a
+ * unit can be provisioned by flashing an NVS image generated with
+ * nvs_partition_gen.py from a CSV:
+ *
+ *   key,type,encoding,value
+ *   device_config,namespace,,
+ *   ssid,data,string,HomeNet
+ *   password,data,string,secret
+ *   device_id,data,string,ESP32_KITCHEN
+ *   server_url,data,string,http://192.168.0.10:3000/api/sensor-data
+ *   read_ms,data,u32,10000
+ *   temp_deadband,data,u32,50
+ *
+ * Deadbands are stored in hundredths (50 = 0.5 °C). Missing keys and
+ * values outside their range fall back to the default.
+ *
+ * RAM copy:
+ * The active configuration is published through a seqlock. Readers on
+ * either core never block; device_config_read_interval_ms() and the other
+ * scalar getters copy a single word and are meant for the hot path.
+ *
+ * Server push:
+ * A server response may carry a "config" object with a "version" and any
+ * of the remotely settable keys (JSON member names are the NVS keys,
+ * deadbands in °C / % RH):
+ *
+ *   {"status":"success","config":{"version":7,"transmit_ms":60000,"temp_deadband":0.3}}
+ *
+ * A push whose version differs from the active one is validated as a
+ * whole and applied at once; a push with the active version is a no-op,
+ * so the server may repeat it in every response. The credentials, the
+ * MQTT broker and the device id are local only: a wrong value pushed
+ * there would cut the unit off from the server that could correct it.
+ *
+ * firmware_url names the firmware image the unit should run; ota_manager
+ * fetches it in the background when it differs from the running one.
+ *
+ * A push that moves server_url is applied on trial: it is used right
+ * away but written to NVS only once an upload to the new URL succeeded.
+ * After DEVICE_CONFIG_TRIAL_FAILURES failed uploads the previous
+ * configuration is restored and that version is ignored until reboot.
+ *
+ * Threading:
+ * Getters are safe from any task. device_config_apply_json() and
+ * device_config_upload_result() are called from the upload task only.
+ */
+
+/**
+ * @brief Defaults of an unprovisioned unit (override with -D at build time)
+ */
+#ifndef DEVICE_CONFIG_DEFAULT_SSID
+#define DEVICE_CONFIG_DEFAULT_SSID              "TempRouter"
+#endif
+#ifndef DEVICE_CONFIG_DEFAULT_PASSWORD
+#define DEVICE_CONFIG_DEFAULT_PASSWORD          "QPWO0192"
+#endif
+#ifndef DEVICE_CONFIG_DEFAULT_SERVER_URL
+#define DEVICE_CONFIG_DEFAULT_SERVER_URL        "http://192.168.0.246:3000/api/sensor-data"
+#endif
+#ifndef DEVICE_CONFIG_DEFAULT_MQTT_URI
+#define DEVICE_CONFIG_DEFAULT_MQTT_URI          "mqtt://192.168.0.246:1883"
+#endif
+#ifndef DEVICE_CONFIG_DEFAULT_DEVICE_ID
+#define DEVICE_CONFIG_DEFAULT_DEVICE_ID         "ESP32_SENSOR_01"
+#endif
+#ifndef DEVICE_CONFIG_DEFAULT_READ_INTERVAL_MS
+#define DEVICE_CONFIG_DEFAULT_READ_INTERVAL_MS      10000   ///< DHT11 reading every 10 seconds
+#endif
+#ifndef DEVICE_CONFIG_DEFAULT_TRANSMIT_INTERVAL_MS
+#define DEVICE_CONFIG_DEFAULT_TRANSMIT_INTERVAL_MS  30000   ///< Upload every 30 seconds
+#endif
+
+/**
+ * @brief Failed uploads to a pushed server URL before it is rolled back
+ */
+#define DEVICE_CONFIG_TRIAL_FAILURES    3
+
+#define DEVICE_CONFIG_SSID_SIZE         33      ///< 32 characters, as in wifi_sta_config_t
+#define DEVICE_CONFIG_PASSWORD_SIZE     65      ///< 64 characters, as in wifi_sta_config_t
+#define DEVICE_CONFIG_URL_SIZE          128
+#define DEVICE_CONFIG_DEVICE_ID_SIZE    32      ///< Same as sensor_data_t.device_id
+
+typedef struct {
+    char ssid[DEVICE_CONFIG_SSID_SIZE];
+    char password[DEVICE_CONFIG_PASSWORD_SIZE];
+    char server_url[DEVICE_CONFIG_URL_SIZE];    ///< HTTP transport endpoint
+    char mqtt_uri[DEVICE_CONFIG_URL_SIZE];      ///< MQTT transport broker
+    char device_id[DEVICE_CONFIG_DEVICE_ID_SIZE];
+    char firmware_url[DEVICE_CONFIG_URL_SIZE];  ///< Firmware image to run, "" = none (see ota_manager.h)
+    uint32_t read_interval_ms;                  ///< Sensor period (1 s .. 1 h)
+    uint32_t transmit_interval_ms;              ///< Upload period (5 s .. 1 h)
+    float temperature_deadband;                 ///< °C, see sample_aggregator.h
+    float humidity_deadband;                    ///< % RH, see sample_aggregator.h
+    uint32_t heartbeat_s;                       ///< See sample_aggregator.h
+    uint32_t version;                           ///< Server's version of this configuration, 0 = never pushed
+} device_config_t;
+
+/**
+ * @brief Called after the active configuration changed
+ *
+ * Runs in the task that caused the change (device_config_init() or the
+ * upload task) and must not block.
+ *
+ * @param config The new active configuration
+ * @param ctx    Pointer passed to device_config_set_listener()
+ */
+typedef void (*device_config_listener_t)(const device_config_t *config, void *ctx);
+
+/**
+ * @brief Set the change listener; call before device_config_init()
+ */
+void device_config_set_listener(device_config_listener_t listener, void *ctx);
+
+/**
+ * @brief Initialize NVS and load the stored configuration
+ *
+ * Erases the NVS partition if it is full or of an older format, like
+ * wifi_manager_init() did before. The listener is called once with the
+ * loaded configuration. Until then the getters return the defaults.
+ *
+ * @return ESP_OK on success (missing or invalid keys only log a warning)
+ * @return NVS error if the partition could not be initialized
+ */
+esp_err_t device_config_init(void);
+
+/**
+ * @brief Snapshot of the active configuration
+ */
+void device_config_get(device_config_t *config);
+
+/**
+ * @brief Incremented on every change of the active configuration
+ *
+ * Lets a user of string fields (URLs) check cheaply whether its copy is
+ * still current.
+ */
+uint32_t device_config_generation(void);
+
+/**
+ * @brief Active sensor period (ms)
+ */
+uint32_t device_config_read_interval_ms(void);
+
+/**
+ * @brief Active upload period (ms)
+ */
+uint32_t device_config_transmit_interval_ms(void);
+
+/**
+ * @brief Version of the active configuration, as reported to the server
+ */
+uint32_t device_config_version(void);
+
+/**
+ * @brief Apply the "config" object of a server response, if it has one
+ *
+ * @param body   Response body (need not be null-terminated)
+ * @param length Body length in bytes
+ * @return ESP_OK if the push was applied or its version is already active
+ * @return ESP_ERR_NOT_FOUND if the body carries no "config" object
+ * @return ESP_ERR_INVALID_ARG if the body or a value is malformed, out of
+ *         range, not remotely settable, or the version is missing; nothing
+ *         is changed then
+ * @return ESP_ERR_INVALID_STATE if this version was rolled back before
+ */
+esp_err_t device_config_apply_json(const char *body, size_t length);
+
+/**
+ * @brief Report the outcome of an upload to the active server URL
+ *
+ * Confirms a server URL on trial (and stores it) on success; counts
+ * towards the rollback on failure. Does nothing without a trial.
+ *
+ * @param delivered true if the server accepted the upload (2xx)
+ */
+void device_config_upload_result(bool delivered);
+
+#endif // DEVICE_CONFIG_H
@@ -22,10 +22,22 @@
  * - Byte 4: Checksum (sum of bytes 0-3)
  * 
  * Timing Considerations:
- * - All timing is implemented using microsecond-precision delays
- * - Interrupts are disabled during critical timing sections
- * - GPIO operations use direct register access for speed
- * - Timeout mechanisms prevent infinite loops on sensor failure
+ * - Frame capture is delegated to a backend (dht11_capture.h). The default
+ *   RMT backend sleeps through the start pulse and lets the RMT peripheral
+ *   timestamp the reply, so interrupts are never masked
+ * - The legacy polling backend (DHT11_USE_LEGACY_BITBANG) still disables
+ *   interrupts for the whole exchange
+ * - Timeout mechanisms prevent infinite waits on sensor failure
+ * - An ESP_PM_CPU_FREQ_MAX lock is held from the start signal until the
+ *   frame has been collected, so neither DFS nor automatic light sleep can
+ *   stretch the timer steps or the legacy backend's polling loop
+ * - Read latency, per-step CPU time and (legacy backend) interrupt-masked
+ *   time are recorded in perf_monitor.h
+ * 
+ * Recovery:
+ * - dht11_reset() rebuilds the pin and capture configuration
+ * - dht11_power_cycle() switches the sensor's supply (DHT11_POWER_PIN) off
+ *   and on through the same one-shot timer that sequences the reads
  * 
  * Error Handling Strategy:
  * - Communication errors return ESP_FAIL with detailed logging
@@ -50,11 +62,17 @@ extern "C"
  - internal and external interfaces from this unit
  */
 #include "dht11.h"              // DHT11 sensor driver API definitions
+#include "dht11_capture.h"      // Frame capture backend (RMT or legacy polling)
 #include "driver/gpio.h"        // ESP32 GPIO control functions
 #include "esp_log.h"            // ESP-IDF logging system
 #include "esp_timer.h"          // High-precision timer for microsecond delays
+#include "esp_pm.h"             // CPU frequency lock during the exchange
+#include "esp_system.h"         // Reset reason: was the supply held through deep sleep
+#include "perf_monitor.h"       // Read latency and step CPU time
+#include "event_log.h"          // Deferred logging from the step timer callbacks
 #include "freertos/FreeRTOS.h"  // FreeRTOS kernel functions
 #include "freertos/task.h"      // FreeRTOS task management
+#include "freertos/semphr.h"    // Completion semaphore for blocking reads
 #include <stdio.h>              // Standard I/O for string formatting
 
 /*============================================================================*/
@@ -69,6 +87,44 @@ static const char *TAG = "DHT11";
 
 /*============================================================================*/
 /* LOCAL TYPEDEFINITIONS (STRUCTURES, UNIONS, ENUMS, MACROS) */
+/**
+ * @brief Steps of the asynchronous read state machine
+ * 
+ * Each state names what the pending one-shot timer will do when it fires:
+ * 
+ *   IDLE --dht11_read_async()--> STABILIZING  (DHT11_STABILIZATION_MS)
+ *   STABILIZING ---------------> START_SIGNAL (DHT11_START_LOW_TIME, line low)
+ *   START_SIGNAL --------------> CAPTURING    (DHT11_CAPTURE_WINDOW_US)
+ *   CAPTURING --ok-------------> IDLE, callback
+ *   CAPTURING --fail, retry----> STABILIZING  (DHT11_RETRY_DELAY_MS + stabilization)
+ *   CAPTURING --fail, no retry-> IDLE, callback with cached reading or ESP_FAIL
+ * 
+ *   IDLE --dht11_power_cycle()-> POWER_OFF    (DHT11_POWER_OFF_MS, supply off)
+ *   POWER_OFF -----------------> POWER_UP     (DHT11_POWER_UP_MS, supply on)
+ *   POWER_UP ------------------> IDLE, or STABILIZING if a read was deferred
+ * 
+ * dht11_init() starts in POWER_UP after switching the supply on. A read
+ * requested during POWER_UP is accepted and starts when the sensor is up.
+ * RESETTING has no timer; dht11_reset() holds it while it reconfigures.
+ */
+typedef enum {
+    DHT11_STATE_IDLE = 0,
+    DHT11_STATE_STABILIZING,
+    DHT11_STATE_START_SIGNAL,
+    DHT11_STATE_CAPTURING,
+    DHT11_STATE_POWER_OFF,
+    DHT11_STATE_POWER_UP,
+    DHT11_STATE_RESETTING
+} dht11_state_t;
+
+/**
+ * @brief Rendezvous between dht11_read() and its completion callback
+ */
+typedef struct {
+    SemaphoreHandle_t done;
+    esp_err_t result;
+    dht11_data_t data;
+} dht11_blocking_read_t;
 
 /*============================================================================*/
 /* EXPORTED TYPEDEFINITIONS */
@@ -88,143 +144,352 @@ static const char *TAG = "DHT11";
  */
 static dht11_data_t last_reading = {0};
 
+/**
+ * @brief Asynchronous read state
+ * 
+ * step_timer drives every transition and runs in the esp_timer task, which
+ * serializes all state changes after a read has been accepted. state_lock
+ * only guards the claim of the IDLE state (see claim_idle()).
+ */
+static esp_timer_handle_t step_timer = NULL;
+static portMUX_TYPE state_lock = portMUX_INITIALIZER_UNLOCKED;
+static volatile dht11_state_t state = DHT11_STATE_IDLE;
+static int attempt = 0;
+static dht11_read_cb_t pending_callback = NULL;
+static void *pending_ctx = NULL;
+static perf_timestamp_t read_started = 0;   ///< When the pending read was accepted
+
+/**
+ * @brief Power management lock held from start signal to frame collection
+ * 
+ * NULL when power management is disabled (CONFIG_PM_ENABLE not set).
+ */
+static esp_pm_lock_handle_t cpu_lock = NULL;
+
 /*============================================================================*/
 /* EXPORTED VARIABLES */
 
 /*============================================================================*/
 /* LOCAL FUNCTIONS */
 /**
- * @brief Wait for GPIO pin to reach expected logic level with timeout
- * 
- * Helper function that monitors a GPIO pin until it reaches the expected
- * logic level or times out. This is essential for DHT11 communication
- * timing as it allows precise measurement of signal transitions.
+ * @brief Validate a raw frame and convert it to a reading
  * 
- * Timing Measurement:
- * Uses esp_timer_get_time() for microsecond-precision timing measurements.
- * This accuracy is critical for distinguishing between '0' and '1' bits
- * in the DHT11 protocol.
- * 
- * Timeout Protection:
- * Prevents infinite loops when the sensor fails to respond or is disconnected.
- * Returns immediately when timeout is exceeded to allow error handling.
+ * Data Format:
+ * - Byte 0: Humidity integer part (0-100)
+ * - Byte 1: Humidity decimal part (always 0 for DHT11)
+ * - Byte 2: Temperature integer part (0-50°C)
+ * - Byte 3: Temperature decimal part (always 0 for DHT11)
+ * - Byte 4: Checksum (sum of bytes 0-3, lower 8 bits)
  * 
- * Usage in DHT11 Protocol:
- * - Wait for sensor response acknowledgment
- * - Measure bit timing for data decoding
- * - Detect communication failures quickly
+ * @param raw_data Frame bytes from dht11_capture_finish()
+ * @param data Pointer to structure for storing sensor readings
+ * @return ESP_OK on success, ESP_FAIL on checksum mismatch
+ */
+static esp_err_t decode_frame(const uint8_t raw_data[DHT11_FRAME_BYTES], dht11_data_t* data)
+{
+    // Initialize data structure to safe default values
+    data->temperature = 0.0;
+    data->humidity = 0.0;
+    data->valid = false;
+    
+    ESP_LOGD(TAG, "Raw data: [0x%02X, 0x%02X, 0x%02X, 0x%02X, 0x%02X]", 
+             raw_data[0], raw_data[1], raw_data[2], raw_data[3], raw_data[4]);
+    ESP_LOGD(TAG, "Validating checksum...");
+    
+    // Validate data integrity using checksum
+    // Checksum is the sum of the first 4 bytes (lower 8 bits)
+    uint8_t calculated_checksum = raw_data[0] + raw_data[1] + raw_data[2] + raw_data[3];
+    if (calculated_checksum != raw_data[4]) 
+    {
+        EVENT_LOGW(TAG, "Checksum mismatch - calculated: 0x%02X, received: 0x%02X", 
+                   calculated_checksum, raw_data[4]);
+        EVENT_LOG_BANNER(TAG, "Data may be corrupted, discarding reading");
+        return ESP_FAIL;
+    }
+    
+    // Extract and convert sensor readings to floating-point values
+    // DHT11 format: integer.decimal (decimal part always 0 for DHT11)
+    data->humidity = (float)raw_data[0] + (float)raw_data[1] / 10.0;
+    data->temperature = (float)raw_data[2] + (float)raw_data[3] / 10.0;
+    data->valid = true;
+    
+    // Validate readings are within expected sensor range
+    if (data->humidity < DHT11_HUMIDITY_MIN || data->humidity > DHT11_HUMIDITY_MAX) 
+    {
+        EVENT_LOGW(TAG, "Humidity reading %.1f%% outside valid range (%d-%d%%)", 
+                   data->humidity, DHT11_HUMIDITY_MIN, DHT11_HUMIDITY_MAX);
+    }
+    
+    if (data->temperature < DHT11_TEMP_MIN || data->temperature > DHT11_TEMP_MAX) 
+    {
+        EVENT_LOGW(TAG, "Temperature reading %.1f°C outside valid range (%d-%d°C)", 
+                   data->temperature, DHT11_TEMP_MIN, DHT11_TEMP_MAX);
+    }
+    
+    return ESP_OK;
+}
+/*----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief Leave IDLE for @p next if no read, reset or power cycle is running
  * 
- * @param expected_level Logic level to wait for (0 = low, 1 = high)
- * @param timeout_us Maximum time to wait in microseconds
+ * @return true if the state machine now belongs to the caller
+ */
+static bool claim_idle(dht11_state_t next)
+{
+    taskENTER_CRITICAL(&state_lock);
+    bool claimed = (state == DHT11_STATE_IDLE);
+    if (claimed) 
+    {
+        state = next;
+    }
+    taskEXIT_CRITICAL(&state_lock);
+    return claimed;
+}
+/*----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief Accept a read while the sensor is powering up
  * 
- * @return Time actually waited in microseconds (>= 0)
- * @return -1 if timeout was exceeded before pin reached expected level
+ * The read starts with its stabilization delay when POWER_UP ends. Only
+ * one read can wait; it counts as in flight like any other.
  * 
- * @note This function busy-waits and should only be used during sensor communication
- * @note Interrupts should be disabled during timing-critical measurements
+ * @return true if the read was queued behind the power-up wait
  */
-static int32_t wait_for_pin_state(int expected_level, uint32_t timeout_us) 
+static bool defer_until_powered(dht11_read_cb_t callback, void* ctx)
 {
-    int64_t start_time = esp_timer_get_time();  // Record start time for timeout calculation
-    
-    // Small initial delay to avoid immediate false positives on pin transitions
-    esp_rom_delay_us(1);
+    taskENTER_CRITICAL(&state_lock);
+    bool deferred = (state == DHT11_STATE_POWER_UP && pending_callback == NULL);
+    if (deferred) 
+    {
+        pending_callback = callback;
+        pending_ctx = ctx;
+        attempt = 1;
+        read_started = PERF_BEGIN();
+    }
+    taskEXIT_CRITICAL(&state_lock);
+    return deferred;
+}
+/*----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief Configure the data pin as an open-drain line with pull-up, idle high
+ */
+static esp_err_t configure_data_pin(void)
+{
+    // Open drain allows both output (host->sensor) and input (sensor->host)
+    gpio_config_t config = 
+    {
+        .pin_bit_mask = (1ULL << DHT11_DATA_PIN),    // Target specific GPIO pin
+        .mode = GPIO_MODE_INPUT_OUTPUT_OD,           // Open drain for single-wire protocol
+        .pull_up_en = GPIO_PULLUP_ENABLE,            // Internal pull-up resistor (required)
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,       // Disable conflicting pull-down
+        .intr_type = GPIO_INTR_DISABLE               // No GPIO interrupts needed
+    };
     
-    // Poll pin state until it matches expected level or timeout occurs
-    while (gpio_get_level(DHT11_DATA_PIN) != expected_level) 
+    esp_err_t ret = gpio_config(&config);
+    if (ret != ESP_OK) 
     {
-        int64_t elapsed = esp_timer_get_time() - start_time;
-        if (elapsed > timeout_us) 
-        {
-            return -1;  // Timeout exceeded - sensor not responding
-        }
-        
-        // Small delay to prevent excessive CPU usage during polling
-        // This also helps with GPIO stability on some ESP32 variants
-        esp_rom_delay_us(1);
+        ESP_LOGE(TAG, "Failed to configure DHT11 data pin %d: %s", DHT11_DATA_PIN, esp_err_to_name(ret));
+        return ret;
     }
     
-    // Return actual time waited (useful for bit timing analysis)
-    return (int32_t)(esp_timer_get_time() - start_time);
+    // Set pin high initially (idle state for single-wire protocol)
+    // This ensures the sensor sees the expected idle state after initialization
+    gpio_set_level(DHT11_DATA_PIN, 1);
+    return ESP_OK;
 }
 /*----------------------------------------------------------------------------*/
 
 /*----------------------------------------------------------------------------*/
 /**
- * @brief Read single data bit from DHT11 sensor
- * 
- * Implements the DHT11 bit reading protocol by measuring the duration
- * of the high pulse that follows each bit's low start pulse.
- * 
- * DHT11 Bit Encoding:
- * - Every bit starts with ~50µs low pulse
- * - Followed by variable-length high pulse:
- *   * '0' bit: 26-28µs high pulse
- *   * '1' bit: ~70µs high pulse
- * 
- * Decoding Algorithm:
- * 1. Wait for low pulse (start of bit)
- * 2. Wait for high pulse (data encoding)
- * 3. Measure high pulse duration
- * 4. Compare duration to threshold (DHT11_BIT_THRESHOLD)
- * 5. Return 0 for short pulses, 1 for long pulses
- * 
- * Error Conditions:
- * - Timeout waiting for low-to-high transition
- * - Timeout waiting for high-to-low transition
- * - Invalid pulse duration measurements
- * 
- * @return 0 for logic '0' bit
- * @return 1 for logic '1' bit
- * @return -1 on communication error or timeout
- * 
- * @note Called 40 times sequentially to read complete sensor data
- * @note Timing accuracy is critical for correct bit decoding
+ * @brief Hold the CPU at full clock for the timing-critical part of a read
  */
-static int read_bit(void) 
+static void exchange_begin(void)
 {
-    int64_t bit_start = esp_timer_get_time();
-    
-    // Wait for low-to-high transition (start of bit)
-    // Each bit transmission begins with a low pulse followed by data encoding
-    int32_t low_wait = wait_for_pin_state(0, DHT11_BIT_TIMEOUT);
-    if (low_wait < 0) 
+    if (cpu_lock != NULL) 
     {
-        ESP_LOGD(TAG, "Bit read failed: timeout waiting for low state after %lldµs", 
-                 esp_timer_get_time() - bit_start);
-        return -1;  // Timeout waiting for start of bit
+        esp_pm_lock_acquire(cpu_lock);
     }
+}
+
+static void exchange_end(void)
+{
+    if (cpu_lock != NULL) 
+    {
+        esp_pm_lock_release(cpu_lock);
+    }
+}
+/*----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief Return to IDLE and deliver the result
+ * 
+ * The state is cleared before the callback runs so that the callback may
+ * immediately start the next read.
+ */
+static void complete_read(esp_err_t result, const dht11_data_t* data)
+{
+    dht11_read_cb_t callback = pending_callback;
+    void *ctx = pending_ctx;
     
-    int32_t high_wait = wait_for_pin_state(1, DHT11_BIT_TIMEOUT);
-    if (high_wait < 0) {
-        ESP_LOGD(TAG, "Bit read failed: timeout waiting for high state (low took %ldµs)", low_wait);
-        return -1;  // Timeout waiting for data encoding pulse
+    pending_callback = NULL;
+    pending_ctx = NULL;
+    state = DHT11_STATE_IDLE;
+    PERF_END(PERF_STAGE_SENSOR_READ, read_started);
+    
+    callback(result, data, ctx);
+}
+/*----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief Handle a failed attempt: schedule a retry or give up
+ * 
+ * After the last attempt the last known good reading is returned (marked
+ * stale), falling back to ESP_FAIL when nothing has been cached yet.
+ */
+static void attempt_failed(void)
+{
+    if (attempt < DHT11_MAX_RETRIES) 
+    {
+        EVENT_LOGW(TAG, "Attempt %d failed, retrying in %dms...", attempt, DHT11_RETRY_DELAY_MS);
+        attempt++;
+        state = DHT11_STATE_STABILIZING;
+        esp_timer_start_once(step_timer, (uint64_t)(DHT11_RETRY_DELAY_MS + DHT11_STABILIZATION_MS) * 1000);
+        return;
     }
     
-    // Measure high pulse duration (this encodes the bit value)
-    // The duration of this pulse determines whether the bit is '0' or '1'
-    int32_t high_time = wait_for_pin_state(0, DHT11_BIT_TIMEOUT);
-    if (high_time < 0) 
+    // All retry attempts failed
+    EVENT_LOGW(TAG, "All %d DHT11 read attempts failed", DHT11_MAX_RETRIES);
+    
+    // Return last known good reading if available as fallback
+    if (last_reading.valid) 
     {
-        ESP_LOGD(TAG, "Bit read failed: timeout waiting for end of high pulse (low=%ldµs, high_wait=%ldµs)", 
-                 low_wait, high_wait);
-        return -1;  // Timeout waiting for end of bit
+        EVENT_LOGW(TAG, "Using cached reading: %.1f°C, %.0f%% humidity (age unknown)", 
+                   last_reading.temperature, last_reading.humidity);
+        dht11_data_t stale = last_reading;
+        stale.valid = false;  // Mark as stale data
+        complete_read(ESP_OK, &stale);  // Return OK but with stale data marker
+        return;
     }
     
-    // Validate pulse timing is within reasonable bounds
-    // Valid DHT11 pulses should be 26-28µs (0) or 70µs (1)
-    if (high_time < 15 || high_time > 100) 
+    EVENT_LOGE(TAG, "No cached data available, DHT11 read completely failed");
+    dht11_data_t empty = {0};
+    complete_read(ESP_FAIL, &empty);
+}
+/*----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief One-shot timer callback advancing the read state machine
+ * 
+ * Runs in the esp_timer task. Every branch either re-arms the timer for the
+ * next step or completes the read.
+ */
+static void on_step_timer(void* arg)
+{
+    perf_timestamp_t step_started = PERF_BEGIN();
+    
+    switch (state) 
     {
-        ESP_LOGD(TAG, "Invalid pulse duration: %ldµs (expected 15-100µs)", high_time);
-        return -1;  // Pulse duration outside valid range
+        case DHT11_STATE_STABILIZING:
+            // Send start signal: hold the data line low for 18ms
+            // This wakes up the DHT11 and signals the start of communication
+            ESP_LOGD(TAG, "Read attempt %d/%d: start signal", attempt, DHT11_MAX_RETRIES);
+            exchange_begin();
+            dht11_capture_start_signal();
+            state = DHT11_STATE_START_SIGNAL;
+            esp_timer_start_once(step_timer, DHT11_START_LOW_TIME);
+            break;
+            
+        case DHT11_STATE_START_SIGNAL:
+            // Release the line and capture the reply
+            if (dht11_capture_arm() != ESP_OK) 
+            {
+                exchange_end();
+                attempt_failed();
+                break;
+            }
+            state = DHT11_STATE_CAPTURING;
+            esp_timer_start_once(step_timer, DHT11_CAPTURE_WINDOW_US);
+            break;
+            
+        case DHT11_STATE_CAPTURING:
+        {
+            uint8_t raw_data[DHT11_FRAME_BYTES];
+            dht11_data_t reading;
+            esp_err_t ret = dht11_capture_finish(raw_data);
+            exchange_end();
+            if (ret != ESP_OK) 
+            {
+                EVENT_LOGW(TAG, "DHT11 capture failed: %s", esp_err_to_name(ret));
+                EVENT_LOG_BANNER(TAG, "Sensor may be disconnected, busy, or experiencing timing issues");
+                attempt_failed();
+                break;
+            }
+            
+            if (decode_frame(raw_data, &reading) != ESP_OK) 
+            {
+                attempt_failed();
+                break;
+            }
+            
+            // Store as last known good reading for fallback purposes
+            last_reading = reading;
+            
+            EVENT_LOG_BANNER(TAG, "✓ Successful reading: %.1f°C, %.0f%% humidity (attempt %d)", 
+                             reading.temperature, reading.humidity, attempt);
+            complete_read(ESP_OK, &reading);
+            break;
+        }
+            
+        case DHT11_STATE_POWER_OFF:
+            // Supply first, then release the data line to idle high
+            gpio_set_level(DHT11_POWER_PIN, 1);
+            gpio_set_level(DHT11_DATA_PIN, 1);
+            state = DHT11_STATE_POWER_UP;
+            esp_timer_start_once(step_timer, (uint64_t)DHT11_POWER_UP_MS * 1000);
+            break;
+            
+        case DHT11_STATE_POWER_UP:
+        {
+            taskENTER_CRITICAL(&state_lock);
+            bool read_waiting = (pending_callback != NULL);
+            state = read_waiting ? DHT11_STATE_STABILIZING : DHT11_STATE_IDLE;
+            taskEXIT_CRITICAL(&state_lock);
+            
+            EVENT_LOGI(TAG, "DHT11 powered up%s", read_waiting ? ", starting deferred read" : "");
+            if (read_waiting) 
+            {
+                esp_timer_start_once(step_timer, (uint64_t)DHT11_STABILIZATION_MS * 1000);
+            }
+            break;
+        }
+            
+        default:
+            break;
     }
     
-    // Determine bit value based on pulse duration
-    // Threshold comparison converts timing measurement to digital value
-    // 0 bit: ~26-28µs high, 1 bit: ~70µs high
-    int bit_value = (high_time > DHT11_BIT_THRESHOLD) ? 1 : 0;
-    ESP_LOGV(TAG, "Bit read: %d (high_time=%ldµs)", bit_value, high_time);
-    return bit_value;
+    // Includes the completion callback when the step finished the read
+    PERF_END(PERF_STAGE_SENSOR_STEP, step_started);
+}
+/*----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief Completion callback used by the blocking dht11_read() wrapper
+ */
+static void blocking_read_done(esp_err_t result, const dht11_data_t* data, void* ctx)
+{
+    dht11_blocking_read_t *request = (dht11_blocking_read_t *)ctx;
+    request->result = result;
+    request->data = *data;
+    xSemaphoreGive(request->done);
 }
 /*----------------------------------------------------------------------------*/
 
@@ -238,10 +503,10 @@ static int read_bit(void)
  * to support the DHT11's single-wire protocol requirements.
  * 
  * GPIO Configuration Details:
- * - Mode: Open-drain output (allows bidirectional communication)
+ * - Mode: Open-drain input/output (drive the start pulse, read the reply)
  * - Pull-up: Enabled (required for single-wire protocol idle state)
  * - Pull-down: Disabled (conflicts with pull-up requirement)
- * - Interrupts: Disabled (not needed for polled communication)
+ * - Interrupts: Disabled (edges are captured by the backend, not GPIO ISRs)
  * 
  * Pin Assignment:
  * The actual GPIO pin number is defined in pinout.h as DHT11_DATA_PIN
@@ -253,6 +518,7 @@ static int read_bit(void)
  * 
  * @return ESP_OK on successful initialization
  * @return ESP_FAIL if GPIO configuration fails
+ * @return Error from the capture backend if the RMT channel cannot be set up
  * 
  * @note Must be called before any dht11_read() operations
  * @note Can be called multiple times safely (idempotent)
@@ -262,31 +528,89 @@ esp_err_t dht11_init(void)
 {
     ESP_LOGI(TAG, "Initializing DHT11 temperature/humidity sensor...");
     
-    // Configure data pin as open-drain output with pull-up
-    // This configuration allows both output (host->sensor) and input (sensor->host) modes
-    gpio_config_t config = 
+    esp_err_t ret;
+    
+#if DHT11_POWER_CONTROL
+    // Sensor supply: a push-pull output driven high (the DHT11 draws < 2.5mA)
+    gpio_config_t power_config = 
     {
-        .pin_bit_mask = (1ULL << DHT11_DATA_PIN),    // Target specific GPIO pin
-        .mode = GPIO_MODE_OUTPUT_OD,                 // Open drain for single-wire protocol
-        .pull_up_en = GPIO_PULLUP_ENABLE,            // Internal pull-up resistor (required)
-        .pull_down_en = GPIO_PULLDOWN_DISABLE,       // Disable conflicting pull-down
-        .intr_type = GPIO_INTR_DISABLE               // No interrupts needed for polling
+        .pin_bit_mask = (1ULL << DHT11_POWER_PIN),
+        .mode = GPIO_MODE_OUTPUT,
+        .pull_up_en = GPIO_PULLUP_DISABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type = GPIO_INTR_DISABLE
     };
+    ret = gpio_config(&power_config);
+    if (ret != ESP_OK) 
+    {
+        ESP_LOGE(TAG, "Failed to configure DHT11 power pin %d: %s", DHT11_POWER_PIN, esp_err_to_name(ret));
+        return ret;
+    }
+    gpio_set_level(DHT11_POWER_PIN, 1);
+    gpio_hold_dis(DHT11_POWER_PIN);     // Latched by dht11_prepare_deep_sleep()
+#endif
     
-    esp_err_t ret = gpio_config(&config);
+    // Data pin as open-drain output with pull-up
+    ret = configure_data_pin();
     if (ret != ESP_OK) 
     {
-        ESP_LOGE(TAG, "Failed to configure DHT11 data pin %d: %s", DHT11_DATA_PIN, esp_err_to_name(ret));
         return ret;
     }
     
-    // Set pin high initially (idle state for single-wire protocol)
-    // This ensures the sensor sees the expected idle state after initialization
-    gpio_set_level(DHT11_DATA_PIN, 1);
+    ret = dht11_capture_init();
+    if (ret != ESP_OK) 
+    {
+        ESP_LOGE(TAG, "Failed to initialize DHT11 capture backend: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    
+    // ESP_ERR_NOT_SUPPORTED without CONFIG_PM_ENABLE: the clock never changes
+    if (cpu_lock == NULL) 
+    {
+        ret = esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "dht11", &cpu_lock);
+        if (ret != ESP_OK && ret != ESP_ERR_NOT_SUPPORTED) 
+        {
+            ESP_LOGE(TAG, "Failed to create CPU frequency lock: %s", esp_err_to_name(ret));
+            return ret;
+        }
+    }
+    
+    // One-shot timer that sequences asynchronous reads
+    if (step_timer == NULL) 
+    {
+        const esp_timer_create_args_t timer_args = 
+        {
+            .callback = on_step_timer,
+            .dispatch_method = ESP_TIMER_TASK,
+            .name = "dht11_step"
+        };
+        ret = esp_timer_create(&timer_args, &step_timer);
+        if (ret != ESP_OK) 
+        {
+            ESP_LOGE(TAG, "Failed to create DHT11 step timer: %s", esp_err_to_name(ret));
+            return ret;
+        }
+    }
+    
+#if DHT11_POWER_CONTROL
+    // A supply held through deep sleep is already up; otherwise it was just
+    // switched on and the sensor needs its start-up time. Reads issued
+    // meanwhile wait for it instead of failing.
+    if (esp_reset_reason() != ESP_RST_DEEPSLEEP && claim_idle(DHT11_STATE_POWER_UP)) 
+    {
+        ret = esp_timer_start_once(step_timer, (uint64_t)DHT11_POWER_UP_MS * 1000);
+        if (ret != ESP_OK) 
+        {
+            state = DHT11_STATE_IDLE;
+            ESP_LOGE(TAG, "Failed to start DHT11 step timer: %s", esp_err_to_name(ret));
+            return ret;
+        }
+    }
+#endif
     
     ESP_LOGI(TAG, "✓ DHT11 initialized successfully on GPIO%d", DHT11_DATA_PIN);
-    ESP_LOGI(TAG, "✓ Pin configured as open-drain with pull-up resistor");
-    ESP_LOGI(TAG, "✓ Sensor ready for temperature/humidity readings");
+    EVENT_LOG_BANNER(TAG, "✓ Pin configured as open-drain with pull-up resistor");
+    EVENT_LOG_BANNER(TAG, "✓ Sensor ready for temperature/humidity readings");
     
     return ESP_OK;
 }
@@ -294,224 +618,206 @@ esp_err_t dht11_init(void)
 
 /*----------------------------------------------------------------------------*/
 /**
- * @brief Read complete 40-bit data packet from DHT11 sensor
+ * @brief Start a non-blocking read of the complete 40-bit data packet
  * 
- * Implements the complete DHT11 communication protocol to obtain
- * temperature and humidity readings. This function handles all
- * timing-critical operations and data validation.
+ * Communication Sequence (each wait is a one-shot esp_timer, not a delay):
+ * 1. HOST STABILIZES:
+ *    - Wait DHT11_STABILIZATION_MS for sensor readiness
  * 
- * Communication Sequence:
- * 1. HOST INITIATES:
+ * 2. HOST INITIATES:
  *    - Pull data line low for 18ms (wake up sensor)
- *    - Release line (pull-up brings it high) for 20-40µs
- * 
- * 2. SENSOR RESPONDS:
- *    - DHT11 pulls line low for 80µs (acknowledge)
- *    - DHT11 pulls line high for 80µs (ready to transmit)
+ *    - Release line (pull-up brings it high)
  * 
- * 3. DATA TRANSMISSION:
- *    - 40 bits transmitted sequentially (5 bytes total)
- *    - Each bit: 50µs low + variable high (26-28µs='0', 70µs='1')
+ * 3. SENSOR RESPONDS (captured by the backend):
+ *    - DHT11 pulls line low for 80µs, then high for 80µs
+ *    - 40 bits: 50µs low + variable high (26-28µs='0', 70µs='1')
  * 
  * 4. DATA VALIDATION:
- *    - Calculate checksum of first 4 bytes
- *    - Compare with 5th byte (checksum byte)
- *    - Accept data only if checksum matches
+ *    - Checksum of first 4 bytes compared with the 5th byte
  * 
- * Data Format:
- * - Byte 0: Humidity integer part (0-100)
- * - Byte 1: Humidity decimal part (always 0 for DHT11)
- * - Byte 2: Temperature integer part (0-50°C)
- * - Byte 3: Temperature decimal part (always 0 for DHT11)
- * - Byte 4: Checksum (sum of bytes 0-3, lower 8 bits)
- * 
- * Critical Timing Sections:
- * Interrupts are disabled during timing-sensitive operations to
- * ensure accurate microsecond-level measurements required by the protocol.
+ * Retry Strategy:
+ * - Attempts up to DHT11_MAX_RETRIES reads
+ * - DHT11_RETRY_DELAY_MS between attempts to allow sensor recovery
+ * - Completes on first successful read
+ * - Falls back to the last known good reading (marked stale)
  * 
- * Error Recovery:
- * On any communication error, the GPIO is restored to output mode
- * with high level to prepare for the next communication attempt.
+ * A read requested while the sensor is powering up (after dht11_init() or
+ * during a power cycle) is accepted and starts once the sensor is up.
  * 
- * @param data Pointer to structure for storing sensor readings
+ * @param callback Completion callback, run in the esp_timer task
+ * @param ctx User pointer handed back to the callback
  * 
- * @return ESP_OK on successful read with valid checksum
- * @return ESP_FAIL on communication error or checksum mismatch
- * @return ESP_ERR_INVALID_ARG if data pointer is NULL
+ * @return ESP_OK if the read was started
+ * @return ESP_ERR_INVALID_ARG if callback is NULL
+ * @return ESP_ERR_INVALID_STATE if not initialized or a read is in progress
  * 
  * @note Minimum 2-second interval between reads (DHT11 limitation)
- * @note Function duration: ~20ms for complete communication
- * @note Interrupts disabled for ~5ms during critical timing sections
  */
-/**
- * @brief Internal function to perform a single DHT11 read attempt
- * 
- * This function contains the core DHT11 communication logic without
- * retry handling. It's separated to enable clean retry implementation.
- * 
- * @param data Pointer to structure for storing sensor readings
- * @return ESP_OK on success, ESP_FAIL on communication error
- */
-static esp_err_t dht11_read_attempt(dht11_data_t* data)
+esp_err_t dht11_read_async(dht11_read_cb_t callback, void* ctx) 
 {
-    // Initialize data structure to safe default values
-    data->temperature = 0.0;
-    data->humidity = 0.0;
-    data->valid = false;
-    
-    ESP_LOGD(TAG, "DHT11 attempt starting with %dms stabilization delay...", DHT11_STABILIZATION_MS);
-    
-    // Add stabilization delay for sensor readiness
-    vTaskDelay(pdMS_TO_TICKS(DHT11_STABILIZATION_MS));
-    
-    ESP_LOGD(TAG, "Beginning timing-critical DHT11 communication sequence...");
-    
-    // === CRITICAL TIMING SECTION START ===
-    // Disable interrupts for precise timing during communication
-    portDISABLE_INTERRUPTS();
-    
-    // Send start signal: pull data line low for 18ms
-    // This wakes up the DHT11 and signals the start of communication
-    gpio_set_level(DHT11_DATA_PIN, 0);
-    esp_rom_delay_us(DHT11_START_LOW_TIME);  // 18ms low signal
-    
-    // Pull high for 20-40µs (host ready to receive)
-    // This signals to the DHT11 that the host is ready for data transmission
-    gpio_set_level(DHT11_DATA_PIN, 1);
-    esp_rom_delay_us(DHT11_START_HIGH_TIME);  // 20-40µs high signal
-    
-    // Switch to input mode to read DHT11 response
-    // Pin is now controlled by DHT11 for response and data transmission
-    gpio_set_direction(DHT11_DATA_PIN, GPIO_MODE_INPUT);
-    
-    int64_t response_start = esp_timer_get_time();
-    
-    // Wait for DHT11 response acknowledgment: 80µs low + 80µs high
-    // This confirms the sensor received the start signal and is ready to transmit
-    if (wait_for_pin_state(0, DHT11_RESPONSE_TIMEOUT) < 0) 
+    if (callback == NULL) 
     {
-        int64_t fail_time = esp_timer_get_time();
-        portENABLE_INTERRUPTS();
-        gpio_set_direction(DHT11_DATA_PIN, GPIO_MODE_OUTPUT_OD);
-        gpio_set_level(DHT11_DATA_PIN, 1);
-        ESP_LOGW(TAG, "Failed waiting for initial low response after %lldµs", fail_time - response_start);
-        return ESP_FAIL;
+        ESP_LOGE(TAG, "Invalid parameter: callback is NULL");
+        return ESP_ERR_INVALID_ARG;
     }
     
-    int64_t low_ack_time = esp_timer_get_time();
-    
-    if (wait_for_pin_state(1, DHT11_RESPONSE_TIMEOUT) < 0) 
+    if (step_timer == NULL) 
     {
-        int64_t fail_time = esp_timer_get_time();
-        portENABLE_INTERRUPTS();
-        gpio_set_direction(DHT11_DATA_PIN, GPIO_MODE_OUTPUT_OD);
-        gpio_set_level(DHT11_DATA_PIN, 1);
-        ESP_LOGW(TAG, "Failed waiting for high response after %lldµs (low took %lldµs)", 
-                 fail_time - low_ack_time, low_ack_time - response_start);
-        return ESP_FAIL;
+        ESP_LOGE(TAG, "DHT11 not initialized");
+        return ESP_ERR_INVALID_STATE;
     }
     
-    int64_t high_ack_time = esp_timer_get_time();
-    ESP_LOGD(TAG, "DHT11 acknowledged: low=%lldµs, high=%lldµs", 
-             low_ack_time - response_start, high_ack_time - low_ack_time);
-    
-    // Read 40 bits of data (5 bytes: humidity_int, humidity_dec, temp_int, temp_dec, checksum)
-    uint8_t raw_data[5] = {0};  // Initialize to zero for clean data collection
-    
-    for (int i = 0; i < 5; i++) 
-    {  // 5 bytes total
-        for (int j = 7; j >= 0; j--) 
-        {  // 8 bits per byte, MSB first
-            int bit = read_bit();
-            if (bit < 0) 
-            {
-                goto error_exit;
-            }
-            raw_data[i] |= (bit << j);  // Assemble byte MSB first
-        }
+    if (defer_until_powered(callback, ctx)) 
+    {
+        ESP_LOGD(TAG, "DHT11 read deferred until the sensor has powered up");
+        return ESP_OK;
     }
     
-    // === CRITICAL TIMING SECTION END ===
-    // Re-enable interrupts now that timing-critical section is complete
-    portENABLE_INTERRUPTS();
-    
-    // Reset pin to output mode with high level (idle state)
-    // Prepare pin for next communication cycle
-    gpio_set_direction(DHT11_DATA_PIN, GPIO_MODE_OUTPUT_OD);
-    gpio_set_level(DHT11_DATA_PIN, 1);
+    // Claim the state machine
+    if (!claim_idle(DHT11_STATE_STABILIZING)) 
+    {
+        EVENT_LOGW(TAG, "DHT11 busy (read or recovery in progress)");
+        return ESP_ERR_INVALID_STATE;
+    }
     
-    ESP_LOGD(TAG, "DHT11 response acknowledged, data reception complete");
-    ESP_LOGD(TAG, "Raw data: [0x%02X, 0x%02X, 0x%02X, 0x%02X, 0x%02X]", 
-             raw_data[0], raw_data[1], raw_data[2], raw_data[3], raw_data[4]);
-    ESP_LOGD(TAG, "Validating checksum...");
+    pending_callback = callback;
+    pending_ctx = ctx;
+    attempt = 1;
+    read_started = PERF_BEGIN();
     
-    // Validate data integrity using checksum
-    // Checksum is the sum of the first 4 bytes (lower 8 bits)
-    uint8_t calculated_checksum = raw_data[0] + raw_data[1] + raw_data[2] + raw_data[3];
-    if (calculated_checksum != raw_data[4]) 
+    ESP_LOGD(TAG, "DHT11 read starting with %dms stabilization delay...", DHT11_STABILIZATION_MS);
+    esp_err_t ret = esp_timer_start_once(step_timer, (uint64_t)DHT11_STABILIZATION_MS * 1000);
+    if (ret != ESP_OK) 
     {
-        ESP_LOGW(TAG, "Checksum mismatch - calculated: 0x%02X, received: 0x%02X", 
-                 calculated_checksum, raw_data[4]);
-        ESP_LOGW(TAG, "Data may be corrupted, discarding reading");
-        return ESP_FAIL;
+        pending_callback = NULL;
+        pending_ctx = NULL;
+        state = DHT11_STATE_IDLE;
+        ESP_LOGE(TAG, "Failed to start DHT11 step timer: %s", esp_err_to_name(ret));
+    }
+    return ret;
+}
+/*----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief Check whether an asynchronous read is in progress
+ * 
+ * @return true between an accepted dht11_read_async() and its callback,
+ *         and while a reset or power cycle is running
+ */
+bool dht11_is_busy(void) 
+{
+    return state != DHT11_STATE_IDLE;
+}
+/*----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief Re-initialize the data pin and the capture backend
+ * 
+ * The capture backend is torn down and rebuilt because a wedged RMT
+ * channel survives a plain pin reconfiguration. The CPU lock and the step
+ * timer are kept.
+ * 
+ * @return ESP_OK on success
+ * @return ESP_ERR_INVALID_STATE if not initialized or busy
+ * @return Error from the GPIO or capture backend setup
+ */
+esp_err_t dht11_reset(void) 
+{
+    if (step_timer == NULL || !claim_idle(DHT11_STATE_RESETTING)) 
+    {
+        return ESP_ERR_INVALID_STATE;
     }
     
-    // Extract and convert sensor readings to floating-point values
-    // DHT11 format: integer.decimal (decimal part always 0 for DHT11)
-    data->humidity = (float)raw_data[0] + (float)raw_data[1] / 10.0;
-    data->temperature = (float)raw_data[2] + (float)raw_data[3] / 10.0;
-    data->valid = true;
-    
-    // Validate readings are within expected sensor range
-    if (data->humidity < DHT11_HUMIDITY_MIN || data->humidity > DHT11_HUMIDITY_MAX) 
+    EVENT_LOGW(TAG, "Re-initializing DHT11 data pin and capture backend");
+    dht11_capture_deinit();
+    gpio_reset_pin(DHT11_DATA_PIN);
+    esp_err_t ret = configure_data_pin();
+    if (ret == ESP_OK) 
     {
-        ESP_LOGW(TAG, "Humidity reading %.1f%% outside valid range (%d-%d%%)", 
-                 data->humidity, DHT11_HUMIDITY_MIN, DHT11_HUMIDITY_MAX);
+        ret = dht11_capture_init();
     }
     
-    if (data->temperature < DHT11_TEMP_MIN || data->temperature > DHT11_TEMP_MAX) 
+    state = DHT11_STATE_IDLE;
+    return ret;
+}
+/*----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief Switch the sensor's supply off and on again
+ * 
+ * The data line is pulled low together with the supply: left high, the
+ * pull-up would keep the sensor powered through its data pin.
+ * 
+ * @param ready_in_ms Receives the time until the sensor can be read
+ * @return ESP_OK if the power cycle was started
+ * @return ESP_ERR_NOT_SUPPORTED without DHT11_POWER_CONTROL
+ * @return ESP_ERR_INVALID_STATE if not initialized or busy
+ */
+esp_err_t dht11_power_cycle(uint32_t* ready_in_ms) 
+{
+#if DHT11_POWER_CONTROL
+    if (step_timer == NULL || !claim_idle(DHT11_STATE_POWER_OFF)) 
     {
-        ESP_LOGW(TAG, "Temperature reading %.1f°C outside valid range (%d-%d°C)", 
-                 data->temperature, DHT11_TEMP_MIN, DHT11_TEMP_MAX);
+        return ESP_ERR_INVALID_STATE;
     }
     
-    // Store as last known good reading for fallback purposes
-    last_reading = *data;
+    EVENT_LOGW(TAG, "Power cycling DHT11 (GPIO%d off for %dms)", DHT11_POWER_PIN, DHT11_POWER_OFF_MS);
+    // The legacy backend may have left the data pin as an input
+    gpio_set_direction(DHT11_DATA_PIN, GPIO_MODE_INPUT_OUTPUT_OD);
+    gpio_set_level(DHT11_DATA_PIN, 0);
+    gpio_set_level(DHT11_POWER_PIN, 0);
     
-    ESP_LOGI(TAG, "✓ Successful reading: %.1f°C, %.0f%% humidity", 
-             data->temperature, data->humidity);
+    esp_err_t ret = esp_timer_start_once(step_timer, (uint64_t)DHT11_POWER_OFF_MS * 1000);
+    if (ret != ESP_OK) 
+    {
+        gpio_set_level(DHT11_POWER_PIN, 1);
+        gpio_set_level(DHT11_DATA_PIN, 1);
+        state = DHT11_STATE_IDLE;
+        return ret;
+    }
     
+    if (ready_in_ms != NULL) 
+    {
+        *ready_in_ms = DHT11_POWER_OFF_MS + DHT11_POWER_UP_MS;
+    }
     return ESP_OK;
-    
-error_exit:
-    // Error recovery: restore pin to safe state and re-enable interrupts
-    portENABLE_INTERRUPTS();
-    gpio_set_direction(DHT11_DATA_PIN, GPIO_MODE_OUTPUT_OD);
-    gpio_set_level(DHT11_DATA_PIN, 1);
-    
-    ESP_LOGW(TAG, "DHT11 communication failed - timeout or bit error detected");
-    ESP_LOGW(TAG, "Sensor may be disconnected, busy, or experiencing timing issues");
-    return ESP_FAIL;
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
 }
+/*----------------------------------------------------------------------------*/
 
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief Latch the supply pin high for deep sleep
+ */
+void dht11_prepare_deep_sleep(void) 
+{
+#if DHT11_POWER_CONTROL
+    gpio_hold_en(DHT11_POWER_PIN);
+    gpio_deep_sleep_hold_en();
+#endif
+}
+/*----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------*/
 /**
  * @brief Read temperature and humidity from DHT11 sensor with retry mechanism
  * 
- * This function implements a robust retry mechanism to handle temporary
- * communication failures common with DHT11 sensors. It attempts multiple
- * reads with appropriate delays between attempts.
- * 
- * Retry Strategy:
- * - Attempts up to DHT11_MAX_RETRIES reads
- * - 100ms delay between attempts to allow sensor recovery
- * - Returns on first successful read
- * - Provides fallback to last known good reading if available
+ * Blocking wrapper around dht11_read_async(). The calling task sleeps on a
+ * semaphore (no CPU time is used) until the state machine completes, which
+ * takes ~230ms for a first-attempt success and longer when retries occur.
  * 
  * @param data Pointer to structure for storing sensor readings
  * 
  * @return ESP_OK on successful read with valid checksum
+ * @return ESP_OK with data->valid = false when the cached reading was used
  * @return ESP_FAIL on all retry attempts failed
  * @return ESP_ERR_INVALID_ARG if data pointer is NULL
+ * @return ESP_ERR_INVALID_STATE if an asynchronous read is already in progress
  */
 esp_err_t dht11_read(dht11_data_t* data) 
 {
@@ -521,43 +827,27 @@ esp_err_t dht11_read(dht11_data_t* data)
         return ESP_ERR_INVALID_ARG;
     }
     
-    ESP_LOGD(TAG, "Starting DHT11 reading with retry mechanism...");
-    
-    // Attempt multiple reads with retry logic
-    for (int attempt = 1; attempt <= DHT11_MAX_RETRIES; attempt++) 
+    StaticSemaphore_t done_buffer;
+    dht11_blocking_read_t request = 
     {
-        ESP_LOGD(TAG, "Read attempt %d/%d", attempt, DHT11_MAX_RETRIES);
-        
-        esp_err_t result = dht11_read_attempt(data);
-        if (result == ESP_OK) 
-        {
-            ESP_LOGD(TAG, "✓ DHT11 read successful on attempt %d", attempt);
-            return ESP_OK;
-        }
-        
-        // Log retry attempt (except for the last one)
-        if (attempt < DHT11_MAX_RETRIES) 
-        {
-            ESP_LOGW(TAG, "Attempt %d failed, retrying in %dms...", attempt, DHT11_RETRY_DELAY_MS);
-            vTaskDelay(pdMS_TO_TICKS(DHT11_RETRY_DELAY_MS));
-        }
-    }
-    
-    // All retry attempts failed
-    ESP_LOGW(TAG, "All %d DHT11 read attempts failed", DHT11_MAX_RETRIES);
+        .done = xSemaphoreCreateBinaryStatic(&done_buffer),
+        .result = ESP_FAIL
+    };
     
-    // Return last known good reading if available as fallback
-    if (last_reading.valid) 
+    esp_err_t ret = dht11_read_async(blocking_read_done, &request);
+    if (ret != ESP_OK) 
     {
-        ESP_LOGW(TAG, "Using cached reading: %.1f°C, %.0f%% humidity (age unknown)", 
-                 last_reading.temperature, last_reading.humidity);
-        *data = last_reading;
-        data->valid = false;  // Mark as stale data
-        return ESP_OK;  // Return OK but with stale data marker
+        vSemaphoreDelete(request.done);
+        return ret;
     }
     
-    ESP_LOGE(TAG, "No cached data available, DHT11 read completely failed");
-    return ESP_FAIL;
+    // The state machine always completes, so an unbounded wait is safe and
+    // guarantees the callback never touches this stack frame after return
+    xSemaphoreTake(request.done, portMAX_DELAY);
+    vSemaphoreDelete(request.done);
+    
+    *data = request.data;
+    return request.result;
 }
 /*----------------------------------------------------------------------------*/
 
@@ -41,6 +41,13 @@ extern "C" {
 #define DHT11_MAX_RETRIES        3      // Maximum read attempts
 #define DHT11_RETRY_DELAY_MS     500    // Delay between retry attempts (increased)
 
+// DHT11 supply switching (recovery power cycle)
+#ifndef DHT11_POWER_CONTROL
+#define DHT11_POWER_CONTROL      1      // 1 = sensor VCC is fed from DHT11_POWER_PIN
+#endif
+#define DHT11_POWER_OFF_MS       500    // Supply off time of a power cycle
+#define DHT11_POWER_UP_MS        1000   // Sensor start-up time before the first read (datasheet: 1s)
+
 // DHT11 measurement limits
 #define DHT11_TEMP_MIN          0       // Minimum temperature (°C)
 #define DHT11_TEMP_MAX          50      // Maximum temperature (°C)  
@@ -58,6 +65,22 @@ typedef struct {
     bool valid;           // True if data is valid (checksum passed)
 } dht11_data_t;
 
+/**
+ * @brief Completion callback for dht11_read_async()
+ * 
+ * Called exactly once per accepted request, from the esp_timer task.
+ * Keep it short and never block in it: copy the data, give a semaphore,
+ * notify a task or post to a queue. Starting the next read from inside
+ * the callback is allowed.
+ * 
+ * @param result ESP_OK with data->valid = true for a fresh reading,
+ *               ESP_OK with data->valid = false for the cached fallback,
+ *               ESP_FAIL if every attempt failed and nothing is cached
+ * @param data   Reading; only valid for the duration of the call
+ * @param ctx    User pointer passed to dht11_read_async()
+ */
+typedef void (*dht11_read_cb_t)(esp_err_t result, const dht11_data_t *data, void *ctx);
+
 /*============================================================================*/
 /* EXPORTED FUNCTIONS */
 /**
@@ -79,11 +102,83 @@ esp_err_t dht11_init(void);
  * 3. Reads 40 bits of data (humidity + temperature + checksum)
  * 4. Validates checksum
  * 
+ * Blocking wrapper around dht11_read_async(): the calling task sleeps on
+ * a semaphore until the read completes.
+ * 
  * @param data Pointer to structure to store sensor readings
  * @return ESP_OK on successful read, ESP_FAIL on communication error
  */
 esp_err_t dht11_read(dht11_data_t* data);
 /*----------------------------------------------------------------------------*/
+/**
+ * @brief Start a non-blocking temperature and humidity read
+ * 
+ * Returns immediately. The stabilization delay, start signal, capture
+ * window and retry delays are all scheduled with a one-shot esp_timer, so
+ * no task is blocked while the read is in progress (~230 ms on the first
+ * attempt, up to ~2.2 s with all retries). The result is delivered through
+ * the callback with the same semantics as dht11_read().
+ * 
+ * While the sensor powers up (DHT11_POWER_UP_MS after dht11_init() or a
+ * power cycle) the read is accepted and starts once the sensor is up, so
+ * the first read after boot needs no delay of its own.
+ * 
+ * Only one read can be in flight at a time.
+ * 
+ * @param callback Completion callback (required)
+ * @param ctx      User pointer handed back to the callback
+ * @return ESP_OK if the read was started
+ * @return ESP_ERR_INVALID_ARG if callback is NULL
+ * @return ESP_ERR_INVALID_STATE if the driver is not initialized or a read is in progress
+ */
+esp_err_t dht11_read_async(dht11_read_cb_t callback, void *ctx);
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief Check whether an asynchronous read is in progress
+ * 
+ * @return true between an accepted dht11_read_async() and its callback
+ */
+bool dht11_is_busy(void);
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief Re-initialize the data pin and the capture backend
+ * 
+ * First recovery step for a sensor that stopped answering: resets the GPIO
+ * and rebuilds the RMT channel, which clears a stuck pin configuration
+ * or receiver. Takes well under a millisecond; the next read may start
+ * right away.
+ * 
+ * @return ESP_OK on success
+ * @return ESP_ERR_INVALID_STATE if not initialized or a read or power cycle is in progress
+ * @return Error from the GPIO or capture backend setup
+ */
+esp_err_t dht11_reset(void);
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief Switch the sensor's supply off and on again (non-blocking)
+ * 
+ * Drives DHT11_POWER_PIN and the data line low for DHT11_POWER_OFF_MS,
+ * then restores power and waits DHT11_POWER_UP_MS for the sensor to start.
+ * Both waits run on the driver's esp_timer. Reads are refused while the
+ * supply is off (ESP_ERR_INVALID_STATE, dht11_is_busy() true); one read
+ * requested during the power-up wait is deferred until the sensor is up.
+ * 
+ * @param ready_in_ms Receives the time until the sensor can be read
+ * @return ESP_OK if the power cycle was started
+ * @return ESP_ERR_NOT_SUPPORTED when built with DHT11_POWER_CONTROL = 0
+ * @return ESP_ERR_INVALID_STATE if not initialized or a read is in progress
+ */
+esp_err_t dht11_power_cycle(uint32_t *ready_in_ms);
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief Keep the sensor powered through deep sleep
+ * 
+ * GPIO outputs are released in deep sleep, which would cut DHT11_POWER_PIN
+ * and cost DHT11_POWER_UP_MS on every wake. Latches the pin high until the
+ * next dht11_init(). Does nothing without DHT11_POWER_CONTROL.
+ */
+void dht11_prepare_deep_sleep(void);
+/*----------------------------------------------------------------------------*/
 /**
  * @brief Get temperature as formatted string
  * 
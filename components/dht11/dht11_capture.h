@@ -0,0 +1,132 @@
+#ifndef DHT11_CAPTURE_H
+#define DHT11_CAPTURE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+/**
+ * @file dht11_capture.h
+ * @brief Frame capture backends for the DHT11 single-wire protocol
+ *
+ * Separates "get 40 bits off the wire" from the validation, caching and
+ * retry logic in dht11.c. A read is split into three steps so that the
+ * asynchronous driver can schedule the waits between them with esp_timer
+ * instead of blocking a task:
+ *
+ *   dht11_capture_start_signal()  line low
+ *       ... DHT11_START_LOW_TIME ...
+ *   dht11_capture_arm()           line released, capture running
+ *       ... DHT11_CAPTURE_WINDOW_US ...
+ *   dht11_capture_finish()        decoded frame
+ *
+ * The steps run in esp_timer task context. Two interchangeable backends
+ * implement this interface:
+ *
+ * - RMT receiver (default): the sensor's reply is timestamped by the RMT
+ *   peripheral while the CPU is free. The pulse list is decoded once the
+ *   capture has completed. Interrupts are never masked.
+ * - Busy-wait polling (fallback): the original implementation. It samples
+ *   the pin in a loop with interrupts disabled for the ~5 ms reply.
+ *   Select it by defining DHT11_USE_LEGACY_BITBANG to 1 (for example
+ *   through target_compile_definitions in the component CMakeLists.txt).
+ */
+
+/**
+ * @brief Use the interrupt-masking polling backend instead of RMT
+ *
+ * 0 = RMT capture (default), 1 = legacy busy-wait polling.
+ */
+#ifndef DHT11_USE_LEGACY_BITBANG
+#define DHT11_USE_LEGACY_BITBANG 0
+#endif
+
+#define DHT11_FRAME_BYTES        5       ///< Humidity int/dec, temperature int/dec, checksum
+#define DHT11_FRAME_BITS         (DHT11_FRAME_BYTES * 8)
+
+/**
+ * @brief Valid range of a data bit's high pulse (µs)
+ *
+ * Shared by both backends. A '0' is 26-28 µs and a '1' is ~70 µs; anything
+ * outside this window is treated as a corrupted frame.
+ */
+#define DHT11_BIT_HIGH_MIN_US    15
+#define DHT11_BIT_HIGH_MAX_US    100
+
+/**
+ * @brief Time between dht11_capture_arm() and dht11_capture_finish() (µs)
+ *
+ * The reply lasts at most ~5.2 ms (160 µs acknowledge, 40 bits of up to
+ * 120 µs, 200 µs idle terminator). The margin covers esp_timer dispatch
+ * latency.
+ */
+#define DHT11_CAPTURE_WINDOW_US  8000
+
+/**
+ * @brief Prepare the capture hardware
+ *
+ * Called once from dht11_init() after the data pin has been configured as
+ * an open-drain line with pull-up.
+ *
+ * @return ESP_OK on success, or the error from the underlying driver
+ */
+esp_err_t dht11_capture_init(void);
+
+/**
+ * @brief Release the capture hardware so dht11_capture_init() rebuilds it
+ *
+ * Used by dht11_reset() to recover from a wedged peripheral. Only called
+ * while no read is in flight.
+ */
+void dht11_capture_deinit(void);
+
+/**
+ * @brief Begin the start signal by pulling the data line low
+ *
+ * The caller keeps the line low for DHT11_START_LOW_TIME (the driver uses a
+ * one-shot esp_timer) and then calls dht11_capture_arm().
+ */
+void dht11_capture_start_signal(void);
+
+/**
+ * @brief Release the line and start capturing the sensor's reply
+ *
+ * Returns immediately with the RMT backend. The legacy backend reads the
+ * whole frame here with interrupts masked (~5 ms).
+ *
+ * @return ESP_OK if the capture was started
+ */
+esp_err_t dht11_capture_arm(void);
+
+/**
+ * @brief Collect and decode the frame, DHT11_CAPTURE_WINDOW_US after arming
+ *
+ * Aborts a capture that has not completed. Leaves the data pin released
+ * (idle high) on return, whether or not the capture succeeded. No checksum
+ * validation is done here.
+ *
+ * @param raw Receives the five frame bytes, MSB first
+ * @return ESP_OK if 40 well-formed bits were captured
+ * @return ESP_ERR_TIMEOUT if the sensor did not answer
+ * @return ESP_FAIL if the pulse train was malformed
+ */
+esp_err_t dht11_capture_finish(uint8_t raw[DHT11_FRAME_BYTES]);
+
+#if !DHT11_USE_LEGACY_BITBANG
+#include "driver/rmt_types.h"
+
+/**
+ * @brief Decode an RMT pulse train into five frame bytes (RMT backend only)
+ *
+ * The decoder dht11_capture_finish() runs on a completed capture. Exposed
+ * so that recorded traces can be decoded without the sensor, e.g. by the
+ * benchmark component.
+ *
+ * @return ESP_OK if 40 in-range high pulses were found
+ * @return ESP_FAIL otherwise
+ */
+esp_err_t dht11_capture_decode_symbols(const rmt_symbol_word_t *symbols, size_t num_symbols,
+                                       uint8_t raw[DHT11_FRAME_BYTES]);
+#endif
+
+#endif // DHT11_CAPTURE_H
@@ -0,0 +1,234 @@
+/**
+ * @file dht11_capture_bitbang.c
+ * @brief Legacy busy-wait DHT11 capture backend
+ *
+ * The original polling implementation. Every pin transition is found by
+ * spinning on gpio_get_level() with interrupts disabled. The 18 ms start
+ * pulse is timed by the caller, so interrupts are masked only from the
+ * host release until the last bit has been read (~5 ms). The whole frame
+ * is read inside dht11_capture_arm(); dht11_capture_finish() just returns it.
+ *
+ * Built only when DHT11_USE_LEGACY_BITBANG is 1; see dht11_capture.h.
+ */
+
+#include "dht11_capture.h"
+
+#if DHT11_USE_LEGACY_BITBANG
+
+#include "dht11.h"
+#include "driver/gpio.h"
+#include "esp_log.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
+#include "perf_monitor.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <string.h>
+
+static const char *TAG = "DHT11_BITBANG";
+
+// Frame read by dht11_capture_arm(), handed out by dht11_capture_finish()
+static uint8_t frame[DHT11_FRAME_BYTES];
+static esp_err_t frame_result = ESP_ERR_TIMEOUT;
+
+/**
+ * @brief Wait for GPIO pin to reach expected logic level with timeout
+ *
+ * Uses esp_timer_get_time() for microsecond-precision timing measurements.
+ * This accuracy is critical for distinguishing between '0' and '1' bits.
+ *
+ * @param expected_level Logic level to wait for (0 = low, 1 = high)
+ * @param timeout_us Maximum time to wait in microseconds
+ *
+ * @return Time actually waited in microseconds (>= 0)
+ * @return -1 if timeout was exceeded before pin reached expected level
+ *
+ * @note Busy-waits; interrupts must be disabled by the caller
+ */
+static int32_t wait_for_pin_state(int expected_level, uint32_t timeout_us)
+{
+    int64_t start_time = esp_timer_get_time();  // Record start time for timeout calculation
+
+    // Small initial delay to avoid immediate false positives on pin transitions
+    esp_rom_delay_us(1);
+
+    // Poll pin state until it matches expected level or timeout occurs
+    while (gpio_get_level(DHT11_DATA_PIN) != expected_level)
+    {
+        int64_t elapsed = esp_timer_get_time() - start_time;
+        if (elapsed > timeout_us)
+        {
+            return -1;  // Timeout exceeded - sensor not responding
+        }
+
+        // Small delay to prevent excessive CPU usage during polling
+        // This also helps with GPIO stability on some ESP32 variants
+        esp_rom_delay_us(1);
+    }
+
+    // Return actual time waited (useful for bit timing analysis)
+    return (int32_t)(esp_timer_get_time() - start_time);
+}
+
+/**
+ * @brief Read single data bit from DHT11 sensor
+ *
+ * Every bit starts with a ~50µs low pulse followed by a variable-length
+ * high pulse (26-28µs = '0', ~70µs = '1'). The high pulse is measured and
+ * compared against DHT11_BIT_THRESHOLD.
+ *
+ * @return 0 or 1 for the decoded bit
+ * @return -1 on communication error or timeout
+ */
+static int read_bit(void)
+{
+    int64_t bit_start = esp_timer_get_time();
+
+    // Wait for low-to-high transition (start of bit)
+    int32_t low_wait = wait_for_pin_state(0, DHT11_BIT_TIMEOUT);
+    if (low_wait < 0)
+    {
+        ESP_LOGD(TAG, "Bit read failed: timeout waiting for low state after %lldµs",
+                 esp_timer_get_time() - bit_start);
+        return -1;  // Timeout waiting for start of bit
+    }
+
+    int32_t high_wait = wait_for_pin_state(1, DHT11_BIT_TIMEOUT);
+    if (high_wait < 0) {
+        ESP_LOGD(TAG, "Bit read failed: timeout waiting for high state (low took %ldµs)", low_wait);
+        return -1;  // Timeout waiting for data encoding pulse
+    }
+
+    // Measure high pulse duration (this encodes the bit value)
+    int32_t high_time = wait_for_pin_state(0, DHT11_BIT_TIMEOUT);
+    if (high_time < 0)
+    {
+        ESP_LOGD(TAG, "Bit read failed: timeout waiting for end of high pulse (low=%ldµs, high_wait=%ldµs)",
+                 low_wait, high_wait);
+        return -1;  // Timeout waiting for end of bit
+    }
+
+    // Validate pulse timing is within reasonable bounds
+    if (high_time < DHT11_BIT_HIGH_MIN_US || high_time > DHT11_BIT_HIGH_MAX_US)
+    {
+        ESP_LOGD(TAG, "Invalid pulse duration: %ldµs (expected %d-%dµs)",
+                 high_time, DHT11_BIT_HIGH_MIN_US, DHT11_BIT_HIGH_MAX_US);
+        return -1;  // Pulse duration outside valid range
+    }
+
+    int bit_value = (high_time > DHT11_BIT_THRESHOLD) ? 1 : 0;
+    ESP_LOGV(TAG, "Bit read: %d (high_time=%ldµs)", bit_value, high_time);
+    return bit_value;
+}
+
+/**
+ * @brief Re-enable interrupts and account for the time they were masked
+ */
+static inline void unmask_interrupts(perf_timestamp_t masked_since)
+{
+    portENABLE_INTERRUPTS();
+    PERF_END(PERF_STAGE_IRQ_MASKED, masked_since);
+}
+
+static void release_line(void)
+{
+    gpio_set_direction(DHT11_DATA_PIN, GPIO_MODE_OUTPUT_OD);
+    gpio_set_level(DHT11_DATA_PIN, 1);
+}
+
+esp_err_t dht11_capture_init(void)
+{
+    ESP_LOGW(TAG, "Legacy polling capture selected: interrupts are masked for ~5ms per read");
+    return ESP_OK;
+}
+
+void dht11_capture_deinit(void)
+{
+    // No peripheral to release; dht11_reset() reconfigures the pin itself
+}
+
+void dht11_capture_start_signal(void)
+{
+    // The 18ms low phase is timed by the caller; interrupts stay enabled
+    gpio_set_direction(DHT11_DATA_PIN, GPIO_MODE_OUTPUT_OD);
+    gpio_set_level(DHT11_DATA_PIN, 0);
+}
+
+esp_err_t dht11_capture_arm(void)
+{
+    // === CRITICAL TIMING SECTION START ===
+    // Disable interrupts for precise timing while the sensor replies
+    perf_timestamp_t masked_since = PERF_BEGIN();
+    portDISABLE_INTERRUPTS();
+
+    // Pull high for 20-40µs (host ready to receive)
+    gpio_set_level(DHT11_DATA_PIN, 1);
+    esp_rom_delay_us(DHT11_START_HIGH_TIME);
+
+    // Switch to input mode to read DHT11 response
+    gpio_set_direction(DHT11_DATA_PIN, GPIO_MODE_INPUT);
+
+    int64_t response_start = esp_timer_get_time();
+
+    // Wait for DHT11 response acknowledgment: 80µs low + 80µs high
+    if (wait_for_pin_state(0, DHT11_RESPONSE_TIMEOUT) < 0)
+    {
+        int64_t fail_time = esp_timer_get_time();
+        unmask_interrupts(masked_since);
+        release_line();
+        ESP_LOGW(TAG, "Failed waiting for initial low response after %lldµs", fail_time - response_start);
+        frame_result = ESP_ERR_TIMEOUT;
+        return ESP_OK;
+    }
+
+    int64_t low_ack_time = esp_timer_get_time();
+
+    if (wait_for_pin_state(1, DHT11_RESPONSE_TIMEOUT) < 0)
+    {
+        int64_t fail_time = esp_timer_get_time();
+        unmask_interrupts(masked_since);
+        release_line();
+        ESP_LOGW(TAG, "Failed waiting for high response after %lldµs (low took %lldµs)",
+                 fail_time - low_ack_time, low_ack_time - response_start);
+        frame_result = ESP_ERR_TIMEOUT;
+        return ESP_OK;
+    }
+
+    // Read 40 bits of data, MSB first
+    for (int i = 0; i < DHT11_FRAME_BYTES; i++)
+    {
+        frame[i] = 0;
+        for (int j = 7; j >= 0; j--)
+        {
+            int bit = read_bit();
+            if (bit < 0)
+            {
+                unmask_interrupts(masked_since);
+                release_line();
+                ESP_LOGW(TAG, "DHT11 communication failed - timeout or bit error detected");
+                frame_result = ESP_FAIL;
+                return ESP_OK;
+            }
+            frame[i] |= (bit << j);
+        }
+    }
+
+    // === CRITICAL TIMING SECTION END ===
+    unmask_interrupts(masked_since);
+    release_line();
+
+    frame_result = ESP_OK;
+    return ESP_OK;
+}
+
+esp_err_t dht11_capture_finish(uint8_t raw[DHT11_FRAME_BYTES])
+{
+    // The frame was already read synchronously by dht11_capture_arm()
+    if (frame_result == ESP_OK)
+    {
+        memcpy(raw, frame, DHT11_FRAME_BYTES);
+    }
+    return frame_result;
+}
+
+#endif // DHT11_USE_LEGACY_BITBANG
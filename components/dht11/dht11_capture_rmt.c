@@ -0,0 +1,251 @@
+/**
+ * @file dht11_capture_rmt.c
+ * @brief RMT receiver based DHT11 capture backend
+ *
+ * Exchange timeline, and who is doing the work:
+ *
+ *   host low (>=18ms)    one-shot esp_timer - no task is blocked
+ *   host release         gpio_set_level(1) then rmt_receive() arms the receiver
+ *   sensor 80µs low/high \
+ *   40 x (50µs low +      > RMT timestamps every edge in hardware (1 µs ticks)
+ *         26/70µs high)  /
+ *   line idle > 200µs    RMT ends the capture, the rx-done ISR sets a flag
+ *   decode               plain loop over the captured symbols, esp_timer task
+ *
+ * Nothing in this path masks interrupts. Arming the receiver after the
+ * release is not timing-critical: the decoder only needs the last 40 high
+ * pulses of the capture, so missing the host release or the 80 µs
+ * acknowledge (if the timer task is briefly preempted) is harmless. The first data
+ * bit only starts ~180 µs after the release.
+ *
+ * The data pin stays in input/output open-drain mode for the whole exchange.
+ * The RMT channel listens through the GPIO matrix while the pin driver
+ * produces the start pulse, so no direction switching is needed.
+ *
+ * The channel is only enabled from the start signal until the frame has
+ * been collected. An enabled RMT channel holds the driver's APB frequency
+ * lock, which would otherwise keep DFS and light sleep off permanently.
+ */
+
+#include "dht11_capture.h"
+
+#if !DHT11_USE_LEGACY_BITBANG
+
+#include "dht11.h"
+#include "driver/gpio.h"
+#include "driver/rmt_rx.h"
+#include "esp_log.h"
+
+static const char *TAG = "DHT11_RMT";
+
+/**
+ * @brief RMT capture configuration
+ *
+ * - 1 MHz resolution: one RMT tick per microsecond, so symbol durations
+ *   compare directly with the µs constants in dht11.h.
+ * - 64 symbols is one ESP32 RMT memory block. A frame is ~42 symbols
+ *   (acknowledge + 40 bits + trailing low).
+ * - Pulses shorter than 1 µs are filtered as glitches; a level held for
+ *   more than 200 µs ends the capture (the longest protocol pulse is 80 µs).
+ */
+#define DHT11_RMT_RESOLUTION_HZ     (1 * 1000 * 1000)
+#define DHT11_RMT_MEM_SYMBOLS       64
+#define DHT11_RMT_GLITCH_NS         1000
+#define DHT11_RMT_IDLE_NS           (200 * 1000)
+
+static rmt_channel_handle_t rx_channel = NULL;
+static rmt_symbol_word_t rx_symbols[DHT11_RMT_MEM_SYMBOLS];
+
+// Written by the rx-done ISR, read by dht11_capture_finish()
+static volatile bool rx_done = false;
+static volatile size_t rx_done_symbols = 0;
+
+// Channel enabled for the current exchange (esp_timer task only)
+static bool rx_enabled = false;
+
+static bool on_rx_done(rmt_channel_handle_t channel, const rmt_rx_done_event_data_t *edata,
+                       void *user_data)
+{
+    rx_done_symbols = edata->num_symbols;
+    rx_done = true;
+    return false;
+}
+
+/**
+ * @brief Decode the captured pulse train into five frame bytes
+ *
+ * Reads only its arguments, so it is also safe on recorded traces.
+ * Collects the duration of every high pulse, in order. The last 40 of those
+ * are the data bits; anything before them (host release, acknowledge) is
+ * ignored. The line is left high at the end of the frame, so the final
+ * symbol half is the idle terminator with duration 0 and is not counted.
+ *
+ * @return ESP_OK if 40 in-range high pulses were found
+ */
+esp_err_t dht11_capture_decode_symbols(const rmt_symbol_word_t *symbols, size_t num_symbols,
+                                       uint8_t raw[DHT11_FRAME_BYTES])
+{
+    uint16_t highs[DHT11_RMT_MEM_SYMBOLS * 2];
+    size_t high_count = 0;
+
+    if (num_symbols > DHT11_RMT_MEM_SYMBOLS)
+    {
+        return ESP_FAIL;    // Longer than any capture the receiver can produce
+    }
+
+    for (size_t i = 0; i < num_symbols; i++)
+    {
+        if (symbols[i].level0 == 1 && symbols[i].duration0 > 0)
+        {
+            highs[high_count++] = symbols[i].duration0;
+        }
+        if (symbols[i].level1 == 1 && symbols[i].duration1 > 0)
+        {
+            highs[high_count++] = symbols[i].duration1;
+        }
+    }
+
+    if (high_count < DHT11_FRAME_BITS)
+    {
+        ESP_LOGW(TAG, "Incomplete frame: %u high pulses in %u symbols (need %d)",
+                 (unsigned)high_count, (unsigned)num_symbols, DHT11_FRAME_BITS);
+        return ESP_FAIL;
+    }
+
+    const uint16_t *bits = &highs[high_count - DHT11_FRAME_BITS];
+    for (int i = 0; i < DHT11_FRAME_BYTES; i++)
+    {
+        raw[i] = 0;
+        for (int j = 0; j < 8; j++)
+        {
+            uint16_t high_time = bits[i * 8 + j];
+            if (high_time < DHT11_BIT_HIGH_MIN_US || high_time > DHT11_BIT_HIGH_MAX_US)
+            {
+                ESP_LOGD(TAG, "Invalid pulse duration: %uµs at bit %d", high_time, i * 8 + j);
+                return ESP_FAIL;
+            }
+            raw[i] = (uint8_t)((raw[i] << 1) | (high_time > DHT11_BIT_THRESHOLD ? 1 : 0));
+        }
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t dht11_capture_init(void)
+{
+    if (rx_channel != NULL)
+    {
+        return ESP_OK;
+    }
+
+    rmt_rx_channel_config_t channel_config = {
+        .gpio_num = DHT11_DATA_PIN,
+        .clk_src = RMT_CLK_SRC_DEFAULT,
+        .resolution_hz = DHT11_RMT_RESOLUTION_HZ,
+        .mem_block_symbols = DHT11_RMT_MEM_SYMBOLS,
+    };
+    esp_err_t ret = rmt_new_rx_channel(&channel_config, &rx_channel);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to create RMT RX channel: %s", esp_err_to_name(ret));
+        rx_channel = NULL;
+        return ret;
+    }
+
+    rmt_rx_event_callbacks_t callbacks = {
+        .on_recv_done = on_rx_done,
+    };
+    ret = rmt_rx_register_event_callbacks(rx_channel, &callbacks, NULL);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to register RMT RX callbacks: %s", esp_err_to_name(ret));
+        goto fail_channel;
+    }
+
+    // The RMT driver routes the pin as an input. Restore the open-drain
+    // output so the same pin can still produce the start pulse.
+    gpio_set_direction(DHT11_DATA_PIN, GPIO_MODE_INPUT_OUTPUT_OD);
+    gpio_set_level(DHT11_DATA_PIN, 1);
+
+    ESP_LOGI(TAG, "✓ RMT capture ready on GPIO%d (%d symbols, 1µs resolution)",
+             DHT11_DATA_PIN, DHT11_RMT_MEM_SYMBOLS);
+    return ESP_OK;
+
+fail_channel:
+    rmt_del_channel(rx_channel);
+    rx_channel = NULL;
+    return ret;
+}
+
+void dht11_capture_deinit(void)
+{
+    if (rx_channel == NULL)
+    {
+        return;
+    }
+    if (rx_enabled)
+    {
+        rmt_disable(rx_channel);
+        rx_enabled = false;
+    }
+    rmt_del_channel(rx_channel);
+    rx_channel = NULL;
+}
+
+void dht11_capture_start_signal(void)
+{
+    // Enabled for this exchange only, see the file header
+    if (rx_channel != NULL && rmt_enable(rx_channel) == ESP_OK)
+    {
+        rx_enabled = true;
+    }
+    gpio_set_level(DHT11_DATA_PIN, 0);
+}
+
+esp_err_t dht11_capture_arm(void)
+{
+    static const rmt_receive_config_t receive_config = {
+        .signal_range_min_ns = DHT11_RMT_GLITCH_NS,
+        .signal_range_max_ns = DHT11_RMT_IDLE_NS,
+    };
+
+    if (!rx_enabled)
+    {
+        gpio_set_level(DHT11_DATA_PIN, 1);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    rx_done = false;
+
+    // Release the line and let the RMT timestamp the reply
+    gpio_set_level(DHT11_DATA_PIN, 1);
+    esp_err_t ret = rmt_receive(rx_channel, rx_symbols, sizeof(rx_symbols), &receive_config);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGW(TAG, "Failed to arm RMT receiver: %s", esp_err_to_name(ret));
+        rmt_disable(rx_channel);
+        rx_enabled = false;
+    }
+    return ret;
+}
+
+esp_err_t dht11_capture_finish(uint8_t raw[DHT11_FRAME_BYTES])
+{
+    // Also aborts a pending receive, so the next attempt starts clean
+    if (rx_enabled)
+    {
+        rmt_disable(rx_channel);
+        rx_enabled = false;
+    }
+
+    if (!rx_done)
+    {
+        ESP_LOGW(TAG, "No complete response from DHT11 within %dµs", DHT11_CAPTURE_WINDOW_US);
+        return ESP_ERR_TIMEOUT;
+    }
+
+    ESP_LOGD(TAG, "Captured %u RMT symbols", (unsigned)rx_done_symbols);
+    return dht11_capture_decode_symbols(rx_symbols, rx_done_symbols, raw);
+}
+
+#endif // !DHT11_USE_LEGACY_BITBANG
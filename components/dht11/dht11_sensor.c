@@ -0,0 +1,87 @@
+/**
+ * @file dht11_sensor.c
+ * @brief DHT11 backend for sensor_scheduler, see dht11_sensor.h
+ */
+
+#include "dht11_sensor.h"
+#include "dht11.h"
+#include "sensor_scheduler.h"
+
+/**
+ * @brief Worst case of one read: the power-up wait it may be deferred
+ *        behind, then every attempt stabilizes, signals and captures
+ *        (~26 ms), with the retry delay between attempts
+ */
+#define DHT11_SENSOR_TIMEOUT_MS \
+    (DHT11_POWER_UP_MS + DHT11_MAX_RETRIES * (DHT11_STABILIZATION_MS + DHT11_RETRY_DELAY_MS + 50))
+
+// Written by the esp_timer task before the notification, read by poll()
+static volatile bool conversion_done = false;
+static esp_err_t conversion_result = ESP_FAIL;
+static dht11_data_t conversion_data;
+
+static void on_read_done(esp_err_t result, const dht11_data_t *data, void *ctx)
+{
+    conversion_result = result;
+    conversion_data = *data;
+    conversion_done = true;
+    sensor_scheduler_notify();
+}
+
+static esp_err_t dht11_sensor_init(void *ctx)
+{
+    return dht11_init();
+}
+
+static esp_err_t dht11_sensor_start(void *ctx)
+{
+    conversion_done = false;
+    return dht11_read_async(on_read_done, NULL);
+}
+
+static esp_err_t dht11_sensor_poll(void *ctx, sensor_reading_t *reading)
+{
+    if (!conversion_done)
+    {
+        return ESP_ERR_NOT_FINISHED;
+    }
+    if (conversion_result != ESP_OK)
+    {
+        return conversion_result;
+    }
+    if (!conversion_data.valid)
+    {
+        return ESP_ERR_INVALID_RESPONSE;    // Cached fallback, not a new measurement
+    }
+
+    reading->fields = SENSOR_FIELD_TEMPERATURE | SENSOR_FIELD_HUMIDITY;
+    reading->temperature = conversion_data.temperature;
+    reading->humidity = conversion_data.humidity;
+    return ESP_OK;
+}
+
+static esp_err_t dht11_sensor_recover(void *ctx, sensor_recovery_t step, uint32_t *settle_ms)
+{
+    switch (step)
+    {
+        case SENSOR_RECOVERY_REINIT:
+            *settle_ms = 0;
+            return dht11_reset();
+        case SENSOR_RECOVERY_POWER_CYCLE:
+            // A retry that lands in the power-up wait is deferred by the driver
+            return dht11_power_cycle(settle_ms);
+        default:
+            return ESP_ERR_NOT_SUPPORTED;
+    }
+}
+
+const sensor_driver_t dht11_sensor_driver = {
+    .name = "dht11",
+    .min_interval_ms = DHT11_SENSOR_MIN_INTERVAL_MS,
+    .conversion_time_ms = DHT11_STABILIZATION_MS + DHT11_START_LOW_TIME / 1000,
+    .timeout_ms = DHT11_SENSOR_TIMEOUT_MS,
+    .init = dht11_sensor_init,
+    .start_conversion = dht11_sensor_start,
+    .poll = dht11_sensor_poll,
+    .recover = dht11_sensor_recover,
+};
@@ -0,0 +1,25 @@
+#ifndef DHT11_SENSOR_H
+#define DHT11_SENSOR_H
+
+#include "sensor_driver.h"
+
+/**
+ * @file dht11_sensor.h
+ * @brief DHT11 backend for sensor_scheduler
+ *
+ * Wraps dht11_read_async(): start_conversion() starts the asynchronous
+ * read and the completion callback wakes the scheduler. The driver's retry
+ * sequence runs inside one conversion. A cached fallback reading (valid ==
+ * false) counts as a failed conversion. Recovery maps to dht11_reset()
+ * and dht11_power_cycle(). The context argument is unused; register with
+ * NULL.
+ */
+
+/**
+ * @brief Shortest supported period (the sensor needs ~1 s between reads)
+ */
+#define DHT11_SENSOR_MIN_INTERVAL_MS    1000
+
+extern const sensor_driver_t dht11_sensor_driver;
+
+#endif // DHT11_SENSOR_H
@@ -0,0 +1,346 @@
+/**
+ * @file display_manager.c
+ * @brief Display render task and command queue
+ *
+ * Producers build a display_cmd_t on their own stack and post it with a zero
+ * timeout. The render task blocks on the queue. When it wakes it folds every
+ * queued command into one render_state_t and then renders that state once:
+ *
+ *   queue: [SENSOR 22.4] [NET UP] [SENSOR 22.5]  ->  one status redraw at 22.5 / UP
+ *   queue: [MESSAGE ERR] [SENSOR 22.5]           ->  status screen (sensor was last)
+ *
+ * The status screen itself only re-renders glyph cells that changed
+ * (status_screen.h), so a typical sensor update flushes a few 11x16 cells,
+ * plus one new column of each history plot when a history slot has closed
+ * (history_plot.h).
+ * Every render pass is timed as PERF_STAGE_DISPLAY_RENDER; the first pass
+ * that puts real readings on the panel is the PERF_BOOT_FIRST_READING_SHOWN
+ * boot milestone.
+ */
+
+#include "display_manager.h"
+#include "status_screen.h"
+#include "history_plot.h"
+#include "st7789.h"
+#include "perf_monitor.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "DISPLAY_MANAGER";
+
+/**
+ * @brief Render task configuration
+ *
+ * Core 1 keeps SPI rendering away from the timing-critical sensor task on
+ * core 0. Priority 1 matches the WiFi task; rendering is never urgent.
+ */
+#define DISPLAY_TASK_CORE           1
+#define DISPLAY_TASK_PRIORITY       1
+#define DISPLAY_TASK_STACK_SIZE     3072
+#define DISPLAY_QUEUE_LENGTH        8
+
+#define DISPLAY_MESSAGE_LINES       3
+
+typedef enum {
+    DISPLAY_CMD_SENSOR = 0,     ///< New temperature/humidity values
+    DISPLAY_CMD_PLACEHOLDER,    ///< Status screen without values
+    DISPLAY_CMD_NETWORK,        ///< Network indicator change
+    DISPLAY_CMD_MESSAGE         ///< Full-screen message
+} display_cmd_type_t;
+
+typedef struct {
+    char text[DISPLAY_MESSAGE_MAX_CHARS + 1];
+    uint16_t color;
+} display_line_t;
+
+/**
+ * @brief Command snapshot passed by value through the queue
+ */
+typedef struct {
+    display_cmd_type_t type;
+    union {
+        struct {
+            float temperature;
+            float humidity;
+        } sensor;
+        display_net_state_t net_state;
+        display_line_t lines[DISPLAY_MESSAGE_LINES];
+    };
+} display_cmd_t;
+
+/**
+ * @brief Which screen the coalesced batch should end up on
+ */
+typedef enum {
+    SCREEN_NONE = 0,
+    SCREEN_STATUS,
+    SCREEN_MESSAGE
+} screen_request_t;
+
+/**
+ * @brief Latest value of every command kind within one drained batch
+ */
+typedef struct {
+    screen_request_t screen;
+    bool has_values;            ///< sensor holds real readings (vs placeholder)
+    float temperature;
+    float humidity;
+    bool net_changed;
+    display_line_t lines[DISPLAY_MESSAGE_LINES];
+} render_state_t;
+
+static QueueHandle_t command_queue = NULL;
+static TaskHandle_t render_task_handle = NULL;
+
+// Render-task-only state: what the status screen shows when it comes back
+static display_net_state_t net_state = DISPLAY_NET_READY;
+static bool status_has_values = false;
+static float status_temperature = 0.0f;
+static float status_humidity = 0.0f;
+
+/**
+ * @brief Post without blocking; on overflow drop the oldest command
+ */
+static bool post_command(const display_cmd_t *cmd)
+{
+    if (command_queue == NULL)
+    {
+        return false;
+    }
+
+    if (xQueueSend(command_queue, cmd, 0) == pdTRUE)
+    {
+        return true;
+    }
+
+    display_cmd_t discarded;
+    xQueueReceive(command_queue, &discarded, 0);
+    ESP_LOGD(TAG, "Display queue full, dropped oldest command (type %d)", discarded.type);
+    return xQueueSend(command_queue, cmd, 0) == pdTRUE;
+}
+
+static void copy_line(display_line_t *line, const char *text, uint16_t color)
+{
+    if (text == NULL)
+    {
+        line->text[0] = '\0';
+    }
+    else
+    {
+        strncpy(line->text, text, DISPLAY_MESSAGE_MAX_CHARS);
+        line->text[DISPLAY_MESSAGE_MAX_CHARS] = '\0';
+    }
+    line->color = color;
+}
+
+/**
+ * @brief Fold one command into the batch state (last writer wins)
+ */
+static void coalesce(render_state_t *state, const display_cmd_t *cmd)
+{
+    switch (cmd->type)
+    {
+        case DISPLAY_CMD_SENSOR:
+            status_has_values = true;
+            status_temperature = cmd->sensor.temperature;
+            status_humidity = cmd->sensor.humidity;
+            state->screen = SCREEN_STATUS;
+            break;
+
+        case DISPLAY_CMD_PLACEHOLDER:
+            status_has_values = false;
+            state->screen = SCREEN_STATUS;
+            break;
+
+        case DISPLAY_CMD_NETWORK:
+            net_state = cmd->net_state;
+            state->net_changed = true;
+            break;
+
+        case DISPLAY_CMD_MESSAGE:
+            memcpy(state->lines, cmd->lines, sizeof(state->lines));
+            state->screen = SCREEN_MESSAGE;
+            break;
+    }
+}
+
+static void render_network_field(void)
+{
+    switch (net_state)
+    {
+        case DISPLAY_NET_UP:
+            status_screen_set_field(STATUS_FIELD_NETWORK, "NET: UP", ST7789_GREEN);
+            break;
+        case DISPLAY_NET_DISCONNECTED:
+            status_screen_set_field(STATUS_FIELD_NETWORK, "NET: DSCNT", ST7789_RED);
+            break;
+        default:
+            status_screen_set_field(STATUS_FIELD_NETWORK, "NET: READY", ST7789_GREEN);
+            break;
+    }
+}
+
+static void render_status_screen(void)
+{
+    char temp_str[20];
+    char humid_str[20];
+
+    if (status_has_values)
+    {
+        snprintf(temp_str, sizeof(temp_str), "TEMP:%.1fC", status_temperature);
+        snprintf(humid_str, sizeof(humid_str), "HUMD:%.0f%%", status_humidity);
+    }
+    else
+    {
+        strcpy(temp_str, "TEMP: __._C");
+        strcpy(humid_str, "HUMD: __%");
+    }
+
+    status_screen_set_field(STATUS_FIELD_TEMPERATURE, temp_str, ST7789_CYAN);
+    status_screen_set_field(STATUS_FIELD_HUMIDITY, humid_str, ST7789_GREEN);
+    render_network_field();
+    history_plot_update();
+    status_screen_present();
+
+    if (status_has_values)
+    {
+        perf_monitor_boot_mark(PERF_BOOT_FIRST_READING_SHOWN);
+    }
+}
+
+static void render_message_screen(const display_line_t lines[DISPLAY_MESSAGE_LINES])
+{
+    static const uint16_t line_y[DISPLAY_MESSAGE_LINES] = {
+        DISPLAY_LINE_1_Y, DISPLAY_LINE_2_Y, DISPLAY_LINE_3_Y
+    };
+
+    status_screen_deactivate();
+    history_plot_invalidate();
+    st7789_clear_screen(ST7789_BLACK);
+    for (int i = 0; i < DISPLAY_MESSAGE_LINES; i++)
+    {
+        if (lines[i].text[0] != '\0')
+        {
+            st7789_draw_large_string(DISPLAY_TEXT_X, line_y[i], lines[i].text, lines[i].color, ST7789_BLACK);
+        }
+    }
+    st7789_flush();
+}
+
+static void render_task(void *pvParameters)
+{
+    ESP_LOGI(TAG, "Display Render Task Started (Core %d)", xPortGetCoreID());
+
+    display_cmd_t cmd;
+    while (1)
+    {
+        xQueueReceive(command_queue, &cmd, portMAX_DELAY);
+
+        render_state_t state = {0};
+        coalesce(&state, &cmd);
+        while (xQueueReceive(command_queue, &cmd, 0) == pdTRUE)
+        {
+            coalesce(&state, &cmd);
+        }
+
+        perf_timestamp_t render_started = PERF_BEGIN();
+        if (state.screen == SCREEN_MESSAGE)
+        {
+            render_message_screen(state.lines);
+        }
+        else if (state.screen == SCREEN_STATUS)
+        {
+            render_status_screen();
+        }
+        else if (state.net_changed && status_screen_is_active())
+        {
+            render_network_field();
+            status_screen_present();
+        }
+        PERF_END(PERF_STAGE_DISPLAY_RENDER, render_started);
+    }
+}
+
+esp_err_t display_manager_init(void)
+{
+    if (command_queue != NULL)
+    {
+        return ESP_OK;
+    }
+
+    const uint16_t status_lines[STATUS_FIELD_COUNT] = {
+        DISPLAY_STATUS_LINE_1_Y, DISPLAY_STATUS_LINE_2_Y, DISPLAY_STATUS_LINE_3_Y
+    };
+    status_screen_init(DISPLAY_TEXT_X, status_lines, ST7789_BLACK);
+
+    command_queue = xQueueCreate(DISPLAY_QUEUE_LENGTH, sizeof(display_cmd_t));
+    if (command_queue == NULL)
+    {
+        ESP_LOGE(TAG, "Failed to create display command queue");
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t display_manager_start(void)
+{
+    if (render_task_handle != NULL)
+    {
+        return ESP_OK;
+    }
+    if (command_queue == NULL)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    BaseType_t result = xTaskCreatePinnedToCore(render_task, "display_task", DISPLAY_TASK_STACK_SIZE,
+                                                NULL, DISPLAY_TASK_PRIORITY, &render_task_handle,
+                                                DISPLAY_TASK_CORE);
+    if (result != pdPASS)
+    {
+        // The queue stays: tasks already running may be posting to it
+        ESP_LOGE(TAG, "Failed to create display render task");
+        return ESP_ERR_NO_MEM;
+    }
+    perf_monitor_watch_task(render_task_handle);
+
+    ESP_LOGI(TAG, "Display manager started (queue depth %d, %d bytes per command)",
+             DISPLAY_QUEUE_LENGTH, (int)sizeof(display_cmd_t));
+    return ESP_OK;
+}
+
+bool display_manager_post_sensor(float temperature, float humidity)
+{
+    display_cmd_t cmd = { .type = DISPLAY_CMD_SENSOR };
+    cmd.sensor.temperature = temperature;
+    cmd.sensor.humidity = humidity;
+    return post_command(&cmd);
+}
+
+bool display_manager_post_placeholder(void)
+{
+    display_cmd_t cmd = { .type = DISPLAY_CMD_PLACEHOLDER };
+    return post_command(&cmd);
+}
+
+bool display_manager_post_network(display_net_state_t state)
+{
+    display_cmd_t cmd = { .type = DISPLAY_CMD_NETWORK };
+    cmd.net_state = state;
+    return post_command(&cmd);
+}
+
+bool display_manager_post_message(const char *line1, uint16_t color1,
+                                  const char *line2, uint16_t color2,
+                                  const char *line3, uint16_t color3)
+{
+    display_cmd_t cmd = { .type = DISPLAY_CMD_MESSAGE };
+    copy_line(&cmd.lines[0], line1, color1);
+    copy_line(&cmd.lines[1], line2, color2);
+    copy_line(&cmd.lines[2], line3, color3);
+    return post_command(&cmd);
+}
@@ -0,0 +1,118 @@
+#ifndef DISPLAY_MANAGER_H
+#define DISPLAY_MANAGER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+/**
+ * @file display_manager.h
+ * @brief Display render task fed by a non-blocking command queue
+ *
+ * All drawing happens on a dedicated render task. Other tasks post small
+ * command snapshots (sensor values, network state, full-screen messages)
+ * and return immediately. A post never waits for the display, so SPI
+ * rendering time can no longer stretch the DHT11 loop or shift its
+ * vTaskDelayUntil() cadence.
+ *
+ * Coalescing (last writer wins):
+ * Each time the render task wakes, it drains the whole queue before it
+ * draws anything. Only the newest value of each kind is kept, and whichever
+ * screen (status or message) was requested last is the one rendered.
+ * Three sensor updates that arrive while a frame is being flushed cost one
+ * redraw, not three.
+ *
+ * If the queue is ever full, the oldest queued command is discarded to
+ * make room for the new one.
+ */
+
+// Display Layout Constants (message screens)
+#define DISPLAY_LINE_1_Y            50      ///< Y position for first display line
+#define DISPLAY_LINE_2_Y            100     ///< Y position for second display line
+#define DISPLAY_LINE_3_Y            150     ///< Y position for third display line
+#define DISPLAY_TEXT_X              20      ///< X position for display text
+
+// Status screen: text lines on whole framebuffer bands, each of the two
+// value lines followed by its 24-hour history plot (history_plot.h)
+#define DISPLAY_STATUS_LINE_1_Y     16      ///< Temperature, band 1
+#define DISPLAY_STATUS_LINE_2_Y     112     ///< Humidity, band 7
+#define DISPLAY_STATUS_LINE_3_Y     208     ///< Network, band 13
+
+/**
+ * @brief Maximum characters per message line (see STATUS_FIELD_MAX_CHARS)
+ */
+#define DISPLAY_MESSAGE_MAX_CHARS   12
+
+/**
+ * @brief Network indicator states shown on the status screen
+ */
+typedef enum {
+    DISPLAY_NET_READY = 0,      ///< "NET: READY" - not yet attempted
+    DISPLAY_NET_UP,             ///< "NET: UP"
+    DISPLAY_NET_DISCONNECTED    ///< "NET: DSCNT"
+} display_net_state_t;
+
+/**
+ * @brief Create the command queue
+ *
+ * Call before any task that posts is started. Commands posted before
+ * display_manager_start() wait in the queue (coalesced as usual); if the
+ * render task never starts they are discarded oldest first.
+ *
+ * @return ESP_OK on success (also if already initialized)
+ * @return ESP_ERR_NO_MEM if the queue could not be created
+ */
+esp_err_t display_manager_init(void);
+
+/**
+ * @brief Start the render task
+ *
+ * Must be called after display_manager_init() and st7789_init(). From then
+ * on only the render task may draw on the display.
+ *
+ * @return ESP_OK on success
+ * @return ESP_ERR_INVALID_STATE if display_manager_init() has not succeeded
+ * @return ESP_ERR_NO_MEM if the task could not be created
+ */
+esp_err_t display_manager_start(void);
+
+/**
+ * @brief Show a sensor reading on the status screen
+ *
+ * @param temperature Temperature in Celsius
+ * @param humidity    Relative humidity in percent
+ * @return true if the command was queued
+ */
+bool display_manager_post_sensor(float temperature, float humidity);
+
+/**
+ * @brief Show the status screen with "__" placeholders instead of values
+ *
+ * @return true if the command was queued
+ */
+bool display_manager_post_placeholder(void);
+
+/**
+ * @brief Update the network indicator
+ *
+ * The state is remembered while a message screen is shown and appears when
+ * the status screen returns.
+ *
+ * @param state New network state
+ * @return true if the command was queued
+ */
+bool display_manager_post_network(display_net_state_t state);
+
+/**
+ * @brief Show a full-screen three-line message
+ *
+ * Replaces the status screen until the next sensor or placeholder command.
+ * Pass NULL for unused lines. Lines are truncated to DISPLAY_MESSAGE_MAX_CHARS.
+ *
+ * @return true if the command was queued
+ */
+bool display_manager_post_message(const char *line1, uint16_t color1,
+                                  const char *line2, uint16_t color2,
+                                  const char *line3, uint16_t color3);
+
+#endif // DISPLAY_MANAGER_H
@@ -0,0 +1,109 @@
+/**
+ * @file history_plot.c
+ * @brief Sweep-style sparklines drawn from sensor_history, see history_plot.h
+ *
+ * Column c covers slots c * HISTORY_PLOT_SLOTS_PER_COLUMN onwards. The
+ * newest column is the one holding slot head - 1; it may still be partial
+ * and is redrawn as further slots of it close. An update redraws the
+ * columns from the one holding the first newly closed slot. Only the newest
+ * HISTORY_PLOT_WIDTH - 1 columns are visible, the remaining x position
+ * being the blank cursor.
+ */
+
+#include "history_plot.h"
+#include "st7789.h"
+#include <math.h>
+#include <stdbool.h>
+
+#define HISTORY_PLOT_BACKGROUND     ST7789_BLACK
+
+typedef struct {
+    uint16_t y;
+    uint16_t color;
+    float min;
+    float max;
+} plot_t;
+
+static const plot_t temperature_plot = {
+    HISTORY_PLOT_TEMPERATURE_Y, ST7789_CYAN, HISTORY_PLOT_TEMPERATURE_MIN, HISTORY_PLOT_TEMPERATURE_MAX
+};
+static const plot_t humidity_plot = {
+    HISTORY_PLOT_HUMIDITY_Y, ST7789_GREEN, HISTORY_PLOT_HUMIDITY_MIN, HISTORY_PLOT_HUMIDITY_MAX
+};
+
+static bool valid = false;
+static uint32_t drawn_head = 0;     ///< sensor_history_head() at the last update
+
+/**
+ * @brief Row of a value within a plot, 0 at the top
+ */
+static uint16_t value_row(const plot_t *plot, float value)
+{
+    float scaled = (value - plot->min) / (plot->max - plot->min) * (HISTORY_PLOT_HEIGHT - 1);
+    long row = (HISTORY_PLOT_HEIGHT - 1) - lroundf(scaled);
+    return (uint16_t)((row < 0) ? 0 : (row > HISTORY_PLOT_HEIGHT - 1) ? HISTORY_PLOT_HEIGHT - 1 : row);
+}
+
+static void draw_bar(const plot_t *plot, uint16_t x, float low, float high)
+{
+    uint16_t top = value_row(plot, high);
+    uint16_t bottom = value_row(plot, low);
+    st7789_fill_rect(x, plot->y + top, 1, bottom - top + 1, plot->color);
+}
+
+static uint16_t column_x(uint32_t column)
+{
+    return HISTORY_PLOT_X + column % HISTORY_PLOT_WIDTH;
+}
+
+static void clear_column(uint32_t column)
+{
+    uint16_t x = column_x(column);
+    st7789_fill_rect(x, temperature_plot.y, 1, HISTORY_PLOT_HEIGHT, HISTORY_PLOT_BACKGROUND);
+    st7789_fill_rect(x, humidity_plot.y, 1, HISTORY_PLOT_HEIGHT, HISTORY_PLOT_BACKGROUND);
+}
+
+static void draw_column(uint32_t column)
+{
+    sensor_history_range_t range;
+
+    clear_column(column);
+    if (sensor_history_range(column * HISTORY_PLOT_SLOTS_PER_COLUMN, HISTORY_PLOT_SLOTS_PER_COLUMN, &range))
+    {
+        uint16_t x = column_x(column);
+        draw_bar(&temperature_plot, x, range.temperature_min, range.temperature_max);
+        draw_bar(&humidity_plot, x, range.humidity_min, range.humidity_max);
+    }
+}
+
+void history_plot_update(void)
+{
+    uint32_t head = sensor_history_head();
+    if (valid && head == drawn_head)
+    {
+        return;
+    }
+
+    uint32_t newest = (head == 0) ? 0 : (head - 1) / HISTORY_PLOT_SLOTS_PER_COLUMN;
+    uint32_t oldest = (newest >= HISTORY_PLOT_WIDTH - 2) ? newest - (HISTORY_PLOT_WIDTH - 2) : 0;
+    if (valid)
+    {
+        // From the column of the first slot closed since the last update
+        uint32_t first_new = drawn_head / HISTORY_PLOT_SLOTS_PER_COLUMN;
+        oldest = (first_new > oldest) ? first_new : oldest;
+    }
+
+    for (uint32_t column = oldest; column <= newest; column++)
+    {
+        draw_column(column);
+    }
+    clear_column(newest + 1);
+
+    valid = true;
+    drawn_head = head;
+}
+
+void history_plot_invalidate(void)
+{
+    valid = false;
+}
@@ -0,0 +1,65 @@
+#ifndef HISTORY_PLOT_H
+#define HISTORY_PLOT_H
+
+#include <stdint.h>
+#include "sensor_history.h"
+
+/**
+ * @file history_plot.h
+ * @brief 24-hour temperature and humidity sparklines on the status screen
+ *
+ * Each plot is HISTORY_PLOT_WIDTH columns of HISTORY_PLOT_SLOTS_PER_COLUMN
+ * sensor_history slots (7.5 minutes). A column is drawn as a vertical bar
+ * from the lowest to the highest slot average it covers; a column without
+ * data stays blank.
+ *
+ * The plot is a sweep: column c is always drawn at x = c % width, and the
+ * blank column just ahead of the newest one marks "now". When a slot
+ * closes, only the newest column and that cursor are redrawn, so an update
+ * reaches the panel as one 2-pixel-wide strip per plot (the ST7789's
+ * hardware scroll only moves whole panel rows, which would drag the text
+ * fields along). The vertical scales are fixed for the same reason:
+ * rescaling would repaint every column.
+ *
+ * Each plot occupies two whole framebuffer bands (see st7789_framebuffer.h).
+ * Driven by the render task only, like status_screen.h.
+ */
+
+#define HISTORY_PLOT_X                  24      ///< Left edge of both plots
+#define HISTORY_PLOT_WIDTH              192     ///< Columns (pixels)
+#define HISTORY_PLOT_HEIGHT             32      ///< Rows (pixels), two framebuffer bands
+#define HISTORY_PLOT_TEMPERATURE_Y      48      ///< Top edge, bands 3-4
+#define HISTORY_PLOT_HUMIDITY_Y         144     ///< Top edge, bands 9-10
+
+#define HISTORY_PLOT_SLOTS_PER_COLUMN   (SENSOR_HISTORY_SLOTS / HISTORY_PLOT_WIDTH)
+
+/**
+ * @brief Value at the bottom and top edge of each plot (clamped beyond)
+ */
+#ifndef HISTORY_PLOT_TEMPERATURE_MIN
+#define HISTORY_PLOT_TEMPERATURE_MIN    10.0f   ///< °C
+#endif
+#ifndef HISTORY_PLOT_TEMPERATURE_MAX
+#define HISTORY_PLOT_TEMPERATURE_MAX    35.0f
+#endif
+#ifndef HISTORY_PLOT_HUMIDITY_MIN
+#define HISTORY_PLOT_HUMIDITY_MIN       0.0f    ///< % RH
+#endif
+#ifndef HISTORY_PLOT_HUMIDITY_MAX
+#define HISTORY_PLOT_HUMIDITY_MAX       100.0f
+#endif
+
+/**
+ * @brief Draw the slots closed since the last call into the off-screen buffer
+ *
+ * Redraws every column after history_plot_invalidate() (or the first
+ * time). Call after the status screen owns the panel; the caller flushes.
+ */
+void history_plot_update(void);
+
+/**
+ * @brief Forget what is on the panel, e.g. because another screen drew over it
+ */
+void history_plot_invalidate(void);
+
+#endif // HISTORY_PLOT_H
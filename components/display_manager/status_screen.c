@@ -0,0 +1,118 @@
+/**
+ * @file status_screen.c
+ * @brief Retained-mode sensor status screen
+ *
+ * Keeps the last rendered text of every field and diffs new values against
+ * it cell by cell. A cell is re-rendered when its character or the field
+ * colour changes; cells past the end of a shorter new string are blanked.
+ * Each re-rendered cell is first filled with the background colour so
+ * characters outside the large-font set never leave stale pixels behind.
+ *
+ * All drawing goes into the st7789 off-screen buffer, so a value change
+ * reaches the panel as a handful of small dirty rectangles on the next
+ * status_screen_present() - no full-screen fill and no visible flicker.
+ */
+
+#include "status_screen.h"
+#include "st7789.h"
+#include "esp_log.h"
+#include <string.h>
+
+static const char *TAG = "STATUS_SCREEN";
+
+/**
+ * @brief Rendered state of a single field
+ */
+typedef struct {
+    uint16_t x;                                 ///< Left edge
+    uint16_t y;                                 ///< Top edge
+    uint16_t color;                             ///< Foreground colour of the rendered text
+    char text[STATUS_FIELD_MAX_CHARS + 1];      ///< Text currently on the panel
+} status_field_t;
+
+static status_field_t fields[STATUS_FIELD_COUNT];
+static uint16_t background = ST7789_BLACK;
+static bool active = false;
+
+/**
+ * @brief Take over the panel: one full clear, then every field is empty
+ */
+static void activate(void)
+{
+    st7789_clear_screen(background);
+    for (int i = 0; i < STATUS_FIELD_COUNT; i++)
+    {
+        fields[i].text[0] = '\0';
+    }
+    active = true;
+    ESP_LOGD(TAG, "Status screen activated");
+}
+
+void status_screen_init(uint16_t x, const uint16_t line_y[STATUS_FIELD_COUNT], uint16_t bg_color)
+{
+    for (int i = 0; i < STATUS_FIELD_COUNT; i++)
+    {
+        fields[i].x = x;
+        fields[i].y = line_y[i];
+        fields[i].color = bg_color;
+        fields[i].text[0] = '\0';
+    }
+    background = bg_color;
+    active = false;
+}
+
+int status_screen_set_field(status_field_id_t id, const char *text, uint16_t color)
+{
+    if (id >= STATUS_FIELD_COUNT || text == NULL)
+    {
+        return 0;
+    }
+
+    if (!active)
+    {
+        activate();
+    }
+
+    status_field_t *field = &fields[id];
+    size_t old_len = strlen(field->text);
+    size_t new_len = strnlen(text, STATUS_FIELD_MAX_CHARS);
+    size_t cells = old_len > new_len ? old_len : new_len;
+    bool recolor = (color != field->color);
+    int redrawn = 0;
+
+    for (size_t i = 0; i < cells; i++)
+    {
+        char old_c = (i < old_len) ? field->text[i] : ' ';
+        char new_c = (i < new_len) ? text[i] : ' ';
+
+        if (old_c == new_c && !recolor)
+        {
+            continue;
+        }
+
+        // The glyph paints its whole cell, a space included
+        uint16_t cell_x = field->x + i * ST7789_LARGE_CHAR_ADVANCE;
+        st7789_draw_large_char(cell_x, field->y, new_c, color, background);
+        redrawn++;
+    }
+
+    memcpy(field->text, text, new_len);
+    field->text[new_len] = '\0';
+    field->color = color;
+    return redrawn;
+}
+
+void status_screen_deactivate(void)
+{
+    active = false;
+}
+
+bool status_screen_is_active(void)
+{
+    return active;
+}
+
+void status_screen_present(void)
+{
+    st7789_flush();
+}
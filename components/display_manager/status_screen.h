@@ -0,0 +1,86 @@
+#ifndef STATUS_SCREEN_H
+#define STATUS_SCREEN_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @file status_screen.h
+ * @brief Retained-mode model of the sensor status screen
+ *
+ * The dashboard has three text fields (temperature, humidity, network
+ * status) drawn with the 16 px large font. Each field remembers the string
+ * and colour it last rendered. When a new value arrives, only the glyph
+ * cells that actually differ are re-rendered. Changing "TEMP:22.5C" to
+ * "TEMP:22.6C" touches one 11x16 cell instead of clearing and redrawing
+ * the whole screen.
+ *
+ * Other screens (startup, sensor error, restart warning) draw over the
+ * panel directly. Call status_screen_deactivate() before drawing them; the
+ * next field update then clears the screen once and re-renders every field
+ * from scratch.
+ *
+ * Changes accumulate in the st7789 off-screen buffer until
+ * status_screen_present() flushes them. The module is not thread-safe and
+ * must be driven by a single task.
+ */
+
+/**
+ * @brief Maximum characters per field
+ *
+ * 12 cells * ST7789_LARGE_CHAR_ADVANCE starting at x = 20 still fits the
+ * 240 pixel width.
+ */
+#define STATUS_FIELD_MAX_CHARS  12
+
+/**
+ * @brief Fields of the status screen
+ */
+typedef enum {
+    STATUS_FIELD_TEMPERATURE = 0,   ///< Line 1: "TEMP:22.5C"
+    STATUS_FIELD_HUMIDITY,          ///< Line 2: "HUMD:40%"
+    STATUS_FIELD_NETWORK,           ///< Line 3: "NET: UP"
+    STATUS_FIELD_COUNT
+} status_field_id_t;
+
+/**
+ * @brief Configure field positions and background colour
+ *
+ * @param x        Left edge of every field
+ * @param line_y   Top edge of each field, indexed by status_field_id_t
+ * @param bg_color Screen background (RGB565)
+ */
+void status_screen_init(uint16_t x, const uint16_t line_y[STATUS_FIELD_COUNT], uint16_t bg_color);
+
+/**
+ * @brief Update one field, re-rendering only the glyph cells that changed
+ *
+ * Activates the status screen first if another screen owns the panel.
+ * Text longer than STATUS_FIELD_MAX_CHARS is truncated.
+ *
+ * @param id    Field to update
+ * @param text  New field contents (large-font character set)
+ * @param color Foreground colour (RGB565)
+ * @return Number of glyph cells re-rendered (0 if nothing changed)
+ */
+int status_screen_set_field(status_field_id_t id, const char *text, uint16_t color);
+
+/**
+ * @brief Hand the panel to another screen
+ *
+ * Forgets the rendered state so the next field update starts from a clean
+ * screen.
+ */
+void status_screen_deactivate(void);
+
+/**
+ * @brief Report whether the status screen currently owns the panel
+ */
+bool status_screen_is_active(void);
+
+/**
+ * @brief Make pending field changes visible (st7789_flush())
+ */
+void status_screen_present(void);
+
+#endif // STATUS_SCREEN_H
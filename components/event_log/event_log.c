@@ -0,0 +1,380 @@
+/**
+ * @file event_log.c
+ * @brief Record ring, per-tag buckets and the drain task, see event_log.h
+ *
+ * Like sample_ring, head is a free-running sequence number and the slot of
+ * sequence n is n % EVENT_LOG_CAPACITY. Two readers follow it with cursors
+ * of their own: the drain task (printed) and the diagnostics upload
+ * (uploaded). A reader that fell more than EVENT_LOG_CAPACITY behind skips
+ * to the oldest record still in the ring.
+ *
+ * Formatting walks the format once per conversion and hands each one to
+ * snprintf() with the stored word cast back to the type its conversion
+ * expects; the compile-time check in EVENT_LOG() is what makes that cast
+ * match the argument the caller passed.
+ */
+
+#include "event_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdio.h>
+
+const char *event_log_level_name(esp_log_level_t level)
+{
+    switch (level)
+    {
+        case ESP_LOG_ERROR:     return "E";
+        case ESP_LOG_WARN:      return "W";
+        case ESP_LOG_INFO:      return "I";
+        case ESP_LOG_DEBUG:     return "D";
+        case ESP_LOG_VERBOSE:   return "V";
+        default:                return "?";
+    }
+}
+
+// Appends one conversion; spec is the conversion including '%'
+static size_t format_conversion(char *out, size_t size, const char *spec, char conversion, uint32_t word)
+{
+    bool is_long = strchr(spec, 'l') != NULL;
+    bool is_size = strchr(spec, 'z') != NULL;
+    int n;
+
+    switch (conversion)
+    {
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+        {
+            float value;
+            memcpy(&value, &word, sizeof(value));
+            n = snprintf(out, size, spec, (double)value);
+            break;
+        }
+        case 's':
+        {
+            const char *value = (const char *)(uintptr_t)word;
+            n = snprintf(out, size, spec, (value != NULL) ? value : "(null)");
+            break;
+        }
+        case 'p':
+            n = snprintf(out, size, spec, (void *)(uintptr_t)word);
+            break;
+        case 'd': case 'i':
+            n = is_size ? snprintf(out, size, spec, (size_t)word)
+                : is_long ? snprintf(out, size, spec, (long)(int32_t)word)
+                : snprintf(out, size, spec, (int)(int32_t)word);
+            break;
+        default:    // c o u x X
+            n = is_size ? snprintf(out, size, spec, (size_t)word)
+                : is_long ? snprintf(out, size, spec, (unsigned long)word)
+                : snprintf(out, size, spec, (unsigned)word);
+            break;
+    }
+
+    if (n < 0)
+    {
+        return 0;
+    }
+    return ((size_t)n < size) ? (size_t)n : size - 1;
+}
+
+// Length without a multi-byte UTF-8 sequence ("°C", "✓") cut off at the end
+static size_t trim_partial_utf8(const char *s, size_t length)
+{
+    size_t start = length;
+    while (start > 0 && length - start < 3 && ((unsigned char)s[start - 1] & 0xC0) == 0x80)
+    {
+        start--;
+    }
+    if (start == 0)
+    {
+        return length;
+    }
+    unsigned char lead = (unsigned char)s[start - 1];
+    size_t needed = (lead >= 0xF0) ? 4 : (lead >= 0xE0) ? 3 : (lead >= 0xC0) ? 2 : 1;
+    return (length - (start - 1) < needed) ? start - 1 : length;
+}
+
+size_t event_log_format(const event_log_record_t *record, char *buffer, size_t size)
+{
+    const char *p = record->format;
+    size_t length = 0;
+    size_t arg = 0;
+
+    if (size == 0)
+    {
+        return 0;
+    }
+    while (*p != '\0' && length < size - 1)
+    {
+        if (*p != '%')
+        {
+            buffer[length++] = *p++;
+            continue;
+        }
+        if (p[1] == '%')
+        {
+            buffer[length++] = '%';
+            p += 2;
+            continue;
+        }
+
+        // Flags, width, precision and length up to the conversion letter
+        char spec[16];
+        size_t spec_length = 0;
+        do
+        {
+            spec[spec_length++] = *p++;
+        } while (*p != '\0' && strchr("diouxXcspfFeEgGaA", *p) == NULL &&
+                 spec_length < sizeof(spec) - 2);
+        if (*p == '\0' || strchr("diouxXcspfFeEgGaA", *p) == NULL)
+        {
+            break;      // Not a conversion this formatter knows; stop here
+        }
+        char conversion = *p++;
+        spec[spec_length++] = conversion;
+        spec[spec_length] = '\0';
+
+        uint32_t word = (arg < record->arg_count) ? record->args[arg] : 0;
+        arg++;
+        length += format_conversion(buffer + length, size - length, spec, conversion, word);
+    }
+    length = trim_partial_utf8(buffer, length);
+    buffer[length] = '\0';
+    return length;
+}
+
+#if EVENT_LOG_PRODUCTION
+
+static const char *TAG = "EVENT_LOG";
+
+typedef struct {
+    const char *tag;
+    uint32_t tokens_milli;          ///< Records allowed now, in thousandths
+    uint32_t refilled_ms;
+    uint32_t suppressed;            ///< Dropped since the drain task last reported
+} tag_bucket_t;
+
+static event_log_record_t records[EVENT_LOG_CAPACITY];
+static uint32_t head = 0;
+static uint32_t printed = 0;
+static uint32_t uploaded = 0;
+static tag_bucket_t buckets[EVENT_LOG_MAX_TAGS];
+static size_t bucket_count = 0;
+static portMUX_TYPE log_lock = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t drain_task = NULL;
+
+// Caller holds log_lock
+static tag_bucket_t *find_bucket(const char *tag, uint32_t now_ms)
+{
+    for (size_t i = 0; i < bucket_count; i++)
+    {
+        // Tags are per-file constants, so the pointer identifies them
+        if (buckets[i].tag == tag)
+        {
+            return &buckets[i];
+        }
+    }
+    if (bucket_count == EVENT_LOG_MAX_TAGS)
+    {
+        return &buckets[EVENT_LOG_MAX_TAGS - 1];
+    }
+    tag_bucket_t *bucket = &buckets[bucket_count++];
+    bucket->tag = tag;
+    bucket->tokens_milli = EVENT_LOG_TAG_BURST * 1000;
+    bucket->refilled_ms = now_ms;
+    return bucket;
+}
+
+// Caller holds log_lock
+static bool take_token(tag_bucket_t *bucket, uint32_t now_ms)
+{
+    uint32_t elapsed_ms = now_ms - bucket->refilled_ms;
+    bucket->refilled_ms = now_ms;
+    uint64_t tokens = bucket->tokens_milli + (uint64_t)elapsed_ms * EVENT_LOG_TAG_RATE_PER_S;
+    bucket->tokens_milli = (tokens > EVENT_LOG_TAG_BURST * 1000) ? EVENT_LOG_TAG_BURST * 1000
+                                                                 : (uint32_t)tokens;
+    if (bucket->tokens_milli < 1000)
+    {
+        bucket->suppressed++;
+        return false;
+    }
+    bucket->tokens_milli -= 1000;
+    return true;
+}
+
+void event_log_write(esp_log_level_t level, const char *tag, const char *format,
+                     const uint32_t *args, size_t arg_count)
+{
+    uint32_t now_ms = esp_log_timestamp();
+    if (arg_count > EVENT_LOG_MAX_ARGS)
+    {
+        arg_count = EVENT_LOG_MAX_ARGS;
+    }
+
+    taskENTER_CRITICAL(&log_lock);
+    if (take_token(find_bucket(tag, now_ms), now_ms))
+    {
+        event_log_record_t *record = &records[head % EVENT_LOG_CAPACITY];
+        record->format = format;
+        record->tag = tag;
+        record->timestamp_ms = now_ms;
+        record->level = (uint8_t)level;
+        record->arg_count = (uint8_t)arg_count;
+        memcpy(record->args, args, arg_count * sizeof(uint32_t));
+        head++;
+    }
+    taskEXIT_CRITICAL(&log_lock);
+}
+
+// Caller holds log_lock; moves a cursor that fell out of the ring to the oldest record
+static uint32_t catch_up(uint32_t *cursor)
+{
+    uint32_t skipped = 0;
+    if (head - *cursor > EVENT_LOG_CAPACITY)
+    {
+        skipped = head - EVENT_LOG_CAPACITY - *cursor;
+        *cursor = head - EVENT_LOG_CAPACITY;
+    }
+    return skipped;
+}
+
+static void print_record(const event_log_record_t *record)
+{
+    char message[EVENT_LOG_MESSAGE_SIZE];
+    event_log_format(record, message, sizeof(message));
+    esp_log_write((esp_log_level_t)record->level, record->tag, "%s (%lu) %s: %s\n",
+                  event_log_level_name((esp_log_level_t)record->level),
+                  (unsigned long)record->timestamp_ms, record->tag, message);
+}
+
+void event_log_drain(void)
+{
+    event_log_record_t record;
+
+    while (1)
+    {
+        taskENTER_CRITICAL(&log_lock);
+        uint32_t lost = catch_up(&printed);
+        bool available = (printed != head);
+        if (available)
+        {
+            record = records[printed % EVENT_LOG_CAPACITY];
+            printed++;
+        }
+        taskEXIT_CRITICAL(&log_lock);
+
+        if (lost > 0)
+        {
+            ESP_LOGW(TAG, "%lu records overwritten before they were printed", (unsigned long)lost);
+        }
+        if (!available)
+        {
+            break;
+        }
+        if (record.level <= EVENT_LOG_PRINT_LEVEL)
+        {
+            print_record(&record);
+        }
+    }
+
+    for (size_t i = 0; i < EVENT_LOG_MAX_TAGS; i++)
+    {
+        taskENTER_CRITICAL(&log_lock);
+        const char *tag = buckets[i].tag;
+        uint32_t suppressed = buckets[i].suppressed;
+        buckets[i].suppressed = 0;
+        taskEXIT_CRITICAL(&log_lock);
+
+        if (suppressed > 0)
+        {
+            ESP_LOGW(TAG, "%s: %lu records suppressed (over %d/s)", tag, (unsigned long)suppressed,
+                     EVENT_LOG_TAG_RATE_PER_S);
+        }
+    }
+}
+
+static void drain_task_main(void *arg)
+{
+    while (1)
+    {
+        event_log_drain();
+        vTaskDelay(pdMS_TO_TICKS(EVENT_LOG_DRAIN_MS));
+    }
+}
+
+esp_err_t event_log_start(void)
+{
+    if (drain_task != NULL)
+    {
+        return ESP_OK;
+    }
+    if (xTaskCreatePinnedToCore(drain_task_main, "event_log", EVENT_LOG_TASK_STACK_SIZE, NULL,
+                                EVENT_LOG_TASK_PRIORITY, &drain_task, EVENT_LOG_TASK_CORE) != pdPASS)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+size_t event_log_peek(event_log_excerpt_t *excerpt)
+{
+    excerpt->count = 0;
+    excerpt->lost = 0;
+
+    taskENTER_CRITICAL(&log_lock);
+    // Skipped records are not inspected, so their levels are unknown
+    excerpt->lost = catch_up(&uploaded);
+    uint32_t seq = uploaded;
+    while (seq != head && excerpt->count < EVENT_LOG_UPLOAD_MAX)
+    {
+        const event_log_record_t *record = &records[seq % EVENT_LOG_CAPACITY];
+        if (record->level <= EVENT_LOG_UPLOAD_LEVEL)
+        {
+            excerpt->records[excerpt->count++] = *record;
+        }
+        seq++;
+    }
+    excerpt->next_seq = seq;
+    taskEXIT_CRITICAL(&log_lock);
+
+    return excerpt->count;
+}
+
+void event_log_commit(const event_log_excerpt_t *excerpt)
+{
+    taskENTER_CRITICAL(&log_lock);
+    if ((int32_t)(excerpt->next_seq - uploaded) > 0)
+    {
+        uploaded = excerpt->next_seq;
+    }
+    taskEXIT_CRITICAL(&log_lock);
+}
+
+#else
+
+void event_log_write(esp_log_level_t level, const char *tag, const char *format,
+                     const uint32_t *args, size_t arg_count)
+{
+}
+
+esp_err_t event_log_start(void)
+{
+    return ESP_OK;
+}
+
+void event_log_drain(void)
+{
+}
+
+size_t event_log_peek(event_log_excerpt_t *excerpt)
+{
+    excerpt->count = 0;
+    excerpt->lost = 0;
+    excerpt->next_seq = 0;
+    return 0;
+}
+
+void event_log_commit(const event_log_excerpt_t *excerpt)
+{
+}
+
+#endif // EVENT_LOG_PRODUCTION
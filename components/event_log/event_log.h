@@ -0,0 +1,233 @@
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "esp_err.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+/**
+ * @file event_log.h
+ * @brief Deferred, rate-limited logging for the hot paths
+ *
+ * ESP_LOGx formats on the calling task and writes to the UART before it
+ * returns: at 115200 baud a 60-character line costs ~5 ms, on the sensor
+ * and upload paths that run every cycle. EVENT_LOGx takes the same
+ * arguments:
+ *
+ *   EVENT_LOGI(TAG, "TX: %u readings, %.1f°C", (unsigned)count, temperature);
+ *
+ * In a production build (CONFIG_EVENT_LOG_PRODUCTION, "Home Monitor" menu
+ * in menuconfig; sdkconfig.h sets it for every component) the call only stores the format string's address (the string stays in
+ * flash, so the address is its ID), the tag and up to EVENT_LOG_MAX_ARGS
+ * 32-bit arguments in a RAM ring: a few word copies under a spinlock, safe
+ * from any task on either core. The drain task formats and prints the ring in the
+ * background at idle priority, and warnings and errors also travel with
+ * the next diagnostics upload (event_log_peek()).
+ *
+ * Arguments are stored as 32-bit words and formatted when the record is
+ * printed, so:
+ * - Integers, floats (formatted as floats; %f expects a double as usual)
+ *   and pointers up to 32 bits; 64-bit arguments (%lld) do not compile.
+ * - A %s argument is stored as a pointer, so it must outlive the record:
+ *   string literals, esp_err_to_name(), sensor_scheduler_name(). Never a
+ *   buffer on the stack.
+ * The format is checked against the arguments at compile time, as for
+ * printf().
+ *
+ * Rate limiting:
+ * Every tag has a token bucket of EVENT_LOG_TAG_BURST records, refilled at
+ * EVENT_LOG_TAG_RATE_PER_S. Records beyond it are dropped and counted; the
+ * drain task reports the count per tag. A full ring overwrites its oldest
+ * record.
+ *
+ * Banners:
+ * EVENT_LOG_BANNER() is for decoration and repeated detail around an
+ * event (separator lines, "✓ ..." summaries). It is ESP_LOGI in
+ * development builds and compiled out in production; the event itself
+ * keeps one ordinary log line.
+ *
+ * In development builds (the default) EVENT_LOGx is plain ESP_LOGx, so
+ * lines appear in order with the rest of the log, and the ring and drain
+ * task do not exist.
+ */
+
+// Keyed off the project configuration, so that every component agrees
+#ifndef EVENT_LOG_PRODUCTION
+#ifdef CONFIG_EVENT_LOG_PRODUCTION
+#define EVENT_LOG_PRODUCTION        1
+#else
+#define EVENT_LOG_PRODUCTION        0
+#endif
+#endif
+
+#define EVENT_LOG_CAPACITY          128     ///< Records in the ring (32 bytes each, 4 KB)
+#define EVENT_LOG_MAX_ARGS          4
+#define EVENT_LOG_MESSAGE_SIZE      96      ///< Formatted message, longer ones are cut
+#define EVENT_LOG_MAX_TAGS          16      ///< Tags with their own bucket; more share the last
+
+#ifndef EVENT_LOG_TAG_RATE_PER_S
+#define EVENT_LOG_TAG_RATE_PER_S    5
+#endif
+#define EVENT_LOG_TAG_BURST         10
+
+#ifndef EVENT_LOG_PRINT_LEVEL
+#define EVENT_LOG_PRINT_LEVEL       ESP_LOG_INFO    ///< Printed by the drain task
+#endif
+#ifndef EVENT_LOG_UPLOAD_LEVEL
+#define EVENT_LOG_UPLOAD_LEVEL      ESP_LOG_WARN    ///< Included in diagnostics uploads
+#endif
+#define EVENT_LOG_UPLOAD_MAX        16      ///< Records per diagnostics upload
+
+#define EVENT_LOG_DRAIN_MS          500
+#define EVENT_LOG_TASK_PRIORITY     0       ///< Idle priority: prints only while everything else waits
+#define EVENT_LOG_TASK_CORE         1
+#define EVENT_LOG_TASK_STACK_SIZE   3072
+
+/**
+ * @brief One deferred log line
+ */
+typedef struct {
+    const char *format;             ///< String literal, the format ID
+    const char *tag;
+    uint32_t timestamp_ms;          ///< esp_log_timestamp() at the call
+    uint8_t level;                  ///< esp_log_level_t
+    uint8_t arg_count;
+    uint32_t args[EVENT_LOG_MAX_ARGS];
+} event_log_record_t;
+
+/**
+ * @brief Records for one upload, see event_log_peek()
+ */
+typedef struct {
+    event_log_record_t records[EVENT_LOG_UPLOAD_MAX];
+    size_t count;
+    uint32_t lost;                  ///< Records (of any level) overwritten before upload
+    uint32_t next_seq;              ///< Where event_log_commit() resumes
+} event_log_excerpt_t;
+
+#if EVENT_LOG_PRODUCTION
+
+static inline uint32_t event_log_arg_int(uint32_t value)
+{
+    return value;
+}
+
+static inline uint32_t event_log_arg_float(double value)
+{
+    float f = (float)value;
+    uint32_t word;
+    memcpy(&word, &f, sizeof(word));
+    return word;
+}
+
+static inline uint32_t event_log_arg_string(const char *value)
+{
+    return (uint32_t)(uintptr_t)value;
+}
+
+// Selected for a 64-bit argument: a compile error rather than a silent truncation
+uint32_t event_log_64_bit_argument(uint64_t value)
+    __attribute__((error("EVENT_LOGx arguments are 32-bit, cast or use ESP_LOGx")));
+
+// Never called; lets the compiler check the format against the arguments
+static inline void __attribute__((format(printf, 1, 2))) event_log_check_format(const char *format, ...)
+{
+}
+
+#define EVENT_LOG_ARG(x) _Generic((x),                                  \
+    float: event_log_arg_float, double: event_log_arg_float,           \
+    char *: event_log_arg_string, const char *: event_log_arg_string,  \
+    long long: event_log_64_bit_argument,                              \
+    unsigned long long: event_log_64_bit_argument,                     \
+    default: event_log_arg_int)(x)
+
+#define EVENT_LOG_PACK0()
+#define EVENT_LOG_PACK1(a)              , EVENT_LOG_ARG(a)
+#define EVENT_LOG_PACK2(a, b)           EVENT_LOG_PACK1(a), EVENT_LOG_ARG(b)
+#define EVENT_LOG_PACK3(a, b, c)        EVENT_LOG_PACK2(a, b), EVENT_LOG_ARG(c)
+#define EVENT_LOG_PACK4(a, b, c, d)     EVENT_LOG_PACK3(a, b, c), EVENT_LOG_ARG(d)
+#define EVENT_LOG_PACK_SELECT(_0, _1, _2, _3, _4, _5, pack, ...) pack
+#define EVENT_LOG_PACK(...)                                             \
+    EVENT_LOG_PACK_SELECT(_0, ##__VA_ARGS__, EVENT_LOG_TOO_MANY_ARGUMENTS, \
+                          EVENT_LOG_PACK4, EVENT_LOG_PACK3, EVENT_LOG_PACK2, \
+                          EVENT_LOG_PACK1, EVENT_LOG_PACK0)(__VA_ARGS__)
+
+#define EVENT_LOG(level, tag, format, ...) do {                                         \
+        if (0) event_log_check_format(format, ##__VA_ARGS__);                          \
+        const uint32_t event_log_args_[] = { 0 EVENT_LOG_PACK(__VA_ARGS__) };          \
+        event_log_write((level), (tag), (format), &event_log_args_[1],                 \
+                        sizeof(event_log_args_) / sizeof(event_log_args_[0]) - 1);     \
+    } while (0)
+
+// Checked like a record, never evaluated, so its arguments count as used
+#define EVENT_LOG_BANNER(tag, format, ...) do {                                         \
+        if (0) event_log_check_format(format, ##__VA_ARGS__);                          \
+    } while (0)
+
+#else
+
+#define EVENT_LOG(level, tag, format, ...)  ESP_LOG_LEVEL_LOCAL(level, tag, format, ##__VA_ARGS__)
+#define EVENT_LOG_BANNER(tag, format, ...)  ESP_LOGI(tag, format, ##__VA_ARGS__)
+
+#endif // EVENT_LOG_PRODUCTION
+
+#define EVENT_LOGE(tag, format, ...)    EVENT_LOG(ESP_LOG_ERROR, tag, format, ##__VA_ARGS__)
+#define EVENT_LOGW(tag, format, ...)    EVENT_LOG(ESP_LOG_WARN, tag, format, ##__VA_ARGS__)
+#define EVENT_LOGI(tag, format, ...)    EVENT_LOG(ESP_LOG_INFO, tag, format, ##__VA_ARGS__)
+
+/**
+ * @brief Store one record; use the EVENT_LOGx macros instead
+ */
+void event_log_write(esp_log_level_t level, const char *tag, const char *format,
+                     const uint32_t *args, size_t arg_count);
+
+/**
+ * @brief Start the drain task (core 1, EVENT_LOG_TASK_PRIORITY)
+ *
+ * Records written before the start stay in the ring until then.
+ *
+ * @return ESP_OK (also in development builds, where there is no task)
+ * @return ESP_ERR_NO_MEM if the task could not be created
+ */
+esp_err_t event_log_start(void);
+
+/**
+ * @brief Print every pending record now, on the calling task
+ *
+ * For the last lines before a restart or deep sleep. Does nothing in
+ * development builds.
+ */
+void event_log_drain(void);
+
+/**
+ * @brief Format a record's message (without level and tag)
+ *
+ * @return Length written, at most size - 1
+ */
+size_t event_log_format(const event_log_record_t *record, char *buffer, size_t size);
+
+/**
+ * @brief Copy the oldest unsent records at EVENT_LOG_UPLOAD_LEVEL or above
+ *
+ * Two-phase like sample_ring: the records stay pending until
+ * event_log_commit() after a successful upload.
+ *
+ * @return Records copied; always 0 in development builds
+ */
+size_t event_log_peek(event_log_excerpt_t *excerpt);
+
+/**
+ * @brief Mark the records of an excerpt as uploaded
+ */
+void event_log_commit(const event_log_excerpt_t *excerpt);
+
+/**
+ * @brief One-letter level name ("E", "W", "I", ...)
+ */
+const char *event_log_level_name(esp_log_level_t level);
+
+#endif // EVENT_LOG_H
@@ -0,0 +1,335 @@
+/**
+ * @file ota_image.c
+ * @brief Firmware container decoder, see ota_image.h
+ *
+ * Two stages run on every fed piece: tinfl inflates into the circular
+ * 32 KB window, and each run of new window bytes goes to emit(). For FULL
+ * images emit() writes it straight to the sink; for DELTA images it drives
+ * the operation parser, which keeps its partial state (an operation header
+ * split across pieces, the remaining length of the current operation)
+ * between calls.
+ */
+
+#include "ota_image.h"
+#include "rom/miniz.h"
+#include "esp_log.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "OTA_IMAGE";
+
+#define OTA_IMAGE_BASE_CHUNK    512     ///< Base bytes read per COPY/ADD step
+
+typedef enum {
+    OP_END = 0x00,
+    OP_COPY = 0x01,
+    OP_ADD = 0x02,
+    OP_INSERT = 0x03,
+    OP_NONE = 0xFF,     ///< Between operations: the next byte starts a header
+} delta_op_t;
+
+struct ota_image_decoder {
+    ota_image_header_t header;
+    ota_image_sink_t sink;
+    tinfl_decompressor inflator;
+    uint8_t *window;                ///< TINFL_LZ_DICT_SIZE bytes
+    size_t window_pos;
+    bool stream_done;
+    uint32_t written;
+
+    // DELTA operation parser
+    uint8_t op;                     ///< delta_op_t of the running operation
+    uint8_t op_header[9];
+    size_t op_header_length;
+    uint32_t op_offset;             ///< Next base offset (COPY, ADD)
+    uint32_t op_remaining;          ///< Bytes left in the running operation
+    bool ops_done;
+    uint8_t base[OTA_IMAGE_BASE_CHUNK];
+};
+
+static inline uint32_t read_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+esp_err_t ota_image_parse_header(const uint8_t *data, size_t length, ota_image_header_t *header)
+{
+    if (length < OTA_IMAGE_HEADER_SIZE)
+    {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    if (read_u32(&data[0]) != OTA_IMAGE_MAGIC || data[4] != OTA_IMAGE_FORMAT ||
+        (data[5] != OTA_IMAGE_FULL && data[5] != OTA_IMAGE_DELTA))
+    {
+        return ESP_ERR_INVALID_VERSION;
+    }
+
+    header->kind = (ota_image_kind_t)data[5];
+    header->image_size = read_u32(&data[8]);
+    header->payload_size = read_u32(&data[12]);
+    memcpy(header->target_sha256, &data[16], OTA_IMAGE_SHA256_SIZE);
+    memcpy(header->base_sha256, &data[48], OTA_IMAGE_SHA256_SIZE);
+    return ESP_OK;
+}
+
+esp_err_t ota_image_decoder_create(const ota_image_header_t *header, const ota_image_sink_t *sink,
+                                   ota_image_decoder_t **decoder)
+{
+    ota_image_decoder_t *d = calloc(1, sizeof(*d));
+    uint8_t *window = malloc(TINFL_LZ_DICT_SIZE);
+    if (d == NULL || window == NULL)
+    {
+        free(d);
+        free(window);
+        return ESP_ERR_NO_MEM;
+    }
+
+    d->header = *header;
+    d->sink = *sink;
+    d->window = window;
+    d->op = OP_NONE;
+    tinfl_init(&d->inflator);
+    *decoder = d;
+    return ESP_OK;
+}
+
+void ota_image_decoder_free(ota_image_decoder_t *decoder)
+{
+    if (decoder != NULL)
+    {
+        free(decoder->window);
+        free(decoder);
+    }
+}
+
+static esp_err_t write_image(ota_image_decoder_t *d, const uint8_t *data, size_t length)
+{
+    if (length > d->header.image_size - d->written)
+    {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    esp_err_t ret = d->sink.write(d->sink.ctx, data, length);
+    if (ret == ESP_OK)
+    {
+        d->written += length;
+    }
+    return ret;
+}
+
+static bool base_range_valid(const ota_image_decoder_t *d, uint32_t offset, uint32_t length)
+{
+    return length <= d->sink.base_size && offset <= d->sink.base_size - length;
+}
+
+// Header bytes of an operation, including the op byte; 0 for an unknown op
+static size_t op_header_size(uint8_t op)
+{
+    switch (op)
+    {
+        case OP_END:    return 1;
+        case OP_COPY:   return 9;
+        case OP_ADD:    return 9;
+        case OP_INSERT: return 5;
+        default:        return 0;
+    }
+}
+
+static esp_err_t copy_base(ota_image_decoder_t *d, uint32_t offset, uint32_t length)
+{
+    while (length > 0)
+    {
+        size_t n = (length < sizeof(d->base)) ? length : sizeof(d->base);
+        esp_err_t ret = d->sink.read_base(d->sink.ctx, offset, d->base, n);
+        if (ret == ESP_OK)
+        {
+            ret = write_image(d, d->base, n);
+        }
+        if (ret != ESP_OK)
+        {
+            return ret;
+        }
+        offset += n;
+        length -= n;
+    }
+    return ESP_OK;
+}
+
+// A complete operation header is in op_header: start the operation
+static esp_err_t begin_op(ota_image_decoder_t *d)
+{
+    const uint8_t *h = d->op_header;
+    d->op_header_length = 0;
+
+    switch (h[0])
+    {
+        case OP_END:
+            d->ops_done = true;
+            return ESP_OK;
+
+        case OP_COPY:
+        case OP_ADD:
+            d->op_offset = read_u32(&h[1]);
+            d->op_remaining = read_u32(&h[5]);
+            if (!base_range_valid(d, d->op_offset, d->op_remaining))
+            {
+                ESP_LOGE(TAG, "Delta reads base 0x%lx+%lu beyond %lu bytes",
+                         (unsigned long)d->op_offset, (unsigned long)d->op_remaining,
+                         (unsigned long)d->sink.base_size);
+                return ESP_ERR_INVALID_ARG;
+            }
+            if (h[0] == OP_COPY)
+            {
+                // Carries no stream data; done right here
+                return copy_base(d, d->op_offset, d->op_remaining);
+            }
+            break;
+
+        case OP_INSERT:
+            d->op_remaining = read_u32(&h[1]);
+            break;
+    }
+
+    if (d->op_remaining > 0)
+    {
+        d->op = h[0];
+    }
+    return ESP_OK;
+}
+
+static esp_err_t delta_consume(ota_image_decoder_t *d, const uint8_t *data, size_t length)
+{
+    while (length > 0)
+    {
+        if (d->ops_done)
+        {
+            return ESP_ERR_INVALID_SIZE;    // Operations after END
+        }
+
+        if (d->op == OP_NONE)
+        {
+            d->op_header[d->op_header_length++] = *data++;
+            length--;
+            size_t needed = op_header_size(d->op_header[0]);
+            if (needed == 0)
+            {
+                ESP_LOGE(TAG, "Unknown delta operation 0x%02x", d->op_header[0]);
+                return ESP_ERR_INVALID_ARG;
+            }
+            if (d->op_header_length == needed)
+            {
+                esp_err_t ret = begin_op(d);
+                if (ret != ESP_OK)
+                {
+                    return ret;
+                }
+            }
+            continue;
+        }
+
+        size_t n = (length < d->op_remaining) ? length : d->op_remaining;
+        esp_err_t ret;
+        if (d->op == OP_ADD)
+        {
+            if (n > sizeof(d->base))
+            {
+                n = sizeof(d->base);
+            }
+            ret = d->sink.read_base(d->sink.ctx, d->op_offset, d->base, n);
+            if (ret == ESP_OK)
+            {
+                for (size_t i = 0; i < n; i++)
+                {
+                    d->base[i] += data[i];
+                }
+                ret = write_image(d, d->base, n);
+            }
+            d->op_offset += n;
+        }
+        else
+        {
+            ret = write_image(d, data, n);
+        }
+        if (ret != ESP_OK)
+        {
+            return ret;
+        }
+
+        data += n;
+        length -= n;
+        d->op_remaining -= n;
+        if (d->op_remaining == 0)
+        {
+            d->op = OP_NONE;
+        }
+    }
+    return ESP_OK;
+}
+
+static esp_err_t emit(ota_image_decoder_t *d, const uint8_t *data, size_t length)
+{
+    if (d->header.kind == OTA_IMAGE_FULL)
+    {
+        return write_image(d, data, length);
+    }
+    return delta_consume(d, data, length);
+}
+
+esp_err_t ota_image_decoder_feed(ota_image_decoder_t *d, const uint8_t *data, size_t length)
+{
+    while (length > 0 || !d->stream_done)
+    {
+        if (d->stream_done)
+        {
+            return ESP_ERR_INVALID_SIZE;    // Bytes after the end of the zlib stream
+        }
+
+        size_t in_bytes = length;
+        size_t out_bytes = TINFL_LZ_DICT_SIZE - d->window_pos;
+        tinfl_status status = tinfl_decompress(&d->inflator, data, &in_bytes, d->window,
+                                               d->window + d->window_pos, &out_bytes,
+                                               TINFL_FLAG_PARSE_ZLIB_HEADER | TINFL_FLAG_HAS_MORE_INPUT);
+        data += in_bytes;
+        length -= in_bytes;
+
+        if (out_bytes > 0)
+        {
+            esp_err_t ret = emit(d, d->window + d->window_pos, out_bytes);
+            if (ret != ESP_OK)
+            {
+                return ret;
+            }
+            d->window_pos = (d->window_pos + out_bytes) & (TINFL_LZ_DICT_SIZE - 1);
+        }
+
+        if (status < TINFL_STATUS_DONE)
+        {
+            ESP_LOGE(TAG, "Corrupt image stream (tinfl status %d)", (int)status);
+            return ESP_ERR_INVALID_CRC;
+        }
+        if (status == TINFL_STATUS_DONE)
+        {
+            d->stream_done = true;
+        }
+        else if (status == TINFL_STATUS_NEEDS_MORE_INPUT && length == 0)
+        {
+            break;
+        }
+        // HAS_MORE_OUTPUT: the window wrapped, go round again
+    }
+    return ESP_OK;
+}
+
+esp_err_t ota_image_decoder_finish(ota_image_decoder_t *d)
+{
+    bool complete = d->stream_done && d->written == d->header.image_size &&
+                    (d->header.kind == OTA_IMAGE_FULL || (d->ops_done && d->op == OP_NONE));
+    if (!complete)
+    {
+        ESP_LOGE(TAG, "Image incomplete: stream %s, %lu of %lu bytes",
+                 d->stream_done ? "ended" : "cut short", (unsigned long)d->written,
+                 (unsigned long)d->header.image_size);
+        return ESP_ERR_INVALID_SIZE;
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,125 @@
+#ifndef OTA_IMAGE_H
+#define OTA_IMAGE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+/**
+ * @file ota_image.h
+ * @brief Streaming decoder for compressed and delta firmware images
+ *
+ * Firmware is distributed in a small container built by ota_image.py:
+ *
+ *   header (80 bytes, little-endian) | zlib stream (payload_size bytes)
+ *
+ * FULL images carry the application image itself, zlib-compressed. DELTA
+ * images carry a zlib-compressed list of operations that rebuild the new
+ * image from the one running now (base_sha256):
+ *
+ *   0x01 COPY    u32 base_offset, u32 length     base bytes unchanged
+ *   0x02 ADD     u32 base_offset, u32 length,    base bytes plus the
+ *                length diff bytes                following bytes (mod 256)
+ *   0x03 INSERT  u32 length, length bytes        new bytes
+ *   0x00 END
+ *
+ * ADD covers code that only moved: most diff bytes are zero, which the
+ * zlib layer squeezes out. Both digests are the image SHA-256 that
+ * esp_partition_get_sha256() reports for an app partition, so the device
+ * can tell from the header alone whether it already runs the image or can
+ * apply the delta.
+ *
+ * The zlib stream is inflated with the miniz tinfl decoder in ROM through
+ * a 32 KB window. Output is handed to the sink in pieces as it appears;
+ * nothing is ever buffered whole.
+ */
+
+#define OTA_IMAGE_MAGIC         0x544F4D48u     ///< "HMOT"
+#define OTA_IMAGE_FORMAT        1
+#define OTA_IMAGE_HEADER_SIZE   80
+#define OTA_IMAGE_SHA256_SIZE   32
+
+typedef enum {
+    OTA_IMAGE_FULL = 0,
+    OTA_IMAGE_DELTA = 1,
+} ota_image_kind_t;
+
+typedef struct {
+    ota_image_kind_t kind;
+    uint32_t image_size;                        ///< Bytes of the rebuilt application image
+    uint32_t payload_size;                      ///< Bytes of zlib stream after the header
+    uint8_t target_sha256[OTA_IMAGE_SHA256_SIZE];
+    uint8_t base_sha256[OTA_IMAGE_SHA256_SIZE]; ///< DELTA only, zero for FULL
+} ota_image_header_t;
+
+/**
+ * @brief Where decoded image bytes go and where a delta reads its base
+ */
+typedef struct {
+    /**
+     * @brief Append image bytes, in order
+     */
+    esp_err_t (*write)(void *ctx, const uint8_t *data, size_t length);
+
+    /**
+     * @brief Read bytes of the base image (DELTA only)
+     */
+    esp_err_t (*read_base)(void *ctx, uint32_t offset, uint8_t *data, size_t length);
+
+    uint32_t base_size;     ///< Readable bytes of the base; larger offsets are rejected
+    void *ctx;
+} ota_image_sink_t;
+
+typedef struct ota_image_decoder ota_image_decoder_t;
+
+/**
+ * @brief Parse and check a container header
+ *
+ * @param data   At least OTA_IMAGE_HEADER_SIZE bytes
+ * @param header Receives the parsed header
+ * @return ESP_OK on success
+ * @return ESP_ERR_INVALID_SIZE if fewer than OTA_IMAGE_HEADER_SIZE bytes are given
+ * @return ESP_ERR_INVALID_VERSION for a wrong magic, format or kind
+ */
+esp_err_t ota_image_parse_header(const uint8_t *data, size_t length, ota_image_header_t *header);
+
+/**
+ * @brief Allocate a decoder (~44 KB, tinfl state and window) for the payload
+ *
+ * @param header Parsed header of the image (copied)
+ * @param sink   Output and base access (copied)
+ * @return ESP_OK, or ESP_ERR_NO_MEM
+ */
+esp_err_t ota_image_decoder_create(const ota_image_header_t *header, const ota_image_sink_t *sink,
+                                   ota_image_decoder_t **decoder);
+
+/**
+ * @brief Decode the next piece of the payload (everything after the header)
+ *
+ * Pieces may be of any size and split anywhere.
+ *
+ * @return ESP_OK if the piece was consumed
+ * @return ESP_ERR_INVALID_CRC if the zlib stream is corrupt
+ * @return ESP_ERR_INVALID_ARG for a malformed operation or a base range
+ *         outside base_size
+ * @return ESP_ERR_INVALID_SIZE if the output outgrows image_size or data
+ *         follows the end of the stream
+ * @return The sink's error otherwise
+ */
+esp_err_t ota_image_decoder_feed(ota_image_decoder_t *decoder, const uint8_t *data, size_t length);
+
+/**
+ * @brief Check that the payload was complete
+ *
+ * @return ESP_OK if the stream (and for DELTA the operation list) ended and
+ *         exactly image_size bytes were written
+ * @return ESP_ERR_INVALID_SIZE otherwise
+ */
+esp_err_t ota_image_decoder_finish(ota_image_decoder_t *decoder);
+
+/**
+ * @brief Release a decoder; NULL is ignored
+ */
+void ota_image_decoder_free(ota_image_decoder_t *decoder);
+
+#endif // OTA_IMAGE_H
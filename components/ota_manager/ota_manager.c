@@ -0,0 +1,671 @@
+/**
+ * @file ota_manager.c
+ * @brief Background firmware updates with health-checked rollback, see ota_manager.h
+ *
+ * The update task sleeps on its notification bits (OTA_EVENT_*). Every
+ * check reads firmware_url from the configuration and runs one download:
+ * header first, then the payload through ota_image into the inactive
+ * slot. A failed download is retried up to OTA_MAX_ATTEMPTS times until
+ * the configuration changes again. Decoded bytes are collected into a
+ * sector buffer so that each flash access is one sector in one
+ * sensor-free window.
+ *
+ * Confirmation and rollback of a pending image also run in this task
+ * (the health timer only raises a bit), because both write otadata.
+ * The health timer ticks every OTA_HEALTH_POLL_MS and only counts the
+ * ticks with the WiFi link up towards OTA_HEALTH_TIMEOUT_MS.
+ */
+
+#include "ota_manager.h"
+#include "ota_image.h"
+#include "device_config.h"
+#include "sensor_scheduler.h"
+#include "wifi_manager.h"
+#include "esp_ota_ops.h"
+#include "esp_app_desc.h"
+#include "esp_partition.h"
+#include "esp_http_client.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char *TAG = "OTA_MANAGER";
+
+#define OTA_SECTOR_SIZE             4096
+
+#define OTA_EVENT_CHECK             (1u << 0)   ///< Configuration changed
+#define OTA_EVENT_HEALTHY           (1u << 1)   ///< Every health check passed
+#define OTA_EVENT_HEALTH_TIMEOUT    (1u << 2)   ///< OTA_HEALTH_TIMEOUT_MS or OTA_HEALTH_MAX_WAIT_MS ran out
+
+#define OTA_HTTPS_PREFIX            "https://"
+
+#ifndef OTA_SERVER_CERT_EMBEDDED
+#define OTA_SERVER_CERT_EMBEDDED    0       ///< Set by CMakeLists.txt when ota_server_cert.pem exists
+#endif
+
+#if OTA_SERVER_CERT_EMBEDDED
+extern const char server_cert_pem[] asm("_binary_ota_server_cert_pem_start");
+#else
+static const char *const server_cert_pem = NULL;
+#endif
+
+typedef enum {
+    UPDATE_INSTALLED,       ///< New image verified and set as boot partition
+    UPDATE_SKIPPED,         ///< Nothing to do for this URL (already running, rejected, wrong base)
+    UPDATE_FAILED,          ///< Network, flash or image error; worth another attempt
+} update_result_t;
+
+/**
+ * @brief State of one download into the update partition
+ */
+typedef struct {
+    esp_ota_handle_t handle;
+    uint8_t *sector;            ///< OTA_SECTOR_SIZE bytes collected for the next write
+    size_t fill;
+} ota_session_t;
+
+static const esp_partition_t *running_partition = NULL;
+static const esp_partition_t *update_partition = NULL;
+static volatile bool pending_verify = false;    ///< Running image not confirmed yet
+static uint32_t health_passed = 0;              ///< OTA_HEALTH_* bits, atomic
+static volatile bool update_ready = false;
+static TaskHandle_t ota_task = NULL;
+static esp_timer_handle_t health_timer = NULL;
+
+// Health timer callback only
+static uint32_t health_link_up_ms = 0;
+static uint32_t health_waited_ms = 0;
+
+// Update task only
+static uint8_t running_sha256[OTA_IMAGE_SHA256_SIZE];
+static bool running_sha256_known = false;
+static char attempted_url[DEVICE_CONFIG_URL_SIZE];
+static uint32_t attempts = 0;           ///< Failed attempts since the last configuration change
+
+// ============================================================================
+// Flash access
+// ============================================================================
+
+/**
+ * @brief Wait until no sensor conversion starts for OTA_FLASH_GUARD_MS
+ *
+ * A conversion is only a few tens of milliseconds in a period of seconds,
+ * so this rarely waits at all.
+ */
+static void wait_flash_window(void)
+{
+    while (sensor_scheduler_idle_ms() < OTA_FLASH_GUARD_MS)
+    {
+        vTaskDelay(pdMS_TO_TICKS(OTA_FLASH_GUARD_POLL_MS));
+    }
+}
+
+static esp_err_t flush_sector(ota_session_t *session)
+{
+    if (session->fill == 0)
+    {
+        return ESP_OK;
+    }
+    wait_flash_window();
+    esp_err_t ret = esp_ota_write(session->handle, session->sector, session->fill);
+    session->fill = 0;
+    return ret;
+}
+
+static esp_err_t session_write(void *ctx, const uint8_t *data, size_t length)
+{
+    ota_session_t *session = ctx;
+    while (length > 0)
+    {
+        size_t n = OTA_SECTOR_SIZE - session->fill;
+        if (n > length)
+        {
+            n = length;
+        }
+        memcpy(session->sector + session->fill, data, n);
+        session->fill += n;
+        data += n;
+        length -= n;
+
+        if (session->fill == OTA_SECTOR_SIZE)
+        {
+            esp_err_t ret = flush_sector(session);
+            if (ret != ESP_OK)
+            {
+                return ret;
+            }
+        }
+    }
+    return ESP_OK;
+}
+
+static esp_err_t session_read_base(void *ctx, uint32_t offset, uint8_t *data, size_t length)
+{
+    wait_flash_window();
+    return esp_partition_read(running_partition, offset, data, length);
+}
+
+// ============================================================================
+// Confirmation and rollback
+// ============================================================================
+
+static void confirm_running_image(void)
+{
+    wait_flash_window();
+    esp_err_t ret = esp_ota_mark_app_valid_cancel_rollback();
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Could not confirm the running image: %s", esp_err_to_name(ret));
+        return;
+    }
+    pending_verify = false;
+    if (health_timer != NULL)
+    {
+        esp_timer_stop(health_timer);
+    }
+    ESP_LOGI(TAG, "Running image passed its health checks - confirmed");
+}
+
+static void roll_back(void)
+{
+    uint32_t passed = __atomic_load_n(&health_passed, __ATOMIC_ACQUIRE);
+    ESP_LOGE(TAG, "Running image failed its health checks (reading %s, upload %s, link up %lu of %lu min) - rolling back",
+             (passed & OTA_HEALTH_READING) ? "ok" : "missing",
+             (passed & OTA_HEALTH_UPLOAD) ? "ok" : "missing",
+             (unsigned long)(health_link_up_ms / 60000), (unsigned long)(health_waited_ms / 60000));
+    wait_flash_window();
+    esp_err_t ret = esp_ota_mark_app_invalid_rollback_and_reboot();    // Returns only on failure
+    ESP_LOGE(TAG, "Rollback failed: %s", esp_err_to_name(ret));
+}
+
+/**
+ * @brief Health timer tick: the deadline only advances while the link is up
+ *
+ * A good image cannot get an upload accepted while the access point is
+ * down, so that time does not count. OTA_HEALTH_MAX_WAIT_MS still rolls
+ * back an image that never brings the link up at all.
+ */
+static void health_tick(void *arg)
+{
+    health_waited_ms += OTA_HEALTH_POLL_MS;
+    if (wifi_manager_is_ready())
+    {
+        health_link_up_ms += OTA_HEALTH_POLL_MS;
+    }
+    if (health_link_up_ms >= OTA_HEALTH_TIMEOUT_MS || health_waited_ms >= OTA_HEALTH_MAX_WAIT_MS)
+    {
+        esp_timer_stop(health_timer);
+        xTaskNotify(ota_task, OTA_EVENT_HEALTH_TIMEOUT, eSetBits);
+    }
+}
+
+// ============================================================================
+// Download
+// ============================================================================
+
+// Images that were rolled back before are not installed again
+static bool is_rejected(const uint8_t *sha256)
+{
+    const esp_partition_t *invalid = esp_ota_get_last_invalid_partition();
+    uint8_t invalid_sha256[OTA_IMAGE_SHA256_SIZE];
+    return invalid != NULL && esp_partition_get_sha256(invalid, invalid_sha256) == ESP_OK &&
+           memcmp(invalid_sha256, sha256, sizeof(invalid_sha256)) == 0;
+}
+
+static esp_err_t read_exactly(esp_http_client_handle_t client, uint8_t *data, size_t length)
+{
+    while (length > 0)
+    {
+        int n = esp_http_client_read(client, (char *)data, (int)length);
+        if (n <= 0)
+        {
+            return ESP_ERR_TIMEOUT;
+        }
+        data += n;
+        length -= (size_t)n;
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Keep the average download rate at OTA_DOWNLOAD_RATE_BYTES_PER_S
+ */
+static void throttle(TickType_t started, uint32_t received)
+{
+    TickType_t due = started + pdMS_TO_TICKS((uint64_t)received * 1000 / OTA_DOWNLOAD_RATE_BYTES_PER_S);
+    TickType_t now = xTaskGetTickCount();
+    if ((int32_t)(due - now) > 0)
+    {
+        vTaskDelay(due - now);
+    }
+}
+
+/**
+ * @brief Decide from the header whether this image should be installed
+ */
+static bool wanted(const ota_image_header_t *header)
+{
+    if (memcmp(header->target_sha256, running_sha256, OTA_IMAGE_SHA256_SIZE) == 0)
+    {
+        ESP_LOGI(TAG, "Firmware at %s is already running", attempted_url);
+        return false;
+    }
+    if (is_rejected(header->target_sha256))
+    {
+        ESP_LOGW(TAG, "Firmware at %s was rolled back before - not installing it again",
+                 attempted_url);
+        return false;
+    }
+    if (header->kind == OTA_IMAGE_DELTA &&
+        memcmp(header->base_sha256, running_sha256, OTA_IMAGE_SHA256_SIZE) != 0)
+    {
+        ESP_LOGW(TAG, "Delta image at %s was built for different firmware", attempted_url);
+        return false;
+    }
+    if (header->image_size > update_partition->size)
+    {
+        ESP_LOGE(TAG, "Image of %lu bytes does not fit the %lu byte partition",
+                 (unsigned long)header->image_size, (unsigned long)update_partition->size);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Stream the payload into the update partition and verify it
+ */
+static update_result_t install(esp_http_client_handle_t client, const ota_image_header_t *header)
+{
+    static uint8_t chunk[OTA_DOWNLOAD_CHUNK_SIZE];
+    ota_session_t session = { 0 };
+    ota_image_decoder_t *decoder = NULL;
+
+    const ota_image_sink_t sink = {
+        .write = session_write,
+        .read_base = session_read_base,
+        .base_size = running_partition->size,
+        .ctx = &session,
+    };
+    session.sector = malloc(OTA_SECTOR_SIZE);
+    esp_err_t ret = (session.sector != NULL) ? ota_image_decoder_create(header, &sink, &decoder)
+                                             : ESP_ERR_NO_MEM;
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "No memory for the image decoder");
+        free(session.sector);
+        return UPDATE_FAILED;
+    }
+
+    // Sequential writes: each sector is erased when the write reaches it,
+    // instead of the whole partition (seconds of stalled cache) up front
+    wait_flash_window();
+    ret = esp_ota_begin(update_partition, OTA_WITH_SEQUENTIAL_WRITES, &session.handle);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "esp_ota_begin failed: %s", esp_err_to_name(ret));
+        ota_image_decoder_free(decoder);
+        free(session.sector);
+        return UPDATE_FAILED;
+    }
+
+    ESP_LOGI(TAG, "Downloading %s image (%lu bytes, %lu compressed) into %s",
+             (header->kind == OTA_IMAGE_DELTA) ? "delta" : "full",
+             (unsigned long)header->image_size, (unsigned long)header->payload_size,
+             update_partition->label);
+    TickType_t started = xTaskGetTickCount();
+    uint32_t received = 0;
+    uint32_t next_progress = header->payload_size / 4;
+
+    while (ret == ESP_OK && received < header->payload_size)
+    {
+        size_t want = header->payload_size - received;
+        if (want > sizeof(chunk))
+        {
+            want = sizeof(chunk);
+        }
+        int n = esp_http_client_read(client, (char *)chunk, (int)want);
+        if (n <= 0)
+        {
+            ESP_LOGW(TAG, "Download stalled after %lu bytes", (unsigned long)received);
+            ret = ESP_ERR_TIMEOUT;
+            break;
+        }
+        ret = ota_image_decoder_feed(decoder, chunk, (size_t)n);
+        received += (uint32_t)n;
+
+        if (received >= next_progress && received < header->payload_size)
+        {
+            ESP_LOGI(TAG, "Downloaded %lu%%", (unsigned long)((uint64_t)received * 100 / header->payload_size));
+            next_progress += header->payload_size / 4;
+        }
+        throttle(started, received);
+    }
+
+    if (ret == ESP_OK)
+    {
+        ret = ota_image_decoder_finish(decoder);
+    }
+    if (ret == ESP_OK)
+    {
+        ret = flush_sector(&session);
+    }
+    ota_image_decoder_free(decoder);
+    free(session.sector);
+
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Update aborted: %s", esp_err_to_name(ret));
+        esp_ota_abort(session.handle);
+        return UPDATE_FAILED;
+    }
+
+    // Validates the image structure and its appended digest
+    ret = esp_ota_end(session.handle);
+    uint8_t written_sha256[OTA_IMAGE_SHA256_SIZE];
+    if (ret == ESP_OK &&
+        (esp_partition_get_sha256(update_partition, written_sha256) != ESP_OK ||
+         memcmp(written_sha256, header->target_sha256, sizeof(written_sha256)) != 0))
+    {
+        ret = ESP_ERR_INVALID_CRC;  // A delta rebuilt some other image
+    }
+    if (ret == ESP_OK)
+    {
+        wait_flash_window();
+        ret = esp_ota_set_boot_partition(update_partition);
+    }
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Downloaded image rejected: %s", esp_err_to_name(ret));
+        return UPDATE_FAILED;
+    }
+
+    esp_app_desc_t desc;
+    if (esp_ota_get_partition_description(update_partition, &desc) == ESP_OK)
+    {
+        ESP_LOGI(TAG, "Firmware %s installed in %lu s - restarting after the next upload",
+                 desc.version, (unsigned long)(pdTICKS_TO_MS(xTaskGetTickCount() - started) / 1000));
+    }
+    return UPDATE_INSTALLED;
+}
+
+static update_result_t download(const char *url)
+{
+    esp_http_client_config_t http_config = {
+        .url = url,
+        .method = HTTP_METHOD_GET,
+        .timeout_ms = OTA_HTTP_TIMEOUT_MS,
+        .cert_pem = server_cert_pem,    // Pinned: no other server can hand out an image
+    };
+    esp_http_client_handle_t client = esp_http_client_init(&http_config);
+    if (client == NULL)
+    {
+        ESP_LOGE(TAG, "Invalid firmware URL %s", url);
+        return UPDATE_SKIPPED;
+    }
+    esp_http_client_set_header(client, "User-Agent", "ESP32-SensorMonitor/1.0");
+
+    update_result_t result = UPDATE_FAILED;
+    esp_err_t ret = esp_http_client_open(client, 0);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGW(TAG, "Firmware server unreachable: %s", esp_err_to_name(ret));
+        esp_http_client_cleanup(client);
+        return UPDATE_FAILED;
+    }
+
+    int64_t length = esp_http_client_fetch_headers(client);
+    int status = esp_http_client_get_status_code(client);
+    uint8_t header_bytes[OTA_IMAGE_HEADER_SIZE];
+    ota_image_header_t header;
+    if (status != 200)
+    {
+        ESP_LOGW(TAG, "Firmware download answered HTTP %d", status);
+    }
+    else if (read_exactly(client, header_bytes, sizeof(header_bytes)) != ESP_OK)
+    {
+        ESP_LOGW(TAG, "Firmware header not received");
+    }
+    else if (ota_image_parse_header(header_bytes, sizeof(header_bytes), &header) != ESP_OK)
+    {
+        ESP_LOGE(TAG, "%s is not a firmware image for this device", url);
+        result = UPDATE_SKIPPED;
+    }
+    else if (length > 0 && length != OTA_IMAGE_HEADER_SIZE + (int64_t)header.payload_size)
+    {
+        ESP_LOGE(TAG, "Firmware image truncated: %lld of %lu bytes", length,
+                 (unsigned long)(OTA_IMAGE_HEADER_SIZE + header.payload_size));
+    }
+    else if (!wanted(&header))
+    {
+        result = UPDATE_SKIPPED;
+    }
+    else
+    {
+        result = install(client, &header);
+    }
+
+    esp_http_client_close(client);
+    esp_http_client_cleanup(client);
+    return result;
+}
+
+/**
+ * @brief Run one update attempt for the configured firmware URL
+ *
+ * @return Delay until the next attempt (ms), 0 if none is needed
+ */
+static uint32_t update_from_config(void)
+{
+    static device_config_t config;
+    device_config_get(&config);
+
+    if (config.firmware_url[0] == '\0' || attempts >= OTA_MAX_ATTEMPTS)
+    {
+        return 0;
+    }
+#if !OTA_SERVER_CERT_EMBEDDED
+    ESP_LOGW(TAG, "No firmware server certificate built in (ota_server_cert.pem) - not updating");
+    return 0;
+#endif
+    // The URL may come from an unauthenticated configuration push; only the
+    // pinned server's certificate makes it trustworthy
+    if (strncmp(config.firmware_url, OTA_HTTPS_PREFIX, strlen(OTA_HTTPS_PREFIX)) != 0)
+    {
+        ESP_LOGE(TAG, "Firmware URL %s is not %s - not updating", config.firmware_url, OTA_HTTPS_PREFIX);
+        return 0;
+    }
+    if (!wifi_manager_is_ready())
+    {
+        return OTA_LINK_POLL_MS;
+    }
+    memcpy(attempted_url, config.firmware_url, sizeof(attempted_url));
+
+    if (!running_sha256_known)
+    {
+        running_sha256_known = esp_partition_get_sha256(running_partition, running_sha256) == ESP_OK;
+        if (!running_sha256_known)
+        {
+            ESP_LOGE(TAG, "Cannot identify the running image - not updating");
+            return 0;
+        }
+    }
+
+    switch (download(attempted_url))
+    {
+        case UPDATE_INSTALLED:
+            update_ready = true;
+            return 0;
+
+        case UPDATE_SKIPPED:
+            return 0;
+
+        case UPDATE_FAILED:
+        default:
+            if (++attempts >= OTA_MAX_ATTEMPTS)
+            {
+                ESP_LOGE(TAG, "Giving up on %s after %d attempts", attempted_url, OTA_MAX_ATTEMPTS);
+                return 0;
+            }
+            ESP_LOGW(TAG, "Update attempt %lu failed - retrying in %d min",
+                     (unsigned long)attempts, OTA_RETRY_DELAY_MS / 60000);
+            return OTA_RETRY_DELAY_MS;
+    }
+}
+
+/**
+ * @brief Update task (core 1, OTA_TASK_PRIORITY)
+ *
+ * A pending image is never replaced before it is confirmed: checks that
+ * arrive meanwhile run right after the confirmation.
+ */
+static void ota_task_main(void *arg)
+{
+    bool check_due = false;
+    bool retry_scheduled = false;
+    TickType_t retry_at = 0;
+
+    while (1)
+    {
+        TickType_t wait = portMAX_DELAY;
+        if (retry_scheduled)
+        {
+            TickType_t now = xTaskGetTickCount();
+            wait = ((int32_t)(retry_at - now) > 0) ? retry_at - now : 0;
+        }
+
+        uint32_t events = 0;
+        xTaskNotifyWait(0, UINT32_MAX, &events, wait);
+
+        if ((events & OTA_EVENT_HEALTH_TIMEOUT) && pending_verify)
+        {
+            roll_back();
+        }
+        if ((events & OTA_EVENT_HEALTHY) && pending_verify)
+        {
+            confirm_running_image();
+        }
+        if (events & OTA_EVENT_CHECK)
+        {
+            // A push may have replaced the image behind the same URL
+            check_due = true;
+            attempts = 0;
+        }
+        if (retry_scheduled && (int32_t)(xTaskGetTickCount() - retry_at) >= 0)
+        {
+            retry_scheduled = false;
+            check_due = true;
+        }
+
+        if (!check_due || pending_verify || update_ready)
+        {
+            continue;
+        }
+        check_due = false;
+        uint32_t retry_ms = update_from_config();
+        retry_scheduled = (retry_ms > 0);
+        retry_at = xTaskGetTickCount() + pdMS_TO_TICKS(retry_ms);
+    }
+}
+
+// ============================================================================
+// Public API
+// ============================================================================
+
+esp_err_t ota_manager_init(void)
+{
+    running_partition = esp_ota_get_running_partition();
+    update_partition = esp_ota_get_next_update_partition(NULL);
+    if (running_partition == NULL || update_partition == NULL)
+    {
+        ESP_LOGW(TAG, "No second app partition - firmware updates disabled");
+        update_partition = NULL;
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    esp_ota_img_states_t state;
+    pending_verify = esp_ota_get_state_partition(running_partition, &state) == ESP_OK &&
+                     state == ESP_OTA_IMG_PENDING_VERIFY;
+
+    const esp_app_desc_t *desc = esp_app_get_description();
+    ESP_LOGI(TAG, "Running firmware %s from %s%s", desc->version, running_partition->label,
+             pending_verify ? " (new, pending health checks)" : "");
+    return ESP_OK;
+}
+
+esp_err_t ota_manager_start(void)
+{
+    if (update_partition == NULL)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (xTaskCreatePinnedToCore(ota_task_main, "ota", OTA_TASK_STACK_SIZE, NULL,
+                                OTA_TASK_PRIORITY, &ota_task, OTA_TASK_CORE) != pdPASS)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (pending_verify)
+    {
+        const esp_timer_create_args_t timer_args = {
+            .callback = health_tick,
+            .name = "ota_health",
+        };
+        if (esp_timer_create(&timer_args, &health_timer) != ESP_OK ||
+            esp_timer_start_periodic(health_timer, (uint64_t)OTA_HEALTH_POLL_MS * 1000) != ESP_OK)
+        {
+            return ESP_ERR_NO_MEM;
+        }
+        // Checks reported before the task existed
+        if (__atomic_load_n(&health_passed, __ATOMIC_ACQUIRE) == OTA_HEALTH_ALL)
+        {
+            xTaskNotify(ota_task, OTA_EVENT_HEALTHY, eSetBits);
+        }
+    }
+    return ESP_OK;
+}
+
+void ota_manager_check(void)
+{
+    if (ota_task != NULL)
+    {
+        xTaskNotify(ota_task, OTA_EVENT_CHECK, eSetBits);
+    }
+}
+
+void ota_manager_report_health(uint32_t checks)
+{
+    if (!pending_verify)
+    {
+        return;
+    }
+    uint32_t before = __atomic_fetch_or(&health_passed, checks, __ATOMIC_ACQ_REL);
+    if (before != OTA_HEALTH_ALL && (before | checks) == OTA_HEALTH_ALL && ota_task != NULL)
+    {
+        xTaskNotify(ota_task, OTA_EVENT_HEALTHY, eSetBits);
+    }
+}
+
+bool ota_manager_update_ready(void)
+{
+    return update_ready;
+}
+
+void ota_manager_settle(void)
+{
+    if (!pending_verify)
+    {
+        return;
+    }
+    if (__atomic_load_n(&health_passed, __ATOMIC_ACQUIRE) == OTA_HEALTH_ALL)
+    {
+        confirm_running_image();
+    }
+    else
+    {
+        roll_back();
+    }
+}
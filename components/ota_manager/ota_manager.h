@@ -0,0 +1,143 @@
+#ifndef OTA_MANAGER_H
+#define OTA_MANAGER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+/**
+ * @file ota_manager.h
+ * @brief Background firmware updates into the inactive app partition
+ *
+ * The partition table has two app slots (ota_0, ota_1). A unit runs from
+ * one and downloads into the other; the bootloader falls back to the old
+ * slot if the new image is not confirmed.
+ *
+ * Trigger:
+ * The firmware_url configuration field (device_config.h), usually pushed
+ * by the server. On every configuration change the update task fetches
+ * the container header (ota_image.h) from that URL and stops there if the
+ * image is already running, was rolled back before, or is a delta for a
+ * different base. Otherwise it streams the rest into the inactive slot.
+ *
+ * Trust:
+ * A configuration push is not authenticated and the container only
+ * carries the SHA-256 of its own image, so neither proves where an image
+ * came from. The download therefore only runs over https:// against the
+ * firmware server's certificate, pinned at build time from
+ * ota_server_cert.pem in the project directory (the server's self-signed
+ * certificate or its CA). Other schemes are refused; without the file
+ * the unit never downloads.
+ *
+ * Staying out of the way:
+ * - The task runs on core 1 below the WiFi task's priority, so uploads
+ *   preempt it, and never on the sensor core.
+ * - The download is throttled to OTA_DOWNLOAD_RATE_BYTES_PER_S; TCP flow
+ *   control slows the server down accordingly.
+ * - Flash erases and writes stall the cache of both cores, so every flash
+ *   access waits for a window of at least OTA_FLASH_GUARD_MS without a
+ *   sensor conversion (sensor_scheduler_idle_ms()). Writes are whole 4 KB
+ *   sectors: one erase and sixteen page programs per window.
+ * - Compressed and delta images are inflated on the fly; fewer bytes
+ *   cross the air, and only the sectors of the new image are written.
+ *
+ * Switch-over and rollback:
+ * A verified image becomes the boot partition, and the WiFi task restarts
+ * into it after its next upload pass (ota_manager_update_ready()). The new
+ * image boots as pending. It is confirmed once a sensor reading and an
+ * accepted upload have both been reported (ota_manager_report_health());
+ * if that does not happen within OTA_HEALTH_TIMEOUT_MS of WiFi link-up
+ * time, the unit marks it invalid and reboots into the previous image.
+ * Time with the link down does not count, so an access point outage does
+ * not roll back a good image; OTA_HEALTH_MAX_WAIT_MS bounds the wait for
+ * an image that never connects. Needs CONFIG_BOOTLOADER_APP_ROLLBACK_ENABLE.
+ *
+ * Deep-sleep builds confirm or roll back with ota_manager_settle() before
+ * every sleep; they do not download.
+ */
+
+#define OTA_TASK_PRIORITY               0       ///< Idle priority: runs only while the WiFi (1) and sensor (2) tasks wait
+#define OTA_TASK_CORE                   1
+#define OTA_TASK_STACK_SIZE             6144
+
+#ifndef OTA_DOWNLOAD_RATE_BYTES_PER_S
+#define OTA_DOWNLOAD_RATE_BYTES_PER_S   (16 * 1024)     ///< ~1 min for a compressed 1 MB image
+#endif
+#define OTA_DOWNLOAD_CHUNK_SIZE         1024    ///< Bytes read from the socket per step
+#define OTA_HTTP_TIMEOUT_MS             15000
+
+#define OTA_FLASH_GUARD_MS              250     ///< Sector erase worst case plus margin
+#define OTA_FLASH_GUARD_POLL_MS         20      ///< Recheck while a conversion runs
+
+#define OTA_RETRY_DELAY_MS              (10 * 60 * 1000)    ///< After a failed download
+#define OTA_LINK_POLL_MS                30000   ///< While WiFi is down
+#define OTA_MAX_ATTEMPTS                3       ///< Failed downloads per configuration change
+
+#ifndef OTA_HEALTH_TIMEOUT_MS
+#define OTA_HEALTH_TIMEOUT_MS           (10 * 60 * 1000)        ///< With the WiFi link up
+#endif
+#ifndef OTA_HEALTH_MAX_WAIT_MS
+#define OTA_HEALTH_MAX_WAIT_MS          (24 * 60 * 60 * 1000)   ///< In total, link up or not
+#endif
+#define OTA_HEALTH_POLL_MS              5000    ///< Link state sampling of the health timer
+
+/**
+ * @brief Health checks a pending image has to pass (ota_manager_report_health())
+ */
+#define OTA_HEALTH_READING              (1u << 0)   ///< A sensor reading was published
+#define OTA_HEALTH_UPLOAD               (1u << 1)   ///< The server accepted an upload
+#define OTA_HEALTH_ALL                  (OTA_HEALTH_READING | OTA_HEALTH_UPLOAD)
+
+/**
+ * @brief Find the running and update partitions and the image state
+ *
+ * Logs whether the running image is pending confirmation. Needed before
+ * any other call, in both power modes.
+ *
+ * @return ESP_OK on success
+ * @return ESP_ERR_NOT_FOUND if the partition table has no second app slot;
+ *         updates are disabled then, health reports are ignored
+ */
+esp_err_t ota_manager_init(void);
+
+/**
+ * @brief Start the update task and, for a pending image, the health timeout
+ *
+ * Continuous power mode only.
+ *
+ * @return ESP_OK on success
+ * @return ESP_ERR_INVALID_STATE if ota_manager_init() failed
+ * @return ESP_ERR_NO_MEM if the task or timer could not be created
+ */
+esp_err_t ota_manager_start(void);
+
+/**
+ * @brief The configuration changed; look at firmware_url again
+ *
+ * Called from the device_config listener. Never blocks.
+ */
+void ota_manager_check(void);
+
+/**
+ * @brief Record passed health checks of the running image
+ *
+ * Cheap when nothing is pending; safe from any task.
+ *
+ * @param checks OTA_HEALTH_* bits
+ */
+void ota_manager_report_health(uint32_t checks);
+
+/**
+ * @brief Whether a downloaded image is waiting for a restart
+ */
+bool ota_manager_update_ready(void);
+
+/**
+ * @brief Decide a pending image before the chip resets (deep sleep)
+ *
+ * Confirms it if every health check passed, otherwise rolls back and
+ * reboots (does not return then). Does nothing for a confirmed image.
+ */
+void ota_manager_settle(void);
+
+#endif // OTA_MANAGER_H
@@ -0,0 +1,281 @@
+/**
+ * @file perf_monitor.c
+ * @brief Stage histograms and resource watermarks, see perf_monitor.h
+ *
+ * Stage statistics live in one static table guarded by a single spinlock;
+ * a record touches four words and one bucket, so contention between the
+ * recording tasks is negligible. Stack and heap figures are not sampled in
+ * the background: they are read from FreeRTOS and the heap allocator when a
+ * snapshot is taken, and both already track their low-water marks.
+ */
+
+#include "perf_monitor.h"
+#include "esp_log.h"
+#include "esp_system.h"
+#include "esp_heap_caps.h"
+#include <string.h>
+
+static const char *TAG = "PERF";
+
+static const char *const stage_names[PERF_STAGE_COUNT] = {
+    [PERF_STAGE_SENSOR_READ] = "sensor_read",
+    [PERF_STAGE_SENSOR_STEP] = "sensor_step",
+    [PERF_STAGE_IRQ_MASKED] = "irq_masked",
+    [PERF_STAGE_DISPLAY_UPDATE] = "display_update",
+    [PERF_STAGE_DISPLAY_RENDER] = "display_render",
+    [PERF_STAGE_UPLOAD] = "upload",
+    [PERF_STAGE_SENSOR_RECOVERY] = "sensor_recovery",
+};
+
+static const char *const boot_names[PERF_BOOT_COUNT] = {
+    [PERF_BOOT_DISPLAY_READY] = "display_ready",
+    [PERF_BOOT_NETWORK_READY] = "network_ready",
+    [PERF_BOOT_FIRST_READING] = "first_reading",
+    [PERF_BOOT_FIRST_READING_SHOWN] = "reading_shown",
+    [PERF_BOOT_WIFI_CONNECTED] = "wifi_connected",
+    [PERF_BOOT_FIRST_UPLOAD] = "first_upload",
+};
+
+const char *perf_monitor_stage_name(perf_stage_t stage)
+{
+    return (stage < PERF_STAGE_COUNT) ? stage_names[stage] : "?";
+}
+
+const char *perf_monitor_boot_name(perf_boot_mark_t mark)
+{
+    return (mark < PERF_BOOT_COUNT) ? boot_names[mark] : "?";
+}
+
+#if PERF_MONITOR_ENABLED
+
+typedef struct {
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t sum_us;
+    uint32_t buckets[PERF_HISTOGRAM_BUCKETS];
+} stage_histogram_t;
+
+static stage_histogram_t histograms[PERF_STAGE_COUNT];
+static int64_t window_start_us = 0;
+static portMUX_TYPE histogram_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static TaskHandle_t watched_tasks[PERF_MAX_TASKS];
+static size_t watched_count = 0;
+static portMUX_TYPE task_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static uint32_t boot_ms[PERF_BOOT_COUNT];
+static portMUX_TYPE boot_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static inline int bucket_of(uint32_t us)
+{
+    int bucket = (us == 0) ? 0 : 32 - __builtin_clz(us);
+    return (bucket < PERF_HISTOGRAM_BUCKETS) ? bucket : PERF_HISTOGRAM_BUCKETS - 1;
+}
+
+void perf_monitor_record(perf_stage_t stage, int64_t duration_us)
+{
+    if (stage >= PERF_STAGE_COUNT)
+    {
+        return;
+    }
+    uint32_t us = (duration_us <= 0) ? 0 :
+                  (duration_us > UINT32_MAX) ? UINT32_MAX : (uint32_t)duration_us;
+    int bucket = bucket_of(us);
+    stage_histogram_t *h = &histograms[stage];
+
+    taskENTER_CRITICAL(&histogram_lock);
+    if (h->count == 0 || us < h->min_us)
+    {
+        h->min_us = us;
+    }
+    if (us > h->max_us)
+    {
+        h->max_us = us;
+    }
+    h->count++;
+    h->sum_us += us;
+    h->buckets[bucket]++;
+    taskEXIT_CRITICAL(&histogram_lock);
+}
+
+void perf_monitor_boot_mark(perf_boot_mark_t mark)
+{
+    if (mark >= PERF_BOOT_COUNT)
+    {
+        return;
+    }
+    // 0 means "not reached", so a milestone at boot rounds up to 1 ms
+    uint32_t now_ms = (uint32_t)(esp_timer_get_time() / 1000);
+    if (now_ms == 0)
+    {
+        now_ms = 1;
+    }
+
+    bool first = false;
+    taskENTER_CRITICAL(&boot_lock);
+    if (boot_ms[mark] == 0)
+    {
+        boot_ms[mark] = now_ms;
+        first = true;
+    }
+    taskEXIT_CRITICAL(&boot_lock);
+
+    if (first)
+    {
+        ESP_LOGI(TAG, "Boot: %s at %lu ms", boot_names[mark], (unsigned long)now_ms);
+    }
+}
+
+esp_err_t perf_monitor_watch_task(TaskHandle_t task)
+{
+    if (task == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t ret = ESP_ERR_NO_MEM;
+    taskENTER_CRITICAL(&task_lock);
+    if (watched_count < PERF_MAX_TASKS)
+    {
+        watched_tasks[watched_count++] = task;
+        ret = ESP_OK;
+    }
+    taskEXIT_CRITICAL(&task_lock);
+    return ret;
+}
+
+/**
+ * @brief Summarize one histogram copy
+ */
+static void summarize(const stage_histogram_t *h, perf_stage_stats_t *stats)
+{
+    *stats = (perf_stage_stats_t) { .count = h->count };
+    if (h->count == 0)
+    {
+        return;
+    }
+    stats->min_us = h->min_us;
+    stats->max_us = h->max_us;
+    stats->avg_us = (uint32_t)(h->sum_us / h->count);
+
+    // Smallest bucket with at least 99% of the samples at or below it
+    uint32_t target = h->count - h->count / 100;
+    uint32_t seen = 0;
+    int bucket = 0;
+    for (; bucket < PERF_HISTOGRAM_BUCKETS - 1; bucket++)
+    {
+        seen += h->buckets[bucket];
+        if (seen >= target)
+        {
+            break;
+        }
+    }
+    uint32_t upper = (bucket == 0) ? 0 : (uint32_t)((1ull << bucket) - 1);
+    stats->p99_us = (upper < h->max_us) ? upper : h->max_us;
+}
+
+esp_err_t perf_monitor_snapshot(perf_report_t *report, bool reset)
+{
+    if (report == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    memset(report, 0, sizeof(*report));
+
+    int64_t now = esp_timer_get_time();
+    report->uptime_s = (uint32_t)(now / 1000000);
+
+    // Copy under the lock, summarize outside it
+    static stage_histogram_t copy[PERF_STAGE_COUNT];
+    taskENTER_CRITICAL(&histogram_lock);
+    memcpy(copy, histograms, sizeof(copy));
+    int64_t window_start = window_start_us;
+    if (reset)
+    {
+        memset(histograms, 0, sizeof(histograms));
+        window_start_us = now;
+    }
+    taskEXIT_CRITICAL(&histogram_lock);
+
+    report->window_s = (uint32_t)((now - window_start) / 1000000);
+    for (int i = 0; i < PERF_STAGE_COUNT; i++)
+    {
+        summarize(&copy[i], &report->stages[i]);
+    }
+
+    report->heap_free = esp_get_free_heap_size();
+    report->heap_min_free = esp_get_minimum_free_heap_size();
+    report->heap_largest_block = heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+
+    TaskHandle_t tasks[PERF_MAX_TASKS];
+    taskENTER_CRITICAL(&task_lock);
+    size_t task_count = watched_count;
+    memcpy(tasks, watched_tasks, sizeof(tasks));
+    taskEXIT_CRITICAL(&task_lock);
+
+    for (size_t i = 0; i < task_count; i++)
+    {
+        perf_task_stats_t *t = &report->tasks[i];
+        strncpy(t->name, pcTaskGetName(tasks[i]), sizeof(t->name) - 1);
+        // ESP-IDF stacks are sized in bytes, so the watermark is in bytes too
+        t->stack_free_min = (uint32_t)uxTaskGetStackHighWaterMark(tasks[i]);
+    }
+    report->task_count = task_count;
+
+    taskENTER_CRITICAL(&boot_lock);
+    memcpy(report->boot_ms, boot_ms, sizeof(report->boot_ms));
+    taskEXIT_CRITICAL(&boot_lock);
+    return ESP_OK;
+}
+
+#else // !PERF_MONITOR_ENABLED
+
+void perf_monitor_record(perf_stage_t stage, int64_t duration_us)
+{
+}
+
+void perf_monitor_boot_mark(perf_boot_mark_t mark)
+{
+}
+
+esp_err_t perf_monitor_watch_task(TaskHandle_t task)
+{
+    return ESP_OK;
+}
+
+esp_err_t perf_monitor_snapshot(perf_report_t *report, bool reset)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif // PERF_MONITOR_ENABLED
+
+void perf_monitor_log(const perf_report_t *report)
+{
+    ESP_LOGI(TAG, "=== Diagnostics: uptime %lus, last %lus ===",
+             (unsigned long)report->uptime_s, (unsigned long)report->window_s);
+    ESP_LOGI(TAG, "%-15s %7s %9s %9s %9s %9s", "stage", "count", "min_us", "avg_us", "p99_us", "max_us");
+    for (int i = 0; i < PERF_STAGE_COUNT; i++)
+    {
+        const perf_stage_stats_t *s = &report->stages[i];
+        ESP_LOGI(TAG, "%-15s %7lu %9lu %9lu %9lu %9lu", stage_names[i], (unsigned long)s->count,
+                 (unsigned long)s->min_us, (unsigned long)s->avg_us, (unsigned long)s->p99_us,
+                 (unsigned long)s->max_us);
+    }
+    ESP_LOGI(TAG, "heap: %lu free, %lu lowest, %lu largest block",
+             (unsigned long)report->heap_free, (unsigned long)report->heap_min_free,
+             (unsigned long)report->heap_largest_block);
+    for (size_t i = 0; i < report->task_count; i++)
+    {
+        ESP_LOGI(TAG, "stack %-15s %5lu bytes never used", report->tasks[i].name,
+                 (unsigned long)report->tasks[i].stack_free_min);
+    }
+    for (int i = 0; i < PERF_BOOT_COUNT; i++)
+    {
+        if (report->boot_ms[i] != 0)
+        {
+            ESP_LOGI(TAG, "boot  %-15s %5lu ms", boot_names[i], (unsigned long)report->boot_ms[i]);
+        }
+    }
+}
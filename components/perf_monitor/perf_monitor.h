@@ -0,0 +1,187 @@
+#ifndef PERF_MONITOR_H
+#define PERF_MONITOR_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+/**
+ * @file perf_monitor.h
+ * @brief Per-stage latency histograms, stack and heap watermarks
+ *
+ * A stage is a span of code that is timed on every run:
+ *
+ *   perf_timestamp_t t = PERF_BEGIN();
+ *   ... work ...
+ *   PERF_END(PERF_STAGE_UPLOAD, t);
+ *
+ * Each stage keeps a count, min, max, sum and a histogram with power-of-two
+ * microsecond buckets, from which the p99 is estimated (the upper edge of
+ * the bucket holding the 99th percentile, so it is exact to within a
+ * factor of two). Recording costs one esp_timer_get_time() call plus a few
+ * word updates under a spinlock, so it is safe from any task, on both cores.
+ *
+ * perf_monitor_snapshot() collects the stage statistics together with the
+ * free-stack watermark of every watched task and the heap figures. The
+ * system manager logs a snapshot over serial and uploads it as a
+ * diagnostics record every PERF_REPORT_INTERVAL_MS, resetting the stage
+ * statistics so that each record covers one interval.
+ *
+ * Boot milestones (perf_boot_mark_t) are recorded once per boot, as ms
+ * since the esp_timer started (early in startup, before app_main), and
+ * included in every report: the parallel bring-up in system_manager.c is
+ * judged by time to first reading on screen and time to first upload.
+ *
+ * Build with -DPERF_MONITOR_ENABLED=0 to compile the instrumentation out:
+ * PERF_BEGIN()/PERF_END() become constants, perf_monitor_watch_task() does
+ * nothing, perf_monitor_boot_mark() records nothing and
+ * perf_monitor_snapshot() returns ESP_ERR_NOT_SUPPORTED.
+ */
+
+#ifndef PERF_MONITOR_ENABLED
+#define PERF_MONITOR_ENABLED        1
+#endif
+
+/**
+ * @brief Histogram buckets per stage
+ *
+ * Bucket 0 holds 0 µs, bucket b holds [2^(b-1), 2^b) µs; the last bucket
+ * also takes everything longer (2^30 µs, ~18 minutes, and up), so sensor
+ * recovery times still get a meaningful p99.
+ */
+#define PERF_HISTOGRAM_BUCKETS      32
+
+/**
+ * @brief Tasks whose stack watermark is reported
+ */
+#define PERF_MAX_TASKS              6
+
+/**
+ * @brief Task name length in a report, including the terminator
+ */
+#define PERF_TASK_NAME_LEN          16
+
+/**
+ * @brief Interval between diagnostics records (ms)
+ */
+#define PERF_REPORT_INTERVAL_MS     300000
+
+/**
+ * @brief Timed stages
+ */
+typedef enum {
+    PERF_STAGE_SENSOR_READ = 0,     ///< DHT11 read, request to result (incl. retries)
+    PERF_STAGE_SENSOR_STEP,         ///< CPU time of one DHT11 state machine step
+    PERF_STAGE_IRQ_MASKED,          ///< Interrupts masked in the DHT11 path (legacy backend)
+    PERF_STAGE_DISPLAY_UPDATE,      ///< update_display_with_sensor_data()
+    PERF_STAGE_DISPLAY_RENDER,      ///< One render pass of the display task
+    PERF_STAGE_UPLOAD,              ///< wifi_manager_send_data() / _send_batch()
+    PERF_STAGE_SENSOR_RECOVERY,     ///< First failed conversion to the next success
+    PERF_STAGE_COUNT
+} perf_stage_t;
+
+/**
+ * @brief Boot milestones, each recorded the first time it is reached
+ */
+typedef enum {
+    PERF_BOOT_DISPLAY_READY = 0,    ///< Panel initialized, display task accepting updates
+    PERF_BOOT_NETWORK_READY,        ///< NVS, TCP/IP stack and WiFi driver initialized
+    PERF_BOOT_FIRST_READING,        ///< First successful sensor conversion
+    PERF_BOOT_FIRST_READING_SHOWN,  ///< First reading flushed to the panel
+    PERF_BOOT_WIFI_CONNECTED,       ///< First IP address
+    PERF_BOOT_FIRST_UPLOAD,         ///< First batch accepted by the server
+    PERF_BOOT_COUNT
+} perf_boot_mark_t;
+
+/**
+ * @brief Statistics of one stage since the last reset
+ *
+ * All durations are 0 when count is 0.
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t avg_us;
+    uint32_t p99_us;                ///< Estimate, see the file description
+    uint32_t max_us;
+} perf_stage_stats_t;
+
+typedef struct {
+    char name[PERF_TASK_NAME_LEN];
+    uint32_t stack_free_min;        ///< Least free stack ever seen (bytes)
+} perf_task_stats_t;
+
+/**
+ * @brief Everything in one diagnostics record
+ */
+typedef struct {
+    uint32_t uptime_s;
+    uint32_t window_s;              ///< Time covered by the stage statistics
+    perf_stage_stats_t stages[PERF_STAGE_COUNT];
+    uint32_t heap_free;             ///< Free heap now (bytes)
+    uint32_t heap_min_free;         ///< Lowest free heap since boot (bytes)
+    uint32_t heap_largest_block;    ///< Largest allocatable internal block (bytes)
+    size_t task_count;
+    perf_task_stats_t tasks[PERF_MAX_TASKS];
+    uint32_t boot_ms[PERF_BOOT_COUNT];  ///< When each milestone was reached, 0 if not yet
+} perf_report_t;
+
+#if PERF_MONITOR_ENABLED
+typedef int64_t perf_timestamp_t;
+#define PERF_BEGIN()                esp_timer_get_time()
+#define PERF_END(stage, start)      perf_monitor_record((stage), esp_timer_get_time() - (start))
+#else
+typedef int32_t perf_timestamp_t;
+#define PERF_BEGIN()                0
+#define PERF_END(stage, start)      ((void)(start))
+#endif
+
+/**
+ * @brief Add one duration to a stage; negative durations count as 0
+ */
+void perf_monitor_record(perf_stage_t stage, int64_t duration_us);
+
+/**
+ * @brief Record that a boot milestone was reached
+ *
+ * Only the first call per milestone counts, so it can be called on every
+ * pass of a loop. Safe from any task.
+ */
+void perf_monitor_boot_mark(perf_boot_mark_t mark);
+
+/**
+ * @brief Include a task's stack watermark in every report
+ *
+ * @return ESP_ERR_NO_MEM if PERF_MAX_TASKS are already watched
+ */
+esp_err_t perf_monitor_watch_task(TaskHandle_t task);
+
+/**
+ * @brief Short name of a stage ("upload"), as used in logs and uploads
+ */
+const char *perf_monitor_stage_name(perf_stage_t stage);
+
+/**
+ * @brief Short name of a boot milestone ("first_upload")
+ */
+const char *perf_monitor_boot_name(perf_boot_mark_t mark);
+
+/**
+ * @brief Collect the current statistics
+ *
+ * @param report Filled in
+ * @param reset  Start a new window for the stage statistics
+ * @return ESP_ERR_NOT_SUPPORTED if built with PERF_MONITOR_ENABLED=0
+ */
+esp_err_t perf_monitor_snapshot(perf_report_t *report, bool reset);
+
+/**
+ * @brief Print a report over serial, one line per stage and task
+ */
+void perf_monitor_log(const perf_report_t *report);
+
+#endif // PERF_MONITOR_H
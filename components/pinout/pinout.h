@@ -57,7 +57,7 @@
  * - GPIO 24: Available for expansion
  * - GPIO 25: Available (DAC1, LED status indicator)
  * - GPIO 26: Available (DAC2)
- * - GPIO 27: Available for expansion
+ * - GPIO 27: DHT11 VCC (switched supply for recovery power cycles)
  * - GPIO 32: Available (ADC1_CH4)
  * - GPIO 33: Available (ADC1_CH5)
  * - GPIO 34: Available (ADC1_CH6, input only)
@@ -144,6 +144,19 @@
  */
 #define DHT11_DATA_PIN      22
 
+/**
+ * @brief DHT11 Supply Pin (switched VCC)
+ * 
+ * Feeds the sensor's VCC so that the driver can power-cycle a sensor that
+ * stopped answering (dht11_power_cycle()) instead of restarting the ESP32.
+ * The DHT11 draws at most 2.5mA, well within a GPIO's drive strength.
+ * Taken from the spare digital pins (was DIGITAL_PIN_10). Boards with VCC
+ * on the 3.3V rail build with -DDHT11_POWER_CONTROL=0.
+ * 
+ * @note Driven high from dht11_init(); held high through deep sleep
+ */
+#define DHT11_POWER_PIN     27
+
 // ===================================================================
 // WiFi Status Indicator (Optional Visual Feedback)
 // ===================================================================
@@ -258,7 +271,7 @@
 #define DIGITAL_PIN_7       24  ///< General digital I/O
 #define DIGITAL_PIN_8       25  ///< General digital I/O (also DAC1)
 #define DIGITAL_PIN_9       26  ///< General digital I/O (also DAC2)
-#define DIGITAL_PIN_10      27  ///< General digital I/O
+#define DIGITAL_PIN_10      27  ///< Reserved: DHT11 supply (DHT11_POWER_PIN)
 
 // ===================================================================
 // Pin Validation and Conflict Detection Macros
@@ -278,7 +291,8 @@
 #define PIN_IS_USED(pin) ( \
     (pin) == ST7789_SCK_PIN || (pin) == ST7789_SDA_PIN || \
     (pin) == ST7789_RST_PIN || (pin) == ST7789_DC_PIN || \
-    (pin) == DHT11_DATA_PIN || (pin) == WIFI_STATUS_LED_PIN \
+    (pin) == DHT11_DATA_PIN || (pin) == DHT11_POWER_PIN || \
+    (pin) == WIFI_STATUS_LED_PIN \
 )
 
 /**
@@ -394,8 +408,8 @@
  * - Power Control Relay: GPIO 26 (digital output)
  * 
  * SPECIAL PURPOSE:
- * - Watchdog Timer Output: GPIO 27 (external WDT reset)
- * - Status LEDs: GPIO 25 (DAC for brightness), GPIO 26, GPIO 27
+ * - Watchdog Timer Output: GPIO 14 (external WDT reset)
+ * - Status LEDs: GPIO 25 (DAC for brightness), GPIO 26
  * - Test Points: GPIO 19, GPIO 24 (easy access for debugging)
  * 
  * PIN CONFLICT WARNINGS:
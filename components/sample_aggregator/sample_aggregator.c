@@ -0,0 +1,176 @@
+/**
+ * @file sample_aggregator.c
+ * @brief Deadband and heartbeat reporting with window rollups, see sample_aggregator.h
+ *
+ * The window is folded into by the sensor task and closed early by
+ * sample_aggregator_flush() from whichever task is about to reset the
+ * chip, so both run under a spinlock; either is a few float operations.
+ * The configuration is a few words read once per reading under its own
+ * spinlock, so it can be replaced from another task (e.g. a configuration
+ * update) without tearing.
+ */
+
+#include "sample_aggregator.h"
+#include "freertos/FreeRTOS.h"
+#include <math.h>
+
+static aggregator_config_t config = {
+    .temperature_deadband = AGGREGATOR_TEMPERATURE_DEADBAND,
+    .humidity_deadband = AGGREGATOR_HUMIDITY_DEADBAND,
+    .heartbeat_s = AGGREGATOR_HEARTBEAT_S,
+};
+static portMUX_TYPE config_lock = portMUX_INITIALIZER_UNLOCKED;
+
+typedef struct {
+    uint32_t count;
+    float temperature_min;
+    float temperature_max;
+    float temperature_sum;
+    float humidity_min;
+    float humidity_max;
+    float humidity_sum;
+    sensor_sample_t last;           ///< Newest reading folded in
+} window_t;
+
+static window_t window;
+static portMUX_TYPE window_lock = portMUX_INITIALIZER_UNLOCKED;
+static bool has_reference = false;      ///< False until the first report
+static float reported_temperature;
+static float reported_humidity;
+static uint32_t reported_at;
+
+static inline int32_t to_centi(float value)
+{
+    return (int32_t)lroundf(value * 100.0f);
+}
+
+static inline int16_t clamp_i16(int32_t value)
+{
+    return (int16_t)((value < INT16_MIN) ? INT16_MIN : (value > INT16_MAX) ? INT16_MAX : value);
+}
+
+static inline uint16_t clamp_u16(int32_t value)
+{
+    return (uint16_t)((value < 0) ? 0 : (value > UINT16_MAX) ? UINT16_MAX : value);
+}
+
+esp_err_t sample_aggregator_configure(const aggregator_config_t *new_config)
+{
+    if (new_config == NULL || !(new_config->temperature_deadband >= 0.0f) ||
+        !(new_config->humidity_deadband >= 0.0f) || new_config->heartbeat_s == 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    taskENTER_CRITICAL(&config_lock);
+    config = *new_config;
+    taskEXIT_CRITICAL(&config_lock);
+    return ESP_OK;
+}
+
+void sample_aggregator_get_config(aggregator_config_t *out)
+{
+    taskENTER_CRITICAL(&config_lock);
+    *out = config;
+    taskEXIT_CRITICAL(&config_lock);
+}
+
+static void window_add(const sensor_sample_t *reading)
+{
+    if (window.count == 0)
+    {
+        window.temperature_min = window.temperature_max = reading->temperature;
+        window.humidity_min = window.humidity_max = reading->humidity;
+    }
+    window.temperature_min = fminf(window.temperature_min, reading->temperature);
+    window.temperature_max = fmaxf(window.temperature_max, reading->temperature);
+    window.humidity_min = fminf(window.humidity_min, reading->humidity);
+    window.humidity_max = fmaxf(window.humidity_max, reading->humidity);
+    window.temperature_sum += reading->temperature;
+    window.humidity_sum += reading->humidity;
+    window.last = *reading;
+    window.count++;
+}
+
+/**
+ * @brief Whether the reading that was just folded in closes the window
+ */
+static bool report_due(const sensor_sample_t *reading, const aggregator_config_t *cfg)
+{
+    if (!has_reference || window.count >= UINT16_MAX)
+    {
+        return true;
+    }
+    // Unsigned, so a clock stepped backwards (SNTP sync) also forces a report
+    if (reading->timestamp - reported_at >= cfg->heartbeat_s)
+    {
+        return true;
+    }
+    return fabsf(reading->temperature - reported_temperature) >= cfg->temperature_deadband ||
+           fabsf(reading->humidity - reported_humidity) >= cfg->humidity_deadband;
+}
+
+/**
+ * @brief Emit the open window as one sample, reported as its newest reading
+ */
+static void window_close(sensor_sample_t *report)
+{
+    const sensor_sample_t *reading = &window.last;
+    *report = (sensor_sample_t) {
+        .timestamp = reading->timestamp,
+        .temperature = reading->temperature,
+        .humidity = reading->humidity,
+        .rollup = { .count = (uint16_t)window.count },
+    };
+    if (window.count > 1)
+    {
+        sample_rollup_t *r = &report->rollup;
+        r->temperature_min = clamp_i16(to_centi(window.temperature_min));
+        r->temperature_max = clamp_i16(to_centi(window.temperature_max));
+        r->temperature_mean = clamp_i16(to_centi(window.temperature_sum / window.count));
+        r->humidity_min = clamp_u16(to_centi(window.humidity_min));
+        r->humidity_max = clamp_u16(to_centi(window.humidity_max));
+        r->humidity_mean = clamp_u16(to_centi(window.humidity_sum / window.count));
+    }
+
+    has_reference = true;
+    reported_temperature = reading->temperature;
+    reported_humidity = reading->humidity;
+    reported_at = reading->timestamp;
+    window = (window_t) { 0 };
+}
+
+bool sample_aggregator_add(const sensor_sample_t *reading, sensor_sample_t *report)
+{
+    aggregator_config_t cfg;
+    sample_aggregator_get_config(&cfg);
+
+    taskENTER_CRITICAL(&window_lock);
+    window_add(reading);
+    bool due = report_due(reading, &cfg);
+    if (due)
+    {
+        window_close(report);
+    }
+    taskEXIT_CRITICAL(&window_lock);
+    return due;
+}
+
+bool sample_aggregator_flush(sensor_sample_t *report)
+{
+    taskENTER_CRITICAL(&window_lock);
+    bool pending = (window.count > 0);
+    if (pending)
+    {
+        window_close(report);
+    }
+    taskEXIT_CRITICAL(&window_lock);
+    return pending;
+}
+
+uint32_t sample_aggregator_pending(void)
+{
+    taskENTER_CRITICAL(&window_lock);
+    uint32_t count = window.count;
+    taskEXIT_CRITICAL(&window_lock);
+    return count;
+}
@@ -0,0 +1,109 @@
+#ifndef SAMPLE_AGGREGATOR_H
+#define SAMPLE_AGGREGATOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "sample_ring.h"
+
+/**
+ * @file sample_aggregator.h
+ * @brief Change-driven reporting with rollups, between the sensors and the sample ring
+ *
+ * Indoors most readings repeat the previous one. Instead of buffering every
+ * reading for upload, the aggregator folds readings into a window and emits
+ * one sample when the window closes:
+ *
+ * - the temperature or humidity moved by at least its deadband from the
+ *   last reported value, or
+ * - the heartbeat interval passed since the last report (proof of life
+ *   while nothing changes).
+ *
+ * The emitted sample carries the reading that closed the window plus a
+ * rollup (count, min, max, mean) of every reading in it, so each reading
+ * is accounted for in exactly one uploaded sample and excursions between
+ * reports are not lost. The first reading after boot is always reported.
+ *
+ * With the defaults and a 10 s sensor period, a steady room produces one
+ * sample per 5-minute heartbeat instead of 30, and most transmission
+ * cycles have nothing to send.
+ *
+ * Deadbands of 0 report every reading (each a window of one), the
+ * behaviour without the aggregator. Defaults can be overridden per device
+ * at build time (-DAGGREGATOR_TEMPERATURE_DEADBAND=0.2f) or at runtime
+ * with sample_aggregator_configure().
+ *
+ * sample_aggregator_add() is called from the sensor task only. The open
+ * window lives in RAM; sample_aggregator_flush() closes it early, from any
+ * task, before a restart would discard it. The configuration may be
+ * changed from any task.
+ */
+
+/**
+ * @brief Temperature change that triggers a report (°C)
+ */
+#ifndef AGGREGATOR_TEMPERATURE_DEADBAND
+#define AGGREGATOR_TEMPERATURE_DEADBAND     0.5f
+#endif
+
+/**
+ * @brief Humidity change that triggers a report (% RH)
+ */
+#ifndef AGGREGATOR_HUMIDITY_DEADBAND
+#define AGGREGATOR_HUMIDITY_DEADBAND        2.0f
+#endif
+
+/**
+ * @brief Longest time between two reports, whatever the readings do (s)
+ */
+#ifndef AGGREGATOR_HEARTBEAT_S
+#define AGGREGATOR_HEARTBEAT_S              300
+#endif
+
+typedef struct {
+    float temperature_deadband;     ///< °C, 0 = report every reading
+    float humidity_deadband;        ///< % RH, 0 = report every reading
+    uint32_t heartbeat_s;           ///< Must be at least 1
+} aggregator_config_t;
+
+/**
+ * @brief Replace the reporting configuration
+ *
+ * Takes effect with the next reading; the open window is kept.
+ *
+ * @return ESP_ERR_INVALID_ARG on NULL, negative deadbands or a 0 heartbeat
+ */
+esp_err_t sample_aggregator_configure(const aggregator_config_t *config);
+
+/**
+ * @brief Current reporting configuration (the build defaults until configured)
+ */
+void sample_aggregator_get_config(aggregator_config_t *config);
+
+/**
+ * @brief Fold one reading into the open window
+ *
+ * @param reading Timestamped reading (its rollup is ignored)
+ * @param report  Receives the window's sample when this reading closes it
+ * @return true if a report is due and *report was filled in
+ */
+bool sample_aggregator_add(const sensor_sample_t *reading, sensor_sample_t *report);
+
+/**
+ * @brief Close the open window now, whatever the deadbands and heartbeat say
+ *
+ * The sample reports the window's newest reading with the rollup of all of
+ * them, as if that reading had closed it. It becomes the reference value
+ * for the following deadband checks.
+ *
+ * @param report Receives the window's sample if it had any readings
+ * @return true if *report was filled in, false if nothing was pending
+ */
+bool sample_aggregator_flush(sensor_sample_t *report);
+
+/**
+ * @brief Readings folded into the open window, not yet reported
+ */
+uint32_t sample_aggregator_pending(void);
+
+#endif // SAMPLE_AGGREGATOR_H
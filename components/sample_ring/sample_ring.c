@@ -0,0 +1,93 @@
+/**
+ * @file sample_ring.c
+ * @brief Fixed-size ring of timestamped sensor samples
+ *
+ * head and tail are free-running sequence numbers, not array indices:
+ * head is the sequence the next push will get, tail the oldest unsent one.
+ * The slot of sequence n is n % SAMPLE_RING_CAPACITY, and head - tail is
+ * the fill level (wrap-around of the 32-bit counters is harmless because
+ * only differences are used).
+ */
+
+#include "sample_ring.h"
+#include "freertos/FreeRTOS.h"
+
+static sensor_sample_t samples[SAMPLE_RING_CAPACITY];
+static uint32_t head = 0;
+static uint32_t tail = 0;
+static uint32_t dropped = 0;
+static portMUX_TYPE ring_lock = portMUX_INITIALIZER_UNLOCKED;
+
+bool sample_ring_push(const sensor_sample_t *sample)
+{
+    bool overwrote = false;
+
+    taskENTER_CRITICAL(&ring_lock);
+    samples[head % SAMPLE_RING_CAPACITY] = *sample;
+    head++;
+    if (head - tail > SAMPLE_RING_CAPACITY)
+    {
+        tail = head - SAMPLE_RING_CAPACITY;
+        dropped++;
+        overwrote = true;
+    }
+    taskEXIT_CRITICAL(&ring_lock);
+
+    return overwrote;
+}
+
+size_t sample_ring_peek(sensor_sample_t *out, size_t max_count, uint32_t *first_seq)
+{
+    taskENTER_CRITICAL(&ring_lock);
+    uint32_t from = tail;
+    taskEXIT_CRITICAL(&ring_lock);
+
+    return sample_ring_peek_from(from, out, max_count, first_seq);
+}
+
+size_t sample_ring_peek_from(uint32_t from_seq, sensor_sample_t *out, size_t max_count,
+                             uint32_t *first_seq)
+{
+    taskENTER_CRITICAL(&ring_lock);
+    // Overflow may already have moved tail past from_seq
+    uint32_t start = ((int32_t)(from_seq - tail) > 0) ? from_seq : tail;
+    size_t count = ((int32_t)(head - start) > 0) ? head - start : 0;
+    if (count > max_count)
+    {
+        count = max_count;
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        out[i] = samples[(start + i) % SAMPLE_RING_CAPACITY];
+    }
+    *first_seq = start;
+    taskEXIT_CRITICAL(&ring_lock);
+
+    return count;
+}
+
+void sample_ring_commit(uint32_t first_seq, size_t count)
+{
+    uint32_t end = first_seq + (uint32_t)count;
+
+    taskENTER_CRITICAL(&ring_lock);
+    // Overflow may already have moved tail past some of these samples
+    if ((int32_t)(end - tail) > 0)
+    {
+        tail = end;
+    }
+    taskEXIT_CRITICAL(&ring_lock);
+}
+
+size_t sample_ring_count(void)
+{
+    taskENTER_CRITICAL(&ring_lock);
+    size_t count = head - tail;
+    taskEXIT_CRITICAL(&ring_lock);
+    return count;
+}
+
+uint32_t sample_ring_dropped(void)
+{
+    return dropped;
+}
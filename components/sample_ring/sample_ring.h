@@ -0,0 +1,120 @@
+#ifndef SAMPLE_RING_H
+#define SAMPLE_RING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file sample_ring.h
+ * @brief Fixed-size, allocation-free ring of timestamped sensor samples
+ *
+ * The sensor task pushes every valid reading. The WiFi task uploads them
+ * in batches, so readings taken between two transmissions (or during a
+ * network outage) are no longer lost.
+ *
+ * Two-phase drain:
+ * The consumer copies a batch out with sample_ring_peek(), sends it, and
+ * only then calls sample_ring_commit(). A failed upload leaves the samples
+ * in the ring for the next attempt. A consumer that pipelines several
+ * batches before their delivery is confirmed copies each following batch
+ * with sample_ring_peek_from() and commits them together.
+ *
+ * Overflow:
+ * When the ring is full, a push overwrites the oldest sample. Every sample
+ * has a monotonically increasing sequence number, so a commit after an
+ * overwrite still drops exactly the samples that were sent and no others.
+ *
+ * The storage is a static array of SAMPLE_RING_CAPACITY entries. Each
+ * operation holds a spinlock only for a few word copies, so the ring can be
+ * shared between tasks on both cores.
+ */
+
+/**
+ * @brief Number of samples retained
+ *
+ * 128 samples cover at least ~21 minutes of WiFi outage at the 10 s sensor
+ * interval, far longer while the aggregator reports only on change
+ * (28 bytes each, 3.5 KB total).
+ */
+#define SAMPLE_RING_CAPACITY    128
+
+/**
+ * @brief Summary of the readings a sample stands for, see sample_aggregator.h
+ *
+ * Fixed point in hundredths, like the binary upload format. A count of 0
+ * or 1 means the sample is a single reading and the other fields are
+ * unused, so zero-initialized samples need no rollup handling.
+ */
+typedef struct {
+    uint16_t count;             ///< Readings in the window, including the reported one
+    int16_t temperature_min;    ///< Centi-°C
+    int16_t temperature_max;
+    int16_t temperature_mean;
+    uint16_t humidity_min;      ///< Centi-% RH
+    uint16_t humidity_max;
+    uint16_t humidity_mean;
+} sample_rollup_t;
+
+/**
+ * @brief One reading as stored in the ring
+ */
+typedef struct {
+    uint32_t timestamp;     ///< Unix timestamp when the reading was taken
+    float temperature;      ///< Temperature in Celsius
+    float humidity;         ///< Relative humidity percentage
+    sample_rollup_t rollup; ///< Readings folded into this sample since the previous one
+} sensor_sample_t;
+
+/**
+ * @brief Append a sample, overwriting the oldest one if the ring is full
+ *
+ * @param sample Sample to store
+ * @return true if the push overwrote an unsent sample
+ */
+bool sample_ring_push(const sensor_sample_t *sample);
+
+/**
+ * @brief Copy out up to max_count of the oldest samples without removing them
+ *
+ * @param out       Destination array
+ * @param max_count Capacity of out
+ * @param first_seq Receives the sequence number of out[0], for sample_ring_commit()
+ * @return Number of samples copied (0 if the ring is empty)
+ */
+size_t sample_ring_peek(sensor_sample_t *out, size_t max_count, uint32_t *first_seq);
+
+/**
+ * @brief Like sample_ring_peek(), but start at sequence from_seq
+ *
+ * Samples before from_seq stay in the ring, uncommitted. If overflow has
+ * already dropped from_seq, the copy starts at the oldest sample left.
+ *
+ * @param from_seq  First sequence wanted, usually the end of the previous batch
+ * @param out       Destination array
+ * @param max_count Capacity of out
+ * @param first_seq Receives the sequence number of out[0]
+ * @return Number of samples copied (0 if nothing from from_seq on is buffered)
+ */
+size_t sample_ring_peek_from(uint32_t from_seq, sensor_sample_t *out, size_t max_count,
+                             uint32_t *first_seq);
+
+/**
+ * @brief Drop samples that were successfully delivered
+ *
+ * @param first_seq Value returned by sample_ring_peek()
+ * @param count     Number of samples that were delivered
+ */
+void sample_ring_commit(uint32_t first_seq, size_t count);
+
+/**
+ * @brief Number of samples waiting to be drained
+ */
+size_t sample_ring_count(void);
+
+/**
+ * @brief Total samples lost to overflow since boot
+ */
+uint32_t sample_ring_dropped(void);
+
+#endif // SAMPLE_RING_H
@@ -0,0 +1,116 @@
+/**
+ * @file sensor_history.c
+ * @brief Fixed-point circular series of slot averages, see sensor_history.h
+ *
+ * The slot of number n is n % SENSOR_HISTORY_SLOTS, like the sequence
+ * numbers of the sample ring. head is the slot currently being averaged;
+ * first is the slot of the first reading since boot, so older, never
+ * written entries read as gaps without initializing the arrays.
+ */
+
+#include "sensor_history.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include <math.h>
+
+#define TEMPERATURE_GAP     INT16_MIN
+#define HUMIDITY_GAP        UINT8_MAX
+
+static int16_t temperature_deci[SENSOR_HISTORY_SLOTS];
+static uint8_t humidity_half[SENSOR_HISTORY_SLOTS];
+static bool started = false;
+static uint32_t head = 0;
+static uint32_t first = 0;
+static float temperature_sum = 0.0f;
+static float humidity_sum = 0.0f;
+static uint32_t reading_count = 0;
+static portMUX_TYPE history_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static void store(uint32_t slot, bool has_data, float temperature, float humidity)
+{
+    size_t index = slot % SENSOR_HISTORY_SLOTS;
+    if (!has_data)
+    {
+        temperature_deci[index] = TEMPERATURE_GAP;
+        humidity_half[index] = HUMIDITY_GAP;
+        return;
+    }
+    long t = lroundf(temperature * 10.0f);
+    long h = lroundf(humidity * 2.0f);
+    temperature_deci[index] = (int16_t)((t <= INT16_MIN) ? INT16_MIN + 1 : (t > INT16_MAX) ? INT16_MAX : t);
+    humidity_half[index] = (uint8_t)((h < 0) ? 0 : (h >= HUMIDITY_GAP) ? HUMIDITY_GAP - 1 : h);
+}
+
+void sensor_history_add(float temperature, float humidity)
+{
+    uint32_t now = (uint32_t)(esp_timer_get_time() / 1000000 / SENSOR_HISTORY_SLOT_S);
+
+    taskENTER_CRITICAL(&history_lock);
+    if (!started)
+    {
+        started = true;
+        head = first = now;
+    }
+    else if (now != head)
+    {
+        store(head, reading_count > 0, temperature_sum / reading_count, humidity_sum / reading_count);
+
+        // Slots without a reading in between become gaps; only the newest matter
+        uint32_t gaps = now - head - 1;
+        if (gaps > SENSOR_HISTORY_SLOTS)
+        {
+            gaps = SENSOR_HISTORY_SLOTS;
+        }
+        for (uint32_t slot = now - gaps; slot != now; slot++)
+        {
+            store(slot, false, 0.0f, 0.0f);
+        }
+        head = now;
+        temperature_sum = humidity_sum = 0.0f;
+        reading_count = 0;
+    }
+    temperature_sum += temperature;
+    humidity_sum += humidity;
+    reading_count++;
+    taskEXIT_CRITICAL(&history_lock);
+}
+
+uint32_t sensor_history_head(void)
+{
+    taskENTER_CRITICAL(&history_lock);
+    uint32_t result = head;
+    taskEXIT_CRITICAL(&history_lock);
+    return result;
+}
+
+bool sensor_history_range(uint32_t from, uint32_t count, sensor_history_range_t *range)
+{
+    *range = (sensor_history_range_t) { 0 };
+
+    taskENTER_CRITICAL(&history_lock);
+    uint32_t oldest = (head - first > SENSOR_HISTORY_SLOTS) ? head - SENSOR_HISTORY_SLOTS : first;
+    uint32_t end = (from >= head) ? from : (count > head - from) ? head : from + count;
+    for (uint32_t slot = (from > oldest) ? from : oldest; slot < end; slot++)
+    {
+        size_t index = slot % SENSOR_HISTORY_SLOTS;
+        if (temperature_deci[index] == TEMPERATURE_GAP)
+        {
+            continue;
+        }
+        float t = temperature_deci[index] / 10.0f;
+        float h = humidity_half[index] / 2.0f;
+        if (range->slots == 0)
+        {
+            range->temperature_min = range->temperature_max = t;
+            range->humidity_min = range->humidity_max = h;
+        }
+        range->temperature_min = fminf(range->temperature_min, t);
+        range->temperature_max = fmaxf(range->temperature_max, t);
+        range->humidity_min = fminf(range->humidity_min, h);
+        range->humidity_max = fmaxf(range->humidity_max, h);
+        range->slots++;
+    }
+    taskEXIT_CRITICAL(&history_lock);
+
+    return range->slots > 0;
+}
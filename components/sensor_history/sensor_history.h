@@ -0,0 +1,68 @@
+#ifndef SENSOR_HISTORY_H
+#define SENSOR_HISTORY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @file sensor_history.h
+ * @brief Packed 24-hour time series of temperature and humidity for the display
+ *
+ * Uptime is divided into slots of SENSOR_HISTORY_SLOT_S seconds. Readings
+ * are averaged into the current slot; when a reading arrives in a later
+ * slot, the current one is closed and stored. The last
+ * SENSOR_HISTORY_SLOTS closed slots are kept in fixed point:
+ *
+ *   temperature  int16  0.1 °C
+ *   humidity     uint8  0.5 % RH
+ *
+ * 960 slots of 90 s cover 24 hours in 2.8 KB. Slots without a reading
+ * (sensor failure, reboot) are stored as gaps.
+ *
+ * Slots are numbered from boot, so the number of the next slot to close
+ * (sensor_history_head()) only ever grows. A reader remembers the head it
+ * last saw and fetches only the slots closed since, which is how the
+ * history plot redraws just its newest column.
+ *
+ * The series uses the monotonic uptime rather than wall-clock time, so it
+ * works before SNTP and is not disturbed by clock steps. The sensor task
+ * writes; any task may read. Every call holds a spinlock for a few slots.
+ */
+
+#define SENSOR_HISTORY_SLOT_S   90      ///< Seconds per slot
+#define SENSOR_HISTORY_SLOTS    960     ///< Slots retained (24 h)
+
+/**
+ * @brief Extremes of the slot averages in a range of slots
+ */
+typedef struct {
+    uint32_t slots;             ///< Slots in the range that hold data (0: all gaps)
+    float temperature_min;      ///< °C
+    float temperature_max;
+    float humidity_min;         ///< % RH
+    float humidity_max;
+} sensor_history_range_t;
+
+/**
+ * @brief Fold a reading into the current slot, closing earlier slots
+ *
+ * Call from the sensor task for every valid reading.
+ */
+void sensor_history_add(float temperature, float humidity);
+
+/**
+ * @brief Number of the next slot to close
+ *
+ * Slots head - SENSOR_HISTORY_SLOTS to head - 1 are retained (fewer
+ * shortly after boot).
+ */
+uint32_t sensor_history_head(void);
+
+/**
+ * @brief Summarize the retained, closed slots among from .. from + count - 1
+ *
+ * @return true if at least one slot in the range holds data
+ */
+bool sensor_history_range(uint32_t from, uint32_t count, sensor_history_range_t *range);
+
+#endif // SENSOR_HISTORY_H
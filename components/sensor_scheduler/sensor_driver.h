@@ -0,0 +1,108 @@
+#ifndef SENSOR_DRIVER_H
+#define SENSOR_DRIVER_H
+
+#include <stdint.h>
+#include "esp_err.h"
+
+/**
+ * @file sensor_driver.h
+ * @brief Interface every sensor backend implements for sensor_scheduler
+ *
+ * A conversion is split into a start and a completion so that the
+ * scheduler can run conversions of several sensors at the same time from
+ * one task:
+ *
+ *   start_conversion()   kick off the measurement, return at once
+ *       ... conversion_time_ms ...
+ *   poll()               ESP_ERR_NOT_FINISHED until the result is ready
+ *
+ * The scheduler first polls conversion_time_ms after the start and then
+ * every SENSOR_SCHEDULER_POLL_MS. A backend whose completion arrives
+ * asynchronously (a callback, an interrupt) calls sensor_scheduler_notify()
+ * so that it is polled immediately instead.
+ *
+ * When conversions keep failing the scheduler asks the backend to recover
+ * the hardware, one step further on every failure (see sensor_scheduler.h).
+ *
+ * All driver functions are called from the scheduler task only.
+ */
+
+/**
+ * @brief Quantities a reading can carry (bits of sensor_reading_t::fields)
+ */
+#define SENSOR_FIELD_TEMPERATURE    (1u << 0)
+#define SENSOR_FIELD_HUMIDITY       (1u << 1)
+
+/**
+ * @brief Result of one successful conversion
+ *
+ * A sensor fills in the quantities it measures and sets the matching
+ * SENSOR_FIELD_* bits; the other members are ignored.
+ */
+typedef struct {
+    uint32_t fields;        ///< SENSOR_FIELD_* bits of the valid members
+    float temperature;      ///< Temperature in Celsius
+    float humidity;         ///< Relative humidity percentage
+} sensor_reading_t;
+
+/**
+ * @brief Recovery steps, in the order sensor_scheduler escalates through them
+ *
+ * The backend is only asked for the hardware steps (REINIT, POWER_CYCLE);
+ * BACKOFF is applied by the scheduler itself.
+ */
+typedef enum {
+    SENSOR_RECOVERY_NONE = 0,       ///< Healthy, or no step taken yet
+    SENSOR_RECOVERY_REINIT,         ///< Reconfigure the pins and the bus peripheral
+    SENSOR_RECOVERY_POWER_CYCLE,    ///< Switch the sensor's supply off and on again
+    SENSOR_RECOVERY_BACKOFF         ///< Poll less often until the sensor answers
+} sensor_recovery_t;
+
+/**
+ * @brief Sensor backend description, usually a const global of the driver
+ */
+typedef struct {
+    const char *name;               ///< Short name for logs ("dht11")
+    uint32_t min_interval_ms;       ///< Shortest period the sensor supports
+    uint32_t conversion_time_ms;    ///< Typical time from start to result
+    uint32_t timeout_ms;            ///< Conversion counts as failed after this
+
+    /**
+     * @brief Prepare the hardware; called once by sensor_scheduler_add()
+     */
+    esp_err_t (*init)(void *ctx);
+
+    /**
+     * @brief Start a conversion without blocking
+     *
+     * @return ESP_OK if the conversion is running; anything else counts as
+     *         a failed conversion
+     */
+    esp_err_t (*start_conversion)(void *ctx);
+
+    /**
+     * @brief Collect the result of the running conversion
+     *
+     * @return ESP_ERR_NOT_FINISHED while the conversion is still running
+     * @return ESP_OK with @p reading filled in
+     * @return Any other error if the conversion failed
+     */
+    esp_err_t (*poll)(void *ctx, sensor_reading_t *reading);
+
+    /**
+     * @brief Optional: run a recovery step after a failed conversion
+     *
+     * Must not block; a step that takes time (a power cycle) is finished
+     * asynchronously by the backend, which reports how long to wait.
+     *
+     * @param step     SENSOR_RECOVERY_REINIT or SENSOR_RECOVERY_POWER_CYCLE
+     * @param settle_ms Receives the time until the next conversion can
+     *                 succeed (the scheduler waits at least min_interval_ms)
+     * @return ESP_OK if the step was taken
+     * @return ESP_ERR_NOT_SUPPORTED if the hardware has no such step (skipped)
+     * @return Any other error if the step failed (it still counts as taken)
+     */
+    esp_err_t (*recover)(void *ctx, sensor_recovery_t step, uint32_t *settle_ms);
+} sensor_driver_t;
+
+#endif // SENSOR_DRIVER_H
@@ -0,0 +1,469 @@
+/**
+ * @file sensor_scheduler.c
+ * @brief Deadline scheduler for periodic sensor conversions, see sensor_scheduler.h
+ *
+ * Every slot has exactly one pending deadline: next_start while it is idle,
+ * next_poll while a conversion is running. The task wakes at the earliest
+ * of them (or on sensor_scheduler_notify()), services every slot that is
+ * due and goes back to sleep. All times are FreeRTOS ticks compared by
+ * signed difference, so tick counter wrap-around is harmless.
+ *
+ * Recovery steps only move deadlines: a hardware step pulls next_start in
+ * to a quick retry, BACKOFF pushes it out. The next success puts the slot
+ * back on its regular grid.
+ */
+
+#include "sensor_scheduler.h"
+#include "perf_monitor.h"
+#include "esp_log.h"
+#include "event_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static const char *TAG = "SENSOR_SCHED";
+
+typedef struct {
+    const sensor_driver_t *driver;
+    void *driver_ctx;
+    TickType_t period;
+    TickType_t degraded_after;
+    TickType_t failed_after;
+    bool converting;
+    TickType_t slot_start;          ///< Scheduled start of the current/last conversion
+    TickType_t next_start;          ///< Idle: when the next conversion starts
+    TickType_t next_poll;           ///< Converting: when to poll next
+    TickType_t timeout_at;          ///< Converting: when to give up
+    TickType_t last_success;        ///< slot_start of the last successful conversion
+    TickType_t failing_since;       ///< When the first failure of the current run completed
+    uint32_t backoff;               ///< Period multiplier of the BACKOFF step (1 = off)
+    uint32_t requested_period_ms;   ///< Set by sensor_scheduler_set_period(), 0 = none
+    sensor_stats_t stats;           ///< Guarded by stats_lock
+} sensor_slot_t;
+
+static sensor_slot_t slots[SENSOR_SCHEDULER_MAX_SENSORS];
+static int slot_count = 0;
+static sensor_reading_cb_t reading_callback = NULL;
+static sensor_health_cb_t health_callback = NULL;
+static void *callback_ctx = NULL;
+static TaskHandle_t scheduler_task = NULL;
+static TickType_t idle_until = 0;   ///< Next conversion start, or a past tick while converting
+static portMUX_TYPE stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static const char *const recovery_names[] = { "none", "reinit", "power cycle", "backoff" };
+
+static inline bool is_due(TickType_t deadline, TickType_t now)
+{
+    return (int32_t)(now - deadline) >= 0;
+}
+
+static void set_health(int id, sensor_slot_t *slot, sensor_health_t health)
+{
+    if (slot->stats.health == health)
+    {
+        return;
+    }
+
+    sensor_stats_t snapshot;
+    taskENTER_CRITICAL(&stats_lock);
+    slot->stats.health = health;
+    snapshot = slot->stats;
+    taskEXIT_CRITICAL(&stats_lock);
+
+    static const char *const names[] = { "OK", "DEGRADED", "FAILED" };
+    EVENT_LOGI(TAG, "%s health: %s (%lu consecutive failures)", slot->driver->name,
+               names[health], (unsigned long)snapshot.consecutive_failures);
+    if (health_callback != NULL)
+    {
+        health_callback(id, &snapshot, callback_ctx);
+    }
+}
+
+/**
+ * @brief Take the next recovery step after a failed conversion
+ *
+ * Hardware steps the driver does not support are skipped; once they are
+ * used up, every further failure doubles the backoff.
+ */
+static void escalate_recovery(sensor_slot_t *slot, TickType_t now)
+{
+    const sensor_driver_t *driver = slot->driver;
+    int step = slot->stats.recovery;
+    uint32_t settle_ms = 0;
+
+    while (++step < SENSOR_RECOVERY_BACKOFF)
+    {
+        if (driver->recover == NULL)
+        {
+            continue;
+        }
+        esp_err_t ret = driver->recover(slot->driver_ctx, (sensor_recovery_t)step, &settle_ms);
+        if (ret == ESP_ERR_NOT_SUPPORTED)
+        {
+            continue;
+        }
+        if (ret != ESP_OK)
+        {
+            EVENT_LOGW(TAG, "%s: %s failed: %s", driver->name, recovery_names[step],
+                       esp_err_to_name(ret));
+        }
+        break;
+    }
+    if (step > SENSOR_RECOVERY_BACKOFF)
+    {
+        step = SENSOR_RECOVERY_BACKOFF;
+    }
+
+    taskENTER_CRITICAL(&stats_lock);
+    slot->stats.recovery = (sensor_recovery_t)step;
+    taskEXIT_CRITICAL(&stats_lock);
+
+    if (step < SENSOR_RECOVERY_BACKOFF)
+    {
+        // Retry as soon as the sensor can answer instead of waiting for the next slot
+        uint32_t retry_ms = (settle_ms > driver->min_interval_ms) ? settle_ms : driver->min_interval_ms;
+        TickType_t retry_at = now + pdMS_TO_TICKS(retry_ms);
+        if ((int32_t)(retry_at - slot->next_start) < 0)
+        {
+            slot->next_start = retry_at;
+        }
+        EVENT_LOGW(TAG, "%s: %s, retrying in %lu ms", driver->name, recovery_names[step],
+                   (unsigned long)retry_ms);
+        return;
+    }
+
+    if (slot->backoff < SENSOR_SCHEDULER_MAX_BACKOFF)
+    {
+        slot->backoff *= 2;
+    }
+    slot->next_start = now + slot->period * slot->backoff;
+    EVENT_LOGW(TAG, "%s: backing off, next conversion in %lu ms", driver->name,
+               (unsigned long)pdTICKS_TO_MS(slot->period * slot->backoff));
+}
+
+/**
+ * @brief Account for a finished conversion and deliver its result
+ *
+ * @param reading NULL for a failed conversion
+ */
+static void complete(int id, sensor_slot_t *slot, const sensor_reading_t *reading, bool timed_out,
+                     TickType_t now)
+{
+    slot->converting = false;
+
+    uint32_t recovery_ms = 0;
+    bool recovered = false;
+    taskENTER_CRITICAL(&stats_lock);
+    slot->stats.conversions++;
+    if (reading != NULL)
+    {
+        recovered = (slot->stats.consecutive_failures > 0);
+        if (recovered)
+        {
+            recovery_ms = pdTICKS_TO_MS(now - slot->failing_since);
+            slot->stats.recoveries++;
+            slot->stats.last_recovery_ms = recovery_ms;
+        }
+        slot->stats.consecutive_failures = 0;
+    }
+    else
+    {
+        slot->stats.failures++;
+        slot->stats.consecutive_failures++;
+        if (timed_out)
+        {
+            slot->stats.timeouts++;
+        }
+    }
+    sensor_recovery_t step = slot->stats.recovery;
+    taskEXIT_CRITICAL(&stats_lock);
+
+    if (reading != NULL)
+    {
+        if (recovered)
+        {
+            EVENT_LOGI(TAG, "%s: recovered %lu ms after the first failure (last step: %s)",
+                       slot->driver->name, (unsigned long)recovery_ms, recovery_names[step]);
+            perf_monitor_record(PERF_STAGE_SENSOR_RECOVERY, (int64_t)recovery_ms * 1000);
+            taskENTER_CRITICAL(&stats_lock);
+            slot->stats.recovery = SENSOR_RECOVERY_NONE;
+            taskEXIT_CRITICAL(&stats_lock);
+            slot->backoff = 1;
+        }
+        slot->last_success = slot->slot_start;
+        set_health(id, slot, SENSOR_HEALTH_OK);
+        reading_callback(id, reading, callback_ctx);
+        return;
+    }
+
+    if (slot->stats.consecutive_failures == 1)
+    {
+        slot->failing_since = now;
+    }
+    escalate_recovery(slot, now);
+
+    // Measured between scheduled starts, so N failed periods are exactly N * period
+    TickType_t without_success = slot->slot_start - slot->last_success;
+    if (without_success >= slot->failed_after && slot->stats.recovery == SENSOR_RECOVERY_BACKOFF)
+    {
+        set_health(id, slot, SENSOR_HEALTH_FAILED);
+    }
+    else if (without_success >= slot->degraded_after && slot->stats.health == SENSOR_HEALTH_OK)
+    {
+        set_health(id, slot, SENSOR_HEALTH_DEGRADED);
+    }
+}
+
+static void start_conversion(int id, sensor_slot_t *slot, TickType_t now)
+{
+    slot->slot_start = slot->next_start;
+
+    // Next slot on the fixed grid; skip slots that were missed entirely
+    slot->next_start += slot->period;
+    if (is_due(slot->next_start, now))
+    {
+        slot->next_start = now + slot->period;
+    }
+
+    esp_err_t ret = slot->driver->start_conversion(slot->driver_ctx);
+    if (ret != ESP_OK)
+    {
+        EVENT_LOGW(TAG, "%s: conversion not started: %s", slot->driver->name, esp_err_to_name(ret));
+        complete(id, slot, NULL, false, now);
+        return;
+    }
+
+    slot->converting = true;
+    slot->next_poll = now + pdMS_TO_TICKS(slot->driver->conversion_time_ms);
+    slot->timeout_at = now + pdMS_TO_TICKS(slot->driver->timeout_ms);
+}
+
+// Take over a period change; the next conversion moves onto the new grid
+static void apply_period(sensor_slot_t *slot)
+{
+    uint32_t period_ms = __atomic_exchange_n(&slot->requested_period_ms, 0, __ATOMIC_ACQUIRE);
+    if (period_ms == 0 || pdMS_TO_TICKS(period_ms) == slot->period)
+    {
+        return;
+    }
+
+    slot->period = pdMS_TO_TICKS(period_ms);
+
+    // Before the first conversion next_start is already "now"; while the
+    // sensor is failing the recovery ladder owns it until the next success
+    bool started = slot->converting || slot->stats.conversions > 0;
+    if (started && slot->stats.consecutive_failures == 0)
+    {
+        slot->next_start = slot->slot_start + slot->period;
+    }
+    ESP_LOGI(TAG, "%s: period changed to %lu ms", slot->driver->name, (unsigned long)period_ms);
+}
+
+static void poll_conversion(int id, sensor_slot_t *slot, TickType_t now)
+{
+    sensor_reading_t reading = { 0 };
+    esp_err_t ret = slot->driver->poll(slot->driver_ctx, &reading);
+
+    if (ret == ESP_OK)
+    {
+        complete(id, slot, &reading, false, now);
+    }
+    else if (ret != ESP_ERR_NOT_FINISHED)
+    {
+        EVENT_LOGW(TAG, "%s: conversion failed: %s", slot->driver->name, esp_err_to_name(ret));
+        complete(id, slot, NULL, false, now);
+    }
+    else if (is_due(slot->timeout_at, now))
+    {
+        EVENT_LOGW(TAG, "%s: no result after %lu ms", slot->driver->name,
+                   (unsigned long)slot->driver->timeout_ms);
+        complete(id, slot, NULL, true, now);
+    }
+    else if (is_due(slot->next_poll, now))
+    {
+        // An early poll after a notification keeps the original first-poll time
+        slot->next_poll = now + pdMS_TO_TICKS(SENSOR_SCHEDULER_POLL_MS);
+    }
+}
+
+esp_err_t sensor_scheduler_init(sensor_reading_cb_t on_reading, sensor_health_cb_t on_health,
+                                void *ctx)
+{
+    if (on_reading == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    reading_callback = on_reading;
+    health_callback = on_health;
+    callback_ctx = ctx;
+    return ESP_OK;
+}
+
+esp_err_t sensor_scheduler_add(const sensor_driver_t *driver, void *driver_ctx,
+                               const sensor_schedule_t *schedule, int *sensor_id)
+{
+    if (driver == NULL || schedule == NULL || driver->start_conversion == NULL ||
+        driver->poll == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (reading_callback == NULL || scheduler_task != NULL)
+    {
+        return ESP_ERR_INVALID_STATE;   // Not initialized, or already running
+    }
+    if (slot_count == SENSOR_SCHEDULER_MAX_SENSORS)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (driver->init != NULL)
+    {
+        esp_err_t ret = driver->init(driver_ctx);
+        if (ret != ESP_OK)
+        {
+            ESP_LOGE(TAG, "%s: init failed: %s", driver->name, esp_err_to_name(ret));
+            return ret;
+        }
+    }
+
+    uint32_t period_ms = schedule->period_ms;
+    if (period_ms < driver->min_interval_ms)
+    {
+        ESP_LOGW(TAG, "%s: period %lu ms raised to %lu ms", driver->name,
+                 (unsigned long)period_ms, (unsigned long)driver->min_interval_ms);
+        period_ms = driver->min_interval_ms;
+    }
+
+    int id = slot_count;
+    sensor_slot_t *slot = &slots[id];
+    *slot = (sensor_slot_t) {
+        .driver = driver,
+        .driver_ctx = driver_ctx,
+        .period = pdMS_TO_TICKS(period_ms),
+        .degraded_after = pdMS_TO_TICKS(schedule->degraded_after_ms),
+        .failed_after = pdMS_TO_TICKS(schedule->failed_after_ms),
+        .backoff = 1,
+    };
+    slot_count++;
+
+    if (sensor_id != NULL)
+    {
+        *sensor_id = id;
+    }
+    ESP_LOGI(TAG, "Sensor %d: %s every %lu ms", id, driver->name, (unsigned long)period_ms);
+    return ESP_OK;
+}
+
+void sensor_scheduler_run(void)
+{
+    scheduler_task = xTaskGetCurrentTaskHandle();
+
+    TickType_t now = xTaskGetTickCount();
+    for (int i = 0; i < slot_count; i++)
+    {
+        slots[i].next_start = now;
+        slots[i].last_success = now - slots[i].period;
+    }
+
+    bool notified = false;
+    while (1)
+    {
+        now = xTaskGetTickCount();
+        TickType_t wait = portMAX_DELAY;
+        bool converting = false;
+
+        for (int i = 0; i < slot_count; i++)
+        {
+            sensor_slot_t *slot = &slots[i];
+
+            apply_period(slot);
+            if (slot->converting && (notified || is_due(slot->next_poll, now)))
+            {
+                poll_conversion(i, slot, now);
+            }
+            // A conversion that overran its slot starts its successor right away
+            if (!slot->converting && is_due(slot->next_start, now))
+            {
+                start_conversion(i, slot, now);
+            }
+
+            TickType_t deadline = slot->converting ? slot->next_poll : slot->next_start;
+            TickType_t remaining = is_due(deadline, now) ? 0 : deadline - now;
+            if (remaining < wait)
+            {
+                wait = remaining;
+            }
+            converting |= slot->converting;
+        }
+
+        // While nothing converts, the earliest deadline is a conversion start.
+        // One word, so sensor_scheduler_idle_ms() never sees a torn state
+        TickType_t quiet = (wait == portMAX_DELAY) ? portMAX_DELAY / 2 : wait;
+        __atomic_store_n(&idle_until, converting ? now : now + quiet, __ATOMIC_RELEASE);
+
+        notified = ulTaskNotifyTake(pdTRUE, wait) > 0;
+    }
+}
+
+void sensor_scheduler_notify(void)
+{
+    if (scheduler_task != NULL)
+    {
+        xTaskNotifyGive(scheduler_task);
+    }
+}
+
+esp_err_t sensor_scheduler_set_period(int sensor, uint32_t period_ms)
+{
+    if (sensor < 0 || sensor >= slot_count || period_ms == 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    sensor_slot_t *slot = &slots[sensor];
+    if (period_ms < slot->driver->min_interval_ms)
+    {
+        ESP_LOGW(TAG, "%s: period %lu ms raised to %lu ms", slot->driver->name,
+                 (unsigned long)period_ms, (unsigned long)slot->driver->min_interval_ms);
+        period_ms = slot->driver->min_interval_ms;
+    }
+
+    // Picked up by the scheduler task, the only one that touches the deadlines
+    __atomic_store_n(&slot->requested_period_ms, period_ms, __ATOMIC_RELEASE);
+    if (scheduler_task != NULL)
+    {
+        xTaskNotifyGive(scheduler_task);
+    }
+    return ESP_OK;
+}
+
+uint32_t sensor_scheduler_idle_ms(void)
+{
+    if (scheduler_task == NULL)
+    {
+        return UINT32_MAX;
+    }
+    TickType_t until = __atomic_load_n(&idle_until, __ATOMIC_ACQUIRE);
+    TickType_t now = xTaskGetTickCount();
+    return is_due(until, now) ? 0 : pdTICKS_TO_MS(until - now);
+}
+
+const char *sensor_scheduler_name(int sensor)
+{
+    if (sensor < 0 || sensor >= slot_count)
+    {
+        return "?";
+    }
+    return slots[sensor].driver->name;
+}
+
+esp_err_t sensor_scheduler_get_stats(int sensor, sensor_stats_t *stats)
+{
+    if (sensor < 0 || sensor >= slot_count || stats == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    taskENTER_CRITICAL(&stats_lock);
+    *stats = slots[sensor].stats;
+    taskEXIT_CRITICAL(&stats_lock);
+    return ESP_OK;
+}
@@ -0,0 +1,197 @@
+#ifndef SENSOR_SCHEDULER_H
+#define SENSOR_SCHEDULER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "sensor_driver.h"
+
+/**
+ * @file sensor_scheduler.h
+ * @brief Deadline scheduler for periodic sensor conversions
+ *
+ * Every registered sensor has its own period. The scheduler task sleeps
+ * until the earliest deadline of any sensor (next conversion start or next
+ * poll), so conversions of different sensors overlap instead of running
+ * back to back. Deadlines advance on a fixed grid like vTaskDelayUntil();
+ * a conversion that overruns its slot delays only that sensor, and missed
+ * slots are skipped rather than replayed.
+ *
+ * Results are handed to a single reading callback, which is where the
+ * application publishes them. Both callbacks run in the scheduler task, so
+ * that task is the single writer of whatever the callbacks update.
+ *
+ * Health:
+ * Each sensor keeps conversion and failure counters. Its health is derived
+ * from the time since the start of its last successful conversion:
+ *
+ *   OK        last conversion succeeded
+ *   DEGRADED  no success for degraded_after_ms
+ *   FAILED    no success for failed_after_ms, and every recovery step
+ *             below has been tried
+ *
+ * The health callback runs on every change, including the recovery to OK.
+ * A sensor that never succeeded is treated as if its last success was one
+ * period before its first conversion.
+ *
+ * Recovery:
+ * Every failed conversion moves the sensor one step up a recovery ladder,
+ * starting with the first failure:
+ *
+ *   REINIT       driver->recover() reconfigures the pins and peripheral;
+ *                the next conversion starts after min_interval_ms
+ *   POWER_CYCLE  driver->recover() switches the supply off and on; the
+ *                next conversion starts once the sensor has powered up
+ *   BACKOFF      the period doubles on every further failure, up to
+ *                SENSOR_SCHEDULER_MAX_BACKOFF times the configured period
+ *
+ * Steps the driver does not support are skipped. The first success resets
+ * the ladder and the period, and the time from the first failure to that
+ * success is recorded as PERF_STAGE_SENSOR_RECOVERY and in the stats.
+ * Reaching FAILED is what is left for the application (a restart).
+ */
+
+/**
+ * @brief Maximum number of registered sensors
+ */
+#define SENSOR_SCHEDULER_MAX_SENSORS    4
+
+/**
+ * @brief Poll interval after conversion_time_ms has elapsed (ms)
+ *
+ * Only matters for backends that do not call sensor_scheduler_notify().
+ */
+#define SENSOR_SCHEDULER_POLL_MS        50
+
+/**
+ * @brief Largest period multiplier of the BACKOFF recovery step
+ */
+#define SENSOR_SCHEDULER_MAX_BACKOFF    8
+
+typedef enum {
+    SENSOR_HEALTH_OK = 0,
+    SENSOR_HEALTH_DEGRADED,
+    SENSOR_HEALTH_FAILED
+} sensor_health_t;
+
+/**
+ * @brief How often a sensor is read and when it is considered unhealthy
+ */
+typedef struct {
+    uint32_t period_ms;             ///< Conversion period (raised to min_interval_ms)
+    uint32_t degraded_after_ms;     ///< Time without success before DEGRADED
+    uint32_t failed_after_ms;       ///< Time without success before FAILED
+} sensor_schedule_t;
+
+/**
+ * @brief Per-sensor counters since boot
+ */
+typedef struct {
+    uint32_t conversions;           ///< Completed conversions, successful or not
+    uint32_t failures;              ///< Failed conversions (including timeouts)
+    uint32_t consecutive_failures;  ///< Failures since the last success
+    uint32_t timeouts;              ///< Conversions abandoned after timeout_ms
+    uint32_t recoveries;            ///< Failure runs that ended in a success
+    uint32_t last_recovery_ms;      ///< First failure to success, last run
+    sensor_recovery_t recovery;     ///< Highest recovery step of the current run
+    sensor_health_t health;         ///< Current health
+} sensor_stats_t;
+
+/**
+ * @brief Called with every successful reading
+ *
+ * @param sensor  Id returned by sensor_scheduler_add()
+ * @param reading Reading; only valid for the duration of the call
+ * @param ctx     Pointer passed to sensor_scheduler_init()
+ */
+typedef void (*sensor_reading_cb_t)(int sensor, const sensor_reading_t *reading, void *ctx);
+
+/**
+ * @brief Called when a sensor's health changes
+ *
+ * @param sensor Id returned by sensor_scheduler_add()
+ * @param stats  Counters at the time of the change, including the new health
+ * @param ctx    Pointer passed to sensor_scheduler_init()
+ */
+typedef void (*sensor_health_cb_t)(int sensor, const sensor_stats_t *stats, void *ctx);
+
+/**
+ * @brief Set the callbacks; call once before sensor_scheduler_add()
+ *
+ * @param on_reading Required
+ * @param on_health  Optional (NULL)
+ * @param ctx        Passed to both callbacks
+ */
+esp_err_t sensor_scheduler_init(sensor_reading_cb_t on_reading, sensor_health_cb_t on_health,
+                                void *ctx);
+
+/**
+ * @brief Initialize a sensor and add it to the schedule
+ *
+ * Calls driver->init(). The first conversion starts as soon as
+ * sensor_scheduler_run() is running.
+ *
+ * @param driver     Backend description (must stay valid)
+ * @param driver_ctx Passed to every driver function
+ * @param schedule   Period and health thresholds (copied)
+ * @param sensor_id  Optional, receives the id used in callbacks
+ * @return ESP_OK on success
+ * @return ESP_ERR_NO_MEM if SENSOR_SCHEDULER_MAX_SENSORS are registered
+ * @return ESP_ERR_INVALID_STATE before sensor_scheduler_init() or once running
+ * @return The error of driver->init() if the sensor could not be set up
+ */
+esp_err_t sensor_scheduler_add(const sensor_driver_t *driver, void *driver_ctx,
+                               const sensor_schedule_t *schedule, int *sensor_id);
+
+/**
+ * @brief Run the schedule in the calling task; never returns
+ */
+void sensor_scheduler_run(void);
+
+/**
+ * @brief Ask the scheduler to poll running conversions now
+ *
+ * Safe to call from any task (not from an ISR). Before
+ * sensor_scheduler_run() it does nothing; no conversion is running yet.
+ */
+void sensor_scheduler_notify(void);
+
+/**
+ * @brief Change a sensor's period, also while the schedule is running
+ *
+ * Safe to call from any task (not from an ISR). The scheduler task takes
+ * the new period over on its next pass: the next conversion starts one new
+ * period after the start of the last one (right away if that is already
+ * past), and the grid continues from there. A running conversion is
+ * finished first.
+ *
+ * @param sensor    Id returned by sensor_scheduler_add()
+ * @param period_ms New period (raised to min_interval_ms)
+ * @return ESP_ERR_INVALID_ARG for an unknown id or a 0 period
+ */
+esp_err_t sensor_scheduler_set_period(int sensor, uint32_t period_ms);
+
+/**
+ * @brief Time until the scheduler next starts a conversion (ms)
+ *
+ * 0 while any conversion is running; UINT32_MAX while no scheduler task
+ * runs (nothing will convert). Flash erases and writes on either core
+ * stall the cache of both; callers use this to place them between
+ * conversions instead of delaying one (see ota_manager.h). Safe to call
+ * from any task.
+ */
+uint32_t sensor_scheduler_idle_ms(void);
+
+/**
+ * @brief Name of a registered sensor, or "?" for an unknown id
+ */
+const char *sensor_scheduler_name(int sensor);
+
+/**
+ * @brief Copy a sensor's counters; safe from any task
+ *
+ * @return ESP_ERR_INVALID_ARG for an unknown id
+ */
+esp_err_t sensor_scheduler_get_stats(int sensor, sensor_stats_t *stats);
+
+#endif // SENSOR_SCHEDULER_H
@@ -0,0 +1,127 @@
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+
+/**
+ * @file seqlock.h
+ * @brief Sequence lock for small structures shared between tasks and cores
+ *
+ * A seqlock publishes a small value (a sensor reading, a link status) so
+ * that readers on either core always get a consistent snapshot, without
+ * ever blocking and without priority inheritance:
+ *
+ *   writer                              reader
+ *   ------                              ------
+ *   sequence++   (now odd)              s0 = sequence
+ *   copy value in                       copy value out
+ *   sequence++   (now even)             retry if s0 was odd or sequence != s0
+ *
+ * - Readers never wait on the writer. A retry happens only when a write
+ *   overlapped the copy, which for a few dozen bytes is well under a
+ *   microsecond, and readers never fail.
+ * - Writers are serialized by a spinlock that is held only for the copy.
+ *   The critical section also stops a same-core reader from preempting a
+ *   half-finished write and spinning on it.
+ * - Writes must come from task context. Reads are allowed anywhere,
+ *   including ISRs.
+ *
+ * Only use it for plain data (no pointers that the reader dereferences)
+ * of a few dozen bytes. Larger payloads belong in a queue.
+ *
+ * Usage:
+ * @code
+ * static seqlock_t reading_lock = SEQLOCK_INITIALIZER;
+ * static reading_t reading;
+ *
+ * seqlock_store(&reading_lock, &reading, &fresh, sizeof(reading));   // writer
+ * seqlock_load(&reading_lock, &reading, &snapshot, sizeof(reading)); // reader
+ * @endcode
+ */
+
+typedef struct {
+    uint32_t sequence;          ///< Even = stable, odd = write in progress
+    portMUX_TYPE writer_lock;   ///< Serializes writers
+} seqlock_t;
+
+#define SEQLOCK_INITIALIZER { .sequence = 0, .writer_lock = portMUX_INITIALIZER_UNLOCKED }
+
+static inline void seqlock_init(seqlock_t *lock)
+{
+    lock->sequence = 0;
+    portMUX_INITIALIZE(&lock->writer_lock);
+}
+
+/**
+ * @brief Enter the write side; the protected value may then be modified in place
+ *
+ * Must be paired with seqlock_write_end(). Keep the section short: it runs
+ * with interrupts disabled on the writing core.
+ */
+static inline void seqlock_write_begin(seqlock_t *lock)
+{
+    taskENTER_CRITICAL(&lock->writer_lock);
+    __atomic_store_n(&lock->sequence, lock->sequence + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static inline void seqlock_write_end(seqlock_t *lock)
+{
+    __atomic_store_n(&lock->sequence, lock->sequence + 1, __ATOMIC_RELEASE);
+    taskEXIT_CRITICAL(&lock->writer_lock);
+}
+
+/**
+ * @brief Start a read; copy the value, then call seqlock_read_retry()
+ *
+ * @return Sequence number to hand to seqlock_read_retry()
+ */
+static inline uint32_t seqlock_read_begin(const seqlock_t *lock)
+{
+    uint32_t sequence;
+    while ((sequence = __atomic_load_n(&lock->sequence, __ATOMIC_ACQUIRE)) & 1u)
+    {
+        // Writer mid-copy on the other core
+    }
+    return sequence;
+}
+
+/**
+ * @brief Check whether the copy made since seqlock_read_begin() is torn
+ *
+ * @return true if a write overlapped the copy and the read must be repeated
+ */
+static inline bool seqlock_read_retry(const seqlock_t *lock, uint32_t sequence)
+{
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&lock->sequence, __ATOMIC_RELAXED) != sequence;
+}
+
+/**
+ * @brief Publish a new value: copy size bytes from src into the protected value
+ */
+static inline void seqlock_store(seqlock_t *lock, void *value, const void *src, size_t size)
+{
+    seqlock_write_begin(lock);
+    memcpy(value, src, size);
+    seqlock_write_end(lock);
+}
+
+/**
+ * @brief Take a consistent snapshot: copy size bytes of the protected value into dst
+ */
+static inline void seqlock_load(const seqlock_t *lock, const void *value, void *dst, size_t size)
+{
+    uint32_t sequence;
+    do
+    {
+        sequence = seqlock_read_begin(lock);
+        memcpy(dst, value, size);
+    } while (seqlock_read_retry(lock, sequence));
+}
+
+#endif // SEQLOCK_H
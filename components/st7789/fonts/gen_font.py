@@ -0,0 +1,329 @@
+#!/usr/bin/env python3
+"""
+Font generator for the ST7789 text renderer
+
+Rasterizes one stroke-font master (printable ASCII, 0x20-0x7E) at each
+requested pixel size and writes the glyphs as 2-bit alpha bitmaps to a C
+header included by st7789_font.c. Run by the component's CMakeLists at
+build time; standard library only.
+
+Strokes narrower than two pixels blur into grey, so the 8 px size is taken
+from the hand-hinted 8x8 bitmap master in font8x8.txt instead (alpha 0 or
+3, 9 px advance as before). Every other size comes from the strokes.
+
+Design space: a glyph is a set of polylines on an 8 x 11 unit box with the
+cap top at y = 0 and the baseline at y = 11 (x-height 4, descenders to 14).
+The box sits in a 16 x 11 unit cell (ADVANCE_UNITS), so one unit is
+size / 16 pixels and a size-16 font draws with 2-pixel strokes.
+
+Each glyph is cropped to its inked bounding box; rows are packed four
+pixels per byte, leftmost pixel in the top two bits, with alpha 0 the
+background and 3 the foreground.
+
+Usage:
+    python gen_font.py --bitmap font8x8.txt --output st7789_font_data.h --sizes 8 16 24 32
+"""
+
+import argparse
+import math
+import os
+import re
+
+CELL_UNITS = 16         # Cell height in design units
+ADVANCE_UNITS = 11      # Cell width in design units, must match ST7789_FONT_ADVANCE()
+ORIGIN_X = 1.5          # Design box origin inside the cell
+ORIGIN_Y = 1.0
+STROKE_RADIUS = 1.0     # Half the stroke width
+SUPERSAMPLE = 4         # Coverage samples per pixel along each axis
+ARC_STEP_DEG = 10
+BITMAP_SIZE = 8         # Size served by the bitmap master
+BITMAP_ADVANCE = 9      # Bitmap glyph width plus one column of spacing
+
+
+def arc(cx, cy, rx, ry, start, end):
+    """Points of an elliptical arc; angles in degrees, 0 = right, 90 = down"""
+    steps = max(1, int(math.ceil(abs(end - start) / ARC_STEP_DEG)))
+    return [(cx + rx * math.cos(math.radians(start + (end - start) * i / steps)),
+             cy + ry * math.sin(math.radians(start + (end - start) * i / steps)))
+            for i in range(steps + 1)]
+
+
+def ellipse(cx, cy, rx, ry):
+    return P(arc(cx, cy, rx, ry, 0, 360))
+
+
+def P(*parts):
+    """One polyline from points (x, y) and point lists (arcs)"""
+    points = []
+    for part in parts:
+        points.extend(part if isinstance(part, list) else [part])
+    return points
+
+
+def L(*coords):
+    """One polyline from flat coordinates x0, y0, x1, y1, ..."""
+    return [(coords[i], coords[i + 1]) for i in range(0, len(coords), 2)]
+
+
+def dot(x, y):
+    return [(x, y)]
+
+
+GLYPHS = {
+    ' ': [],
+    '!': [L(4, 0, 4, 7.5), dot(4, 10.5)],
+    '"': [L(2.5, 0, 2.5, 3), L(5.5, 0, 5.5, 3)],
+    '#': [L(3, 0, 2, 11), L(6, 0, 5, 11), L(0.5, 3.5, 8, 3.5), L(0, 7.5, 7.5, 7.5)],
+    '$': [P(arc(4, 2.75, 3.4, 2.25, 330, 90), arc(4, 7.75, 3.6, 2.75, 270, 510)), L(4, -0.5, 4, 11.5)],
+    '%': [ellipse(1.75, 2, 1.5, 2), ellipse(6.25, 9, 1.5, 2), L(7, 0, 1, 11)],
+    '&': [P((8, 11), (2.39, 4.44), arc(3.8, 2.6, 2.0, 2.6, 135, 405), (2.05, 6.33),
+            arc(3.6, 8.5, 3.1, 2.5, 240, 0), (8, 6.5))],
+    "'": [L(4, 0, 4, 3)],
+    '(': [P(arc(7.5, 5.5, 4, 6.8, 237, 123))],
+    ')': [P(arc(0.5, 5.5, 4, 6.8, -57, 57))],
+    '*': [L(4, 1, 4, 7), L(1.4, 2.5, 6.6, 5.5), L(6.6, 2.5, 1.4, 5.5)],
+    '+': [L(4, 3, 4, 10), L(0.5, 6.5, 7.5, 6.5)],
+    ',': [L(4.3, 10.2, 4.3, 11.3, 3, 13.2)],
+    '-': [L(1.5, 6.5, 6.5, 6.5)],
+    '.': [dot(4, 10.5)],
+    '/': [L(7, -0.5, 1, 11.5)],
+    '0': [ellipse(4, 5.5, 3.25, 5.5), L(6, 2.5, 2, 8.5)],
+    '1': [L(1.5, 2.5, 4.5, 0, 4.5, 11), L(1.5, 11, 7.5, 11)],
+    '2': [P(arc(4, 3.25, 3.5, 3.25, 195, 380), (0.5, 11), (7.75, 11))],
+    '3': [P(arc(4, 2.75, 3.25, 2.75, 200, 450), arc(4, 8.25, 3.6, 2.75, 270, 520))],
+    '4': [L(6, 11, 6, 0, 0.5, 8, 8, 8)],
+    '5': [P((7.5, 0), (1, 0), (0.6, 5.2), arc(4, 7.4, 3.6, 3.6, 215, 520))],
+    '6': [P(arc(4.2, 5.6, 3.7, 5.6, 300, 180), (0.5, 7.6), arc(4, 7.6, 3.5, 3.4, 180, 540))],
+    '7': [L(0.5, 0, 7.75, 0, 3, 11)],
+    '8': [ellipse(4, 2.8, 3.1, 2.8), ellipse(4, 8.25, 3.6, 2.75)],
+    '9': [P(arc(4, 3.4, 3.5, 3.4, 0, 360), (7.5, 5.5), arc(3.8, 5.5, 3.7, 5.5, 0, 120))],
+    ':': [dot(4, 5.5), dot(4, 10.5)],
+    ';': [dot(4, 5.5), L(4.3, 10.2, 4.3, 11.3, 3, 13.2)],
+    '<': [L(7, 2.5, 1, 6.5, 7, 10.5)],
+    '=': [L(1, 4.5, 7, 4.5), L(1, 8.5, 7, 8.5)],
+    '>': [L(1, 2.5, 7, 6.5, 1, 10.5)],
+    '?': [P(arc(4, 3, 3.3, 3, 190, 420), (4, 7.2), (4, 8)), dot(4, 10.5)],
+    '@': [ellipse(4, 6.5, 1.7, 2.2),
+          P((5.7, 4.3), (5.7, 8.4), (6.6, 9.2), (7.6, 8.4), (7.9, 5.5), arc(4, 5.5, 3.9, 5.5, 360, 70))],
+    'A': [L(0.25, 11, 4, 0, 7.75, 11), L(1.5, 7.3, 6.5, 7.3)],
+    'B': [P((1, 11), (1, 0), (4.5, 0), arc(4.5, 2.75, 2.9, 2.75, 270, 450), (1, 5.5)),
+          P((4.8, 5.5), arc(4.8, 8.25, 3.1, 2.75, 270, 450), (1, 11))],
+    'C': [P(arc(4.25, 5.5, 3.9, 5.5, 320, 40))],
+    'D': [P((1, 0), (1, 11), (3.5, 11), arc(3.5, 5.5, 4, 5.5, 90, -90), (1, 0))],
+    'E': [L(7.5, 0, 1, 0, 1, 11, 7.5, 11), L(1, 5.5, 6, 5.5)],
+    'F': [L(7.5, 0, 1, 0, 1, 11), L(1, 5.5, 6, 5.5)],
+    'G': [P(arc(4.2, 5.5, 3.9, 5.5, 320, 20), (7.9, 6.2), (4.6, 6.2))],
+    'H': [L(1, 0, 1, 11), L(7, 0, 7, 11), L(1, 5.5, 7, 5.5)],
+    'I': [L(4, 0, 4, 11), L(1.5, 0, 6.5, 0), L(1.5, 11, 6.5, 11)],
+    'J': [P((7, 0), (7, 7.5), arc(4, 7.5, 3, 3.5, 0, 180))],
+    'K': [L(1, 0, 1, 11), L(7.5, 0, 1, 7), L(3.2, 4.7, 7.5, 11)],
+    'L': [L(1, 0, 1, 11, 7.5, 11)],
+    'M': [L(0.5, 11, 0.75, 0, 4, 7.5, 7.25, 0, 7.5, 11)],
+    'N': [L(1, 11, 1, 0, 7, 11, 7, 0)],
+    'O': [ellipse(4, 5.5, 3.9, 5.5)],
+    'P': [P((1, 11), (1, 0), (4.5, 0), arc(4.5, 3, 3, 3, 270, 450), (1, 6))],
+    'Q': [ellipse(4, 5.5, 3.9, 5.5), L(4.8, 7.8, 8, 11.5)],
+    'R': [P((1, 11), (1, 0), (4.5, 0), arc(4.5, 3, 3, 3, 270, 450), (1, 6)), L(4, 6, 7.5, 11)],
+    'S': [P(arc(4, 2.75, 3.4, 2.75, 330, 90), arc(4, 8.25, 3.6, 2.75, 270, 510))],
+    'T': [L(0.25, 0, 7.75, 0), L(4, 0, 4, 11)],
+    'U': [P((1, 0), (1, 7.5), arc(4, 7.5, 3, 3.5, 180, 0), (7, 0))],
+    'V': [L(0.25, 0, 4, 11, 7.75, 0)],
+    'W': [L(0, 0, 1.75, 11, 4, 3.5, 6.25, 11, 8, 0)],
+    'X': [L(0.5, 0, 7.5, 11), L(7.5, 0, 0.5, 11)],
+    'Y': [L(0.25, 0, 4, 5.5, 7.75, 0), L(4, 5.5, 4, 11)],
+    'Z': [L(0.75, 0, 7.5, 0, 0.5, 11, 7.5, 11)],
+    '[': [L(6, -0.5, 3, -0.5, 3, 12, 6, 12)],
+    '\\': [L(1, -0.5, 7, 11.5)],
+    ']': [L(2, -0.5, 5, -0.5, 5, 12, 2, 12)],
+    '^': [L(1, 4, 4, 0, 7, 4)],
+    '_': [L(0, 13.5, 8, 13.5)],
+    '`': [L(3, 0, 5, 2)],
+    'a': [ellipse(3.9, 7.6, 3.1, 3.4), L(7, 4, 7, 11)],
+    'b': [L(1, 0, 1, 11), ellipse(4.3, 7.5, 3.3, 3.5)],
+    'c': [P(arc(4.3, 7.5, 3.5, 3.5, 320, 40))],
+    'd': [L(7, 0, 7, 11), ellipse(3.7, 7.5, 3.3, 3.5)],
+    'e': [P((0.8, 7.5), (7.5, 7.5), arc(4.15, 7.5, 3.35, 3.5, 360, 45))],
+    'f': [P(arc(5.5, 2.5, 2, 2.5, 330, 180), (3.5, 11)), L(1, 4.5, 6.5, 4.5)],
+    'g': [ellipse(3.8, 7.3, 3.2, 3.3), P((7, 4), (7, 12), arc(4, 12, 3, 2, 0, 160))],
+    'h': [L(1, 0, 1, 11), P(arc(4, 7, 3, 3, 180, 360), (7, 11))],
+    'i': [L(2, 4, 4, 4, 4, 11), L(1.5, 11, 6.5, 11), dot(4, 1.3)],
+    'j': [P((2.5, 4), (5, 4), (5, 12), arc(2.5, 12, 2.5, 2, 0, 140)), dot(5, 1.3)],
+    'k': [L(1, 0, 1, 11), L(6.8, 4, 1, 8.6), L(3.4, 6.7, 7.2, 11)],
+    'l': [L(2, 0, 4, 0, 4, 11), L(1.5, 11, 6.5, 11)],
+    'm': [L(0.5, 4, 0.5, 11), P(arc(2.35, 6.5, 1.85, 2.5, 180, 360), (4.2, 11)),
+          P(arc(6.05, 6.5, 1.85, 2.5, 180, 360), (7.9, 11))],
+    'n': [L(1, 4, 1, 11), P(arc(4, 7, 3, 3, 180, 360), (7, 11))],
+    'o': [ellipse(4, 7.5, 3.4, 3.5)],
+    'p': [L(1, 4, 1, 14), ellipse(4.3, 7.5, 3.3, 3.5)],
+    'q': [L(7, 4, 7, 14), ellipse(3.7, 7.5, 3.3, 3.5)],
+    'r': [L(1.5, 4, 1.5, 11), P(arc(5, 7.5, 3.5, 3.5, 180, 300))],
+    's': [P(arc(4, 5.75, 3, 1.75, 330, 90), arc(4, 9.25, 3.2, 1.75, 270, 510))],
+    't': [P((3.5, 1), (3.5, 9), arc(5.5, 9, 2, 2, 180, 60)), L(1, 4.2, 7, 4.2)],
+    'u': [P((1, 4), (1, 8), arc(4, 8, 3, 3, 180, 0)), L(7, 4, 7, 11)],
+    'v': [L(0.75, 4, 4, 11, 7.25, 4)],
+    'w': [L(0, 4, 1.9, 11, 4, 5.5, 6.1, 11, 8, 4)],
+    'x': [L(1, 4, 7, 11), L(7, 4, 1, 11)],
+    'y': [L(0.75, 4, 3.8, 11), L(7.25, 4, 2.3, 14)],
+    'z': [L(1, 4, 7, 4, 0.8, 11, 7.2, 11)],
+    '{': [L(6, -0.5, 4.8, -0.5, 4, 0.5, 4, 4.5, 2.5, 5.7, 4, 7, 4, 11, 4.8, 12, 6, 12)],
+    '|': [L(4, -0.5, 4, 13.5)],
+    '}': [L(2, -0.5, 3.2, -0.5, 4, 0.5, 4, 4.5, 5.5, 5.7, 4, 7, 4, 11, 3.2, 12, 2, 12)],
+    '~': [L(0.5, 7.2, 2, 5.8, 3.2, 6.2, 4.8, 7.2, 6, 7.4, 7.5, 5.8)],
+}
+
+FIRST_CHAR = 0x20
+LAST_CHAR = 0x7E
+
+
+def advance(size):
+    if size == BITMAP_SIZE:
+        return BITMAP_ADVANCE
+    return (size * ADVANCE_UNITS + CELL_UNITS // 2) // CELL_UNITS
+
+
+def load_bitmap(path):
+    """Row bytes per character code from the bitmap master"""
+    rows = [line for line in open(path) if line.lstrip().startswith('{')]
+    glyphs = {}
+    for code, line in zip(range(FIRST_CHAR, LAST_CHAR + 1), rows):
+        values = [int(v, 16) for v in re.findall(r'0x([0-9A-Fa-f]{2})', line.split('}')[0])]
+        assert len(values) == BITMAP_SIZE, line
+        glyphs[code] = values
+    if len(glyphs) != LAST_CHAR - FIRST_CHAR + 1:
+        raise ValueError('%s: expected %d glyphs' % (path, LAST_CHAR - FIRST_CHAR + 1))
+    return glyphs
+
+
+def expand_bitmap(rows):
+    """Alpha 0 or 3 per pixel of the bitmap cell, bit 0 = leftmost pixel"""
+    return [[3 if bits & (1 << x) else 0 for x in range(BITMAP_ADVANCE)] for bits in rows]
+
+
+def segment_distance_sq(px, py, ax, ay, bx, by):
+    dx, dy = bx - ax, by - ay
+    length_sq = dx * dx + dy * dy
+    t = 0.0 if length_sq == 0 else max(0.0, min(1.0, ((px - ax) * dx + (py - ay) * dy) / length_sq))
+    ex, ey = ax + t * dx - px, ay + t * dy - py
+    return ex * ex + ey * ey
+
+
+def rasterize(strokes, size):
+    """Alpha 0..3 per pixel of the width x size cell"""
+    width = advance(size)
+    scale = size / CELL_UNITS
+    sub = SUPERSAMPLE
+    radius = STROKE_RADIUS * scale
+    covered = [[False] * (width * sub) for _ in range(size * sub)]
+
+    for polyline in strokes:
+        points = [((x + ORIGIN_X) * scale, (y + ORIGIN_Y) * scale) for x, y in polyline]
+        segments = list(zip(points, points[1:])) or [(points[0], points[0])]
+        for (ax, ay), (bx, by) in segments:
+            # Only the subsamples within the segment's bounding box
+            x0 = max(0, int(math.floor((min(ax, bx) - radius) * sub)))
+            x1 = min(width * sub, int(math.ceil((max(ax, bx) + radius) * sub)))
+            y0 = max(0, int(math.floor((min(ay, by) - radius) * sub)))
+            y1 = min(size * sub, int(math.ceil((max(ay, by) + radius) * sub)))
+            for sy in range(y0, y1):
+                py = (sy + 0.5) / sub
+                row = covered[sy]
+                for sx in range(x0, x1):
+                    if not row[sx] and segment_distance_sq((sx + 0.5) / sub, py, ax, ay, bx, by) <= radius * radius:
+                        row[sx] = True
+
+    alpha = [[0] * width for _ in range(size)]
+    for y in range(size):
+        for x in range(width):
+            hits = sum(covered[y * sub + j][x * sub + i] for j in range(sub) for i in range(sub))
+            alpha[y][x] = (hits * 3 + (sub * sub) // 2) // (sub * sub)
+    return alpha
+
+
+def crop(alpha):
+    """(x, y, w, h) of the inked pixels, all zero for a blank glyph"""
+    rows = [y for y, row in enumerate(alpha) if any(row)]
+    cols = [x for x in range(len(alpha[0])) if any(row[x] for row in alpha)]
+    if not rows:
+        return 0, 0, 0, 0
+    return cols[0], rows[0], cols[-1] - cols[0] + 1, rows[-1] - rows[0] + 1
+
+
+def pack(alpha, x, y, w, h):
+    data = bytearray()
+    for row in alpha[y:y + h]:
+        pixels = row[x:x + w] + [0] * (-w % 4)
+        for i in range(0, len(pixels), 4):
+            data.append(pixels[i] << 6 | pixels[i + 1] << 4 | pixels[i + 2] << 2 | pixels[i + 3])
+    return data
+
+
+def char_name(code):
+    c = chr(code)
+    return 'space' if c == ' ' else "'\\\\'" if c == '\\' else "'%s'" % c
+
+
+def generate(sizes, bitmap):
+    out = ['/**',
+           ' * @file st7789_font_data.h',
+           ' * @brief Generated by fonts/gen_font.py - do not edit',
+           ' *',
+           ' * Included by st7789_font.c only. Sizes: %s px' % ', '.join(str(s) for s in sizes),
+           ' */',
+           '',
+           '#include "st7789_font.h"',
+           '']
+    fonts = []
+    for size in sizes:
+        data = bytearray()
+        records = []
+        for code in range(FIRST_CHAR, LAST_CHAR + 1):
+            if size == BITMAP_SIZE:
+                alpha = expand_bitmap(bitmap[code])
+            else:
+                alpha = rasterize(GLYPHS[chr(code)], size)
+            x, y, w, h = crop(alpha)
+            records.append((len(data), x, y, w, h, code))
+            data += pack(alpha, x, y, w, h)
+        assert len(data) <= 0xFFFF
+
+        out.append('static const uint8_t font_alpha_%d[%d] = {' % (size, len(data)))
+        for i in range(0, len(data), 16):
+            out.append('    ' + ' '.join('0x%02X,' % b for b in data[i:i + 16]))
+        out.append('};')
+        out.append('')
+        out.append('static const st7789_glyph_t font_glyphs_%d[ST7789_FONT_GLYPHS] = {' % size)
+        for offset, x, y, w, h, code in records:
+            out.append('    { %5d, %2d, %2d, %2d, %2d },   // %s' % (offset, x, y, w, h, char_name(code)))
+        out.append('};')
+        out.append('')
+        out.append('#define FONT_DATA_ADVANCE_%d %d' % (size, advance(size)))
+        out.append('')
+        fonts.append(size)
+
+    out.append('static const st7789_font_data_t font_data[] = {')
+    for size in fonts:
+        out.append('    { %d, FONT_DATA_ADVANCE_%d, font_glyphs_%d, font_alpha_%d },' % (size, size, size, size))
+    out.append('};')
+    out.append('')
+    return '\n'.join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument('--output', required=True, help='Header to write')
+    parser.add_argument('--bitmap', default=os.path.join(os.path.dirname(os.path.abspath(__file__)), 'font8x8.txt'),
+                        help='Bitmap master for the %d px size' % BITMAP_SIZE)
+    parser.add_argument('--sizes', type=int, nargs='+', default=[8, 16, 24, 32], help='Pixel sizes')
+    args = parser.parse_args()
+
+    missing = [chr(c) for c in range(FIRST_CHAR, LAST_CHAR + 1) if chr(c) not in GLYPHS]
+    if missing:
+        parser.error('no stroke definition for %r' % ''.join(missing))
+
+    text = generate(args.sizes, load_bitmap(args.bitmap))
+    with open(args.output, 'w', newline='\n') as f:
+        f.write(text)
+
+
+if __name__ == '__main__':
+    main()
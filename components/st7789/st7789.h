@@ -10,10 +10,35 @@
  * 
  * High-performance driver for ST7789-based 240x240 TFT displays.
  * Optimized for displays without CS pin using SPI communication.
+ * Wire traffic goes through st7789_transport.h (VSPI + DMA by default).
+ * 
+ * All drawing functions render into an off-screen buffer and only record
+ * which regions changed. Call st7789_flush() to make the changes visible.
  * 
  * GPIO pin assignments are defined in pinout.h for centralized management.
  */ 
 
+/**
+ * @brief Text sizes, named after the cell height in pixels
+ * 
+ * All sizes cover printable ASCII (32-126) and are monospaced. The glyphs
+ * are generated at build time (fonts/gen_font.py) as 2-bit alpha bitmaps
+ * and blended against the background colour when drawn.
+ */
+typedef enum {
+    ST7789_FONT_8 = 0,  ///< 8x8 bitmap font, crisp at small sizes
+    ST7789_FONT_16,     ///< Anti-aliased, dashboard fields and messages
+    ST7789_FONT_24,     ///< Anti-aliased
+    ST7789_FONT_32,     ///< Anti-aliased
+    ST7789_FONT_COUNT
+} st7789_font_t;
+
+// Horizontal distance between characters (cell width) per font size
+#define ST7789_FONT_8_ADVANCE      9
+#define ST7789_FONT_16_ADVANCE     11
+#define ST7789_FONT_24_ADVANCE     17
+#define ST7789_FONT_32_ADVANCE     22
+
 /**
  * @brief Initialize the ST7789 display driver
  * 
@@ -45,7 +70,7 @@ void st7789_draw_pixel(uint16_t x, uint16_t y, uint16_t color);
 void st7789_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
 
 /**
- * @brief Draw a single character at specified position
+ * @brief Draw a single character at specified position (ST7789_FONT_8)
  * 
  * @param x X coordinate for character placement
  * @param y Y coordinate for character placement  
@@ -56,7 +81,7 @@ void st7789_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t c
 void st7789_draw_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t bg_color);
 
 /**
- * @brief Draw a text string at specified position
+ * @brief Draw a text string at specified position (ST7789_FONT_8)
  * 
  * Supports newline (\n) and carriage return (\r) characters.
  * Automatically wraps text to next line if it exceeds display width.
@@ -69,6 +94,34 @@ void st7789_draw_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t b
  */
 void st7789_draw_string(uint16_t x, uint16_t y, const char* str, uint16_t color, uint16_t bg_color);
 
+/**
+ * @brief Draw a text string in any font size
+ * 
+ * Every character paints its whole cell (advance x height), so no clear is
+ * needed before overwriting text of the same length. Supports newline (\n)
+ * and carriage return (\r); lines are 1.25 cell heights apart and wrap at
+ * the display width. Characters outside printable ASCII are skipped.
+ * 
+ * @param x X coordinate for text start position
+ * @param y Y coordinate for text start position
+ * @param str Null-terminated string to draw
+ * @param font Text size
+ * @param color 16-bit RGB565 foreground color
+ * @param bg_color 16-bit RGB565 background color
+ */
+void st7789_draw_text(uint16_t x, uint16_t y, const char *str, st7789_font_t font,
+                      uint16_t color, uint16_t bg_color);
+
+/**
+ * @brief Cell width of a font size, 0 for an invalid size
+ */
+uint16_t st7789_font_advance(st7789_font_t font);
+
+/**
+ * @brief Cell height of a font size, 0 for an invalid size
+ */
+uint16_t st7789_font_height(st7789_font_t font);
+
 /**
  * @brief Clear entire screen with specified color
  * 
@@ -77,34 +130,41 @@ void st7789_draw_string(uint16_t x, uint16_t y, const char* str, uint16_t color,
 void st7789_clear_screen(uint16_t color);
 
 /**
- * @brief Draw a single large character (16x16) at specified position
+ * @brief Draw a single large character (ST7789_FONT_16) at specified position
  * 
- * Supports numbers (0-9), period (.), percent (%), colon (:), and selected uppercase letters (A,C,D,E,H,I,M,N,P,R,S,T,U,Y).
+ * Paints the whole ST7789_LARGE_FONT_WIDTH x ST7789_LARGE_FONT_HEIGHT cell.
  * Perfect for displaying sensor readings and labels.
  * 
  * @param x X coordinate for character placement
  * @param y Y coordinate for character placement  
- * @param c Character to draw (supported characters only)
+ * @param c Character to draw (printable ASCII 32-126)
  * @param color 16-bit RGB565 foreground color
  * @param bg_color 16-bit RGB565 background color
  */
 void st7789_draw_large_char(uint16_t x, uint16_t y, char c, uint16_t color, uint16_t bg_color);
 
 /**
- * @brief Draw a text string with large font (16x16)
+ * @brief Draw a text string with large font (ST7789_FONT_16)
  * 
  * Supports newline (\n) and carriage return (\r) characters.
  * Automatically wraps text to next line if it exceeds display width.
- * Character set includes numbers, period, percent, colon, and selected uppercase letters.
  * 
  * @param x X coordinate for text start position
  * @param y Y coordinate for text start position
- * @param str Null-terminated string to draw (supported characters only)
+ * @param str Null-terminated string to draw
  * @param color 16-bit RGB565 foreground color
  * @param bg_color 16-bit RGB565 background color
  */
 void st7789_draw_large_string(uint16_t x, uint16_t y, const char* str, uint16_t color, uint16_t bg_color);
 
+/**
+ * @brief Push all regions drawn since the last flush to the display
+ * 
+ * Only dirty rectangles are transmitted, each as one address window and
+ * DMA bursts from the off-screen buffer.
+ */
+void st7789_flush(void);
+
 /**
  * @brief Run display functionality test
  * 
@@ -116,11 +176,16 @@ void st7789_test(void);
 /**
  * @brief Test large font functionality with sensor-style display
  * 
- * Demonstrates the 16x16 large font capabilities by showing sample
- * sensor readings and testing the complete character set.
+ * Shows sample sensor readings in the large font, then one line of
+ * every font size.
  */
 void st7789_large_font_test(void);
 
+// Large font cell geometry, matching st7789_draw_large_string() layout
+#define ST7789_LARGE_FONT_WIDTH    ST7789_FONT_16_ADVANCE  // Cell width in pixels
+#define ST7789_LARGE_FONT_HEIGHT   16                      // Cell height in pixels
+#define ST7789_LARGE_CHAR_ADVANCE  ST7789_FONT_16_ADVANCE  // Horizontal distance between characters
+
 // Common RGB565 color definitions for convenience
 #define ST7789_BLACK   0x0000  // Black
 #define ST7789_WHITE   0xFFFF  // White  
@@ -0,0 +1,166 @@
+/**
+ * @file st7789_font.c
+ * @brief Palette-blended text rendering from the generated fonts
+ *
+ * See st7789_font.h for the font format.
+ */
+
+#include "st7789_font.h"
+#include "st7789_font_data.h"       // Generated by fonts/gen_font.py
+#include "st7789_framebuffer.h"
+#include "st7789_glyph_cache.h"
+#include "st7789_transport.h"
+#include <string.h>
+
+_Static_assert(sizeof(font_data) / sizeof(font_data[0]) == ST7789_FONT_COUNT,
+               "Generated font sizes must match st7789_font_t");
+_Static_assert(FONT_DATA_ADVANCE_8 == ST7789_FONT_8_ADVANCE &&
+               FONT_DATA_ADVANCE_16 == ST7789_FONT_16_ADVANCE &&
+               FONT_DATA_ADVANCE_24 == ST7789_FONT_24_ADVANCE &&
+               FONT_DATA_ADVANCE_32 == ST7789_FONT_32_ADVANCE,
+               "Generated advances must match st7789.h");
+_Static_assert(ST7789_GLYPH_CACHE_GLYPHS == ST7789_FONT_GLYPHS,
+               "Glyph cache size must match the font character set");
+
+/**
+ * @brief Glyph and blended colours passed to the row renderer
+ */
+typedef struct {
+    const st7789_glyph_t *glyph;
+    const uint8_t *alpha;       ///< First row of the glyph bitmap
+    uint16_t palette[4];        ///< Wire-order colour per alpha value, 0 = background
+} glyph_blend_ctx_t;
+
+/**
+ * @brief Mix two RGB565 colours channel by channel, @p alpha in 0..3
+ */
+static uint16_t blend(uint16_t fg, uint16_t bg, unsigned alpha)
+{
+    unsigned r = (((fg >> 11) & 0x1F) * alpha + ((bg >> 11) & 0x1F) * (3 - alpha) + 1) / 3;
+    unsigned g = (((fg >> 5) & 0x3F) * alpha + ((bg >> 5) & 0x3F) * (3 - alpha) + 1) / 3;
+    unsigned b = ((fg & 0x1F) * alpha + (bg & 0x1F) * (3 - alpha) + 1) / 3;
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+// Expand one row of a cell: background outside the inked box, palette inside
+static void render_blend_row(const void *ctx, uint16_t row, uint16_t col, uint16_t count, uint16_t *dst)
+{
+    const glyph_blend_ctx_t *blend_ctx = ctx;
+    const st7789_glyph_t *glyph = blend_ctx->glyph;
+    const uint16_t *palette = blend_ctx->palette;
+
+    if (row < glyph->y || row >= glyph->y + glyph->h)
+    {
+        for (uint16_t i = 0; i < count; i++)
+        {
+            dst[i] = palette[0];
+        }
+        return;
+    }
+
+    const uint8_t *bits = blend_ctx->alpha + (row - glyph->y) * ((glyph->w + 3) / 4);
+    for (uint16_t i = 0; i < count; i++)
+    {
+        unsigned x = (unsigned)(col + i) - glyph->x;   // Wraps for pixels left of the box
+        dst[i] = (x < glyph->w) ? palette[(bits[x >> 2] >> (6 - 2 * (x & 3))) & 3] : palette[0];
+    }
+}
+
+// Copy one row of a pre-expanded cell from the glyph cache
+typedef struct {
+    const uint16_t *block;
+    uint16_t width;
+} cached_cell_t;
+
+static void render_cached_row(const void *ctx, uint16_t row, uint16_t col, uint16_t count, uint16_t *dst)
+{
+    const cached_cell_t *cell = ctx;
+    memcpy(dst, &cell->block[row * cell->width + col], count * sizeof(uint16_t));
+}
+
+void st7789_font_draw_char(st7789_font_t font, uint16_t x, uint16_t y, char c,
+                           uint16_t color, uint16_t bg_color)
+{
+    unsigned index = (unsigned char)c - ST7789_FONT_FIRST_CHAR;
+    if (font >= ST7789_FONT_COUNT || index >= ST7789_FONT_GLYPHS)
+    {
+        return;
+    }
+
+    const st7789_font_data_t *data = &font_data[font];
+    const st7789_glyph_t *glyph = &data->glyphs[index];
+    glyph_blend_ctx_t blend_ctx = {
+        .glyph = glyph,
+        .alpha = data->alpha + glyph->offset,
+    };
+    for (unsigned alpha = 0; alpha < 4; alpha++)
+    {
+        blend_ctx.palette[alpha] = ST7789_SWAP_BYTES(blend(color, bg_color, alpha));
+    }
+
+    // Fast path: the cell expanded once into the glyph cache, copied row by row
+    const uint16_t *block = st7789_glyph_cache_get(font, index, color, bg_color, data->advance, data->size,
+                                                   render_blend_row, &blend_ctx);
+    if (block != NULL)
+    {
+        cached_cell_t cell = { block, data->advance };
+        st7789_fb_draw(x, y, data->advance, data->size, render_cached_row, &cell);
+        return;
+    }
+
+    // Cache budget exhausted: blend straight into the band
+    st7789_fb_draw(x, y, data->advance, data->size, render_blend_row, &blend_ctx);
+}
+
+void st7789_draw_text(uint16_t x, uint16_t y, const char *str, st7789_font_t font,
+                      uint16_t color, uint16_t bg_color)
+{
+    if (font >= ST7789_FONT_COUNT)
+    {
+        return;
+    }
+
+    uint16_t advance = font_data[font].advance;
+    uint16_t height = font_data[font].size;
+    uint16_t line_height = height + height / 4;
+    uint16_t cur_x = x;
+    uint16_t cur_y = y;
+
+    for (; *str && cur_y + height <= ST7789_FB_HEIGHT; str++)
+    {
+        if (*str == '\n')
+        {
+            cur_x = x;
+            cur_y += line_height;
+            continue;
+        }
+        if (*str == '\r')
+        {
+            cur_x = x;
+            continue;
+        }
+
+        if (cur_x + advance <= ST7789_FB_WIDTH)
+        {
+            st7789_font_draw_char(font, cur_x, cur_y, *str, color, bg_color);
+        }
+        cur_x += advance;
+
+        // Wrap to the next line if the next character would not fit
+        if (cur_x + advance > ST7789_FB_WIDTH)
+        {
+            cur_x = x;
+            cur_y += line_height;
+        }
+    }
+}
+
+uint16_t st7789_font_advance(st7789_font_t font)
+{
+    return (font < ST7789_FONT_COUNT) ? font_data[font].advance : 0;
+}
+
+uint16_t st7789_font_height(st7789_font_t font)
+{
+    return (font < ST7789_FONT_COUNT) ? font_data[font].size : 0;
+}
@@ -0,0 +1,58 @@
+#ifndef ST7789_FONT_H
+#define ST7789_FONT_H
+
+#include <stdint.h>
+#include "st7789.h"
+
+/**
+ * @file st7789_font.h
+ * @brief Generated 2-bit alpha fonts and their renderer
+ *
+ * fonts/gen_font.py rasterizes the font masters at build time into
+ * st7789_font_data.h (in the build directory): one st7789_font_data_t per
+ * st7789_font_t size, each with a glyph record per printable ASCII
+ * character and a shared alpha array. A glyph is stored cropped to its
+ * inked box, four pixels per byte, leftmost pixel in the top two bits.
+ *
+ * Drawing a glyph paints its whole advance x height cell, so text always
+ * overwrites what was behind it. Alpha 0..3 selects one of four colours
+ * blended once per draw from the fg/bg pair; expanded cells are kept in
+ * the glyph cache (st7789_glyph_cache.h), so a repeated character costs a
+ * row copy like any other cached block.
+ *
+ * Internal to the st7789 component.
+ */
+
+#define ST7789_FONT_FIRST_CHAR  0x20    ///< Space
+#define ST7789_FONT_GLYPHS      95      ///< Space to tilde
+
+/**
+ * @brief Cropped glyph bitmap within its cell
+ */
+typedef struct {
+    uint16_t offset;    ///< First byte in the font's alpha array
+    uint8_t x;          ///< Left edge of the inked box within the cell
+    uint8_t y;          ///< Top edge of the inked box within the cell
+    uint8_t w;          ///< Inked box width, 0 for a blank glyph
+    uint8_t h;          ///< Inked box height
+} st7789_glyph_t;
+
+/**
+ * @brief One generated font size
+ */
+typedef struct {
+    uint8_t size;                   ///< Cell height in pixels
+    uint8_t advance;                ///< Cell width in pixels
+    const st7789_glyph_t *glyphs;   ///< ST7789_FONT_GLYPHS records
+    const uint8_t *alpha;           ///< Packed 2-bit rows, (w + 3) / 4 bytes each
+} st7789_font_data_t;
+
+/**
+ * @brief Draw one character cell into the off-screen buffer
+ *
+ * Characters outside space..tilde are skipped.
+ */
+void st7789_font_draw_char(st7789_font_t font, uint16_t x, uint16_t y, char c,
+                           uint16_t color, uint16_t bg_color);
+
+#endif // ST7789_FONT_H
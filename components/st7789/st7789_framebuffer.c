@@ -0,0 +1,353 @@
+/**
+ * @file st7789_framebuffer.c
+ * @brief Banded off-screen render target for the ST7789 display
+ *
+ * See st7789_framebuffer.h for the memory model. Every band is in one of
+ * three modes:
+ *
+ * - UNIFORM:  logical content is fill_color everywhere. The band may still
+ *             own a buffer from earlier use; its contents are then stale.
+ * - BUFFERED: the buffer holds the exact band content.
+ * - DIRECT:   no buffer could be obtained; draws went straight to the panel
+ *             and the band content is unknown until it is filled again.
+ *
+ * Dirty rectangles use absolute, inclusive screen coordinates.
+ */
+
+#include "st7789_framebuffer.h"
+#include "st7789_transport.h"
+#include "esp_log.h"
+#include <string.h>
+
+static const char *TAG = "ST7789_FB";
+
+/**
+ * @brief ST7789 window commands (see st7789.c for the full command set)
+ */
+#define ST7789_CASET    0x2A    ///< Column address set
+#define ST7789_RASET    0x2B    ///< Row address set
+#define ST7789_RAMWR    0x2C    ///< Memory write
+
+/**
+ * @brief Scratch buffer size for direct (unbuffered) drawing, in pixels
+ *
+ * Four full rows; enough for a whole 16 px glyph cell in a single transfer.
+ */
+#define ST7789_FB_SCRATCH_PIXELS    (ST7789_FB_WIDTH * 4)
+
+typedef enum
+{
+    BAND_UNIFORM,
+    BAND_BUFFERED,
+    BAND_DIRECT
+} fb_band_mode_t;
+
+typedef struct
+{
+    uint16_t *pixels;           ///< ST7789_FB_WIDTH * ST7789_FB_BAND_ROWS wire-order pixels, or NULL
+    uint16_t fill_color;        ///< Native colour of a UNIFORM band
+    fb_band_mode_t mode;        ///< Current band mode
+    bool dirty;                 ///< Dirty rectangle below is valid
+    uint16_t dirty_x0;          ///< Dirty rectangle, inclusive screen coordinates
+    uint16_t dirty_y0;
+    uint16_t dirty_x1;
+    uint16_t dirty_y1;
+} fb_band_t;
+
+static fb_band_t bands[ST7789_FB_BAND_COUNT];
+static uint8_t bands_allocated = 0;         ///< Bands that own a pixel buffer
+static uint16_t *scratch = NULL;            ///< DMA buffer for DIRECT drawing
+static bool dma_in_flight = false;          ///< Band or scratch memory may still be on the wire
+
+/**
+ * @brief Row renderer producing a solid colour (ctx = wire-order colour)
+ */
+static void render_solid_row(const void *ctx, uint16_t row, uint16_t col, uint16_t count, uint16_t *dst)
+{
+    uint16_t wire = *(const uint16_t *)ctx;
+    for (uint16_t i = 0; i < count; i++)
+    {
+        dst[i] = wire;
+    }
+}
+
+static void set_address_window(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    uint16_t x_end = x + w - 1;
+    uint16_t y_end = y + h - 1;
+    uint8_t params[4];
+
+    st7789_transport_write_command(ST7789_CASET);
+    params[0] = x >> 8;     params[1] = x & 0xFF;
+    params[2] = x_end >> 8; params[3] = x_end & 0xFF;
+    st7789_transport_write_data(params, sizeof(params));
+
+    st7789_transport_write_command(ST7789_RASET);
+    params[0] = y >> 8;     params[1] = y & 0xFF;
+    params[2] = y_end >> 8; params[3] = y_end & 0xFF;
+    st7789_transport_write_data(params, sizeof(params));
+
+    st7789_transport_write_command(ST7789_RAMWR);
+}
+
+/**
+ * @brief Make sure no DMA transfer still reads band or scratch memory
+ */
+static void wait_for_dma(void)
+{
+    if (dma_in_flight)
+    {
+        st7789_transport_wait_idle();
+        dma_in_flight = false;
+    }
+}
+
+static void mark_dirty(fb_band_t *band, uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1)
+{
+    if (!band->dirty)
+    {
+        band->dirty = true;
+        band->dirty_x0 = x0;
+        band->dirty_y0 = y0;
+        band->dirty_x1 = x1;
+        band->dirty_y1 = y1;
+        return;
+    }
+
+    if (x0 < band->dirty_x0) band->dirty_x0 = x0;
+    if (y0 < band->dirty_y0) band->dirty_y0 = y0;
+    if (x1 > band->dirty_x1) band->dirty_x1 = x1;
+    if (y1 > band->dirty_y1) band->dirty_y1 = y1;
+}
+
+/**
+ * @brief Send one band's dirty rectangle to the panel
+ */
+static void flush_band(int index)
+{
+    fb_band_t *band = &bands[index];
+    if (!band->dirty)
+    {
+        return;
+    }
+
+    uint16_t w = band->dirty_x1 - band->dirty_x0 + 1;
+    uint16_t h = band->dirty_y1 - band->dirty_y0 + 1;
+    uint16_t top = index * ST7789_FB_BAND_ROWS;
+
+    set_address_window(band->dirty_x0, band->dirty_y0, w, h);
+
+    if (band->mode == BAND_UNIFORM)
+    {
+        st7789_transport_fill(band->fill_color, (uint32_t)w * h);
+    }
+    else if (w == ST7789_FB_WIDTH)
+    {
+        // Full-width rows are contiguous in the band: one burst
+        st7789_transport_write_pixels(&band->pixels[(band->dirty_y0 - top) * ST7789_FB_WIDTH],
+                                      (size_t)w * h);
+    }
+    else
+    {
+        // One transfer per row segment, all inside the same RAMWR window
+        for (uint16_t y = band->dirty_y0; y <= band->dirty_y1; y++)
+        {
+            st7789_transport_write_pixels(&band->pixels[(y - top) * ST7789_FB_WIDTH + band->dirty_x0], w);
+        }
+    }
+
+    band->dirty = false;
+    dma_in_flight = true;
+}
+
+/**
+ * @brief Give a band a valid pixel buffer, or switch it to DIRECT mode
+ *
+ * @return true if the band is BUFFERED afterwards
+ */
+static bool prepare_band_buffer(int index)
+{
+    fb_band_t *band = &bands[index];
+
+    if (band->mode == BAND_BUFFERED)
+    {
+        return true;
+    }
+    if (band->mode == BAND_DIRECT)
+    {
+        return false;
+    }
+
+    // UNIFORM: materialize the fill colour into a buffer
+    if (band->pixels == NULL && bands_allocated < ST7789_FB_BAND_BUDGET)
+    {
+        band->pixels = st7789_transport_alloc_pixels(ST7789_FB_WIDTH * ST7789_FB_BAND_ROWS);
+        if (band->pixels != NULL)
+        {
+            bands_allocated++;
+        }
+        else
+        {
+            ESP_LOGW(TAG, "Band %d buffer allocation failed, drawing directly", index);
+        }
+    }
+
+    if (band->pixels == NULL)
+    {
+        // Pending uniform fill must reach the panel before direct draws
+        flush_band(index);
+        band->mode = BAND_DIRECT;
+        return false;
+    }
+
+    uint16_t wire = ST7789_SWAP_BYTES(band->fill_color);
+    for (int i = 0; i < ST7789_FB_WIDTH * ST7789_FB_BAND_ROWS; i++)
+    {
+        band->pixels[i] = wire;
+    }
+    band->mode = BAND_BUFFERED;
+    return true;
+}
+
+/**
+ * @brief Render a clipped span of rows straight to the panel
+ */
+static void draw_direct(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
+                        uint16_t prim_x, uint16_t prim_y,
+                        st7789_fb_renderer_t renderer, const void *ctx)
+{
+    uint16_t w = x1 - x0 + 1;
+    uint16_t rows_per_chunk = ST7789_FB_SCRATCH_PIXELS / w;
+
+    set_address_window(x0, y0, w, y1 - y0 + 1);
+
+    for (uint16_t y = y0; y <= y1; )
+    {
+        wait_for_dma();
+
+        uint16_t rows = 0;
+        while (rows < rows_per_chunk && y <= y1)
+        {
+            renderer(ctx, y - prim_y, x0 - prim_x, w, &scratch[rows * w]);
+            rows++;
+            y++;
+        }
+
+        st7789_transport_write_pixels(scratch, (size_t)rows * w);
+        dma_in_flight = true;
+    }
+}
+
+esp_err_t st7789_fb_init(uint16_t color)
+{
+    if (scratch == NULL)
+    {
+        scratch = st7789_transport_alloc_pixels(ST7789_FB_SCRATCH_PIXELS);
+        if (scratch == NULL)
+        {
+            ESP_LOGE(TAG, "Failed to allocate direct-draw scratch buffer");
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    for (int i = 0; i < ST7789_FB_BAND_COUNT; i++)
+    {
+        bands[i].mode = BAND_UNIFORM;
+        bands[i].fill_color = color;
+        bands[i].dirty = false;
+        mark_dirty(&bands[i], 0, i * ST7789_FB_BAND_ROWS,
+                   ST7789_FB_WIDTH - 1, (i + 1) * ST7789_FB_BAND_ROWS - 1);
+    }
+
+    ESP_LOGI(TAG, "Banded framebuffer: %d bands of %d rows, budget %d x %d bytes",
+             ST7789_FB_BAND_COUNT, ST7789_FB_BAND_ROWS, ST7789_FB_BAND_BUDGET,
+             ST7789_FB_WIDTH * ST7789_FB_BAND_ROWS * 2);
+    return ESP_OK;
+}
+
+void st7789_fb_draw(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                    st7789_fb_renderer_t renderer, const void *ctx)
+{
+    if (w == 0 || h == 0 || x >= ST7789_FB_WIDTH || y >= ST7789_FB_HEIGHT)
+    {
+        return;
+    }
+
+    uint16_t x1 = (x + w > ST7789_FB_WIDTH) ? ST7789_FB_WIDTH - 1 : x + w - 1;
+    uint16_t y1 = (y + h > ST7789_FB_HEIGHT) ? ST7789_FB_HEIGHT - 1 : y + h - 1;
+    uint16_t span = x1 - x + 1;
+
+    wait_for_dma();
+
+    for (int index = y / ST7789_FB_BAND_ROWS; index <= y1 / ST7789_FB_BAND_ROWS; index++)
+    {
+        uint16_t top = index * ST7789_FB_BAND_ROWS;
+        uint16_t row0 = (y > top) ? y : top;
+        uint16_t row1 = (y1 < top + ST7789_FB_BAND_ROWS - 1) ? y1 : top + ST7789_FB_BAND_ROWS - 1;
+
+        if (!prepare_band_buffer(index))
+        {
+            draw_direct(x, row0, x1, row1, x, y, renderer, ctx);
+            continue;
+        }
+
+        fb_band_t *band = &bands[index];
+        for (uint16_t row = row0; row <= row1; row++)
+        {
+            renderer(ctx, row - y, 0, span, &band->pixels[(row - top) * ST7789_FB_WIDTH + x]);
+        }
+        mark_dirty(band, x, row0, x1, row1);
+    }
+}
+
+void st7789_fb_fill(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+{
+    if (w == 0 || h == 0 || x >= ST7789_FB_WIDTH || y >= ST7789_FB_HEIGHT)
+    {
+        return;
+    }
+
+    uint16_t x1 = (x + w > ST7789_FB_WIDTH) ? ST7789_FB_WIDTH - 1 : x + w - 1;
+    uint16_t y1 = (y + h > ST7789_FB_HEIGHT) ? ST7789_FB_HEIGHT - 1 : y + h - 1;
+    uint16_t wire = ST7789_SWAP_BYTES(color);
+
+    for (int index = y / ST7789_FB_BAND_ROWS; index <= y1 / ST7789_FB_BAND_ROWS; index++)
+    {
+        uint16_t top = index * ST7789_FB_BAND_ROWS;
+        uint16_t bottom = top + ST7789_FB_BAND_ROWS - 1;
+        uint16_t row0 = (y > top) ? y : top;
+        uint16_t row1 = (y1 < bottom) ? y1 : bottom;
+
+        if (x == 0 && x1 == ST7789_FB_WIDTH - 1 && row0 == top && row1 == bottom)
+        {
+            // Whole band covered: becomes uniform, no pixel writes needed
+            fb_band_t *band = &bands[index];
+            band->mode = BAND_UNIFORM;
+            band->fill_color = color;
+            mark_dirty(band, 0, top, ST7789_FB_WIDTH - 1, bottom);
+            continue;
+        }
+
+        st7789_fb_draw(x, row0, x1 - x + 1, row1 - row0 + 1, render_solid_row, &wire);
+    }
+}
+
+void st7789_fb_flush(void)
+{
+    for (int i = 0; i < ST7789_FB_BAND_COUNT; i++)
+    {
+        flush_band(i);
+    }
+}
+
+bool st7789_fb_is_dirty(void)
+{
+    for (int i = 0; i < ST7789_FB_BAND_COUNT; i++)
+    {
+        if (bands[i].dirty)
+        {
+            return true;
+        }
+    }
+    return false;
+}
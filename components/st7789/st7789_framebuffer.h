@@ -0,0 +1,108 @@
+#ifndef ST7789_FRAMEBUFFER_H
+#define ST7789_FRAMEBUFFER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+/**
+ * @file st7789_framebuffer.h
+ * @brief Banded off-screen render target with dirty-rectangle flush
+ *
+ * The target board has no PSRAM, and a full 240x240 RGB565 framebuffer
+ * (112.5 KB) does not fit reliably next to the WiFi stack in internal RAM.
+ * The screen is therefore split into horizontal bands of
+ * ST7789_FB_BAND_ROWS rows, each backed by its own lazily allocated
+ * DMA-capable buffer:
+ *
+ * - A band nobody has drawn into since the last clear needs no memory; its
+ *   whole content is a single fill colour.
+ * - The first draw touching a band allocates its buffer (up to
+ *   ST7789_FB_BAND_BUDGET bands) and expands the fill colour into it.
+ * - If the budget is exhausted or allocation fails, draws into that band go
+ *   straight to the panel (the pre-framebuffer behaviour) until the next
+ *   clear.
+ *
+ * Each band tracks one dirty rectangle. st7789_fb_flush() sends every dirty
+ * rectangle as one address window followed by DMA bursts directly out of
+ * the band buffer (or a DMA fill for uniform bands), then clears the dirty
+ * state. Pixels are stored in wire (big-endian) order so no conversion is
+ * needed at flush time.
+ *
+ * This module is internal to the st7789 component and is not thread-safe;
+ * callers serialize access the same way they serialize the draw API.
+ */
+
+#define ST7789_FB_WIDTH         240     ///< Panel width in pixels
+#define ST7789_FB_HEIGHT        240     ///< Panel height in pixels
+
+/**
+ * @brief Rows per band (240 must be a multiple)
+ *
+ * 16 rows matches the large font height, so a line of 16 px text aligned
+ * to a band boundary touches one band, and at most two otherwise.
+ */
+#define ST7789_FB_BAND_ROWS     16
+#define ST7789_FB_BAND_COUNT    (ST7789_FB_HEIGHT / ST7789_FB_BAND_ROWS)
+
+/**
+ * @brief Maximum number of bands backed by RAM at once
+ *
+ * 7.5 KB per band. The status screen touches seven bands (three
+ * band-aligned text lines and two 2-band history plots); the message
+ * screen's lines straddle six bands, only one of them outside that set.
+ */
+#define ST7789_FB_BAND_BUDGET   8
+
+/**
+ * @brief Row renderer callback used by st7789_fb_draw()
+ *
+ * Writes @p count pixels of row @p row, starting at column @p col, into
+ * @p dst in wire (big-endian) order. @p row and @p col are relative to the
+ * top-left corner of the primitive being drawn.
+ */
+typedef void (*st7789_fb_renderer_t)(const void *ctx, uint16_t row, uint16_t col,
+                                     uint16_t count, uint16_t *dst);
+
+/**
+ * @brief Initialize the band table and the direct-draw scratch buffer
+ *
+ * The whole screen starts as a dirty uniform area of @p color, so the first
+ * st7789_fb_flush() clears the panel.
+ *
+ * @param color Native RGB565 initial screen colour
+ * @return ESP_OK, or ESP_ERR_NO_MEM if the scratch buffer cannot be allocated
+ */
+esp_err_t st7789_fb_init(uint16_t color);
+
+/**
+ * @brief Fill a rectangle with a solid colour
+ *
+ * Bands fully covered by the rectangle become uniform (no pixel writes and no
+ * memory needed); partially covered bands are rendered into their buffers.
+ */
+void st7789_fb_fill(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
+
+/**
+ * @brief Render an arbitrary primitive through a row renderer
+ *
+ * The rectangle is clipped to the screen; @p renderer is only invoked for
+ * visible pixels.
+ */
+void st7789_fb_draw(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                    st7789_fb_renderer_t renderer, const void *ctx);
+
+/**
+ * @brief Push all dirty rectangles to the panel and reset dirty tracking
+ *
+ * Transfers are queued on the DMA transport; the next draw call waits for
+ * them to finish before touching band memory.
+ */
+void st7789_fb_flush(void);
+
+/**
+ * @brief Report whether any region is waiting to be flushed
+ */
+bool st7789_fb_is_dirty(void);
+
+#endif // ST7789_FRAMEBUFFER_H
@@ -0,0 +1,122 @@
+/**
+ * @file st7789_glyph_cache.c
+ * @brief Lazily built cache of expanded glyph cells
+ *
+ * See st7789_glyph_cache.h for the cache organisation.
+ */
+
+#include "st7789_glyph_cache.h"
+#include "st7789_transport.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include <stdbool.h>
+
+static const char *TAG = "ST7789_GLYPHS";
+
+typedef struct {
+    bool in_use;
+    uint8_t font;                                       ///< st7789_font_t
+    uint16_t fg;                                        ///< Native foreground colour
+    uint16_t bg;                                        ///< Native background colour
+    uint16_t block_pixels;                              ///< Cell size of the font
+    uint32_t last_used;                                 ///< Access stamp for LRU eviction
+    uint16_t *glyphs[ST7789_GLYPH_CACHE_GLYPHS];        ///< Expanded blocks, NULL until built
+} glyph_style_t;
+
+static glyph_style_t styles[ST7789_GLYPH_CACHE_STYLES];
+static uint32_t access_clock = 0;
+static size_t pixels_allocated = 0;
+
+static void release_style(glyph_style_t *style)
+{
+    for (int i = 0; i < ST7789_GLYPH_CACHE_GLYPHS; i++)
+    {
+        if (style->glyphs[i] != NULL)
+        {
+            heap_caps_free(style->glyphs[i]);
+            style->glyphs[i] = NULL;
+            pixels_allocated -= style->block_pixels;
+        }
+    }
+    style->in_use = false;
+}
+
+/**
+ * @brief Find the slot for a style, claiming (or evicting) one if needed
+ */
+static glyph_style_t *find_style(uint8_t font, uint16_t fg, uint16_t bg, uint16_t block_pixels)
+{
+    glyph_style_t *free_slot = NULL;
+    glyph_style_t *oldest = &styles[0];
+
+    for (int i = 0; i < ST7789_GLYPH_CACHE_STYLES; i++)
+    {
+        glyph_style_t *style = &styles[i];
+        if (style->in_use && style->font == font && style->fg == fg && style->bg == bg)
+        {
+            return style;
+        }
+        if (!style->in_use && free_slot == NULL)
+        {
+            free_slot = style;
+        }
+        if (style->last_used < oldest->last_used)
+        {
+            oldest = style;
+        }
+    }
+
+    if (free_slot == NULL)
+    {
+        ESP_LOGD(TAG, "Evicting style %u 0x%04X/0x%04X", oldest->font, oldest->fg, oldest->bg);
+        release_style(oldest);
+        free_slot = oldest;
+    }
+
+    free_slot->in_use = true;
+    free_slot->font = font;
+    free_slot->fg = fg;
+    free_slot->bg = bg;
+    free_slot->block_pixels = block_pixels;
+    return free_slot;
+}
+
+const uint16_t *st7789_glyph_cache_get(uint8_t font, uint8_t glyph, uint16_t fg, uint16_t bg,
+                                       uint16_t width, uint16_t height,
+                                       st7789_fb_renderer_t renderer, const void *ctx)
+{
+    if (glyph >= ST7789_GLYPH_CACHE_GLYPHS)
+    {
+        return NULL;
+    }
+
+    uint16_t block_pixels = width * height;
+    glyph_style_t *style = find_style(font, fg, bg, block_pixels);
+    style->last_used = ++access_clock;
+
+    uint16_t *block = style->glyphs[glyph];
+    if (block != NULL)
+    {
+        return block;
+    }
+
+    if (pixels_allocated + block_pixels > ST7789_GLYPH_CACHE_BUDGET_PIXELS)
+    {
+        return NULL;
+    }
+
+    block = st7789_transport_alloc_pixels(block_pixels);
+    if (block == NULL)
+    {
+        return NULL;
+    }
+    pixels_allocated += block_pixels;
+
+    for (uint16_t row = 0; row < height; row++)
+    {
+        renderer(ctx, row, 0, width, &block[row * width]);
+    }
+
+    style->glyphs[glyph] = block;
+    return block;
+}
@@ -0,0 +1,57 @@
+#ifndef ST7789_GLYPH_CACHE_H
+#define ST7789_GLYPH_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "st7789_framebuffer.h"
+
+/**
+ * @file st7789_glyph_cache.h
+ * @brief Pre-expanded glyph cells for the generated fonts
+ *
+ * The dashboard draws text in a handful of fixed styles (one font size and
+ * CYAN, GREEN, RED or YELLOW on BLACK). Blending the alpha bitmap for every
+ * character is wasted work, so each (style, glyph) combination is expanded
+ * once into a ready-to-copy block: the whole cell in RGB565 pixels already
+ * in wire (big-endian) order, in DMA-capable memory.
+ *
+ * Organisation:
+ * - Up to ST7789_GLYPH_CACHE_STYLES styles (font, fg, bg) are tracked.
+ *   Finding a style is a scan of at most that many entries; the glyph
+ *   inside a style is a direct array index.
+ * - Blocks are allocated lazily on first use, so only glyphs that are
+ *   actually drawn consume memory. The total is capped at
+ *   ST7789_GLYPH_CACHE_BUDGET_PIXELS.
+ * - When a new style arrives and all style slots are taken, the least
+ *   recently used style and its blocks are released.
+ * - Once the budget is spent, further glyphs are simply not cached. The
+ *   caller then falls back to blending the bitmap.
+ *
+ * Not thread-safe; used only from the st7789 drawing path.
+ */
+
+#define ST7789_GLYPH_CACHE_GLYPHS         95          ///< Glyphs per font (printable ASCII)
+#define ST7789_GLYPH_CACHE_STYLES         6           ///< Font/colour styles tracked at once
+#define ST7789_GLYPH_CACHE_BUDGET_PIXELS  (12 * 1024) ///< Block budget (24 KB, 69 16 px cells)
+
+/**
+ * @brief Get the expanded cell for a glyph, building it on first use
+ *
+ * Missing cells are rendered row by row through @p renderer, the same
+ * callback the caller would otherwise hand to st7789_fb_draw().
+ *
+ * @param font     st7789_font_t of the glyph
+ * @param glyph    Glyph index within the font (0..ST7789_GLYPH_CACHE_GLYPHS-1)
+ * @param fg       Native RGB565 foreground colour
+ * @param bg       Native RGB565 background colour
+ * @param width    Cell width; the same for every glyph of a font
+ * @param height   Cell height
+ * @param renderer Row renderer producing the cell
+ * @param ctx      Renderer context
+ * @return width * height wire-order pixels, or NULL if the glyph could not be cached
+ */
+const uint16_t *st7789_glyph_cache_get(uint8_t font, uint8_t glyph, uint16_t fg, uint16_t bg,
+                                       uint16_t width, uint16_t height,
+                                       st7789_fb_renderer_t renderer, const void *ctx);
+
+#endif // ST7789_GLYPH_CACHE_H
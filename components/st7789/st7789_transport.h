@@ -0,0 +1,149 @@
+#ifndef ST7789_TRANSPORT_H
+#define ST7789_TRANSPORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+/**
+ * @file st7789_transport.h
+ * @brief Wire-level transport for the ST7789 display controller
+ *
+ * Separates the byte-moving part of the display driver from the drawing code
+ * in st7789.c. Two interchangeable backends implement this interface:
+ *
+ * - Hardware SPI (default): the ESP32 VSPI peripheral (SPI3_HOST) drives
+ *   GPIO 23/18 through the IO MUX. Pixel data is pushed with DMA-queued
+ *   transactions so the CPU is free while a transfer is on the wire, and the
+ *   DC line is switched by a pre-transfer callback using the transaction's
+ *   user field.
+ * - Bit-banged GPIO (fallback): the original software SPI implementation,
+ *   kept for boards where the VSPI peripheral is unavailable. Select it by
+ *   defining ST7789_USE_BITBANG_TRANSPORT to 1 (for example through
+ *   target_compile_definitions in the component CMakeLists.txt).
+ *
+ * Pixel byte order:
+ * Pixel buffers handed to st7789_transport_write_pixels() are in wire order,
+ * i.e. each RGB565 value is stored big-endian (high byte first). Use
+ * ST7789_SWAP_BYTES() when filling a buffer from native uint16_t colours.
+ *
+ * Ordering guarantees:
+ * Commands and register data are sent synchronously. Pixel writes and fills
+ * may complete asynchronously; every command call first waits for queued
+ * pixel data to drain, so the sequence on the wire always matches the
+ * sequence of calls.
+ */
+
+/**
+ * @brief Use the bit-banged GPIO transport instead of hardware SPI
+ *
+ * 0 = VSPI peripheral with DMA (default), 1 = software SPI fallback.
+ */
+#ifndef ST7789_USE_BITBANG_TRANSPORT
+#define ST7789_USE_BITBANG_TRANSPORT 0
+#endif
+
+/**
+ * @brief SPI clock frequency for the hardware transport (Hz)
+ *
+ * 40 MHz is within the ST7789 write-cycle specification and is reachable
+ * because GPIO 18/23 are the native VSPI IO MUX pins (no GPIO matrix delay).
+ * Lower this value if long jumper wires cause corrupted pixels.
+ */
+#define ST7789_SPI_CLOCK_HZ         (40 * 1000 * 1000)
+
+/**
+ * @brief Depth of the SPI transaction queue
+ *
+ * Number of pixel transactions that may be in flight at once. Deeper queues
+ * let large fills run without CPU involvement between chunks.
+ */
+#define ST7789_SPI_QUEUE_DEPTH      8
+
+/**
+ * @brief Largest single DMA transaction in bytes
+ *
+ * Larger pixel writes are split into chunks of this size. 20 full display
+ * rows (240 * 20 * 2 bytes) keeps per-transaction overhead negligible.
+ */
+#define ST7789_SPI_MAX_TRANSFER     (240 * 20 * 2)
+
+/**
+ * @brief Size of the solid-colour DMA buffer used by fills (pixels)
+ *
+ * The buffer is filled once per colour and queued repeatedly, so a full
+ * screen clear needs 57600 / ST7789_FILL_BUFFER_PIXELS transactions.
+ */
+#define ST7789_FILL_BUFFER_PIXELS   (240 * 10)
+
+/**
+ * @brief Convert a native RGB565 value into wire (big-endian) order
+ */
+#define ST7789_SWAP_BYTES(color)    ((uint16_t)(((color) >> 8) | ((color) << 8)))
+
+/**
+ * @brief Initialize the transport backend
+ *
+ * Configures the SCK, MOSI and DC pins and, for the hardware backend, the
+ * VSPI bus, the display device and the DMA fill buffer. The RST pin is
+ * owned by st7789.c and is not touched here.
+ *
+ * @return ESP_OK on success, error code from the SPI driver or
+ *         ESP_ERR_NO_MEM if DMA memory could not be allocated
+ */
+esp_err_t st7789_transport_init(void);
+
+/**
+ * @brief Send a single command byte (DC low)
+ *
+ * Waits for any queued pixel data to finish before the command is sent.
+ *
+ * @param cmd ST7789 command byte
+ */
+void st7789_transport_write_command(uint8_t cmd);
+
+/**
+ * @brief Send command parameters or register data (DC high)
+ *
+ * Intended for short parameter lists. The call returns once the bytes have
+ * been transmitted, so the buffer may live on the caller's stack.
+ *
+ * @param data Bytes to send
+ * @param len  Number of bytes
+ */
+void st7789_transport_write_data(const uint8_t *data, size_t len);
+
+/**
+ * @brief Queue pixel data for transmission (DC high)
+ *
+ * With the hardware backend the data is sent by DMA in the background; the
+ * buffer must be DMA-capable (see st7789_transport_alloc_pixels()) and must
+ * not be modified until st7789_transport_wait_idle() returns.
+ *
+ * @param pixels Pixel data in wire (big-endian) order
+ * @param count  Number of 16-bit pixels
+ */
+void st7789_transport_write_pixels(const uint16_t *pixels, size_t count);
+
+/**
+ * @brief Stream a single colour to the current address window (DC high)
+ *
+ * @param color Native RGB565 colour
+ * @param count Number of pixels to write
+ */
+void st7789_transport_fill(uint16_t color, uint32_t count);
+
+/**
+ * @brief Block until all queued pixel transactions have completed
+ */
+void st7789_transport_wait_idle(void);
+
+/**
+ * @brief Allocate a pixel buffer usable with st7789_transport_write_pixels()
+ *
+ * @param count Number of 16-bit pixels
+ * @return DMA-capable buffer, or NULL if no suitable memory is available
+ */
+uint16_t *st7789_transport_alloc_pixels(size_t count);
+
+#endif // ST7789_TRANSPORT_H
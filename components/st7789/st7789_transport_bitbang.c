@@ -0,0 +1,113 @@
+/**
+ * @file st7789_transport_bitbang.c
+ * @brief Bit-banged GPIO transport for the ST7789 display (fallback)
+ *
+ * Software SPI implementation that toggles MOSI/SCK with gpio_set_level()
+ * once per bit. It is roughly two orders of magnitude slower than the VSPI
+ * transport and is only built when ST7789_USE_BITBANG_TRANSPORT is set to 1,
+ * e.g. for bring-up on boards where the SPI peripheral is needed elsewhere.
+ *
+ * All operations are synchronous, so st7789_transport_wait_idle() is a no-op.
+ */
+
+#include "st7789_transport.h"
+
+#if ST7789_USE_BITBANG_TRANSPORT
+
+#include "pinout.h"
+#include "driver/gpio.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <stdlib.h>
+
+static const char *TAG = "ST7789_BITBANG";
+
+/**
+ * @brief Send single byte via bit-banging SPI
+ *
+ * Optimized for speed with no delays between clock cycles. Clock idles high
+ * and data is sampled on the rising edge (SPI mode 3).
+ *
+ * @param data 8-bit data byte to transmit (MSB first)
+ */
+static void spi_write_byte_bitbang(uint8_t data)
+{
+    for (int i = 7; i >= 0; i--)
+    {
+        // Set data bit on MOSI
+        gpio_set_level(ST7789_SDA_PIN, (data >> i) & 1);
+
+        // Clock pulse - maximum speed, no delays
+        gpio_set_level(ST7789_SCK_PIN, 0);
+        gpio_set_level(ST7789_SCK_PIN, 1);
+    }
+}
+
+esp_err_t st7789_transport_init(void)
+{
+    gpio_config_t io_conf = {};
+    io_conf.intr_type = GPIO_INTR_DISABLE;
+    io_conf.mode = GPIO_MODE_OUTPUT;
+    io_conf.pin_bit_mask = (1ULL << ST7789_SDA_PIN) | (1ULL << ST7789_SCK_PIN) | (1ULL << ST7789_DC_PIN);
+    io_conf.pull_down_en = GPIO_PULLDOWN_DISABLE;
+    io_conf.pull_up_en = GPIO_PULLUP_DISABLE;
+    gpio_config(&io_conf);
+
+    gpio_set_level(ST7789_SCK_PIN, 1);  // Clock idle high
+    gpio_set_level(ST7789_SDA_PIN, 0);  // MOSI idle low
+    gpio_set_level(ST7789_DC_PIN, 1);   // Data mode default
+
+    ESP_LOGW(TAG, "Using bit-banged GPIO transport (slow fallback)");
+    return ESP_OK;
+}
+
+void st7789_transport_write_command(uint8_t cmd)
+{
+    gpio_set_level(ST7789_DC_PIN, 0);   // DC low = command mode
+    spi_write_byte_bitbang(cmd);
+    gpio_set_level(ST7789_DC_PIN, 1);   // Ready for data mode
+}
+
+void st7789_transport_write_data(const uint8_t *data, size_t len)
+{
+    gpio_set_level(ST7789_DC_PIN, 1);
+    for (size_t i = 0; i < len; i++)
+    {
+        spi_write_byte_bitbang(data[i]);
+    }
+}
+
+void st7789_transport_write_pixels(const uint16_t *pixels, size_t count)
+{
+    // Buffer is already in wire order, so send it byte by byte
+    st7789_transport_write_data((const uint8_t *)pixels, count * 2);
+}
+
+void st7789_transport_fill(uint16_t color, uint32_t count)
+{
+    gpio_set_level(ST7789_DC_PIN, 1);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        spi_write_byte_bitbang(color >> 8);
+        spi_write_byte_bitbang(color & 0xFF);
+
+        // Yield occasionally - a full screen takes seconds at bit-bang speed
+        if (count > 1000 && (i % 500) == 0)
+        {
+            taskYIELD();
+        }
+    }
+}
+
+void st7789_transport_wait_idle(void)
+{
+    // Every operation is synchronous
+}
+
+uint16_t *st7789_transport_alloc_pixels(size_t count)
+{
+    return malloc(count * sizeof(uint16_t));
+}
+
+#endif // ST7789_USE_BITBANG_TRANSPORT
@@ -0,0 +1,316 @@
+/**
+ * @file st7789_transport_spi.c
+ * @brief Hardware SPI + DMA transport for the ST7789 display
+ *
+ * Drives the display through the ESP32 VSPI peripheral (SPI3_HOST). The
+ * display module has no CS pin, so the bus carries a single device with
+ * spics_io_num = -1 and SPI mode 3 (clock idle high, sample on rising edge),
+ * matching the timing of the original bit-banged implementation.
+ *
+ * Transaction Model:
+ * - Commands and parameters use polling transactions. They are short, and
+ *   waiting for DMA completion would cost more than sending the bytes.
+ * - Pixel data uses interrupt/DMA transactions from a fixed pool of
+ *   ST7789_SPI_QUEUE_DEPTH descriptors. When the pool is exhausted the
+ *   oldest transaction is reclaimed (results come back in queue order), so
+ *   a writer only blocks while the hardware is genuinely busy.
+ * - The DC level travels in spi_transaction_t::user and is applied by a
+ *   pre-transfer callback, so command/data switching happens exactly at the
+ *   transaction boundary even for queued transfers.
+ *
+ * The SPI driver does not allow polling transactions while queued ones are
+ * still pending, so every command first drains the queue.
+ *
+ * Power management:
+ * The 40 MHz SPI clock is derived from the 80 MHz APB clock, which DFS
+ * lowers to 40 MHz when the system is idle. An ESP_PM_APB_FREQ_MAX lock is
+ * held from the first queued transaction until the queue has drained (and
+ * around each polling transaction), so a frame is sent at one clock and the
+ * chip cannot enter light sleep between its chunks. Without CONFIG_PM_ENABLE
+ * the lock is not created and these calls do nothing.
+ */
+
+#include "st7789_transport.h"
+
+#if !ST7789_USE_BITBANG_TRANSPORT
+
+#include "pinout.h"
+#include "driver/gpio.h"
+#include "driver/spi_master.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_pm.h"
+#include "freertos/FreeRTOS.h"
+#include <string.h>
+
+static const char *TAG = "ST7789_SPI";
+
+/**
+ * @brief SPI host used for the display (VSPI on the original ESP32)
+ */
+#define ST7789_SPI_HOST     SPI3_HOST
+
+/**
+ * @brief DC pin levels carried in spi_transaction_t::user
+ */
+#define DC_COMMAND          ((void *)0)
+#define DC_DATA             ((void *)1)
+
+static spi_device_handle_t spi_device = NULL;            ///< Display device on the VSPI bus
+static spi_transaction_t trans_pool[ST7789_SPI_QUEUE_DEPTH]; ///< Queued pixel transactions
+static uint8_t trans_next = 0;                           ///< Next pool slot to use
+static uint8_t trans_in_flight = 0;                      ///< Queued but not yet reclaimed
+static uint16_t *fill_buffer = NULL;                     ///< Solid-colour DMA buffer
+static uint16_t fill_buffer_color = 0;                   ///< Native colour currently in fill_buffer
+static bool fill_buffer_valid = false;                   ///< fill_buffer holds fill_buffer_color
+static esp_pm_lock_handle_t apb_lock = NULL;             ///< Held while the bus is busy
+
+/**
+ * @brief Drive DC from the transaction's user field right before it starts
+ *
+ * Runs in ISR context for queued transactions, hence IRAM placement.
+ */
+static void IRAM_ATTR spi_pre_transfer_callback(spi_transaction_t *trans)
+{
+    gpio_set_level(ST7789_DC_PIN, (uint32_t)(uintptr_t)trans->user);
+}
+
+/**
+ * @brief Keep the APB clock at its maximum while transactions are on the wire
+ */
+static void bus_busy_begin(void)
+{
+    if (apb_lock != NULL)
+    {
+        esp_pm_lock_acquire(apb_lock);
+    }
+}
+
+static void bus_busy_end(void)
+{
+    if (apb_lock != NULL)
+    {
+        esp_pm_lock_release(apb_lock);
+    }
+}
+
+/**
+ * @brief Reclaim the oldest queued transaction, blocking until it completes
+ */
+static void reclaim_one(void)
+{
+    spi_transaction_t *done = NULL;
+    esp_err_t ret = spi_device_get_trans_result(spi_device, &done, portMAX_DELAY);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to reclaim SPI transaction: %s", esp_err_to_name(ret));
+    }
+    trans_in_flight--;
+    if (trans_in_flight == 0)
+    {
+        bus_busy_end();
+    }
+}
+
+/**
+ * @brief Queue one DMA transaction of pixel data
+ *
+ * @param data  Wire-order bytes (DMA-capable memory)
+ * @param bytes Transaction length in bytes (<= ST7789_SPI_MAX_TRANSFER)
+ */
+static void queue_data(const void *data, size_t bytes)
+{
+    if (trans_in_flight == ST7789_SPI_QUEUE_DEPTH)
+    {
+        reclaim_one();
+    }
+
+    spi_transaction_t *trans = &trans_pool[trans_next];
+    memset(trans, 0, sizeof(*trans));
+    trans->length = bytes * 8;
+    trans->tx_buffer = data;
+    trans->user = DC_DATA;
+
+    if (trans_in_flight == 0)
+    {
+        bus_busy_begin();
+    }
+
+    esp_err_t ret = spi_device_queue_trans(spi_device, trans, portMAX_DELAY);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to queue SPI transaction: %s", esp_err_to_name(ret));
+        if (trans_in_flight == 0)
+        {
+            bus_busy_end();
+        }
+        return;
+    }
+
+    trans_next = (trans_next + 1) % ST7789_SPI_QUEUE_DEPTH;
+    trans_in_flight++;
+}
+
+/**
+ * @brief Send a short buffer synchronously with the given DC level
+ */
+static void polling_send(const uint8_t *data, size_t len, void *dc)
+{
+    if (len == 0)
+    {
+        return;
+    }
+
+    st7789_transport_wait_idle();
+
+    spi_transaction_t trans = {0};
+    trans.length = len * 8;
+    trans.user = dc;
+    if (len <= sizeof(trans.tx_data))
+    {
+        trans.flags = SPI_TRANS_USE_TXDATA;
+        memcpy(trans.tx_data, data, len);
+    }
+    else
+    {
+        trans.tx_buffer = data;
+    }
+
+    bus_busy_begin();
+    esp_err_t ret = spi_device_polling_transmit(spi_device, &trans);
+    bus_busy_end();
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "SPI polling transmit failed: %s", esp_err_to_name(ret));
+    }
+}
+
+esp_err_t st7789_transport_init(void)
+{
+    // DC is plain GPIO; SCK/MOSI are claimed by the SPI driver below
+    gpio_config_t io_conf = {};
+    io_conf.intr_type = GPIO_INTR_DISABLE;
+    io_conf.mode = GPIO_MODE_OUTPUT;
+    io_conf.pin_bit_mask = (1ULL << ST7789_DC_PIN);
+    io_conf.pull_down_en = GPIO_PULLDOWN_DISABLE;
+    io_conf.pull_up_en = GPIO_PULLUP_DISABLE;
+    gpio_config(&io_conf);
+    gpio_set_level(ST7789_DC_PIN, 1);
+
+    spi_bus_config_t bus_cfg = {
+        .mosi_io_num = ST7789_SDA_PIN,
+        .miso_io_num = -1,
+        .sclk_io_num = ST7789_SCK_PIN,
+        .quadwp_io_num = -1,
+        .quadhd_io_num = -1,
+        .max_transfer_sz = ST7789_SPI_MAX_TRANSFER,
+    };
+    esp_err_t ret = spi_bus_initialize(ST7789_SPI_HOST, &bus_cfg, SPI_DMA_CH_AUTO);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "SPI bus initialization failed: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    spi_device_interface_config_t dev_cfg = {
+        .clock_speed_hz = ST7789_SPI_CLOCK_HZ,
+        .mode = 3,                      // CS-less ST7789 modules require CPOL=1, CPHA=1
+        .spics_io_num = -1,             // No CS pin on this module
+        .queue_size = ST7789_SPI_QUEUE_DEPTH,
+        .pre_cb = spi_pre_transfer_callback,
+    };
+    ret = spi_bus_add_device(ST7789_SPI_HOST, &dev_cfg, &spi_device);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to add ST7789 SPI device: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    // ESP_ERR_NOT_SUPPORTED without CONFIG_PM_ENABLE: the clocks never change
+    ret = esp_pm_lock_create(ESP_PM_APB_FREQ_MAX, 0, "st7789_spi", &apb_lock);
+    if (ret != ESP_OK && ret != ESP_ERR_NOT_SUPPORTED)
+    {
+        ESP_LOGE(TAG, "Failed to create APB frequency lock: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    fill_buffer = st7789_transport_alloc_pixels(ST7789_FILL_BUFFER_PIXELS);
+    if (fill_buffer == NULL)
+    {
+        ESP_LOGE(TAG, "Failed to allocate %d byte DMA fill buffer", ST7789_FILL_BUFFER_PIXELS * 2);
+        return ESP_ERR_NO_MEM;
+    }
+    fill_buffer_valid = false;
+
+    ESP_LOGI(TAG, "VSPI transport ready: %d MHz, DMA queue depth %d",
+             ST7789_SPI_CLOCK_HZ / 1000000, ST7789_SPI_QUEUE_DEPTH);
+    return ESP_OK;
+}
+
+void st7789_transport_write_command(uint8_t cmd)
+{
+    polling_send(&cmd, 1, DC_COMMAND);
+}
+
+void st7789_transport_write_data(const uint8_t *data, size_t len)
+{
+    polling_send(data, len, DC_DATA);
+}
+
+void st7789_transport_write_pixels(const uint16_t *pixels, size_t count)
+{
+    const uint8_t *bytes = (const uint8_t *)pixels;
+    size_t remaining = count * 2;
+
+    while (remaining > 0)
+    {
+        size_t chunk = remaining > ST7789_SPI_MAX_TRANSFER ? ST7789_SPI_MAX_TRANSFER : remaining;
+        queue_data(bytes, chunk);
+        bytes += chunk;
+        remaining -= chunk;
+    }
+}
+
+void st7789_transport_fill(uint16_t color, uint32_t count)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    // The fill buffer may still be on the wire from a previous fill
+    if (!fill_buffer_valid || fill_buffer_color != color)
+    {
+        st7789_transport_wait_idle();
+        uint16_t wire = ST7789_SWAP_BYTES(color);
+        for (int i = 0; i < ST7789_FILL_BUFFER_PIXELS; i++)
+        {
+            fill_buffer[i] = wire;
+        }
+        fill_buffer_color = color;
+        fill_buffer_valid = true;
+    }
+
+    // Same buffer is queued repeatedly - its contents never change mid-fill
+    while (count > 0)
+    {
+        uint32_t chunk = count > ST7789_FILL_BUFFER_PIXELS ? ST7789_FILL_BUFFER_PIXELS : count;
+        queue_data(fill_buffer, chunk * 2);
+        count -= chunk;
+    }
+}
+
+void st7789_transport_wait_idle(void)
+{
+    while (trans_in_flight > 0)
+    {
+        reclaim_one();
+    }
+}
+
+uint16_t *st7789_transport_alloc_pixels(size_t count)
+{
+    return heap_caps_malloc(count * sizeof(uint16_t), MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+}
+
+#endif // !ST7789_USE_BITBANG_TRANSPORT
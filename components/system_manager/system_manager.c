@@ -10,20 +10,21 @@
  * Complete System Flow Description:
  * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
  * 
- * PHASE 1: SYSTEM INITIALIZATION (0-10 seconds)
+ * PHASE 1: PARALLEL BRING-UP (no fixed startup delays)
  * ┌─ Power On ─┐
  *         │
- *         ▼
- * ┌─ Component Init ─┐  ← ST7789 display, DHT11 sensor, WiFi manager
- *         │
- *         ▼
- * ┌─ Display Ready ──┐  ← Immediate display functionality (no WiFi required)
- *         │
- *         ▼
- * ┌─ Task Creation ──┐  ← Dual-core tasks: Sensor (Core 0), WiFi (Core 1)
- *         │
- *         ▼
- * ┌─ Initial Display ┐  ← "TEMP: __._C", "HUMD: __%", "NET: READY"
+ *         ├─────────────────────┬─────────────────────┐
+ *         ▼                     ▼                     ▼
+ * ┌─ DHT11 power-up ─┐  ┌─ WiFi task ──────┐  ┌─ ST7789 reset ───┐
+ * │  + first read    │  │  NVS, netif,     │  │  + display task  │
+ * │  (Core 0 task)   │  │  driver, connect │  │  (app_main)      │
+ *         │                     │                     │
+ *         ▼                     ▼                     ▼
+ *   FIRST_READING         NETWORK_READY         DISPLAY_READY
+ *         └──────────┬──────────┴─────────────────────┘
+ *                    ▼
+ * ┌─ Reading Shown ──┐  ← Once reading and display are both ready
+ * ┌─ First Upload ───┐  ← Once reading and IP address are both there
  * 
  * PHASE 2: SENSOR OPERATION (Continuous - Core 0)
  * ┌─ Every 10 seconds ─┐ ◄─┐
@@ -39,8 +40,8 @@
  *         │               │
  *         └───────────────┘
  * 
- * PHASE 3: WIFI CONNECTION WITH DELAYED START (Core 1)
- * ┌─ Wait 10 seconds ──┐     ← Allows display to initialize without interference
+ * PHASE 3: WIFI CONNECTION (Core 1)
+ * ┌─ WiFi Init ────────┐     ← NVS, TCP/IP stack and driver, parallel to PHASE 1
  *         │
  *         ▼
  * ┌─ WiFi Connect ─────┐     ← Blocking connection attempt (router available)
@@ -65,13 +66,13 @@
  * ┌─ Local Operation ──┐     ← Sensor readings continue normally
  *         │
  *         ▼
- * ┌─ Reconnect Every 60s ┐ ◄─┐ ← Reset retry counter for fresh attempts
+ * ┌─ Backoff Reconnect ─┐ ◄─┐ ← Jittered exponential delay, 0.5 s up to 60 s
  *         │                 │
  *         ▼                 │
  * ┌─ Router Returns ────┐   │
  *         │                 │
  *         ▼                 │
- * ┌─ Auto Reconnect ────┐   │ ← Immediate reconnection when router available
+ * ┌─ Auto Reconnect ────┐   │ ← GOT_IP wakes the WiFi task immediately
  *         │                 │
  *         ▼                 │
  * ┌─ Resume IoT ────────┐   │ ← Display: "NET: UP", data transmission resumes
@@ -90,7 +91,7 @@
  * │ │ • 10s intervals │◄┼─────────┼►│ • 30s intervals │ │
  * │ │ • Timing-crit.  │ │         │ │ • HTTP POST     │ │
  * │ │ • Data acquire  │ │         │ │ • JSON format   │ │
- * │ │ • Display ctrl  │ │         │ │ • Auto-reconnect│ │
+ * │ │ • Display post  │ │         │ │ • Auto-reconnect│ │
  * │ └─────────────────┘ │         │ └─────────────────┘ │
  * │                     │         │                     │
  * │ ┌─────────────────┐ │         │ ┌─────────────────┐ │
@@ -107,9 +108,9 @@
  *             ┌─────────────────┐
  *             │ Shared Data     │
  *             │ Structure       │
- *             │ • Mutex protect │
+ *             │ • Seqlock       │
  *             │ • Thread-safe   │
- *             │ • Atomic access │
+ *             │ • Lock-free rd  │
  *             └─────────────────┘
  * 
  * Key Design Principles:
@@ -122,23 +123,23 @@
  *    - Display initialization isolated from WiFi connection timing
  * 
  * 2. THREAD-SAFE DATA SHARING:
- *    - FreeRTOS mutex protects shared sensor data structure
- *    - Atomic read/write operations prevent data corruption
- *    - Timeout-based mutex acquisition prevents deadlocks
+ *    - Sequence lock publishes the shared sensor data structure
+ *    - Readers get consistent snapshots without blocking or timeouts
+ *    - No priority inheritance between sensor and WiFi tasks
  *    - Safe helper functions for consistent data access patterns
  * 
  * 3. BULLETPROOF WIFI CONNECTIVITY:
  *    - Automatic router outage detection and recovery
  *    - Intelligent retry counter reset for fresh connection attempts
  *    - Non-blocking reconnection doesn't affect sensor operations
- *    - 10-second startup delay prevents display interference
+ *    - Brought up in parallel with the display, without startup delays
  *    - Continues local operation during network outages
  * 
  * 4. GRACEFUL ERROR HANDLING:
  *    - Sensor failures don't affect WiFi transmission
  *    - Network outages don't impact local monitoring
  *    - Display shows appropriate status indicators for all conditions
- *    - Progressive sensor failure response (1min error, 2min restart)
+ *    - Tiered sensor recovery (reinit, power cycle, backoff; restart last)
  * 
  * 5. RESOURCE OPTIMIZATION:
  *    - Minimal memory footprint with efficient buffer management
@@ -149,10 +150,10 @@
  * Technical Specifications:
  * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
  * 
- * • Sensor Reading Frequency: 10 seconds (configurable)
- * • WiFi Transmission Frequency: 30 seconds (configurable)  
- * • WiFi Reconnection Attempts: Every 60 seconds when disconnected
- * • WiFi Startup Delay: 10 seconds (prevents display interference)
+ * • Sensor Reading Frequency: 10 seconds (default, changeable at runtime)
+ * • WiFi Transmission Frequency: 30 seconds (default, changeable at runtime)
+ * • WiFi Reconnection Attempts: Jittered exponential backoff, capped at 60 s
+ * • Boot Milestones: measured on every boot (PERF_BOOT_*, perf_monitor.h)
  * • Display Update: Real-time on sensor change (immediate)
  * • Display Works: Independent of WiFi status (router on/off)
  * • Data Format: JSON with device ID, timestamp, and readings
@@ -174,11 +175,29 @@
 
 #include "system_manager.h"
 #include "st7789.h"           // ST7789 240x240 TFT display driver
+#include "display_manager.h"  // Display render task and command queue
 #include "dht11.h"            // DHT11 temperature/humidity sensor driver
+#include "dht11_sensor.h"     // DHT11 backend for the sensor scheduler
+#include "sensor_scheduler.h" // Per-sensor periods, conversions and health
 #include "wifi_manager.h"     // WiFi connectivity and HTTP transmission
+#include "device_config.h"    // Device id, intervals and deadbands from NVS / server
+#include "sample_ring.h"      // Buffered readings awaiting batch upload
+#include "sample_aggregator.h" // Deadband / heartbeat reporting with rollups
+#include "sensor_history.h"   // 24-hour series behind the history plots
+#include "telemetry_log.h"    // Flash store-and-forward log for outages
+#include "perf_monitor.h"     // Stage latencies, stack and heap watermarks
+#include "ota_manager.h"      // Background firmware updates and rollback
+#include "event_log.h"        // Deferred, rate-limited logging on the hot paths
+#include "benchmark.h"        // On-device benchmarks (SYSTEM_BENCHMARK builds)
 #include "esp_log.h"          // ESP-IDF logging system
 #include "freertos/FreeRTOS.h" // FreeRTOS real-time operating system
 #include "freertos/task.h"    // FreeRTOS task management
+#include "freertos/event_groups.h" // Boot readiness bits
+#include "esp_attr.h"         // RTC_DATA_ATTR for deep-sleep state
+#include "esp_sleep.h"        // Deep-sleep timer wakeup
+#include "esp_timer.h"        // Time awake since the last wake
+#include "esp_pm.h"           // Dynamic frequency scaling and light sleep
+#include "sdkconfig.h"        // "Home Monitor" build options (main/Kconfig.projbuild)
 #include <string.h>           // String manipulation functions
 #include <time.h>             // Time functions for timestamps
 
@@ -190,47 +209,79 @@ static const char *TAG = "SYSTEM_MANAGER";
 /**
  * @brief Task handles for dual-core implementation
  */
-static TaskHandle_t sensor_task_handle = NULL;    ///< DHT11 sensor task (Core 0)
+static TaskHandle_t sensor_task_handle = NULL;    ///< Sensor scheduler task (Core 0)
 static TaskHandle_t wifi_task_handle = NULL;      ///< WiFi transmission task (Core 1)
 
 /**
- * @brief Shared sensor data structure with thread-safe access control
+ * @brief Whether the panel and its render task came up
+ * 
+ * Once the sensor and WiFi tasks run, a display failure is not fatal: the
+ * unit keeps measuring and uploading headless; posts pile up in the
+ * display queue, oldest discarded first.
+ */
+static bool display_available = false;
+
+/**
+ * @brief Boot readiness, see BOOT_*_BIT
+ * 
+ * system_init() starts the sensor and WiFi tasks before the display is up.
+ * Instead of fixed delays, each side waits for exactly what it needs.
+ */
+static EventGroupHandle_t boot_events = NULL;
+
+#define BOOT_DISPLAY_READY_BIT  BIT0    ///< Initial status screen queued; display posts allowed
+#define BOOT_FIRST_READING_BIT  BIT1    ///< First reading published and buffered for upload
+
+/**
+ * @brief Shared sensor data structure with lock-free snapshot access
  * 
  * This structure serves as the central data exchange point between the sensor
- * task (Core 0) and WiFi transmission task (Core 1). It implements thread-safe
- * access patterns using FreeRTOS mutex synchronization.
+ * task (Core 0) and WiFi transmission task (Core 1). It is published through
+ * a sequence lock: the sensor task is the single writer, and any task on
+ * either core can take a consistent snapshot without blocking.
  * 
  * Data Flow Architecture:
  * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
  * 
- * [Sensor Task]     [Mutex Lock]     [Shared Data]     [Mutex Lock]     [WiFi Task]
- *      │                   │               │                   │                │
- *      ├─ Read DHT11 ──────┼─ Acquire ────┼─ Write Data ──────┼─ Release ──────┤
- *      │                   │               │                   │                │
- *      │                   │               │                   │                │
- *      │                   │               │                   │         Read Data
- *      │                   │               │             Acquire ◄─────────────┤
- *      │                   │               │ ◄─────────── Release               │
- *      │                   │               │                   │                │
- *      └─ Next Cycle ──────┼─ Wait ────────┼─ Available ───────┼─ Wait ─────────┤
+ * [Sensor Task]          [Shared Data + seqlock]              [WiFi Task]
+ *      │                           │                              │
+ *      ├─ Read DHT11               │                              │
+ *      ├─ sequence++ (odd) ───────►│                              │
+ *      ├─ Copy reading ───────────►│                              │
+ *      ├─ sequence++ (even) ──────►│                              │
+ *      │                           │◄──── Read sequence ──────────┤
+ *      │                           │───── Copy snapshot ─────────►│
+ *      │                           │◄──── Sequence unchanged? ────┤
+ *      └─ Next Cycle               │      (else copy again)       │
  * 
  * Thread Safety Mechanisms:
- * • FreeRTOS mutex prevents concurrent access to shared data
- * • Timeout-based mutex acquisition (100ms) prevents deadlocks
- * • Atomic flag operations for new data notification
+ * • Readers never block and never fail (no timeout path)
+ * • A torn copy is detected by the sequence check and simply repeated
+ * • No priority inheritance: readers and writer never wait on each other
  * • Separate timestamp tracking for data age calculation
  * 
  * Performance Characteristics:
- * • Mutex overhead: ~1-5μs per operation
- * • Lock contention: Minimal due to different update frequencies
- * • Memory footprint: 32 bytes + mutex control block
- * • Cache efficiency: Structure sized for optimal alignment
+ * • Snapshot cost: one ~20 byte copy plus two loads of the sequence
+ * • Write cost: one short critical section around the copy
+ * • Memory footprint: 32 bytes + 12 byte sequence lock
  * 
- * @note This structure must never be accessed without proper mutex protection
- * @warning Direct access bypassing mutex can cause data corruption
+ * @note Access only through publish_sensor_data() / snapshot_sensor_data()
  */
 static shared_sensor_data_t shared_data = {0};
 
+/**
+ * @brief Device id attached to every upload
+ * 
+ * Copied from the configuration by on_config_change(). Only the WiFi task
+ * reads it, and that is also where the listener runs.
+ */
+static char device_id[DEVICE_CONFIG_DEVICE_ID_SIZE] = DEVICE_CONFIG_DEFAULT_DEVICE_ID;
+
+/**
+ * @brief Scheduler id of the DHT11, for period changes
+ */
+static int climate_sensor = -1;
+
 /**
  * @brief Core assignment definitions
  */
@@ -239,27 +290,72 @@ static shared_sensor_data_t shared_data = {0};
 
 /**
  * @brief Task timing configurations
+ * 
+ * The sensor and transmission periods are runtime configuration, see
+ * device_config_read_interval_ms() / device_config_transmit_interval_ms().
  */
-#define SENSOR_READ_INTERVAL_MS     10000   ///< DHT11 reading every 10 seconds
-#define WIFI_TRANSMIT_INTERVAL_MS   30000   ///< WiFi transmission every 30 seconds
-#define WIFI_RECONNECT_INTERVAL_MS  10000   ///< WiFi reconnection attempt every 10 seconds
-#define MUTEX_TIMEOUT_MS            100     ///< Mutex timeout for shared data access
-#define WIFI_STARTUP_DELAY_MS       10000   ///< Delay before WiFi connection attempt
-#define TASK_STARTUP_DELAY_MS       100     ///< Delay between task creation and display setup
-#define STARTUP_SCREEN_DELAY_MS     2000    ///< Duration to show startup screen
+#define FIRST_READING_WAIT_MS       5000    ///< Longest the first upload waits for a first reading
 #define RESTART_WARNING_DELAY_MS    5000    ///< Warning delay before system restart
 
-// Display Layout Constants
-#define DISPLAY_LINE_1_Y            50      ///< Y position for first display line
-#define DISPLAY_LINE_2_Y            100     ///< Y position for second display line  
-#define DISPLAY_LINE_3_Y            150     ///< Y position for third display line
-#define DISPLAY_TEXT_X              20      ///< X position for display text
-
-// Sensor Health Monitoring Constants
+// Sensor health thresholds, per sensor (time without a successful reading).
+// sensor_scheduler reinitializes, power-cycles and backs off a failing
+// sensor first; the restart is only the last resort after all of that.
 #define SENSOR_ERROR_DISPLAY_TIME_MS  30000   ///< Display error after 30 seconds of sensor failures
-#define SENSOR_RESTART_TIME_MS        60000   ///< Restart system after 60 seconds of sensor failures
-#define SENSOR_FAILURE_COUNT_LIMIT    3       ///< Number of consecutive failures before error (60s / 10s intervals)
-#define SENSOR_RESTART_COUNT_LIMIT    6      ///< Number of consecutive failures before restart (120s / 10s intervals)
+#define SENSOR_RESTART_TIME_MS        300000  ///< Restart system after 5 minutes of sensor failures
+
+/**
+ * @brief Power mode, selected at build time (menuconfig: Home Monitor →
+ *        Power mode, i.e. CONFIG_SYSTEM_POWER_MODE_DEEP_SLEEP)
+ * 
+ * CONTINUOUS runs the dual-core tasks and the display. DEEP_SLEEP is for
+ * battery units: each wake reads the DHT11, buffers the reading in RTC
+ * memory and sleeps again; WiFi comes up only every
+ * DEEP_SLEEP_UPLOAD_EVERY_WAKES wakes. The display is not used.
+ */
+#define SYSTEM_POWER_CONTINUOUS     0
+#define SYSTEM_POWER_DEEP_SLEEP     1
+#ifndef SYSTEM_POWER_MODE
+#ifdef CONFIG_SYSTEM_POWER_MODE_DEEP_SLEEP
+#define SYSTEM_POWER_MODE           SYSTEM_POWER_DEEP_SLEEP
+#else
+#define SYSTEM_POWER_MODE           SYSTEM_POWER_CONTINUOUS
+#endif
+#endif
+
+// Deep-sleep duty cycle (wake period is the configured read interval)
+#define DEEP_SLEEP_UPLOAD_EVERY_WAKES   30      ///< Upload every 30 wakes (5 minutes)
+#define DEEP_SLEEP_RTC_SAMPLES          64      ///< Readings kept in RTC memory (1.75 KB)
+#define DEEP_SLEEP_MIN_SLEEP_MS         1000    ///< Shortest sleep after a long upload wake
+
+/**
+ * @brief Power management in CONTINUOUS mode (needs CONFIG_PM_ENABLE)
+ * 
+ * Between task wakes the CPU drops to the crystal frequency and, with
+ * tickless idle, the chip enters automatic light sleep. Components hold
+ * esp_pm locks while their timing matters: an APB lock during ST7789 SPI
+ * transfers, a CPU lock during DHT11 exchanges; WiFi uses modem sleep.
+ */
+#define SYSTEM_PM_MAX_FREQ_MHZ      CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ
+#define SYSTEM_PM_MIN_FREQ_MHZ      CONFIG_XTAL_FREQ
+#ifndef SYSTEM_PM_LIGHT_SLEEP
+#define SYSTEM_PM_LIGHT_SLEEP       1
+#endif
+
+/**
+ * @brief Run the benchmarks of benchmark.h at startup (menuconfig: Home Monitor
+ *        -> Run the on-device benchmarks, i.e. CONFIG_SYSTEM_BENCHMARK)
+ * 
+ * Display, decode and encoding benchmarks run before the initial status
+ * screen; the upload benchmarks run once WiFi first connects. Normal operation
+ * follows. CONTINUOUS power mode only.
+ */
+#ifndef SYSTEM_BENCHMARK
+#ifdef CONFIG_SYSTEM_BENCHMARK
+#define SYSTEM_BENCHMARK            1
+#else
+#define SYSTEM_BENCHMARK            0
+#endif
+#endif
 
 /**
  * @brief Forward declarations
@@ -267,10 +363,11 @@ static shared_sensor_data_t shared_data = {0};
 static void update_display_with_sensor_data(float temperature, float humidity);
 static void display_sensor_error(uint32_t failure_count);
 static void restart_system_due_to_sensor_failure(void);
-static void display_clear_and_setup(void);
-static void display_network_status(void);
-static bool safe_read_sensor_data(sensor_data_t *data, bool *has_valid_data);
-static bool safe_write_sensor_data(const dht11_data_t *sensor_reading, uint32_t timestamp);
+static void display_network_status(bool connected);
+static bool snapshot_sensor_data(sensor_data_t *data);
+static void wifi_task(void *pvParameters);
+static void sensor_task(void *pvParameters);
+static void publish_sensor_data(const dht11_data_t *sensor_reading, uint32_t timestamp);
 
 /**
  * @brief Initialize shared data structure with thread safety
@@ -278,229 +375,235 @@ static bool safe_write_sensor_data(const dht11_data_t *sensor_reading, uint32_t
 static esp_err_t init_shared_data(void) 
 {
     // Initialize sensor data to invalid state
+    seqlock_init(&shared_data.lock);
     shared_data.data.valid = false;
     shared_data.data.temperature = 0.0;
     shared_data.data.humidity = 0.0;
     shared_data.timestamp = 0;
     shared_data.has_new_data = false;
     
-    // Create mutex for thread-safe access
-    shared_data.mutex = xSemaphoreCreateMutex();
-    if (shared_data.mutex == NULL) 
-    {
-        ESP_LOGE(TAG, "Failed to create shared data mutex");
-        return ESP_FAIL;
-    }
-    
     return ESP_OK;
 }
 
 /**
- * @brief Safely read sensor data from shared memory with mutex protection
+ * @brief Take a consistent snapshot of the shared sensor data
+ * 
+ * Lock-free: never blocks, never fails. Safe to call from either core.
  * 
- * @param data Pointer to store the read sensor data
- * @param has_valid_data Pointer to store validity flag
- * @return true if mutex acquired and data read successfully, false otherwise
+ * @param data Pointer to store temperature and humidity (only written when valid)
+ * @return true if the shared data holds a valid reading, false otherwise
  */
-static bool safe_read_sensor_data(sensor_data_t *data, bool *has_valid_data)
+static bool snapshot_sensor_data(sensor_data_t *data)
 {
-    if (xSemaphoreTake(shared_data.mutex, pdMS_TO_TICKS(MUTEX_TIMEOUT_MS)) == pdTRUE) {
-        if (shared_data.data.valid) {
-            data->temperature = shared_data.data.temperature;
-            data->humidity = shared_data.data.humidity;
-            *has_valid_data = true;
-        } else {
-            *has_valid_data = false;
-        }
-        xSemaphoreGive(shared_data.mutex);
-        return true;
+    dht11_data_t reading;
+    seqlock_load(&shared_data.lock, &shared_data.data, &reading, sizeof(reading));
+    
+    if (reading.valid) {
+        data->temperature = reading.temperature;
+        data->humidity = reading.humidity;
     }
-    ESP_LOGW(TAG, "Failed to acquire mutex for reading sensor data");
-    *has_valid_data = false;
-    return false;
+    return reading.valid;
 }
 
 /**
- * @brief Safely write sensor data to shared memory with mutex protection
+ * @brief Publish a new sensor reading to the shared data
+ * 
+ * Must only be called from the sensor task (single writer).
  * 
  * @param sensor_reading Pointer to sensor data to write
  * @param timestamp Timestamp of the reading
- * @return true if mutex acquired and data written successfully, false otherwise
  */
-static bool safe_write_sensor_data(const dht11_data_t *sensor_reading, uint32_t timestamp)
+static void publish_sensor_data(const dht11_data_t *sensor_reading, uint32_t timestamp)
 {
-    if (xSemaphoreTake(shared_data.mutex, pdMS_TO_TICKS(MUTEX_TIMEOUT_MS)) == pdTRUE) {
-        shared_data.data = *sensor_reading;
-        shared_data.timestamp = timestamp;
-        shared_data.has_new_data = true;
-        xSemaphoreGive(shared_data.mutex);
-        return true;
-    }
-    ESP_LOGW(TAG, "Failed to acquire mutex for writing sensor data");
-    return false;
+    seqlock_write_begin(&shared_data.lock);
+    shared_data.data = *sensor_reading;
+    shared_data.timestamp = timestamp;
+    shared_data.has_new_data = true;
+    seqlock_write_end(&shared_data.lock);
 }
 
 /**
- * @brief DHT11 Environmental Sensor Reading Task (Core 0 - Protocol CPU)
+ * @brief Publish a finished reading: shared store, sample ring, history and display
  * 
- * This task implements the primary environmental data acquisition subsystem,
- * operating on Core 0 to ensure timing-critical sensor communications are
- * isolated from network operations and other non-deterministic processes.
+ * This is the one place readings enter the system. It runs in the sensor
+ * task (the scheduler's callback), which keeps the seqlock single-writer.
+ * Quantities the reading does not carry keep their previous value.
  * 
- * Task Architecture and Responsibilities:
- * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+ * The display always shows the latest reading. The sample ring only gets
+ * the samples the aggregator reports (a change beyond the deadband, or the
+ * heartbeat), each with a rollup of the readings it stands for.
  * 
- * ┌─────────────────────────────────────────────────────────────────────┐
- * │                        SENSOR TASK WORKFLOW                        │
- * └─────────────────────────────────────────────────────────────────────┘
+ * The first reading can complete before the display is up; system_start()
+ * then shows it when it sets BOOT_DISPLAY_READY_BIT.
+ */
+static void on_sensor_reading(int sensor, const sensor_reading_t *reading, void *ctx)
+{
+    static uint32_t reading_count = 0;
+    reading_count++;
+    
+    dht11_data_t climate;
+    seqlock_load(&shared_data.lock, &shared_data.data, &climate, sizeof(climate));
+    if (reading->fields & SENSOR_FIELD_TEMPERATURE) 
+    {
+        climate.temperature = reading->temperature;
+    }
+    if (reading->fields & SENSOR_FIELD_HUMIDITY) 
+    {
+        climate.humidity = reading->humidity;
+    }
+    climate.valid = true;
+    
+    // Publish the latest reading; buffer it for upload only when it closes a window
+    publish_sensor_data(&climate, reading_count);
+    sensor_history_add(climate.temperature, climate.humidity);
+    sensor_sample_t sample = {
+        .timestamp = (uint32_t)time(NULL),
+        .temperature = climate.temperature,
+        .humidity = climate.humidity,
+    };
+    sensor_sample_t report;
+    if (sample_aggregator_add(&sample, &report) && sample_ring_push(&report)) 
+    {
+        EVENT_LOGW(TAG, "Sample ring full - oldest reading overwritten (%lu dropped)", 
+                   sample_ring_dropped());
+    }
+    EVENT_LOGI(TAG, "Sensor %s: %.1f°C, %.1f%% (reading %lu)", sensor_scheduler_name(sensor),
+               climate.temperature, climate.humidity, reading_count);
+    perf_monitor_boot_mark(PERF_BOOT_FIRST_READING);
+    ota_manager_report_health(OTA_HEALTH_READING);
+    
+    // Published before the check, so system_start() cannot miss this reading
+    EventBits_t boot = xEventGroupSetBits(boot_events, BOOT_FIRST_READING_BIT);
+    if (boot & BOOT_DISPLAY_READY_BIT) 
+    {
+        update_display_with_sensor_data(climate.temperature, climate.humidity);
+    }
+}
+
+/**
+ * @brief React to a sensor's health change
  * 
- * ┌─ Task Start ─┐
- *         │
- *         ▼
- * ┌─ Initialize Variables ─┐
- *         │
- *         ▼
- * ┌─ Precise 10s Delay ─┐ ◄─┐
- *         │               │
- *         ▼               │
- * ┌─ Read DHT11 Sensor ─┐ │
- *         │               │
- *         ▼               │
- * ┌─ Validate Checksum ─┐ │
- *         │               │
- *         ▼               │
- * ┌─ Acquire Mutex ─────┐ │
- *         │               │
- *         ▼               │
- * ┌─ Update Shared Data ─┐│
- *         │               │
- *         ▼               │
- * ┌─ Release Mutex ─────┐ │
- *         │               │
- *         ▼               │
- * ┌─ Update Display ────┐ │
- *         │               │
- *         └───────────────┘
+ * Every sensor registered by register_sensors() is required, so a FAILED
+ * sensor restarts the system. FAILED is only reached once the scheduler's
+ * own recovery steps (see sensor_scheduler.h) have not brought it back.
+ */
+static void on_sensor_health(int sensor, const sensor_stats_t *stats, void *ctx)
+{
+    const char *name = sensor_scheduler_name(sensor);
+    
+    switch (stats->health) 
+    {
+        case SENSOR_HEALTH_OK:
+            EVENT_LOGI(TAG, "Sensor %s recovered in %lu ms (%lu of %lu conversions failed so far)", 
+                       name, stats->last_recovery_ms, stats->failures, stats->conversions);
+            break;
+            
+        case SENSOR_HEALTH_DEGRADED:
+            EVENT_LOGW(TAG, "WARNING: Sensor %s without reading for %d s - displaying error", 
+                       name, SENSOR_ERROR_DISPLAY_TIME_MS / 1000);
+            display_sensor_error(stats->consecutive_failures);
+            break;
+            
+        case SENSOR_HEALTH_FAILED:
+            EVENT_LOGE(TAG, "CRITICAL: Sensor %s without reading for %d s despite recovery - restarting system", 
+                       name, SENSOR_RESTART_TIME_MS / 1000);
+            restart_system_due_to_sensor_failure();
+            break;
+    }
+}
+
+/**
+ * @brief Register every sensor with the scheduler
  * 
- * Key Technical Features:
- * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+ * The DHT11 is the only backend so far. Further sensors (I2C on
+ * I2C_SDA_PIN/I2C_SCL_PIN, SPI on SPI_CS1_PIN/SPI_CS2_PIN, ADC) are added
+ * here with their own sensor_driver_t and period.
+ */
+static esp_err_t register_sensors(void) 
+{
+    esp_err_t ret = sensor_scheduler_init(on_sensor_reading, on_sensor_health, NULL);
+    if (ret != ESP_OK) 
+    {
+        return ret;
+    }
+    
+    // The build default until device_config_init() has loaded the stored period
+    const sensor_schedule_t climate_schedule = {
+        .period_ms = device_config_read_interval_ms(),
+        .degraded_after_ms = SENSOR_ERROR_DISPLAY_TIME_MS,
+        .failed_after_ms = SENSOR_RESTART_TIME_MS,
+    };
+    return sensor_scheduler_add(&dht11_sensor_driver, NULL, &climate_schedule, &climate_sensor);
+}
+
+/**
+ * @brief Apply the active configuration (device_config listener)
  * 
- * • DETERMINISTIC TIMING:
- *   - vTaskDelayUntil() ensures precise 10-second intervals
- *   - Timing immune to task execution duration variations
- *   - Prevents timing drift over extended operation periods
+ * Runs in the WiFi task: once when device_config_init() has loaded the
+ * stored configuration, and after every accepted server push. The sensor
+ * period and the reporting deadbands change without a restart; wifi_task()
+ * reads the transmission period on every cycle by itself. A new
+ * firmware_url is picked up by the update task (ota_manager.h).
+ */
+static void on_config_change(const device_config_t *config, void *ctx) 
+{
+    memcpy(device_id, config->device_id, sizeof(device_id));
+    
+    if (climate_sensor >= 0) 
+    {
+        sensor_scheduler_set_period(climate_sensor, config->read_interval_ms);
+    }
+    
+    const aggregator_config_t aggregation = {
+        .temperature_deadband = config->temperature_deadband,
+        .humidity_deadband = config->humidity_deadband,
+        .heartbeat_s = config->heartbeat_s,
+    };
+    if (sample_aggregator_configure(&aggregation) != ESP_OK) 
+    {
+        ESP_LOGW(TAG, "Reporting configuration rejected - keeping the previous one");
+    }
+    
+    ota_manager_check();
+}
+
+/**
+ * @brief Sensor Scheduler Task (Core 0 - Protocol CPU)
  * 
- * • ROBUST ERROR HANDLING:
- *   - Graceful handling of sensor communication failures
- *   - Maintains system operation during temporary sensor issues
- *   - Detailed error logging for diagnostic purposes
+ * Runs sensor_scheduler for every sensor registered in system_init(). The
+ * task sleeps until the next conversion start or poll deadline of any
+ * sensor; conversions of different sensors overlap, and each sensor keeps
+ * its own drift-free period (see sensor_scheduler.h).
  * 
- * • THREAD-SAFE OPERATIONS:
- *   - Mutex-protected access to shared data structure
- *   - Atomic update operations prevent data corruption
- *   - Timeout mechanisms prevent deadlock conditions
+ * Readings and health changes come back through on_sensor_reading() and
+ * on_sensor_health() in this task:
  * 
- * • DISPLAY INTEGRATION:
- *   - Real-time display updates on successful readings
- *   - Visual error indicators for sensor failure states
- *   - Immediate user feedback on system status changes
+ * • Readings are published through the sequence lock (single writer),
+ *   aggregated into the sample ring and posted to the display task queue
+ * • A failing sensor is reinitialized, power-cycled and then read less
+ *   often by the scheduler, starting with its first failed conversion
+ * • A sensor without a reading for SENSOR_ERROR_DISPLAY_TIME_MS shows the
+ *   error screen; after SENSOR_RESTART_TIME_MS, with every recovery step
+ *   tried, the system restarts
  * 
  * Performance Characteristics:
- * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
- * 
- * • Execution Frequency: Every 10 seconds (configurable)
  * • Task Priority: 2 (high priority for timing accuracy)
- * • Stack Size: 4KB (sufficient for sensor operations)
+ * • Stack Size: 4KB
  * • Core Affinity: Pinned to Core 0 (Protocol CPU)
- * • Blocking Time: ~20ms per sensor read cycle
- * • Error Recovery: Automatic with detailed logging
+ * • Blocking Time: none - DHT11 conversions run on esp_timer
  * 
  * @param pvParameters Unused FreeRTOS task parameter (required by API)
  * 
  * @note This task runs in an infinite loop and should never exit
- * @warning Modifying timing parameters may affect DHT11 communication reliability
- * 
- * @see dht11_read() for sensor communication protocol details
- * @see update_display_with_sensor_data() for display update implementation
  */
 static void sensor_task(void *pvParameters) 
 {
-    ESP_LOGI(TAG, "DHT11 Sensor Task Started (Core %d, 10s interval)", xPortGetCoreID());
-    
-    uint32_t cycle_count = 0;
-    uint32_t consecutive_failures = 0;
-    bool error_displayed = false;
-    TickType_t last_wake_time = xTaskGetTickCount();
-    
-    while (1) 
-    {
-        cycle_count++;
-        
-        // Read DHT11 sensor
-        dht11_data_t sensor_reading = {0};
-        esp_err_t read_result = dht11_read(&sensor_reading);
-        
-        // Update shared data with thread safety
-        if (read_result == ESP_OK && sensor_reading.valid) 
-        {
-            // Successful sensor reading - reset failure counters
-            if (consecutive_failures > 0) 
-            {
-                ESP_LOGI(TAG, "Sensor recovered after %lu consecutive failures", consecutive_failures);
-                consecutive_failures = 0;
-                error_displayed = false;
-            }
-            
-            // Write sensor data using helper function
-            if (safe_write_sensor_data(&sensor_reading, cycle_count)) 
-            {
-                ESP_LOGI(TAG, "Sensor: %.1f°C, %.1f%% (cycle %lu)", 
-                         sensor_reading.temperature, sensor_reading.humidity, cycle_count);
-                
-                // Update display with new sensor data
-                update_display_with_sensor_data(sensor_reading.temperature, sensor_reading.humidity);
-            }
-        } 
-        else 
-        {
-            // Sensor reading failed - increment failure counter
-            consecutive_failures++;
-            
-            ESP_LOGW(TAG, "Sensor read failed: %s (failure %lu/%d)", 
-                     esp_err_to_name(read_result), consecutive_failures, SENSOR_RESTART_COUNT_LIMIT);
-            
-            // Check for sensor health safeguards
-            if (consecutive_failures >= SENSOR_RESTART_COUNT_LIMIT) 
-            {
-                // 2 minutes of failures - restart system
-                ESP_LOGE(TAG, "CRITICAL: Sensor failed for 2 minutes - restarting system");
-                restart_system_due_to_sensor_failure();
-            } 
-            else if (consecutive_failures >= SENSOR_FAILURE_COUNT_LIMIT && !error_displayed) 
-            {
-                // 1 minute of failures - display error
-                ESP_LOGW(TAG, "WARNING: Sensor failed for 1 minute - displaying error");
-                display_sensor_error(consecutive_failures);
-                error_displayed = true;
-            } 
-            else if (consecutive_failures < SENSOR_FAILURE_COUNT_LIMIT) 
-            {
-                // Still within normal failure tolerance - update display with last known data
-                sensor_data_t last_data;
-                bool has_valid_data;
-                if (safe_read_sensor_data(&last_data, &has_valid_data) && has_valid_data) 
-                {
-                    update_display_with_sensor_data(last_data.temperature, last_data.humidity);
-                }
-            }
-        }
-        
-        vTaskDelayUntil(&last_wake_time, pdMS_TO_TICKS(SENSOR_READ_INTERVAL_MS));
-    }
+    ESP_LOGI(TAG, "Sensor Scheduler Task Started (Core %d)", xPortGetCoreID());
+    sensor_scheduler_run();
 }
 
 /**
- * @brief Display sensor error on screen when sensor fails for 1 minute
+ * @brief Display sensor error on screen once a sensor's health is DEGRADED
  * 
  * Shows a clear error message indicating sensor failure and the current failure count.
  * This provides immediate visual feedback that the sensor system requires attention.
@@ -509,23 +612,22 @@ static void sensor_task(void *pvParameters)
  */
 static void display_sensor_error(uint32_t failure_count)
 {
-    display_clear_and_setup();
-    st7789_draw_large_string(DISPLAY_TEXT_X, DISPLAY_LINE_1_Y, "SENS0R", ST7789_RED, ST7789_BLACK);
-    st7789_draw_large_string(DISPLAY_TEXT_X, DISPLAY_LINE_2_Y, "ERR0R!", ST7789_RED, ST7789_BLACK);
-    
     char error_msg[20];
-    snprintf(error_msg, sizeof(error_msg), "ERR0R:%lu", failure_count);
-    st7789_draw_large_string(DISPLAY_TEXT_X, DISPLAY_LINE_3_Y, error_msg, ST7789_YELLOW, ST7789_BLACK);
+    snprintf(error_msg, sizeof(error_msg), "ERROR:%lu", failure_count);
+    display_manager_post_message("SENSOR", ST7789_RED,
+                                 "ERROR!", ST7789_RED,
+                                 error_msg, ST7789_YELLOW);
     
-    ESP_LOGE(TAG, "Sensor error displayed: %lu consecutive failures", failure_count);
+    EVENT_LOGE(TAG, "Sensor error displayed: %lu consecutive failures", failure_count);
 }
 
 /**
- * @brief Restart system due to critical sensor failure (2 minutes without readings)
+ * @brief Restart system due to critical sensor failure
  * 
- * Performs a controlled system restart when the DHT11 sensor has been unresponsive
- * for 2 minutes (12 consecutive reading failures). This ensures the system attempts
- * to recover from hardware issues that might be resolved by a restart.
+ * Performs a controlled system restart when a sensor has been unresponsive
+ * for SENSOR_RESTART_TIME_MS (its health reached FAILED). This is the last
+ * resort: the scheduler has already reinitialized and power-cycled the
+ * sensor, so what is left to try is resetting the rest of the chip.
  * 
  * The restart is logged for diagnostic purposes and performed using ESP32's
  * built-in restart mechanism.
@@ -534,22 +636,214 @@ static void restart_system_due_to_sensor_failure(void)
 {
     ESP_LOGE(TAG, "CRITICAL SENSOR FAILURE: Restarting system in 5 seconds...");
     
-    // Display critical error message
-    display_clear_and_setup();
-    st7789_draw_large_string(DISPLAY_TEXT_X, DISPLAY_LINE_1_Y, "TEMP ERR0R", ST7789_RED, ST7789_BLACK);
-    st7789_draw_large_string(DISPLAY_TEXT_X, DISPLAY_LINE_2_Y, "RESTART", ST7789_RED, ST7789_BLACK);
-    st7789_draw_large_string(DISPLAY_TEXT_X, DISPLAY_LINE_3_Y, "IN 5S", ST7789_YELLOW, ST7789_BLACK);
+    // Display critical error message (rendered by the display task during the delay)
+    display_manager_post_message("TEMP ERROR", ST7789_RED,
+                                 "RESTART", ST7789_RED,
+                                 "IN 5S", ST7789_YELLOW);
     
     // Give user time to see the message
     vTaskDelay(pdMS_TO_TICKS(RESTART_WARNING_DELAY_MS));
     
-    // Log restart reason
+    // Log restart reason, after whatever led up to it
+    event_log_drain();
     ESP_LOGE(TAG, "Performing system restart due to sensor failure");
     
     // Perform system restart
     esp_restart();
 }
 
+/**
+ * @brief Drain the sample ring in batches of up to WIFI_BATCH_MAX_SAMPLES
+ * 
+ * Batches are peeked one after another and sent without committing. The
+ * first failure stops sending. Everything sent is committed together, and
+ * only once wifi_manager_flush() confirms delivery: at once with HTTP,
+ * after the broker's PUBACKs with MQTT, whose publishes only reach the
+ * client's RAM outbox. Otherwise all of it stays buffered and is sent
+ * again next cycle.
+ * 
+ * @return Number of readings delivered
+ */
+static size_t upload_buffered_samples(void) 
+{
+    static sensor_sample_t batch[WIFI_BATCH_MAX_SAMPLES];
+    
+    if (sample_ring_count() == 0) 
+    {
+        EVENT_LOGI(TAG, "TX: no buffered readings");
+        return 0;
+    }
+    
+    uint32_t start_seq = 0;
+    uint32_t next_seq = 0;
+    size_t sent = 0;
+    uint32_t first_seq = 0;
+    size_t count = sample_ring_peek(batch, WIFI_BATCH_MAX_SAMPLES, &first_seq);
+    
+    while (count > 0) 
+    {
+        esp_err_t tx_result = wifi_manager_send_batch(device_id, batch, count);
+        if (tx_result != ESP_OK) 
+        {
+            EVENT_LOGW(TAG, "WiFi TX failed: %s", esp_err_to_name(tx_result));
+            break;
+        }
+        
+        // Overflow during the upload may have skipped samples; the commit
+        // below is by sequence and stays correct
+        if (sent == 0) 
+        {
+            start_seq = first_seq;
+        }
+        next_seq = first_seq + (uint32_t)count;
+        sent += count;
+        EVENT_LOGI(TAG, "TX: %u readings, %.1f°C .. %.1f°C", (unsigned)count, 
+                   batch[0].temperature, batch[count - 1].temperature);
+        
+        count = sample_ring_peek_from(next_seq, batch, WIFI_BATCH_MAX_SAMPLES, &first_seq);
+    }
+    
+    if (sent == 0) 
+    {
+        return 0;
+    }
+    
+    esp_err_t flush_result = wifi_manager_flush(HTTP_TIMEOUT_MS);
+    if (flush_result != ESP_OK) 
+    {
+        EVENT_LOGW(TAG, "TX: delivery not confirmed (%s) - %u readings kept", 
+                   esp_err_to_name(flush_result), (unsigned)sample_ring_count());
+        return 0;
+    }
+    
+    sample_ring_commit(start_seq, next_seq - start_seq);
+    perf_monitor_boot_mark(PERF_BOOT_FIRST_UPLOAD);
+    ota_manager_report_health(OTA_HEALTH_UPLOAD);
+    return sent;
+}
+
+/**
+ * @brief Move full blocks of buffered samples from RAM into the flash log
+ * 
+ * Runs while the link is down (and while an older backlog is replayed) so
+ * the RAM ring never overflows during a long outage. Only whole blocks are
+ * written; the remainder stays in RAM until the next cycle. Page programs
+ * and sector erases stall both cores' caches, so telemetry_log places each
+ * one between sensor conversions; this task waits, the readings do not.
+ */
+static void spill_samples_to_flash(void) 
+{
+    static sensor_sample_t block[TELEMETRY_LOG_BLOCK_SAMPLES];
+    
+    if (!telemetry_log_is_ready()) 
+    {
+        return;
+    }
+    
+    while (sample_ring_count() >= TELEMETRY_LOG_BLOCK_SAMPLES) 
+    {
+        uint32_t first_seq = 0;
+        size_t count = sample_ring_peek(block, TELEMETRY_LOG_BLOCK_SAMPLES, &first_seq);
+        esp_err_t ret = telemetry_log_append(block, count);
+        if (ret != ESP_OK) 
+        {
+            EVENT_LOGW(TAG, "Offline log write failed: %s", esp_err_to_name(ret));
+            return;
+        }
+        sample_ring_commit(first_seq, count);
+        EVENT_LOGI(TAG, "Stored %u readings offline (%lu blocks pending)", 
+                   (unsigned)count, telemetry_log_pending_blocks());
+    }
+}
+
+/**
+ * @brief Replay the flash log, oldest first, at a limited rate
+ * 
+ * Sends at most TELEMETRY_LOG_REPLAY_BLOCKS_PER_CYCLE blocks per cycle so
+ * that a long backlog does not monopolize the link. While a backlog
+ * remains, new readings keep going to flash behind it so the server
+ * receives everything in order.
+ * 
+ * @return true if the flash log is empty and the RAM ring may be uploaded
+ */
+static bool replay_flash_log(void) 
+{
+    static sensor_sample_t block[TELEMETRY_LOG_BLOCK_SAMPLES];
+    
+    if (!telemetry_log_is_ready() || telemetry_log_pending_blocks() == 0) 
+    {
+        return true;
+    }
+    
+    for (int sent = 0; sent < TELEMETRY_LOG_REPLAY_BLOCKS_PER_CYCLE; sent++) 
+    {
+        uint32_t block_seq = 0;
+        size_t count = telemetry_log_peek(block, &block_seq);
+        if (count == 0) 
+        {
+            EVENT_LOGI(TAG, "Offline backlog replayed");
+            return true;
+        }
+        
+        // Consumed only once delivered: with MQTT a publish is only queued
+        esp_err_t tx_result = wifi_manager_send_batch(device_id, block, count);
+        if (tx_result == ESP_OK) 
+        {
+            tx_result = wifi_manager_flush(HTTP_TIMEOUT_MS);
+        }
+        if (tx_result != ESP_OK) 
+        {
+            EVENT_LOGW(TAG, "Backlog replay failed: %s", esp_err_to_name(tx_result));
+            break;
+        }
+        telemetry_log_consume(block_seq);
+        perf_monitor_boot_mark(PERF_BOOT_FIRST_UPLOAD);
+        ota_manager_report_health(OTA_HEALTH_UPLOAD);
+    }
+    
+    EVENT_LOGI(TAG, "Offline backlog: %lu blocks still pending", telemetry_log_pending_blocks());
+    spill_samples_to_flash();
+    return false;
+}
+
+/**
+ * @brief Log a diagnostics record and upload it if the link is up
+ * 
+ * Each record covers the PERF_REPORT_INTERVAL_MS since the previous one. A
+ * record that cannot be uploaded is only logged; diagnostics are not
+ * buffered like readings.
+ */
+static void report_diagnostics(bool connected) 
+{
+    static perf_report_t report;
+    static event_log_excerpt_t log_excerpt;
+    
+    if (perf_monitor_snapshot(&report, true) != ESP_OK) 
+    {
+        return;     // Built with PERF_MONITOR_ENABLED=0
+    }
+    perf_monitor_log(&report);
+    
+    if (connected) 
+    {
+        // Warnings and errors since the last accepted record travel with it
+        event_log_peek(&log_excerpt);
+        esp_err_t ret = wifi_manager_send_diagnostics(device_id, &report, &log_excerpt);
+        if (ret == ESP_OK) 
+        {
+            ret = wifi_manager_flush(HTTP_TIMEOUT_MS);
+        }
+        if (ret == ESP_OK) 
+        {
+            event_log_commit(&log_excerpt);
+        }
+        else 
+        {
+            EVENT_LOGW(TAG, "Diagnostics upload failed: %s", esp_err_to_name(ret));
+        }
+    }
+}
+
 /**
  * @brief WiFi IoT Data Transmission Task (Core 1 - Application CPU)
  * 
@@ -564,13 +858,19 @@ static void restart_system_due_to_sensor_failure(void)
  * │                     IoT TRANSMISSION WORKFLOW                      │
  * └─────────────────────────────────────────────────────────────────────┘
  * 
- * ┌─ Task Start ─┐
+ * ┌─ Task Start ─┐               ← Created by system_init(), before the display
+ *         │
+ *         ▼
+ * ┌─ NVS + WiFi Init ───────┐   ← Parallel to display reset and first read
  *         │
  *         ▼
- * ┌─ Initialize Counters ─┐
+ * ┌─ Connect ───────────────┐   ← Right away, no startup delay
  *         │
  *         ▼
- * ┌─ Precise 30s Delay ─┐ ◄───┐
+ * ┌─ Wait Display + Reading ┐   ← Boot event bits
+ *         │
+ *         ▼
+ * ┌─ Transmit Interval ─┐ ◄───┐
  *         │                  │
  *         ▼                  │
  * ┌─ Check WiFi Status ─┐    │
@@ -596,14 +896,15 @@ static void restart_system_due_to_sensor_failure(void)
  * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
  * 
  * • RESILIENT CONNECTIVITY:
- *   - Automatic WiFi connection monitoring and recovery
+ *   - Reconnection handled by wifi_manager with jittered exponential backoff
+ *   - Wakes immediately on link up / link down instead of the next slot
  *   - Graceful handling of network outages and server errors
  *   - Continues operation during temporary connectivity issues
  *   - Detailed connection quality monitoring (RSSI tracking)
  * 
  * • INTELLIGENT DATA MANAGEMENT:
  *   - JSON format ensures universal IoT platform compatibility
- *   - Sends "N/A" values when sensor data unavailable
+ *   - Buffers every reading so outages do not leave gaps in the data
  *   - Timestamp synchronization for accurate time-series data
  *   - Device identification for multi-sensor deployments
  * 
@@ -622,43 +923,84 @@ static void restart_system_due_to_sensor_failure(void)
  * Data Transmission Format:
  * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
  * 
- * JSON Payload Structure:
+ * JSON Payload Structure (one POST per batch of buffered readings):
  * {
  *   "device_id": "ESP32_SENSOR_01",     // Unique device identifier
- *   "timestamp": 1696204800,            // Unix timestamp (UTC)
- *   "temperature": 23.5,                // Celsius, -999.0 for N/A
- *   "humidity": 65.0,                   // Percentage, -999.0 for N/A
- *   "signal_strength": -45              // WiFi RSSI in dBm
+ *   "rssi": -45,                        // WiFi RSSI in dBm at upload time
+ *   "readings": [                       // Oldest first, up to 32 per batch
+ *     {"timestamp": 1696204800, "temperature": 23.5, "humidity": 65.0},
+ *     {"timestamp": 1696205100, "temperature": 23.6, "humidity": 65.0,
+ *      "rollup": {"count": 30, "temperature": {"min": 23.4, ...}, ...}},
+ *     ...
+ *   ]
  * }
  * 
+ * sensor_task() pushes every sample the aggregator reports into the sample
+ * ring, so readings taken between transmissions or during an outage are
+ * uploaded later instead of being lost; most cycles in a steady room have
+ * nothing to send. A batch is removed from the ring only after
+ * the server acknowledged it.
+ * 
+ * During an outage, full blocks of readings are moved from the RAM ring
+ * into the "telemetry" flash partition (~22 hours at one sample per
+ * reading, much longer while the aggregator reports only heartbeats). Once
+ * the link is back, the flash backlog is replayed oldest first at
+ * TELEMETRY_LOG_REPLAY_BLOCKS_PER_CYCLE blocks per cycle before the RAM
+ * ring is uploaded again.
+ * 
  * Performance Characteristics:
  * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
  * 
- * • Transmission Frequency: Every 30 seconds (configurable)
+ * • First Upload: as soon as the link and the first reading are there,
+ *   followed by one diagnostics record with the boot milestones
+ * • Transmission Frequency: Every 30 seconds (default; read from
+ *   device_config every cycle, so a pushed period applies from the next slot)
  * • Task Priority: 1 (lower than sensor task)
  * • Stack Size: 8KB (sufficient for HTTP operations)
  * • Core Affinity: Pinned to Core 1 (Application CPU)
  * • Network Timeout: 10 seconds (configurable)
- * • Payload Size: ~150 bytes (compact and efficient)
+ * • Payload Size: ~64 bytes per reading plus ~60 bytes per batch
  * 
  * @param pvParameters Unused FreeRTOS task parameter (required by API)
  * 
  * @note This task runs in an infinite loop and should never exit
  * @warning Network operations may experience variable latency
  * 
- * @see wifi_manager_send_data() for HTTP transmission implementation
+ * @see wifi_manager_send_batch() for HTTP transmission implementation
  * @see wifi_manager_is_ready() for connection status checking
  */
 static void wifi_task(void *pvParameters) 
 {
-    ESP_LOGI(TAG, "WiFi Task Started (Core %d, 30s interval)", xPortGetCoreID());
+    ESP_LOGI(TAG, "WiFi Task Started (Core %d)", xPortGetCoreID());
+    
+    // NVS and the stored configuration first: the credentials, server and
+    // device id come from it, and on_config_change() moves the sensor onto
+    // its stored period
+    if (device_config_init() != ESP_OK) 
+    {
+        ESP_LOGW(TAG, "Stored configuration unavailable - using build defaults");
+    }
+    
+    // TCP/IP stack and WiFi driver, while core 0 resets the display and the
+    // DHT11 powers up
+    if (wifi_manager_init() != ESP_OK) 
+    {
+        ESP_LOGE(TAG, "WiFi manager initialization failed - continuing with local monitoring only");
+        xEventGroupWaitBits(boot_events, BOOT_DISPLAY_READY_BIT, pdFALSE, pdTRUE, portMAX_DELAY);
+        display_network_status(false);
+        wifi_task_handle = NULL;
+        vTaskDelete(NULL);
+    }
+    perf_monitor_boot_mark(PERF_BOOT_NETWORK_READY);
+    perf_monitor_watch_task(xTaskGetCurrentTaskHandle());
     
-    // Wait 10 seconds before attempting WiFi connection to allow display to fully initialize
-    ESP_LOGI(TAG, "Waiting 10 seconds before WiFi connection to allow display initialization...");
-    vTaskDelay(pdMS_TO_TICKS(WIFI_STARTUP_DELAY_MS));
+    // Non-fatal: without the partition, outages are only bridged by the RAM ring
+    if (telemetry_log_init() != ESP_OK) 
+    {
+        ESP_LOGW(TAG, "Offline telemetry log unavailable");
+    }
     
-    // Attempt initial WiFi connection using the blocking connect function
-    // Since we've delayed this, it won't interfere with display initialization
+    // Display and sensor do not depend on the link, so connect right away
     ESP_LOGI(TAG, "Attempting initial WiFi connection (with blocking behavior)...");
     esp_err_t initial_connect = wifi_manager_connect();  // Blocking connection attempt
     if (initial_connect == ESP_OK) 
@@ -670,115 +1012,120 @@ static void wifi_task(void *pvParameters)
         ESP_LOGW(TAG, "Initial WiFi connection failed - will retry in background");
     }
     
-    uint32_t transmission_count = 0;
-    uint32_t disconnection_time = 0;
+    // The loop posts the network status, so it needs the status screen; and
+    // its first pass uploads, so give the first reading a moment to arrive
+    xEventGroupWaitBits(boot_events, BOOT_DISPLAY_READY_BIT, pdFALSE, pdTRUE, portMAX_DELAY);
+    EventBits_t boot = xEventGroupWaitBits(boot_events, BOOT_FIRST_READING_BIT, pdFALSE, pdTRUE, 
+                                           pdMS_TO_TICKS(FIRST_READING_WAIT_MS));
+    if (!(boot & BOOT_FIRST_READING_BIT)) 
+    {
+        ESP_LOGW(TAG, "No sensor reading yet - first upload follows the next reading");
+    }
+    
+#if SYSTEM_BENCHMARK
+    if (benchmark_run_network() == ESP_FAIL) 
+    {
+        ESP_LOGW(TAG, "Upload benchmark had failures");
+    }
+#endif
+    
+    TickType_t disconnected_since = xTaskGetTickCount();
     bool was_connected = false;  // Start with false, will be updated in loop
+    bool net_status_shown = false;
     TickType_t last_wake_time = xTaskGetTickCount();
+    TickType_t last_report_time = last_wake_time;
+    bool boot_reported = false;
     
     while (1) 
     {
-        transmission_count++;
         bool is_connected = wifi_manager_is_ready();
+        bool uploaded = false;
+        
+        // Publish network indicator changes to the display task
+        if (!net_status_shown || is_connected != was_connected) 
+        {
+            display_network_status(is_connected);
+            net_status_shown = true;
+        }
         
         // Detect WiFi disconnection and track disconnection time
         if (was_connected && !is_connected) 
         {
-            ESP_LOGW(TAG, "WiFi disconnection detected - starting reconnection monitoring");
-            disconnection_time = transmission_count;
+            EVENT_LOGW(TAG, "WiFi disconnection detected - wifi_manager is reconnecting with backoff");
+            disconnected_since = xTaskGetTickCount();
         }
         
-        // If WiFi is not connected, attempt reconnection every 60 seconds (2 cycles)
         if (!is_connected) 
         {
-            uint32_t cycles_disconnected = transmission_count - disconnection_time;
-            uint32_t seconds_disconnected = cycles_disconnected * (WIFI_TRANSMIT_INTERVAL_MS / 1000);
-            
-            // For initial connection (never connected) or reconnection after disconnection
-            bool should_attempt_connection = false;
-            
-            if (disconnection_time == 0) 
-            {
-                // Never connected - try every 60 seconds from start
-                should_attempt_connection = (transmission_count % 2) == 0;
-            } 
-            else 
-            {
-                // Previously connected but disconnected - try every 60 seconds since disconnection
-                should_attempt_connection = (cycles_disconnected % 2) == 0 && cycles_disconnected > 0;
-            }
-            
-            if (should_attempt_connection) 
-            {
-                if (disconnection_time == 0) 
-                {
-                    ESP_LOGI(TAG, "Attempting WiFi connection (never connected, cycle %lu)", transmission_count);
-                } 
-                else 
-                {
-                    ESP_LOGI(TAG, "Attempting WiFi reconnection (disconnected for %lu seconds)", seconds_disconnected);
-                }
-                
-                // Reset retry counter in wifi_manager and attempt reconnection
-                esp_err_t reconnect_result = wifi_manager_reconnect();
-                if (reconnect_result == ESP_OK) 
-                {
-                    ESP_LOGI(TAG, "WiFi reconnection initiated successfully");
-                } 
-                else 
-                {
-                    ESP_LOGW(TAG, "WiFi reconnection attempt failed: %s", esp_err_to_name(reconnect_result));
-                }
-            }
-            
-            if (disconnection_time == 0) 
-            {
-                ESP_LOGW(TAG, "WiFi not ready (never connected, cycle %lu)", transmission_count);
-            } 
-            else 
-            {
-                ESP_LOGW(TAG, "WiFi not ready (disconnected for %lu seconds)", seconds_disconnected);
-            }
-            was_connected = false;
+            // Reconnection is driven by wifi_manager's event handler; this task
+            // only keeps the readings safe until the link is back
+            uint32_t seconds_disconnected = pdTICKS_TO_MS(xTaskGetTickCount() - disconnected_since) / 1000;
+            EVENT_LOGW(TAG, "WiFi not ready (status %d, disconnected for %lu seconds)", 
+                       wifi_manager_get_status(), seconds_disconnected);
+            spill_samples_to_flash();
         } 
         else 
         {
             // WiFi is connected - handle data transmission
             if (!was_connected) 
             {
-                ESP_LOGI(TAG, "WiFi connection restored!");
-                disconnection_time = 0;  // Reset disconnection tracking
+                EVENT_LOGI(TAG, "WiFi connection restored after %lu seconds - flushing buffered readings", 
+                           pdTICKS_TO_MS(xTaskGetTickCount() - disconnected_since) / 1000);
             }
-            was_connected = true;
-            
-            // Prepare transmission data
-            sensor_data_t wifi_data = {0};
-            bool has_valid_data = false;
             
-            // Use helper function to safely read sensor data
-            safe_read_sensor_data(&wifi_data, &has_valid_data);
-            
-            strcpy(wifi_data.device_id, "ESP32_SENSOR_01");
-            wifi_data.timestamp = (uint32_t)time(NULL);
-            
-            if (has_valid_data) 
+            if (replay_flash_log()) 
             {
-                ESP_LOGI(TAG, "TX: %.1f°C, %.1f%%", wifi_data.temperature, wifi_data.humidity);
-            } 
-            else 
+                uploaded = upload_buffered_samples() > 0;
+            }
+        }
+        was_connected = is_connected;
+        
+        // One early record right after the first upload delivers the boot
+        // milestones, instead of a full report interval later
+        if ((uploaded && !boot_reported) || 
+            xTaskGetTickCount() - last_report_time >= pdMS_TO_TICKS(PERF_REPORT_INTERVAL_MS)) 
+        {
+            last_report_time = xTaskGetTickCount();
+            boot_reported = true;
+            report_diagnostics(is_connected);
+        }
+        
+        // A downloaded firmware takes over once this pass has delivered
+        // every buffered reading, RAM ring and flash backlog alike. The
+        // aggregator's open window would die with the restart, so it is
+        // closed into the ring and sent last, after every older reading.
+        if (ota_manager_update_ready() && is_connected && sample_ring_count() == 0 && 
+            telemetry_log_pending_blocks() == 0) 
+        {
+            sensor_sample_t rollup;
+            if (sample_aggregator_flush(&rollup)) 
             {
-                wifi_data.temperature = -999.0;
-                wifi_data.humidity = -999.0;
-                ESP_LOGI(TAG, "TX: N/A (no sensor data)");
+                sample_ring_push(&rollup);
+                upload_buffered_samples();
             }
-            
-            esp_err_t tx_result = wifi_manager_send_data(&wifi_data);
-            if (tx_result != ESP_OK) 
+            if (sample_ring_count() == 0) 
             {
-                ESP_LOGW(TAG, "WiFi TX failed: %s", esp_err_to_name(tx_result));
+                event_log_drain();
+                ESP_LOGI(TAG, "Restarting into the downloaded firmware");
+                esp_restart();
             }
         }
         
-        vTaskDelayUntil(&last_wake_time, pdMS_TO_TICKS(WIFI_TRANSMIT_INTERVAL_MS));
+        // Sleep until the next transmission slot, but wake as soon as the
+        // link comes up (to flush the backlog) or goes down (to update the
+        // display). An early wake keeps the regular slot where it was.
+        // Slots missed entirely (a long upload, or a push that shortened
+        // the period) are skipped rather than caught up back to back.
+        const TickType_t interval = pdMS_TO_TICKS(device_config_transmit_interval_ms());
+        TickType_t elapsed = xTaskGetTickCount() - last_wake_time;
+        if (elapsed >= interval) 
+        {
+            last_wake_time += interval * (elapsed / interval);
+        } 
+        else if (!wifi_manager_wait_link_change(pdTICKS_TO_MS(interval - elapsed))) 
+        {
+            last_wake_time += interval;
+        }
     }
 }
 
@@ -795,17 +1142,17 @@ static void wifi_task(void *pvParameters)
  * ┌─────────────────────────────────────────────┐  ← ST7789 240x240 Display
  * │                                             │
  * │     ┌─────────────────────────────────┐     │  ← Y=50: Temperature Zone
- * │     │  TEMP: 23.5C                   │     │    (16x16 Large Font)
+ * │     │  TEMP: 23.5C                   │     │    (16 px Large Font)
  * │     │  [Color: CYAN on BLACK]        │     │    High visibility
  * │     └─────────────────────────────────┘     │
  * │                                             │
  * │     ┌─────────────────────────────────┐     │  ← Y=100: Humidity Zone
- * │     │  HUMD: 65%                     │     │    (16x16 Large Font)
+ * │     │  HUMD: 65%                     │     │    (16 px Large Font)
  * │     │  [Color: GREEN on BLACK]       │     │    Easy reading
  * │     └─────────────────────────────────┘     │
  * │                                             │
  * │     ┌─────────────────────────────────┐     │  ← Y=150: Network Status
- * │     │  NET: UP                       │     │    (16x16 Large Font)
+ * │     │  NET: UP                       │     │    (16 px Large Font)
  * │     │  [Color: GREEN/RED on BLACK]   │     │    Status indication
  * │     └─────────────────────────────────┘     │
  * │                                             │
@@ -816,7 +1163,7 @@ static void wifi_task(void *pvParameters)
  * 
  * • IMMEDIATE RECOGNITION:
  *   - Color-coded information zones for instant status identification
- *   - Large 16x16 pixel fonts ensure readability from distance
+ *   - Large 16 px anti-aliased fonts ensure readability from distance
  *   - High contrast color schemes optimize visibility in various lighting
  * 
  * • CONSISTENT INFORMATION HIERARCHY:
@@ -838,179 +1185,388 @@ static void wifi_task(void *pvParameters)
  * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
  * 
  * • Display Technology: ST7789 TFT with RGB565 color depth
- * • Font System: Custom 16x16 bitmap fonts for optimal readability
- * • Memory Usage: Double-buffered for flicker-free updates
+ * • Font System: Build-time generated 2-bit alpha fonts (st7789_font_t)
+ * • Memory Usage: Banded off-screen buffer, pushed with st7789_flush()
  * • Update Frequency: Real-time on sensor data changes
  * • Color Palette: Optimized for low-power LCD technology
- * • Performance: <50ms full screen update time
+ * • Performance: measured by the st7789_* benchmarks (benchmark.h)
  * 
  * Supported Character Set (ST7789 Large Font):
  * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
  * 
- * Available: Space, 0-9, :, A, C, D, E, H, I, M, N, P, R, S, T, U, Y, ., %
- * Note: Character 'O' and 'K' not available, use alternatives (0, UP, etc.)
+ * Available: all printable ASCII (32-126), see st7789_font_t
  * 
  * @param temperature Current temperature reading in Celsius
  * @param humidity Current relative humidity reading in percentage
  * 
- * @note Function performs full screen clear and redraw for consistent appearance
- * @warning Display updates may take 20-50ms, consider timing in calling context
+ * @note Rendering happens on the display task (display_manager.h); this call
+ *       only queues a snapshot and never blocks. Only glyph cells that differ
+ *       from the previous update are redrawn (see status_screen.h)
  * 
- * @see st7789_draw_large_string() for text rendering implementation
- * @see wifi_manager_is_ready() for network status determination
+ * @see display_manager_post_sensor() for the render command
+ * @see wifi_task() for network status updates
  */
 static void update_display_with_sensor_data(float temperature, float humidity) 
 {
-    char temp_str[20];
-    char humid_str[20];
+    perf_timestamp_t started = PERF_BEGIN();
     
-    // Format strings with proper labels
-    snprintf(temp_str, sizeof(temp_str), "TEMP:%.1fC", temperature);
-    snprintf(humid_str, sizeof(humid_str), "HUMD:%.0f%%", humidity);
+    // Snapshot goes to the render task; this never waits for SPI
+    if (display_manager_post_sensor(temperature, humidity)) 
+    {
+        EVENT_LOG_BANNER(TAG, "✓ Display update queued: %.1f°C, %.0f%% humidity", temperature, humidity);
+    }
+    PERF_END(PERF_STAGE_DISPLAY_UPDATE, started);
+}
+
+/**
+ * @brief Publish network status to the display's network indicator
+ * 
+ * @param connected true when WiFi is connected and has an IP address
+ */
+static void display_network_status(bool connected)
+{
+    display_manager_post_network(connected ? DISPLAY_NET_UP : DISPLAY_NET_DISCONNECTED);
+}
+
+/**
+ * @brief Enable dynamic frequency scaling and automatic light sleep
+ * 
+ * Non-fatal: without CONFIG_PM_ENABLE the system simply runs at full clock.
+ */
+static void configure_power_management(void) 
+{
+    esp_pm_config_t pm_config = {
+        .max_freq_mhz = SYSTEM_PM_MAX_FREQ_MHZ,
+        .min_freq_mhz = SYSTEM_PM_MIN_FREQ_MHZ,
+        .light_sleep_enable = SYSTEM_PM_LIGHT_SLEEP,
+    };
     
-    // Update display with current readings
-    display_clear_and_setup();
-    st7789_draw_large_string(DISPLAY_TEXT_X, DISPLAY_LINE_1_Y, temp_str, ST7789_CYAN, ST7789_BLACK);
-    st7789_draw_large_string(DISPLAY_TEXT_X, DISPLAY_LINE_2_Y, humid_str, ST7789_GREEN, ST7789_BLACK);
-    display_network_status();
+    esp_err_t ret = esp_pm_configure(&pm_config);
+    if (ret == ESP_ERR_NOT_SUPPORTED) 
+    {
+        ESP_LOGW(TAG, "Power management disabled in sdkconfig - running at %d MHz",
+                 SYSTEM_PM_MAX_FREQ_MHZ);
+        return;
+    }
+    if (ret != ESP_OK) 
+    {
+        ESP_LOGW(TAG, "Power management configuration failed: %s", esp_err_to_name(ret));
+        return;
+    }
     
-    ESP_LOGI(TAG, "✓ Display updated: %.1f°C, %.0f%% humidity", temperature, humidity);
+    ESP_LOGI(TAG, "Power management: %d-%d MHz, light sleep %s",
+             SYSTEM_PM_MIN_FREQ_MHZ, SYSTEM_PM_MAX_FREQ_MHZ,
+             SYSTEM_PM_LIGHT_SLEEP ? "enabled" : "disabled");
+}
+
+#if SYSTEM_POWER_MODE == SYSTEM_POWER_DEEP_SLEEP
+
+/**
+ * @brief State that survives deep sleep (RTC slow memory)
+ * 
+ * Everything in SRAM is lost between wakes, so the counters the continuous
+ * sensor task keeps on its stack, plus the readings not yet uploaded, live
+ * here instead. RTC_DATA_ATTR memory is zeroed on power-on and on any reset
+ * other than a deep-sleep wake; the magic detects that.
+ */
+typedef struct {
+    uint32_t magic;                 ///< RTC_STATE_MAGIC once initialized
+    uint32_t cycle_count;           ///< Wakes since power-on
+    uint32_t consecutive_failures;  ///< Failed DHT11 reads in a row
+    uint32_t wakes_since_upload;    ///< Wakes since WiFi was last brought up
+    uint32_t sample_count;          ///< Valid entries in samples[]
+    sensor_sample_t samples[DEEP_SLEEP_RTC_SAMPLES];  ///< Oldest first
+} rtc_state_t;
+
+#define RTC_STATE_MAGIC     0x534C5031  // "SLP1"
+
+RTC_DATA_ATTR static rtc_state_t rtc_state;
+
+/**
+ * @brief Move the RTC buffer into the sample ring for upload / spilling
+ */
+static void rtc_samples_to_ring(void) 
+{
+    for (uint32_t i = 0; i < rtc_state.sample_count; i++) 
+    {
+        sample_ring_push(&rtc_state.samples[i]);
+    }
+    rtc_state.sample_count = 0;
 }
 
 /**
- * @brief Clear display and set up common layout
+ * @brief Keep whatever the upload left in the sample ring across the next sleep
+ * 
+ * The ring lives in SRAM. Anything beyond the RTC capacity has to go to the
+ * flash log; if that is unavailable the oldest readings are dropped.
  */
-static void display_clear_and_setup(void)
+static void ring_samples_to_rtc(void) 
 {
-    st7789_clear_screen(ST7789_BLACK);
+    spill_samples_to_flash();   // Whole blocks only, leaves the remainder in RAM
+    
+    size_t excess = (sample_ring_count() > DEEP_SLEEP_RTC_SAMPLES) ? 
+                    sample_ring_count() - DEEP_SLEEP_RTC_SAMPLES : 0;
+    uint32_t first_seq = 0;
+    while (excess > 0) 
+    {
+        sensor_sample_t discard[TELEMETRY_LOG_BLOCK_SAMPLES];
+        size_t n = sample_ring_peek(discard, (excess < TELEMETRY_LOG_BLOCK_SAMPLES) ? 
+                                    excess : TELEMETRY_LOG_BLOCK_SAMPLES, &first_seq);
+        sample_ring_commit(first_seq, n);
+        excess -= n;
+        EVENT_LOGW(TAG, "Deep sleep: %u buffered readings dropped (no room)", (unsigned)n);
+    }
+    
+    size_t n = sample_ring_peek(rtc_state.samples, DEEP_SLEEP_RTC_SAMPLES, &first_seq);
+    sample_ring_commit(first_seq, n);
+    rtc_state.sample_count = (uint32_t)n;
 }
 
 /**
- * @brief Display network status in standardized position
+ * @brief Bring WiFi up, upload the RTC buffer and any flash backlog
+ * 
+ * Runs on one wake in DEEP_SLEEP_UPLOAD_EVERY_WAKES. The readings pass
+ * through the same sample ring / flash log path as in continuous mode, so
+ * a failed upload keeps them for the next upload wake.
  */
-static void display_network_status(void)
+static void deep_sleep_upload(void) 
 {
-    if (wifi_manager_is_ready()) 
+    rtc_samples_to_ring();
+    
+    if (wifi_manager_init() == ESP_OK && wifi_manager_connect() == ESP_OK) 
     {
-        st7789_draw_large_string(DISPLAY_TEXT_X, DISPLAY_LINE_3_Y, "NET: UP", ST7789_GREEN, ST7789_BLACK);
+        if (replay_flash_log()) 
+        {
+            upload_buffered_samples();
+        }
     } 
     else 
     {
-        st7789_draw_large_string(DISPLAY_TEXT_X, DISPLAY_LINE_3_Y, "NET: DSCNT", ST7789_RED, ST7789_BLACK);
+        EVENT_LOGW(TAG, "Deep sleep: WiFi unavailable, %u readings kept", 
+                   (unsigned)sample_ring_count());
     }
+    
+    ring_samples_to_rtc();
 }
 
 /**
- * @brief Display system startup screen
+ * @brief One deep-sleep duty cycle: read, buffer, maybe upload, sleep
+ * 
+ * Never returns. The next wake reboots through app_main() with rtc_state
+ * intact. A DHT11 that keeps failing is only logged: every wake already
+ * resets the digital domain, which is what the continuous mode's restart
+ * is for.
  */
-static void display_startup_screen(void) 
+static void run_deep_sleep_cycle(void) 
 {
-    display_clear_and_setup();
-    st7789_draw_large_string(DISPLAY_TEXT_X, DISPLAY_LINE_1_Y, "START", ST7789_CYAN, ST7789_BLACK);
-    st7789_draw_large_string(DISPLAY_TEXT_X, DISPLAY_LINE_2_Y, "SYSTEM", ST7789_GREEN, ST7789_BLACK);
-    st7789_draw_large_string(DISPLAY_TEXT_X, DISPLAY_LINE_3_Y, "......", ST7789_YELLOW, ST7789_BLACK);
-    vTaskDelay(pdMS_TO_TICKS(STARTUP_SCREEN_DELAY_MS));
+    if (esp_sleep_get_wakeup_cause() != ESP_SLEEP_WAKEUP_TIMER || rtc_state.magic != RTC_STATE_MAGIC) 
+    {
+        memset(&rtc_state, 0, sizeof(rtc_state));
+        rtc_state.magic = RTC_STATE_MAGIC;
+        rtc_state.wakes_since_upload = DEEP_SLEEP_UPLOAD_EVERY_WAKES;    // Upload on first boot
+        ESP_LOGI(TAG, "Deep sleep mode: cold start");
+    }
+    rtc_state.cycle_count++;
+    
+    dht11_data_t sensor_reading = {0};
+    esp_err_t read_result = dht11_read(&sensor_reading);
+    if (read_result == ESP_OK && sensor_reading.valid) 
+    {
+        if (rtc_state.consecutive_failures > 0) 
+        {
+            EVENT_LOGI(TAG, "Sensor recovered after %lu consecutive failures", rtc_state.consecutive_failures);
+            rtc_state.consecutive_failures = 0;
+        }
+        
+        if (rtc_state.sample_count == DEEP_SLEEP_RTC_SAMPLES) 
+        {
+            // Only reachable if the flash log is unavailable: drop the oldest
+            memmove(&rtc_state.samples[0], &rtc_state.samples[1], 
+                    (DEEP_SLEEP_RTC_SAMPLES - 1) * sizeof(sensor_sample_t));
+            rtc_state.sample_count--;
+        }
+        rtc_state.samples[rtc_state.sample_count++] = (sensor_sample_t){
+            .timestamp = (uint32_t)time(NULL),
+            .temperature = sensor_reading.temperature,
+            .humidity = sensor_reading.humidity,
+        };
+        EVENT_LOGI(TAG, "Sensor: %.1f°C, %.1f%% (cycle %lu, %lu buffered)", 
+                   sensor_reading.temperature, sensor_reading.humidity, 
+                   rtc_state.cycle_count, rtc_state.sample_count);
+        ota_manager_report_health(OTA_HEALTH_READING);
+    } 
+    else 
+    {
+        rtc_state.consecutive_failures++;
+        EVENT_LOGW(TAG, "Sensor read failed: %s (failure %lu)", 
+                   esp_err_to_name(read_result), rtc_state.consecutive_failures);
+    }
+    
+    // WiFi only every N wakes, or early if the RTC buffer is about to overflow
+    rtc_state.wakes_since_upload++;
+    if (rtc_state.wakes_since_upload >= DEEP_SLEEP_UPLOAD_EVERY_WAKES || 
+        rtc_state.sample_count >= DEEP_SLEEP_RTC_SAMPLES) 
+    {
+        deep_sleep_upload();
+        rtc_state.wakes_since_upload = 0;
+    }
+    
+    // Keep a fixed wake period: subtract the time this wake was awake
+    int64_t awake_us = esp_timer_get_time();
+    int64_t sleep_us = (int64_t)device_config_read_interval_ms() * 1000 - awake_us;
+    if (sleep_us < DEEP_SLEEP_MIN_SLEEP_MS * 1000) 
+    {
+        sleep_us = DEEP_SLEEP_MIN_SLEEP_MS * 1000;
+    }
+    EVENT_LOGI(TAG, "Deep sleep for %lu ms (awake %lu ms)", 
+               (unsigned long)(sleep_us / 1000), (unsigned long)(awake_us / 1000));
+    event_log_drain();
+    esp_sleep_enable_timer_wakeup((uint64_t)sleep_us);
+    dht11_prepare_deep_sleep();
+    
+    // The bootloader rolls back an image still pending at the next boot,
+    // so a new one has to pass within its first wake
+    ota_manager_settle();
+    esp_deep_sleep_start();
 }
 
+#endif // SYSTEM_POWER_MODE == SYSTEM_POWER_DEEP_SLEEP
+
 /**
  * @brief Initialize Complete Environmental Monitoring System
  * 
- * This function orchestrates the initialization of all system components in the
- * correct sequence, ensuring proper hardware configuration and software readiness
- * before operational mode begins. The initialization follows a dependency-aware
- * sequence to prevent conflicts and ensure reliable system startup.
+ * This function orchestrates the initialization of all system components as a
+ * dependency graph rather than a fixed sequence: each component starts as
+ * soon as what it depends on is ready, and the slow ones (WiFi bring-up,
+ * DHT11 power-up, ST7789 reset) overlap instead of adding up.
  * 
- * Initialization Sequence and Dependencies:
+ * Initialization Graph and Dependencies:
  * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
  * 
  * ┌─────────────────────────────────────────────────────────────────────┐
- * │                    SYSTEM INITIALIZATION FLOW                      │
+ * │                    SYSTEM INITIALIZATION GRAPH                     │
  * └─────────────────────────────────────────────────────────────────────┘
  * 
- * ┌─ System Start ─┐
- *         │
- *         ▼
- * ┌─ Shared Data Structure ─┐  ← Foundation: Thread-safe data sharing
+ * ┌─ Power Management, Shared Data, Boot Events ─┐  ← Foundation
  *         │
- *         ▼
- * ┌─ ST7789 Display ────────┐  ← UI Layer: Visual feedback capability
- *         │
- *         ▼
- * ┌─ DHT11 Sensor ──────────┐  ← Data Layer: Environmental sensing
+ *         ├─► ┌─ Sensors ────┐ ─► ┌─ Sensor Task (Core 0) ─┐  ← First read waits
+ *         │   │ DHT11 power  │    │ first conversion       │    out the power-up
+ *         │   └──────────────┘    └────────────────────────┘
  *         │
- *         ▼
- * ┌─ WiFi Manager ──────────┐  ← Network Layer: IoT connectivity
+ *         ├─► ┌─ WiFi Task (Core 1) ───────────────────────┐  ← NVS, netif,
+ *         │   │ init, offline log, connect                 │    driver, link
+ *         │   └────────────────────────────────────────────┘
  *         │
- *         ▼
- * ┌─ Network Connection ────┐  ← Service Layer: External communication
- *         │
- *         ▼
- * ┌─ System Ready ──────────┐  ← Operational: Ready for task creation
+ *         └─► ┌─ ST7789 Display + Render Task ─────────────┐  ← This task, while
+ *             │ reset sequence, controller setup           │    the others run
+ *             └────────────────────────────────────────────┘
+ *                                  │
+ *                                  ▼
+ *             system_start(): status screen, BOOT_DISPLAY_READY_BIT
  * 
  * Component Initialization Details:
  * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
  * 
- * 1. SHARED DATA STRUCTURE:
- *    • Creates FreeRTOS mutex for thread-safe access
- *    • Initializes sensor data to safe default values
- *    • Establishes inter-task communication foundation
+ * 1. SHARED DATA AND BOOT EVENTS:
+ *    • Initializes the sequence lock for lock-free snapshots
+ *    • Creates the boot event group the tasks synchronize on
  *    • Critical: Must complete before any task creation
  * 
- * 2. ST7789 DISPLAY DRIVER:
+ * 2. SENSORS FIRST:
+ *    • Switches the DHT11 supply on; its 1 s start-up is the longest wait
+ *    • The sensor task starts right away; the driver holds the first read
+ *      until the sensor is up, while the display is still being reset
+ *    • Readings are published and buffered; display posts wait for
+ *      BOOT_DISPLAY_READY_BIT
+ * 
+ * 3. WIFI TASK:
+ *    • Initializes NVS, the TCP/IP stack and the WiFi driver on Core 1
+ *    • Connects immediately; the first upload follows the first reading
+ *    • A WiFi initialization failure is not fatal: local monitoring goes on
+ * 
+ * 4. ST7789 DISPLAY DRIVER:
+ *    • The display command queue exists before the sensor and WiFi tasks
+ *      start, so nothing they post is lost while the panel is reset
  *    • Configures SPI interface and GPIO pins
  *    • Performs hardware reset sequence with proper timing
- *    • Initializes display controller and clears screen
- *    • Enables immediate visual feedback during startup
- * 
- * 3. DHT11 SENSOR DRIVER:
- *    • Configures GPIO pin for single-wire communication
- *    • Sets up open-drain mode with internal pull-up
- *    • Validates sensor connectivity and timing parameters
- *    • Prepares for timing-critical communication protocols
- * 
- * 4. WIFI MANAGER:
- *    • Initializes ESP32 WiFi subsystem and TCP/IP stack
- *    • Configures security parameters and network credentials
- *    • Sets up event handlers for connection management
- *    • Prepares HTTP client for IoT data transmission
- * 
- * 5. NETWORK CONNECTION ESTABLISHMENT:
- *    • Attempts connection to configured WiFi network
- *    • Implements retry logic for connection reliability
- *    • Continues initialization even if connection fails
- *    • Enables automatic reconnection during operation
+ *    • Initializes display controller and starts the render task
+ * 
+ * Every milestone (display ready, network ready, first reading, first
+ * reading on screen, WiFi connected, first upload) is recorded with
+ * perf_monitor_boot_mark() and reported in the diagnostics records.
  * 
  * Error Handling Strategy:
  * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
  * 
- * • FAIL-FAST APPROACH: Critical component failures prevent system startup
- * • GRACEFUL DEGRADATION: Non-critical failures (WiFi) allow continued operation
+ * • FAIL-FAST APPROACH: Failures before any task runs (shared data, boot
+ *   events, display queue, sensors, sensor task) prevent system startup
+ * • GRACEFUL DEGRADATION: Once the sensor task runs nothing fails the
+ *   init: no WiFi task means local monitoring only, no display means
+ *   headless measuring and uploading; offline log failures are non-fatal
  * • DETAILED LOGGING: Comprehensive error messages aid troubleshooting
  * • RESOURCE CLEANUP: Partial initialization cleanup on component failure
  * 
  * Performance Characteristics:
  * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
  * 
- * • Total Initialization Time: 2-8 seconds (WiFi dependent)
+ * • Total Initialization Time: ~0.5 s (display reset; WiFi continues in background)
+ * • First Reading on Screen: ~1.3 s after power-on (DHT11 start-up + one read)
  * • Memory Allocation: ~15KB for component drivers and buffers
  * • GPIO Configuration: 6 pins (display + sensor + optional indicators)
  * • Power Consumption: Increases to operational levels (~150mA)
  * 
- * @return ESP_OK on successful system initialization
- * @return ESP_FAIL if any critical component initialization fails
+ * @return ESP_OK once the sensor task runs (with or without WiFi and display)
+ * @return ESP_FAIL if a failure before that prevents startup; no task of
+ *         this component is running then
  * 
- * @note WiFi connection failure is non-fatal; system continues with local operation
+ * @note WiFi and display failures are non-fatal; the system continues with
+ *       local or headless operation
  * @warning This function must complete before calling system_start()
  * 
  * @see init_shared_data() for thread-safe data structure setup
  * @see st7789_init() for display hardware initialization
  * @see dht11_init() for sensor communication setup
- * @see wifi_manager_init() for network subsystem preparation
+ * @see wifi_task() for network subsystem bring-up
  */
 esp_err_t system_init(void) 
 {
     ESP_LOGI(TAG, "ESP32 Dual-Core Environmental Monitor - Initializing...");
     
+    // Set before any task can load the configuration
+    device_config_set_listener(on_config_change, NULL);
+    
+    // Non-fatal: a partition table without a second app slot only disables updates
+    ota_manager_init();
+    
+#if SYSTEM_POWER_MODE == SYSTEM_POWER_DEEP_SLEEP
+    // Per wake only the sensor is needed; WiFi is brought up by upload wakes.
+    // The configuration gives the wake period and device id.
+    if (device_config_init() != ESP_OK) 
+    {
+        ESP_LOGW(TAG, "Stored configuration unavailable - using build defaults");
+    }
+    if (dht11_init() != ESP_OK) 
+    {
+        ESP_LOGE(TAG, "DHT11 sensor initialization failed");
+        return ESP_FAIL;
+    }
+    if (telemetry_log_init() != ESP_OK) 
+    {
+        ESP_LOGW(TAG, "Offline telemetry log unavailable");
+    }
+    return ESP_OK;
+#endif
+    
+    // DFS and light sleep first; component locks take effect from here on
+    configure_power_management();
+    
+    // Non-fatal: without the drain task deferred records are only printed
+    // before a restart
+    if (event_log_start() != ESP_OK) 
+    {
+        ESP_LOGW(TAG, "Log drain task unavailable");
+    }
+    
     // Initialize components
     if (init_shared_data() != ESP_OK) 
     {
@@ -1018,39 +1574,86 @@ esp_err_t system_init(void)
         return ESP_FAIL;
     }
     
-    if (st7789_init() != ESP_OK) 
+    boot_events = xEventGroupCreate();
+    if (boot_events == NULL) 
     {
-        ESP_LOGE(TAG, "ST7789 display initialization failed");
+        ESP_LOGE(TAG, "Failed to create boot event group");
         return ESP_FAIL;
     }
     
-    if (dht11_init() != ESP_OK) 
+    // The queue before its producers: the sensor task may report an error
+    // screen before the panel is up
+    if (display_manager_init() != ESP_OK) 
+    {
+        ESP_LOGE(TAG, "Display command queue creation failed");
+        return ESP_FAIL;
+    }
+    
+    // Initializes the DHT11 and every other sensor backend. First, so the
+    // DHT11's start-up time runs while everything else comes up
+    if (register_sensors() != ESP_OK) 
     {
         ESP_LOGE(TAG, "DHT11 sensor initialization failed");
         return ESP_FAIL;
     }
     
-    if (wifi_manager_init() != ESP_OK) 
+    // Sensor task on Core 0: the first conversion overlaps the display reset
+    BaseType_t sensor_task_created = xTaskCreatePinnedToCore(
+        sensor_task, "sensors", 4096, NULL, 2, &sensor_task_handle, SENSOR_TASK_CORE
+    );
+    if (sensor_task_created != pdPASS) 
     {
-        ESP_LOGE(TAG, "WiFi manager initialization failed");
+        ESP_LOGE(TAG, "Failed to create sensor task");
         return ESP_FAIL;
     }
+    perf_monitor_watch_task(sensor_task_handle);
     
-    // WiFi initialization complete - connection will be handled by WiFi task after delay
-    // This ensures display and sensor work immediately while WiFi connects in background
-    ESP_LOGI(TAG, "WiFi manager initialized - connection will be handled by WiFi task");
-    ESP_LOGW(TAG, "Display and sensor will work even without WiFi connection");
+    // Update task on Core 1, before the WiFi task loads the configuration
+    // that may name a new firmware
+    esp_err_t ota_ret = ota_manager_start();
+    if (ota_ret != ESP_OK && ota_ret != ESP_ERR_INVALID_STATE) 
+    {
+        ESP_LOGW(TAG, "Firmware update task unavailable: %s", esp_err_to_name(ota_ret));
+    }
+    
+    // WiFi task on Core 1: initializes NVS and the WiFi stack, then connects
+    BaseType_t wifi_task_created = xTaskCreatePinnedToCore(
+        wifi_task, "wifi_transmit", 8192, NULL, 1, &wifi_task_handle, WIFI_TASK_CORE
+    );
+    if (wifi_task_created != pdPASS) 
+    {
+        // The sensor task already runs; measuring goes on without uploads
+        wifi_task_handle = NULL;
+        ESP_LOGE(TAG, "Failed to create WiFi task - continuing with local monitoring only");
+    }
+    
+    // From here on failures leave a headless unit: the tasks keep running
+    // and system_start() still releases them
+    if (st7789_init() != ESP_OK) 
+    {
+        ESP_LOGE(TAG, "ST7789 display initialization failed - continuing headless");
+        return ESP_OK;
+    }
+    
+    if (display_manager_start() != ESP_OK) 
+    {
+        ESP_LOGE(TAG, "Display render task startup failed - continuing headless");
+        return ESP_OK;
+    }
+    display_available = true;
     
-    ESP_LOGI(TAG, "All components initialized successfully");
+    ESP_LOGI(TAG, "Display ready - WiFi is coming up in the background");
+    ESP_LOGW(TAG, "Display and sensor will work even without WiFi connection");
     return ESP_OK;
 }
 
 /**
  * @brief Launch Dual-Core Environmental Monitoring System
  * 
- * This function transitions the system from initialization to operational mode by
- * creating and launching the dual-core task architecture. It implements a sophisticated
- * task management strategy that leverages both ESP32 cores for optimal performance
+ * This function transitions the system from initialization to operational mode.
+ * The dual-core tasks were already launched by system_init() so that their
+ * bring-up overlaps the display's; this function opens the display to them.
+ * The task layout below leverages both ESP32 cores for optimal performance
  * and reliability.
  * 
  * Dual-Core Architecture Implementation:
@@ -1084,8 +1687,8 @@ esp_err_t system_init(void)
  *                        │
  *             ┌─────────────────┐
  *             │   Shared Data   │  ← Thread-safe communication
- *             │   with Mutex    │    between cores
- *             │   Protection    │
+ *             │   with Seqlock  │    between cores
+ *             │   Publication   │
  *             └─────────────────┘
  * 
  * Task Creation and Management Strategy:
@@ -1114,20 +1717,16 @@ esp_err_t system_init(void)
  * Startup Sequence and Display Management:
  * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
  * 
- * 1. STARTUP SCREEN DISPLAY:
- *    • Shows system initialization status to user
- *    • Provides visual feedback during task creation
- *    • 2-second display duration for user awareness
- * 
- * 2. TASK CREATION VALIDATION:
- *    • Verifies successful task creation before proceeding
- *    • Implements fail-safe error handling for task failures
- *    • Provides detailed error logging for troubleshooting
- * 
- * 3. INITIAL DISPLAY CONFIGURATION:
+ * 1. INITIAL DISPLAY CONFIGURATION:
  *    • Sets up template display layout with placeholders
- *    • Prepares visual interface for real-time data updates
- *    • Establishes consistent user interface standards
+ *    • Queued before any reading, so a placeholder never hides a value
+ *    • No startup screen and no fixed delay: the status screen is the
+ *      first thing shown
+ * 
+ * 2. DISPLAY READY:
+ *    • Sets BOOT_DISPLAY_READY_BIT; from here on readings and network
+ *      status go to the display as they happen
+ *    • A reading that completed during the display reset is shown at once
  * 
  * System Reliability Features:
  * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
@@ -1140,57 +1739,50 @@ esp_err_t system_init(void)
  * Performance Characteristics:
  * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
  * 
- * • Task Creation Time: <100ms for both tasks
+ * • Display Ready: right after system_init(), ~0.5 s after power-on
  * • Core Utilization: ~5% Core 0, ~10% Core 1 during normal operation
  * • Memory Overhead: 12KB total for both task stacks
  * • Response Time: Real-time sensor updates, 30s network transmission
  * 
  * @return ESP_OK on successful dual-core system launch
- * @return ESP_FAIL if task creation fails for either core
  * 
  * @note This function must be called after successful system_init()
- * @warning Task creation failure is a critical error requiring system restart
  * 
  * @see sensor_task() for Core 0 sensor operations implementation
  * @see wifi_task() for Core 1 network operations implementation
- * @see display_startup_screen() for user interface initialization
  */
 esp_err_t system_start(void) 
 {
-    ESP_LOGI(TAG, "Starting Dual-Core Operation Mode");
+#if SYSTEM_POWER_MODE == SYSTEM_POWER_DEEP_SLEEP
+    run_deep_sleep_cycle();     // Does not return
+#endif
     
-    // Show startup screen
-    display_startup_screen();
+    ESP_LOGI(TAG, "Starting Dual-Core Operation Mode");
     
-    // Create sensor task on Core 0
-    BaseType_t sensor_task_created = xTaskCreatePinnedToCore(
-        sensor_task, "dht11_sensor", 4096, NULL, 2, &sensor_task_handle, SENSOR_TASK_CORE
-    );
-    if (sensor_task_created != pdPASS) 
+#if SYSTEM_BENCHMARK
+    // Nothing has been posted to the display manager yet, so the panel is free
+    if (display_available && benchmark_run_local() != ESP_OK) 
     {
-        ESP_LOGE(TAG, "Failed to create sensor task");
-        return ESP_FAIL;
+        ESP_LOGW(TAG, "Local benchmarks had failures");
     }
+#endif
     
-    // Create WiFi task on Core 1
-    BaseType_t wifi_task_created = xTaskCreatePinnedToCore(
-        wifi_task, "wifi_transmit", 8192, NULL, 1, &wifi_task_handle, WIFI_TASK_CORE
-    );
-    if (wifi_task_created != pdPASS) 
+    // Queue the initial status screen before any reading is posted, so the
+    // placeholder never overwrites a real value
+    ESP_LOGI(TAG, "Setting up initial display...");
+    display_manager_post_placeholder();
+    display_manager_post_network(DISPLAY_NET_READY);
+    
+    // Open the display to the tasks, then show a reading that completed
+    // during the display reset (a reading published after the snapshot
+    // sees the bit and posts itself)
+    xEventGroupSetBits(boot_events, BOOT_DISPLAY_READY_BIT);
+    perf_monitor_boot_mark(PERF_BOOT_DISPLAY_READY);
+    sensor_data_t early_reading;
+    if (snapshot_sensor_data(&early_reading)) 
     {
-        ESP_LOGE(TAG, "Failed to create WiFi task");
-        return ESP_FAIL;
+        update_display_with_sensor_data(early_reading.temperature, early_reading.humidity);
     }
-    
-    // Give tasks a moment to start before setting up display
-    vTaskDelay(pdMS_TO_TICKS(TASK_STARTUP_DELAY_MS));
-    
-    // Set initial display
-    ESP_LOGI(TAG, "Setting up initial display...");
-    display_clear_and_setup();
-    st7789_draw_large_string(DISPLAY_TEXT_X, DISPLAY_LINE_1_Y, "TEMP: __._C", ST7789_CYAN, ST7789_BLACK);
-    st7789_draw_large_string(DISPLAY_TEXT_X, DISPLAY_LINE_2_Y, "HUMD: __%", ST7789_GREEN, ST7789_BLACK);
-    st7789_draw_large_string(DISPLAY_TEXT_X, DISPLAY_LINE_3_Y, "NET: READY", ST7789_GREEN, ST7789_BLACK);
     ESP_LOGI(TAG, "Initial display setup complete");
     
     ESP_LOGI(TAG, "Dual-core system operational - Core 0: Sensor, Core 1: WiFi");
@@ -1223,9 +1815,6 @@ esp_err_t system_start(void)
  * ┌─ Release FreeRTOS ─────┐    ← Clean up task handles and resources
  *         │
  *         ▼
- * ┌─ Cleanup Mutex ────────┐    ← Release synchronization objects
- *         │
- *         ▼
  * ┌─ Update Display ───────┐    ← Show shutdown status to user
  *         │
  *         ▼
@@ -1247,10 +1836,8 @@ esp_err_t system_start(void)
  *    • Ensures data integrity for in-progress transmissions
  * 
  * 3. SYNCHRONIZATION CLEANUP:
- *    • Safely releases shared data mutex
- *    • Prevents potential deadlocks during shutdown
- *    • Ensures no tasks are waiting on synchronization objects
- *    • Cleans up FreeRTOS kernel objects
+ *    • Shared data uses a statically allocated sequence lock, so there
+ *      are no kernel synchronization objects to release
  * 
  * Resource Cleanup and Safety:
  * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
@@ -1276,7 +1863,7 @@ esp_err_t system_start(void)
  * • DISPLAY STATUS UPDATE:
  *   - Clear indication of system shutdown state
  *   - Red color coding for immediate recognition
- *   - "ST0PPED" text using supported character set
+ *   - "STOPPED" text in the large font
  *   - Remains visible until power cycle
  * 
  * Use Cases for System Shutdown:
@@ -1295,7 +1882,6 @@ esp_err_t system_start(void)
  * @warning This function should only be called from main task or similar context
  * 
  * @see vTaskDelete() for FreeRTOS task termination details
- * @see vSemaphoreDelete() for mutex cleanup implementation
  */
 esp_err_t system_stop(void) 
 {
@@ -1314,16 +1900,10 @@ esp_err_t system_stop(void)
         wifi_task_handle = NULL;
     }
     
-    // Clean up mutex
-    if (shared_data.mutex != NULL) 
-    {
-        vSemaphoreDelete(shared_data.mutex);
-        shared_data.mutex = NULL;
-    }
-    
     // Show stopped status
-    display_clear_and_setup();
-    st7789_draw_large_string(DISPLAY_TEXT_X, DISPLAY_LINE_2_Y, "ST0PPED", ST7789_RED, ST7789_BLACK);
+    display_manager_post_message(NULL, ST7789_BLACK,
+                                 "STOPPED", ST7789_RED,
+                                 NULL, ST7789_BLACK);
     
     ESP_LOGI(TAG, "System shutdown complete");
     return ESP_OK;
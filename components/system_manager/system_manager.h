@@ -3,9 +3,9 @@
 
 #include "esp_err.h"
 #include "freertos/FreeRTOS.h"
-#include "freertos/semphr.h"
 #include "freertos/queue.h"
 #include "dht11.h"
+#include "seqlock.h"
 
 /**
  * @file system_manager.h
@@ -15,7 +15,7 @@
  * dual-core architecture for optimal performance:
  * - Core 0: DHT11 sensor reading task (dedicated timing-critical operations)
  * - Core 1: WiFi transmission task (independent periodic data sending)
- * - ST7789 Display updates (main thread)
+ * - ST7789 Display updates (render task fed by display_manager queue)
  * 
  * Thread-safe data sharing ensures reliable communication between cores.
  */
@@ -24,31 +24,35 @@
  * @brief Shared sensor data structure for inter-task communication
  * 
  * This structure is used to safely share sensor readings between the
- * sensor task (Core 0) and WiFi task (Core 1) using FreeRTOS synchronization.
+ * sensor task (Core 0) and WiFi task (Core 1). The sensor task is the only
+ * writer; readers on either core take lock-free snapshots through the
+ * embedded sequence lock (see seqlock.h).
  */
 typedef struct {
+    seqlock_t lock;             ///< Sequence lock guarding the fields below
     dht11_data_t data;          ///< DHT11 sensor reading data
     uint32_t timestamp;         ///< When the reading was taken (cycles)
     bool has_new_data;          ///< Flag indicating fresh data available
-    SemaphoreHandle_t mutex;    ///< Mutex for thread-safe access
 } shared_sensor_data_t;
 
 /**
  * @brief Initialize all system components
  * 
- * Performs sequential initialization of all hardware components
- * in the correct order with proper error handling.
+ * Brings the components up in parallel along their dependencies: the
+ * sensor task (Core 0) and the WiFi task (Core 1, which initializes NVS
+ * and the WiFi stack itself) are started first, then the display is reset
+ * while they run. WiFi failures are not fatal.
  * 
- * @return ESP_OK on successful initialization, ESP_FAIL if any component fails
+ * @return ESP_OK on successful initialization, ESP_FAIL if a critical component fails
  */
 esp_err_t system_init(void);
 
 /**
  * @brief Start dual-core system operation
  * 
- * Creates and starts separate tasks for sensor reading and WiFi transmission
- * on different CPU cores for optimal performance and independence.
- * Call this after successful system_init().
+ * Shows the initial status screen and signals the already running sensor
+ * and WiFi tasks that the display is ready, so readings and network status
+ * appear as they happen. Call this after successful system_init().
  * 
  * @return ESP_OK on successful startup, ESP_FAIL on error
  */
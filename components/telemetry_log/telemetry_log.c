@@ -0,0 +1,307 @@
+/**
+ * @file telemetry_log.c
+ * @brief Circular flash log of sensor sample blocks
+ *
+ * Block sequence numbers are free-running; the slot of sequence n is
+ * n % block_count. block_count is a whole number of sectors, so the
+ * sector a slot belongs to never changes. head_seq is the sequence the next
+ * append writes and tail_seq the oldest block that may still be pending.
+ * Blocks between the two that fail validation (torn writes) are skipped
+ * when the tail reaches them.
+ *
+ * Every flash access goes through wait_flash_window() first, see
+ * telemetry_log.h.
+ */
+
+#include "telemetry_log.h"
+#include "sensor_scheduler.h"
+#include "esp_partition.h"
+#include "esp_rom_crc.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include <string.h>
+
+static const char *TAG = "TELEMETRY_LOG";
+
+#define TELEMETRY_LOG_MAGIC             0x7E12  ///< Bumped with the sample layout; older blocks are ignored
+#define TELEMETRY_LOG_SECTOR_SIZE       4096
+#define TELEMETRY_LOG_BLOCKS_PER_SECTOR (TELEMETRY_LOG_SECTOR_SIZE / TELEMETRY_LOG_BLOCK_SIZE)
+#define TELEMETRY_LOG_PENDING           0xFFFFFFFFu     ///< Erased state of the consumed word
+
+typedef struct {
+    uint16_t magic;             ///< TELEMETRY_LOG_MAGIC
+    uint16_t count;             ///< Valid entries in samples[]
+    uint32_t sequence;          ///< Free-running block sequence number
+    uint32_t crc;               ///< CRC32 of magic, count, sequence and the valid samples
+    uint32_t consumed;          ///< TELEMETRY_LOG_PENDING until uploaded, then 0
+    sensor_sample_t samples[TELEMETRY_LOG_BLOCK_SAMPLES];
+    uint8_t reserved[TELEMETRY_LOG_BLOCK_SIZE - 16 -
+                     TELEMETRY_LOG_BLOCK_SAMPLES * sizeof(sensor_sample_t)];
+} telemetry_block_t;
+
+_Static_assert(sizeof(telemetry_block_t) == TELEMETRY_LOG_BLOCK_SIZE,
+               "telemetry block must fill exactly one flash page");
+
+static const esp_partition_t *partition = NULL;
+static uint32_t block_count = 0;
+static uint32_t head_seq = 0;
+static uint32_t tail_seq = 0;
+
+/**
+ * @brief Wait until no sensor conversion starts for TELEMETRY_LOG_FLASH_GUARD_MS
+ */
+static void wait_flash_window(void)
+{
+    while (sensor_scheduler_idle_ms() < TELEMETRY_LOG_FLASH_GUARD_MS)
+    {
+        vTaskDelay(pdMS_TO_TICKS(TELEMETRY_LOG_FLASH_GUARD_POLL_MS));
+    }
+}
+
+static uint32_t block_crc(const telemetry_block_t *block)
+{
+    uint32_t crc = esp_rom_crc32_le(0, (const uint8_t *)block, offsetof(telemetry_block_t, crc));
+    return esp_rom_crc32_le(crc, (const uint8_t *)block->samples,
+                            block->count * sizeof(sensor_sample_t));
+}
+
+static size_t slot_offset(uint32_t sequence)
+{
+    return (size_t)(sequence % block_count) * TELEMETRY_LOG_BLOCK_SIZE;
+}
+
+/**
+ * @brief Read the block that should hold a sequence and validate it
+ *
+ * @return true if the slot holds that sequence with a correct CRC
+ */
+static bool read_block(uint32_t sequence, telemetry_block_t *block)
+{
+    wait_flash_window();
+    if (esp_partition_read(partition, slot_offset(sequence), block, sizeof(*block)) != ESP_OK)
+    {
+        return false;
+    }
+    return block->magic == TELEMETRY_LOG_MAGIC &&
+           block->count > 0 && block->count <= TELEMETRY_LOG_BLOCK_SAMPLES &&
+           block->sequence == sequence &&
+           block->crc == block_crc(block);
+}
+
+static bool block_is_blank(const telemetry_block_t *block)
+{
+    const uint32_t *words = (const uint32_t *)block;
+    for (size_t i = 0; i < sizeof(*block) / sizeof(uint32_t); i++)
+    {
+        if (words[i] != 0xFFFFFFFFu)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+esp_err_t telemetry_log_init(void)
+{
+    partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY,
+                                         TELEMETRY_LOG_PARTITION_LABEL);
+    if (partition == NULL)
+    {
+        ESP_LOGW(TAG, "No '%s' partition - offline samples will not survive outages",
+                 TELEMETRY_LOG_PARTITION_LABEL);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    block_count = (partition->size / TELEMETRY_LOG_SECTOR_SIZE) * TELEMETRY_LOG_BLOCKS_PER_SECTOR;
+    if (block_count < 2 * TELEMETRY_LOG_BLOCKS_PER_SECTOR)
+    {
+        ESP_LOGE(TAG, "Partition too small: %lu bytes (need two sectors)",
+                 (unsigned long)partition->size);
+        partition = NULL;
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    // Scan every slot: the newest valid block gives the head, the oldest
+    // pending one the tail
+    telemetry_block_t block;
+    bool any_valid = false;
+    bool any_pending = false;
+    uint32_t newest = 0;
+    uint32_t oldest_pending = 0;
+
+    for (uint32_t slot = 0; slot < block_count; slot++)
+    {
+        if (slot % TELEMETRY_LOG_BLOCKS_PER_SECTOR == 0)
+        {
+            wait_flash_window();
+        }
+        esp_err_t ret = esp_partition_read(partition, (size_t)slot * TELEMETRY_LOG_BLOCK_SIZE,
+                                           &block, sizeof(block));
+        if (ret != ESP_OK)
+        {
+            ESP_LOGE(TAG, "Flash read failed at block %lu: %s",
+                     (unsigned long)slot, esp_err_to_name(ret));
+            partition = NULL;
+            return ret;
+        }
+        if (block.magic != TELEMETRY_LOG_MAGIC || block.sequence % block_count != slot ||
+            block.count == 0 || block.count > TELEMETRY_LOG_BLOCK_SAMPLES ||
+            block.crc != block_crc(&block))
+        {
+            continue;
+        }
+
+        if (!any_valid || block.sequence > newest)
+        {
+            newest = block.sequence;
+        }
+        any_valid = true;
+
+        if (block.consumed == TELEMETRY_LOG_PENDING &&
+            (!any_pending || block.sequence < oldest_pending))
+        {
+            oldest_pending = block.sequence;
+            any_pending = true;
+        }
+    }
+
+    head_seq = any_valid ? newest + 1 : 0;
+    tail_seq = any_pending ? oldest_pending : head_seq;
+
+    // A write torn by a reset leaves a slot that can no longer be programmed;
+    // continue at the next sector, which the next append erases first
+    if (head_seq % TELEMETRY_LOG_BLOCKS_PER_SECTOR != 0)
+    {
+        wait_flash_window();
+        if (esp_partition_read(partition, slot_offset(head_seq), &block, sizeof(block)) != ESP_OK ||
+            !block_is_blank(&block))
+        {
+            head_seq += TELEMETRY_LOG_BLOCKS_PER_SECTOR - head_seq % TELEMETRY_LOG_BLOCKS_PER_SECTOR;
+            ESP_LOGW(TAG, "Partial block at head - skipping to sequence %lu", (unsigned long)head_seq);
+        }
+    }
+
+    ESP_LOGI(TAG, "✓ Telemetry log: %lu blocks (%lu samples), %lu pending",
+             (unsigned long)block_count,
+             (unsigned long)(block_count * TELEMETRY_LOG_BLOCK_SAMPLES),
+             (unsigned long)(head_seq - tail_seq));
+    return ESP_OK;
+}
+
+bool telemetry_log_is_ready(void)
+{
+    return partition != NULL;
+}
+
+esp_err_t telemetry_log_append(const sensor_sample_t *samples, size_t count)
+{
+    if (partition == NULL)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (samples == NULL || count == 0 || count > TELEMETRY_LOG_BLOCK_SAMPLES)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    size_t offset = slot_offset(head_seq);
+
+    if (head_seq % TELEMETRY_LOG_BLOCKS_PER_SECTOR == 0)
+    {
+        // Entering a sector: erase it, dropping the oldest blocks if the log wrapped
+        if (head_seq >= block_count)
+        {
+            uint32_t first_kept = head_seq - block_count + TELEMETRY_LOG_BLOCKS_PER_SECTOR;
+            if ((int32_t)(first_kept - tail_seq) > 0)
+            {
+                ESP_LOGW(TAG, "Log full - dropping %lu oldest blocks",
+                         (unsigned long)(first_kept - tail_seq));
+                tail_seq = first_kept;
+            }
+        }
+
+        wait_flash_window();
+        esp_err_t ret = esp_partition_erase_range(partition, offset, TELEMETRY_LOG_SECTOR_SIZE);
+        if (ret != ESP_OK)
+        {
+            ESP_LOGE(TAG, "Sector erase failed at 0x%x: %s", (unsigned)offset, esp_err_to_name(ret));
+            return ret;
+        }
+    }
+
+    telemetry_block_t block;
+    memset(&block, 0xFF, sizeof(block));
+    block.magic = TELEMETRY_LOG_MAGIC;
+    block.count = (uint16_t)count;
+    block.sequence = head_seq;
+    memcpy(block.samples, samples, count * sizeof(sensor_sample_t));
+    block.crc = block_crc(&block);
+
+    wait_flash_window();
+    esp_err_t ret = esp_partition_write(partition, offset, &block, sizeof(block));
+    // Advance even on failure: a half-programmed slot cannot be rewritten
+    head_seq++;
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Block write failed: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    ESP_LOGD(TAG, "Stored block %lu (%u samples)", (unsigned long)block.sequence, (unsigned)count);
+    return ESP_OK;
+}
+
+size_t telemetry_log_peek(sensor_sample_t out[TELEMETRY_LOG_BLOCK_SAMPLES], uint32_t *block_seq)
+{
+    if (partition == NULL)
+    {
+        return 0;
+    }
+
+    telemetry_block_t block;
+    while (tail_seq != head_seq)
+    {
+        if (read_block(tail_seq, &block) && block.consumed == TELEMETRY_LOG_PENDING)
+        {
+            memcpy(out, block.samples, block.count * sizeof(sensor_sample_t));
+            *block_seq = tail_seq;
+            return block.count;
+        }
+        // Torn or already consumed: nothing to replay in this slot
+        tail_seq++;
+    }
+    return 0;
+}
+
+esp_err_t telemetry_log_consume(uint32_t block_seq)
+{
+    if (partition == NULL)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (block_seq != tail_seq || tail_seq == head_seq)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    static const uint32_t consumed = 0;
+    wait_flash_window();
+    esp_err_t ret = esp_partition_write(partition,
+                                        slot_offset(block_seq) + offsetof(telemetry_block_t, consumed),
+                                        &consumed, sizeof(consumed));
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Failed to mark block %lu consumed: %s",
+                 (unsigned long)block_seq, esp_err_to_name(ret));
+        return ret;
+    }
+
+    tail_seq++;
+    return ESP_OK;
+}
+
+uint32_t telemetry_log_pending_blocks(void)
+{
+    return head_seq - tail_seq;
+}
@@ -0,0 +1,109 @@
+#ifndef TELEMETRY_LOG_H
+#define TELEMETRY_LOG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "sample_ring.h"
+
+/**
+ * @file telemetry_log.h
+ * @brief Store-and-forward log of sensor samples in a dedicated flash partition
+ *
+ * Keeps readings through WiFi outages that outlast the RAM sample ring, and
+ * through a reboot during an outage. The log is a circular, append-only
+ * sequence of 256-byte blocks (one flash page each) in the "telemetry"
+ * partition:
+ *
+ *   block: magic | count | sequence | crc32 | consumed | 8 samples | reserved
+ *
+ * - Appends fill the partition round-robin, so every sector is erased
+ *   equally often (the circular layout is the wear levelling).
+ * - A block is written once with a single page program. A torn write fails
+ *   its CRC and is skipped on the next boot.
+ * - Uploading a block clears its "consumed" word (1 -> 0 bits only, no
+ *   erase). The oldest block that is still pending is found again by a
+ *   header scan at boot.
+ * - When the log is full, the sector holding the oldest blocks is erased
+ *   and those samples are dropped.
+ *
+ * Only the WiFi task calls into the log. The sensor task keeps pushing into
+ * the RAM sample ring and never calls it. Flash accesses stall the cache of
+ * both cores, though, so every read, page program and sector erase first
+ * waits for a window of at least TELEMETRY_LOG_FLASH_GUARD_MS without a
+ * sensor conversion (sensor_scheduler_idle_ms()), the same gate the OTA
+ * download uses. A conversion is never stretched by the log; the WiFi task
+ * waits instead.
+ */
+
+#define TELEMETRY_LOG_PARTITION_LABEL   "telemetry"
+
+#define TELEMETRY_LOG_BLOCK_SIZE        256     ///< One flash page
+#define TELEMETRY_LOG_BLOCK_SAMPLES     8       ///< (256 - 16-byte header) / 28-byte sample
+
+#define TELEMETRY_LOG_FLASH_GUARD_MS        250     ///< Sector erase worst case plus margin
+#define TELEMETRY_LOG_FLASH_GUARD_POLL_MS   20      ///< Recheck while a conversion runs
+
+/**
+ * @brief Blocks replayed per WiFi task cycle once the link is back
+ *
+ * Limits the extra upload traffic after an outage: 6 blocks (48 samples)
+ * per 30 s cycle drains a full 256 KB log in about 85 minutes.
+ */
+#define TELEMETRY_LOG_REPLAY_BLOCKS_PER_CYCLE   6
+
+/**
+ * @brief Open the telemetry partition and locate the head and tail blocks
+ *
+ * Scans every block header once (~1000 small reads for a 256 KB partition),
+ * one sector's worth per sensor-free window.
+ *
+ * @return ESP_OK on success
+ * @return ESP_ERR_NOT_FOUND if the partition table has no telemetry partition
+ * @return Flash read error otherwise
+ */
+esp_err_t telemetry_log_init(void);
+
+/**
+ * @brief Whether telemetry_log_init() found a usable partition
+ */
+bool telemetry_log_is_ready(void);
+
+/**
+ * @brief Append up to TELEMETRY_LOG_BLOCK_SAMPLES samples as one block
+ *
+ * May erase a 4 KB sector (~50 ms) when the write position enters it. The
+ * erase and the page program each wait for a sensor-free window, so this
+ * can block for up to a conversion. Call from the WiFi task only.
+ *
+ * @return ESP_OK on success
+ * @return ESP_ERR_INVALID_STATE if the log is not initialized
+ * @return ESP_ERR_INVALID_ARG on a count of 0 or above TELEMETRY_LOG_BLOCK_SAMPLES
+ * @return Flash write or erase error otherwise
+ */
+esp_err_t telemetry_log_append(const sensor_sample_t *samples, size_t count);
+
+/**
+ * @brief Read the oldest pending block without consuming it
+ *
+ * @param out       Receives up to TELEMETRY_LOG_BLOCK_SAMPLES samples
+ * @param block_seq Receives the block sequence, for telemetry_log_consume()
+ * @return Number of samples read (0 if nothing is pending)
+ */
+size_t telemetry_log_peek(sensor_sample_t out[TELEMETRY_LOG_BLOCK_SAMPLES], uint32_t *block_seq);
+
+/**
+ * @brief Mark the block returned by telemetry_log_peek() as uploaded
+ *
+ * @return ESP_OK on success
+ * @return ESP_ERR_INVALID_ARG if block_seq is not the oldest pending block
+ */
+esp_err_t telemetry_log_consume(uint32_t block_seq);
+
+/**
+ * @brief Number of blocks written but not yet consumed
+ */
+uint32_t telemetry_log_pending_blocks(void);
+
+#endif // TELEMETRY_LOG_H
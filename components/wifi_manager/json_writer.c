@@ -0,0 +1,241 @@
+/**
+ * @file json_writer.c
+ * @brief Allocation-free streaming JSON writer, see json_writer.h
+ */
+
+#include "json_writer.h"
+#include <string.h>
+
+static void init(json_writer_t *w, char *chunk, size_t chunk_size, json_sink_t sink, void *ctx)
+{
+    memset(w, 0, sizeof(*w));
+    w->chunk = chunk;
+    w->chunk_size = chunk_size;
+    w->sink = sink;
+    w->sink_ctx = ctx;
+    w->error = ESP_OK;
+}
+
+void json_writer_init_counter(json_writer_t *w)
+{
+    init(w, NULL, 0, NULL, NULL);
+}
+
+void json_writer_init_buffer(json_writer_t *w, char *buffer, size_t size)
+{
+    // Keep one byte for the terminator written by json_writer_finish()
+    init(w, buffer, (size > 0) ? size - 1 : 0, NULL, NULL);
+    if (size == 0)
+    {
+        w->error = ESP_ERR_INVALID_SIZE;
+    }
+}
+
+void json_writer_init_stream(json_writer_t *w, char *chunk, size_t chunk_size,
+                             json_sink_t sink, void *ctx)
+{
+    init(w, chunk, chunk_size, sink, ctx);
+}
+
+static void drain(json_writer_t *w)
+{
+    if (w->used > 0 && w->error == ESP_OK)
+    {
+        w->error = w->sink(w->sink_ctx, w->chunk, w->used);
+        w->used = 0;
+    }
+}
+
+static void put(json_writer_t *w, const char *data, size_t length)
+{
+    if (w->error != ESP_OK)
+    {
+        return;
+    }
+    w->length += length;
+    if (w->chunk == NULL)
+    {
+        return;     // Counting only
+    }
+
+    while (length > 0)
+    {
+        if (w->used == w->chunk_size)
+        {
+            if (w->sink == NULL)
+            {
+                w->error = ESP_ERR_INVALID_SIZE;
+                return;
+            }
+            drain(w);
+            if (w->error != ESP_OK)
+            {
+                return;
+            }
+        }
+        size_t n = w->chunk_size - w->used;
+        if (n > length)
+        {
+            n = length;
+        }
+        memcpy(w->chunk + w->used, data, n);
+        w->used += n;
+        data += n;
+        length -= n;
+    }
+}
+
+static void put_char(json_writer_t *w, char c)
+{
+    put(w, &c, 1);
+}
+
+/**
+ * @brief Emit the separator needed before a new value or member
+ */
+static void separate(json_writer_t *w)
+{
+    if (w->need_comma)
+    {
+        put_char(w, ',');
+    }
+    w->need_comma = false;
+}
+
+static void put_uint(json_writer_t *w, uint32_t value)
+{
+    char digits[10];
+    size_t n = 0;
+    do
+    {
+        digits[sizeof(digits) - 1 - n++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    put(w, &digits[sizeof(digits) - n], n);
+}
+
+void json_writer_object_begin(json_writer_t *w)
+{
+    separate(w);
+    put_char(w, '{');
+}
+
+void json_writer_object_end(json_writer_t *w)
+{
+    put_char(w, '}');
+    w->need_comma = true;
+}
+
+void json_writer_array_begin(json_writer_t *w)
+{
+    separate(w);
+    put_char(w, '[');
+}
+
+void json_writer_array_end(json_writer_t *w)
+{
+    put_char(w, ']');
+    w->need_comma = true;
+}
+
+void json_writer_key(json_writer_t *w, const char *key)
+{
+    json_writer_string(w, key);
+    put_char(w, ':');
+    w->need_comma = false;
+}
+
+void json_writer_string(json_writer_t *w, const char *value)
+{
+    static const char hex[] = "0123456789abcdef";
+
+    separate(w);
+    put_char(w, '"');
+    const char *run = value;
+    for (const char *p = value; *p != '\0'; p++)
+    {
+        unsigned char c = (unsigned char)*p;
+        if (c != '"' && c != '\\' && c >= 0x20)
+        {
+            continue;
+        }
+        put(w, run, (size_t)(p - run));
+        if (c == '"' || c == '\\')
+        {
+            char escaped[2] = { '\\', (char)c };
+            put(w, escaped, sizeof(escaped));
+        }
+        else
+        {
+            char escaped[6] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0x0F] };
+            put(w, escaped, sizeof(escaped));
+        }
+        run = p + 1;
+    }
+    put(w, run, strlen(run));
+    put_char(w, '"');
+    w->need_comma = true;
+}
+
+void json_writer_int(json_writer_t *w, int32_t value)
+{
+    separate(w);
+    if (value < 0)
+    {
+        put_char(w, '-');
+        put_uint(w, (uint32_t)0 - (uint32_t)value);
+    }
+    else
+    {
+        put_uint(w, (uint32_t)value);
+    }
+    w->need_comma = true;
+}
+
+void json_writer_uint(json_writer_t *w, uint32_t value)
+{
+    separate(w);
+    put_uint(w, value);
+    w->need_comma = true;
+}
+
+void json_writer_fixed2(json_writer_t *w, float value)
+{
+    separate(w);
+
+    // Round half away from zero to hundredths, then print as integer.fraction
+    float scaled = value * 100.0f;
+    bool negative = scaled < 0.0f;
+    if (negative)
+    {
+        scaled = -scaled;
+    }
+    uint32_t centi = (scaled < 4.0e9f) ? (uint32_t)(scaled + 0.5f) : 4000000000u;
+
+    if (negative && centi > 0)
+    {
+        put_char(w, '-');
+    }
+    put_uint(w, centi / 100);
+    char fraction[3] = { '.', (char)('0' + (centi / 10) % 10), (char)('0' + centi % 10) };
+    put(w, fraction, sizeof(fraction));
+    w->need_comma = true;
+}
+
+void json_writer_raw(json_writer_t *w, const void *data, size_t length)
+{
+    put(w, (const char *)data, length);
+}
+
+esp_err_t json_writer_finish(json_writer_t *w)
+{
+    if (w->sink != NULL)
+    {
+        drain(w);
+    }
+    else if (w->chunk != NULL && w->error == ESP_OK)
+    {
+        w->chunk[w->used] = '\0';
+    }
+    return w->error;
+}
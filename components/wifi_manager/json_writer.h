@@ -0,0 +1,109 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+/**
+ * @file json_writer.h
+ * @brief Allocation-free streaming JSON writer
+ *
+ * Serializes straight into a small caller-provided chunk buffer that is
+ * handed to a sink (for example esp_http_client_write()) whenever it fills,
+ * so a document of any size needs only one chunk of stack and no heap.
+ *
+ * Three modes, chosen at init:
+ * - Counting: no chunk and no sink. Only the length is tracked, which gives
+ *   the Content-Length before anything is sent.
+ * - Buffer: chunk only, no sink. The document must fit; it is
+ *   null-terminated by json_writer_finish().
+ * - Streaming: chunk and sink. The chunk is drained as it fills.
+ *
+ * Numbers are formatted with integer arithmetic only. json_writer_fixed2()
+ * rounds a float to two decimals without calling printf.
+ *
+ * Commas between members and elements are inserted automatically.
+ *
+ * @code
+ * json_writer_object_begin(&w);
+ * json_writer_key(&w, "device_id"); json_writer_string(&w, id);
+ * json_writer_key(&w, "temperature"); json_writer_fixed2(&w, 23.5f);
+ * json_writer_object_end(&w);
+ * esp_err_t ret = json_writer_finish(&w);
+ * @endcode
+ */
+
+/**
+ * @brief Receives a full chunk of output
+ *
+ * @return ESP_OK to continue, anything else aborts the document
+ */
+typedef esp_err_t (*json_sink_t)(void *ctx, const char *data, size_t length);
+
+typedef struct {
+    char *chunk;            ///< Output staging buffer (NULL when counting)
+    size_t chunk_size;      ///< Usable bytes in chunk
+    size_t used;            ///< Bytes staged in chunk
+    size_t length;          ///< Total bytes produced so far
+    json_sink_t sink;       ///< Drains the chunk (NULL in buffer mode)
+    void *sink_ctx;
+    bool need_comma;        ///< A value was just completed at this level
+    esp_err_t error;        ///< First error, sticky
+} json_writer_t;
+
+/**
+ * @brief Prepare a writer in counting mode
+ */
+void json_writer_init_counter(json_writer_t *w);
+
+/**
+ * @brief Prepare a writer that formats into buffer (null-terminated on finish)
+ */
+void json_writer_init_buffer(json_writer_t *w, char *buffer, size_t size);
+
+/**
+ * @brief Prepare a writer that streams through a chunk into sink
+ */
+void json_writer_init_stream(json_writer_t *w, char *chunk, size_t chunk_size,
+                             json_sink_t sink, void *ctx);
+
+void json_writer_object_begin(json_writer_t *w);
+void json_writer_object_end(json_writer_t *w);
+void json_writer_array_begin(json_writer_t *w);
+void json_writer_array_end(json_writer_t *w);
+
+/**
+ * @brief Start an object member; the next call writes its value
+ */
+void json_writer_key(json_writer_t *w, const char *key);
+
+/**
+ * @brief Write a string value, escaping quotes, backslashes and control characters
+ */
+void json_writer_string(json_writer_t *w, const char *value);
+
+void json_writer_int(json_writer_t *w, int32_t value);
+void json_writer_uint(json_writer_t *w, uint32_t value);
+
+/**
+ * @brief Write a number rounded to two decimals (e.g. 23.50, -0.25)
+ */
+void json_writer_fixed2(json_writer_t *w, float value);
+
+/**
+ * @brief Write pre-encoded bytes verbatim (no separators are added)
+ */
+void json_writer_raw(json_writer_t *w, const void *data, size_t length);
+
+/**
+ * @brief Drain the staged output and report the first error
+ *
+ * @return ESP_OK if the whole document was produced
+ * @return ESP_ERR_INVALID_SIZE if a buffer-mode document did not fit
+ * @return The sink's error if a streaming write failed
+ */
+esp_err_t json_writer_finish(json_writer_t *w);
+
+#endif // JSON_WRITER_H
@@ -0,0 +1,126 @@
+/**
+ * @file telemetry_codec.c
+ * @brief Binary batch encoder, see telemetry_codec.h for the layout
+ */
+
+#include "telemetry_codec.h"
+#include <math.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define TELEMETRY_DELTA_ESCAPE  0xFFFF
+
+typedef struct {
+    uint8_t *buffer;
+    size_t size;
+    size_t used;
+    bool overflow;
+} writer_t;
+
+static void put_bytes(writer_t *w, const void *data, size_t length)
+{
+    if (w->overflow || w->size - w->used < length)
+    {
+        w->overflow = true;
+        return;
+    }
+    memcpy(w->buffer + w->used, data, length);
+    w->used += length;
+}
+
+static void put_u8(writer_t *w, uint8_t value)
+{
+    put_bytes(w, &value, 1);
+}
+
+static void put_u16(writer_t *w, uint16_t value)
+{
+    uint8_t bytes[2] = { (uint8_t)value, (uint8_t)(value >> 8) };
+    put_bytes(w, bytes, sizeof(bytes));
+}
+
+static void put_u32(writer_t *w, uint32_t value)
+{
+    uint8_t bytes[4] = { (uint8_t)value, (uint8_t)(value >> 8),
+                         (uint8_t)(value >> 16), (uint8_t)(value >> 24) };
+    put_bytes(w, bytes, sizeof(bytes));
+}
+
+/**
+ * @brief Scale a reading to hundredths and clamp it into the field range
+ */
+static int32_t to_centi(float value, int32_t min, int32_t max)
+{
+    int32_t centi = (int32_t)lroundf(value * 100.0f);
+    if (centi < min)
+    {
+        return min;
+    }
+    if (centi > max)
+    {
+        return max;
+    }
+    return centi;
+}
+
+esp_err_t telemetry_codec_encode_binary(const char *device_id, int8_t rssi,
+                                        const sensor_sample_t *samples, size_t count,
+                                        uint8_t *buffer, size_t size, size_t *length)
+{
+    if (device_id == NULL || samples == NULL || buffer == NULL || length == NULL ||
+        count == 0 || count > UINT8_MAX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    size_t id_length = strlen(device_id);
+    if (id_length > TELEMETRY_BINARY_MAX_ID_LEN)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    writer_t w = { .buffer = buffer, .size = size };
+
+    put_bytes(&w, "HM", 2);
+    put_u8(&w, TELEMETRY_BINARY_VERSION);
+    put_u8(&w, (uint8_t)count);
+    put_u8(&w, (uint8_t)rssi);
+    put_u8(&w, (uint8_t)id_length);
+    put_bytes(&w, device_id, id_length);
+    put_u32(&w, samples[0].timestamp);
+
+    uint32_t previous = samples[0].timestamp;
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t delta = samples[i].timestamp - previous;
+        bool escaped = samples[i].timestamp < previous || delta >= TELEMETRY_DELTA_ESCAPE;
+
+        put_u16(&w, escaped ? TELEMETRY_DELTA_ESCAPE : (uint16_t)delta);
+        put_u16(&w, (uint16_t)(int16_t)to_centi(samples[i].temperature, INT16_MIN, INT16_MAX));
+        put_u16(&w, (uint16_t)to_centi(samples[i].humidity, 0, UINT16_MAX));
+        const sample_rollup_t *rollup = &samples[i].rollup;
+        put_u16(&w, rollup->count);
+        if (escaped)
+        {
+            put_u32(&w, samples[i].timestamp);
+        }
+        if (rollup->count > 1)
+        {
+            put_u16(&w, (uint16_t)rollup->temperature_min);
+            put_u16(&w, (uint16_t)rollup->temperature_max);
+            put_u16(&w, (uint16_t)rollup->temperature_mean);
+            put_u16(&w, rollup->humidity_min);
+            put_u16(&w, rollup->humidity_max);
+            put_u16(&w, rollup->humidity_mean);
+        }
+        previous = samples[i].timestamp;
+    }
+
+    if (w.overflow)
+    {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    *length = w.used;
+    return ESP_OK;
+}
@@ -0,0 +1,73 @@
+#ifndef TELEMETRY_CODEC_H
+#define TELEMETRY_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "sample_ring.h"
+
+/**
+ * @file telemetry_codec.h
+ * @brief Compact binary encoding of a batch of readings
+ *
+ * An alternative to the JSON batch document for the upload request body,
+ * sent with Content-Type TELEMETRY_BINARY_CONTENT_TYPE. All fields are
+ * little-endian:
+ *
+ *   offset  size  field
+ *   0       2     magic "HM"
+ *   2       1     version (TELEMETRY_BINARY_VERSION)
+ *   3       1     reading count N
+ *   4       1     RSSI in dBm (int8)
+ *   5       1     device id length L (max 31)
+ *   6       L     device id (not null-terminated)
+ *   6+L     4     timestamp of the first reading (uint32, Unix seconds)
+ *   10+L    8*N+  readings:
+ *                   uint16  seconds since the previous reading (0 for the
+ *                           first); 0xFFFF = an absolute uint32 timestamp
+ *                           follows the count
+ *                   int16   temperature in 0.01 °C
+ *                   uint16  humidity in 0.01 %
+ *                   uint16  readings rolled up into this one (0 or 1 = none);
+ *                           above 1 the rollup follows:
+ *                             int16 x3   temperature min, max, mean
+ *                             uint16 x3  humidity min, max, mean
+ *
+ * Version 2 added the rollup count and fields (see sample_aggregator.h);
+ * version 1 readings were the first three fields only.
+ *
+ * A batch of 32 readings is ~290 bytes without rollups and ~670 bytes with,
+ * instead of ~2-6 KB of JSON. Encoding needs no float formatting, only a
+ * scale-and-round per value.
+ */
+
+#define TELEMETRY_BINARY_CONTENT_TYPE   "application/vnd.home-monitor.telemetry.v2"
+#define TELEMETRY_BINARY_VERSION        2
+#define TELEMETRY_BINARY_MAX_ID_LEN     31
+
+/**
+ * @brief Worst-case encoded size of a batch (every delta escaped, every reading rolled up)
+ */
+#define TELEMETRY_BINARY_MAX_SIZE(count) \
+    (10 + TELEMETRY_BINARY_MAX_ID_LEN + (count) * (8 + 4 + 12))
+
+/**
+ * @brief Encode a batch of readings in the binary wire format
+ *
+ * @param device_id Null-terminated id, at most TELEMETRY_BINARY_MAX_ID_LEN characters
+ * @param rssi      Current signal strength in dBm
+ * @param samples   Readings, oldest first
+ * @param count     Number of readings (1 to 255)
+ * @param buffer    Output buffer
+ * @param size      Size of buffer in bytes
+ * @param length    Receives the encoded length
+ *
+ * @return ESP_OK on success
+ * @return ESP_ERR_INVALID_ARG on NULL pointers, a bad count or an over-long id
+ * @return ESP_ERR_INVALID_SIZE if the encoding does not fit in buffer
+ */
+esp_err_t telemetry_codec_encode_binary(const char *device_id, int8_t rssi,
+                                        const sensor_sample_t *samples, size_t count,
+                                        uint8_t *buffer, size_t size, size_t *length);
+
+#endif // TELEMETRY_CODEC_H
@@ -2,8 +2,10 @@
  * @file wifi_config.h
  * @brief WiFi Configuration Settings
  * 
- * Edit this file to configure your WiFi credentials and server settings.
- * This file should be customized for your specific network and server setup.
+ * Build-time tuning of the WiFi link and the upload transports. The
+ * settings that differ per unit or deployment (SSID, password, server URL,
+ * MQTT broker, device id, intervals) are runtime configuration stored in
+ * NVS; see device_config.h for their defaults and how to provision them.
  */
 
 #ifndef WIFI_CONFIG_H
@@ -12,32 +14,92 @@
 // ===================================================================
 // WiFi Network Configuration
 // ===================================================================
-// IMPORTANT: Replace these with your actual WiFi credentials
-#define WIFI_SSID           "TempRouter"
-#define WIFI_PASSWORD       "QPWO0192"
+// Credentials: "ssid" and "password" in device_config.h
 
 // Advanced WiFi Settings
-#define WIFI_RETRY_COUNT    5           // Number of connection retry attempts
+#define WIFI_RETRY_COUNT    5           // Failed attempts before reporting ERROR (retrying continues)
 #define WIFI_TIMEOUT_MS     10000       // Connection timeout in milliseconds
 
+// Static IPv4 address: skips the DHCP exchange on every connect. Leave
+// WIFI_STATIC_IP undefined to use DHCP (lwIP then re-requests the previous
+// lease directly, see CONFIG_LWIP_DHCP_RESTORE_LAST_IP in sdkconfig).
+// #define WIFI_STATIC_IP       "192.168.0.50"
+#define WIFI_STATIC_NETMASK     "255.255.255.0"
+#define WIFI_STATIC_GATEWAY     "192.168.0.1"
+#define WIFI_STATIC_DNS         "192.168.0.1"
+
+// Reconnection backoff: attempt n waits a random time in the upper half of
+// min(WIFI_BACKOFF_MAX_MS, WIFI_BACKOFF_BASE_MS * 2^(n-1))
+#define WIFI_BACKOFF_BASE_MS        1000    // First retry after 0.5-1 s
+#define WIFI_BACKOFF_MAX_MS         60000   // Never wait more than a minute
+#define WIFI_BACKOFF_CONFIG_MIN_MS  15000   // Floor for wrong password / SSID not found
+
+// Modem sleep while associated: the radio wakes only for DTIM beacons (MIN)
+// or every WIFI_LISTEN_INTERVAL beacons (MAX). Automatic light sleep (see
+// system_manager.c) requires one of the two; WIFI_PS_NONE keeps it awake.
+#ifndef WIFI_POWER_SAVE
+#define WIFI_POWER_SAVE             WIFI_PS_MIN_MODEM
+#endif
+#define WIFI_LISTEN_INTERVAL        3       // Beacons between wakes with WIFI_PS_MAX_MODEM
+
 // ===================================================================
 // HTTP Server Configuration
 // ===================================================================
-// IMPORTANT: Replace with your actual server URL
-// Examples:
+// Endpoint: "server_url" in device_config.h, for example
 // - Local server: "http://192.168.1.100:3000/api/sensor-data"
 // - Cloud service: "https://your-domain.com/api/sensors"
 // - Webhook URL: "https://hooks.zapier.com/hooks/catch/12345/abcde/"
-#define HTTP_SERVER_URL     "http://192.168.0.246:3000/api/sensor-data"
 
 // HTTP Settings
 #define HTTP_TIMEOUT_MS     10000       // HTTP request timeout
-#define HTTP_BUFFER_SIZE    1024        // HTTP buffer size
+#define HTTP_BUFFER_SIZE    256         // Stack chunk the request body is streamed through
+#define HTTP_RESPONSE_MAX_SIZE  512     // Response body kept for configuration pushes
+
+// The upload connection is kept open between requests (one every 30 s).
+// TCP keep-alive probes detect a silently dropped connection.
+#define HTTP_KEEPALIVE_IDLE_S       5   // Idle time before the first probe
+#define HTTP_KEEPALIVE_INTERVAL_S   5   // Time between probes
+#define HTTP_KEEPALIVE_COUNT        3   // Unanswered probes before closing
+
+// Batch upload: at most WIFI_BATCH_MAX_SAMPLES readings per POST (~2-6 KB of
+// JSON, streamed; never held in memory as a whole)
+#define WIFI_BATCH_MAX_SAMPLES  32
+
+// Largest JSON batch document: ~70 bytes per reading, ~190 with a rollup
+#define WIFI_BATCH_JSON_MAX_SIZE    (128 + WIFI_BATCH_MAX_SAMPLES * 200)
+
+// Batch upload body format. Binary (see telemetry_codec.h) is ~10x smaller
+// than JSON; the device falls back to JSON if the server answers 415.
+#define WIFI_PAYLOAD_JSON       0
+#define WIFI_PAYLOAD_BINARY     1
+#ifndef WIFI_PAYLOAD_FORMAT
+#define WIFI_PAYLOAD_FORMAT     WIFI_PAYLOAD_BINARY
+#endif
+
+// ===================================================================
+// Upload Transport
+// ===================================================================
+// HTTP posts to the configured server_url. MQTT publishes QoS 1 messages
+// to the configured mqtt_uri over a persistent session (see wifi_transport.h).
+#define WIFI_TRANSPORT_HTTP     0
+#define WIFI_TRANSPORT_MQTT     1
+#ifndef WIFI_TRANSPORT
+#define WIFI_TRANSPORT          WIFI_TRANSPORT_HTTP
+#endif
+
+// MQTT Settings (used when WIFI_TRANSPORT is WIFI_TRANSPORT_MQTT)
+// Readings go to <prefix>/<device_id>/telemetry/{json,bin}; the retained
+// <prefix>/<device_id>/status topic is "online", or "offline" via Last Will.
+#define MQTT_TOPIC_PREFIX       "home-monitor"
+#define MQTT_KEEPALIVE_S        60      // Broker declares the device offline after 1.5x this
+#define MQTT_MAX_INFLIGHT       4       // Unacknowledged QoS 1 publishes before send blocks
+#define MQTT_PUBLISH_TIMEOUT_MS 10000   // Wait for a free in-flight slot
+#define MQTT_CONNECT_WAIT_MS    5000    // Wait for the broker session after the link comes up
 
 // ===================================================================
 // Data Transmission Settings
 // ===================================================================
-#define DEVICE_ID           "ESP32_SENSOR_01"   // Unique device identifier
+// Device identifier: "device_id" in device_config.h
 #define DATA_SEND_INTERVAL  20                  // Send data every N sensor readings (20 = 1 minute)
 
 // ===================================================================
@@ -0,0 +1,98 @@
+/**
+ * @file wifi_link_cache.c
+ * @brief NVS-backed access point hint, see wifi_link_cache.h
+ */
+
+#include "wifi_link_cache.h"
+#include "nvs.h"
+#include <string.h>
+
+#define LINK_CACHE_NAMESPACE    "wifi_link"
+#define LINK_CACHE_KEY          "ap"
+#define LINK_CACHE_VERSION      1
+
+// Stored blob; the version guards against reading a record of another layout
+typedef struct {
+    uint8_t version;
+    wifi_link_cache_t hint;
+} link_cache_record_t;
+
+static bool is_valid(const wifi_link_cache_t *hint)
+{
+    static const uint8_t zero[6] = { 0 };
+    return hint->channel >= 1 && hint->channel <= 14 &&
+           memcmp(hint->bssid, zero, sizeof(zero)) != 0;
+}
+
+static esp_err_t read_record(nvs_handle_t handle, link_cache_record_t *record)
+{
+    size_t length = sizeof(*record);
+    esp_err_t ret = nvs_get_blob(handle, LINK_CACHE_KEY, record, &length);
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+    if (length != sizeof(*record) || record->version != LINK_CACHE_VERSION ||
+        !is_valid(&record->hint))
+    {
+        return ESP_ERR_NOT_FOUND;
+    }
+    return ESP_OK;
+}
+
+esp_err_t wifi_link_cache_load(wifi_link_cache_t *hint)
+{
+    if (hint == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    nvs_handle_t handle;
+    if (nvs_open(LINK_CACHE_NAMESPACE, NVS_READONLY, &handle) != ESP_OK)
+    {
+        return ESP_ERR_NOT_FOUND;   // Namespace does not exist before the first store
+    }
+
+    link_cache_record_t record;
+    esp_err_t ret = read_record(handle, &record);
+    nvs_close(handle);
+    if (ret != ESP_OK)
+    {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    *hint = record.hint;
+    return ESP_OK;
+}
+
+esp_err_t wifi_link_cache_store(const wifi_link_cache_t *hint)
+{
+    if (hint == NULL || !is_valid(hint))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    nvs_handle_t handle;
+    esp_err_t ret = nvs_open(LINK_CACHE_NAMESPACE, NVS_READWRITE, &handle);
+    if (ret != ESP_OK)
+    {
+        return ret;
+    }
+
+    link_cache_record_t stored;
+    if (read_record(handle, &stored) == ESP_OK &&
+        memcmp(&stored.hint, hint, sizeof(*hint)) == 0)
+    {
+        nvs_close(handle);
+        return ESP_OK;              // Unchanged: no flash write
+    }
+
+    link_cache_record_t record = { .version = LINK_CACHE_VERSION, .hint = *hint };
+    ret = nvs_set_blob(handle, LINK_CACHE_KEY, &record, sizeof(record));
+    if (ret == ESP_OK)
+    {
+        ret = nvs_commit(handle);
+    }
+    nvs_close(handle);
+    return ret;
+}
@@ -0,0 +1,46 @@
+#ifndef WIFI_LINK_CACHE_H
+#define WIFI_LINK_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+/**
+ * @file wifi_link_cache.h
+ * @brief Last good access point, kept in NVS for fast reassociation
+ *
+ * A full connect scans every channel for the configured SSID before
+ * associating. When the BSSID and channel of the AP we last got an IP from
+ * are known, the station can associate directly on that channel instead,
+ * which cuts the radio-on time of every boot and every reconnect.
+ *
+ * The hint is only an optimization: wifi_manager falls back to the full scan
+ * as soon as a directed attempt fails, and replaces the hint after the next
+ * successful connection. The IP lease is cached separately by lwIP
+ * (CONFIG_LWIP_DHCP_RESTORE_LAST_IP), or replaced by WIFI_STATIC_IP.
+ *
+ * The record is small and only rewritten when the AP actually changes, so
+ * flash wear is negligible.
+ */
+
+typedef struct {
+    uint8_t bssid[6];       ///< MAC address of the access point
+    uint8_t channel;        ///< Primary channel (1-14)
+} wifi_link_cache_t;
+
+/**
+ * @brief Read the cached AP
+ *
+ * @return ESP_OK if a valid hint was loaded into @p hint
+ * @return ESP_ERR_NOT_FOUND if nothing (or an incompatible record) is cached
+ */
+esp_err_t wifi_link_cache_load(wifi_link_cache_t *hint);
+
+/**
+ * @brief Remember the AP of a successful connection
+ *
+ * Does not touch flash if the same hint is already stored.
+ */
+esp_err_t wifi_link_cache_store(const wifi_link_cache_t *hint);
+
+#endif // WIFI_LINK_CACHE_H
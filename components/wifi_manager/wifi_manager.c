@@ -12,7 +12,7 @@
  * - Real-time connection status monitoring
  * - Signal strength (RSSI) measurement and reporting
  * - JSON data formatting for sensor readings
- * - HTTP POST transmission with proper headers
+ * - HTTP POST or MQTT publish transmission (see wifi_transport.h)
  * - Comprehensive error handling and recovery
  * - Event-driven architecture for responsive operation
  * 
@@ -26,9 +26,11 @@
  * - Automatic retry on connection failure (configurable attempts)
  * - Graceful handling of network disconnections
  * - Signal strength monitoring for link quality assessment
- * - NVS flash storage for network credentials persistence
+ * - Network credentials from the runtime configuration (device_config.h)
  * 
  * Data Transmission Protocol:
+ * - Delivered by the transport selected with WIFI_TRANSPORT in wifi_config.h:
+ *   wifi_transport_http.c (default) or wifi_transport_mqtt.c
  * - HTTP POST requests with JSON payload format
  * - Standard Content-Type and User-Agent headers
  * - Configurable server endpoint and timeout values
@@ -50,11 +52,18 @@
 #include "esp_event.h"          // ESP-IDF event system
 #include "esp_log.h"            // ESP-IDF logging system
 #include "esp_system.h"         // ESP32 system functions
-#include "esp_http_client.h"    // HTTP client for data transmission
 #include "nvs_flash.h"          // Non-volatile storage for WiFi credentials
 #include "freertos/FreeRTOS.h"  // FreeRTOS kernel functions
 #include "freertos/task.h"      // FreeRTOS task management
 #include "freertos/event_groups.h" // FreeRTOS event group synchronization
+#include "esp_timer.h"          // One-shot timer for delayed reconnection
+#include "esp_random.h"         // Hardware RNG for backoff jitter
+#include "seqlock.h"            // Lock-free publication of link state
+#include "wifi_payload.h"       // JSON emitters shared with the transports
+#include "wifi_transport.h"     // HTTP or MQTT upload backend
+#include "wifi_link_cache.h"    // Last good AP for directed reassociation
+#include "device_config.h"      // SSID and password stored in NVS
+#include "event_log.h"          // Deferred logging on the event and upload paths
 #include <string.h>             // Standard string functions
 #include <stdio.h>              // Standard I/O for formatting
 #include <time.h>               // Time functions for timestamps
@@ -82,6 +91,13 @@ static const char *TAG = "WIFI_MANAGER";
  */
 #define WIFI_FAIL_BIT         BIT1
 
+/**
+ * @brief Event bit indicating the link went up or down
+ * Set on IP_EVENT_STA_GOT_IP and on losing an established connection;
+ * consumed by wifi_manager_wait_link_change()
+ */
+#define WIFI_LINK_CHANGED_BIT BIT2
+
 // === Static State Variables ===
 // Internal state management for WiFi operations
 
@@ -94,21 +110,23 @@ static const char *TAG = "WIFI_MANAGER";
 static EventGroupHandle_t wifi_event_group;
 
 /**
- * @brief Current WiFi connection status
+ * @brief Current WiFi link state: connection status and signal strength
  * 
- * Tracks the real-time connection state for application use.
- * Updated by event handlers and read by status query functions.
- */
-static wifi_status_t current_status = WIFI_STATUS_DISCONNECTED;
-
-/**
- * @brief Current WiFi signal strength in dBm
+ * Written by the event handler (event loop task) and by the connect /
+ * disconnect / reconnect calls (application tasks). Read from any task on
+ * either core through the status query functions. Published with a
+ * sequence lock so readers always see a status and RSSI that belong
+ * together, without blocking.
  * 
- * Stores the received signal strength indicator (RSSI) value.
- * Updated when connection is established and periodically thereafter.
- * Range: -100 dBm (very poor) to -30 dBm (excellent)
+ * RSSI range: -100 dBm (very poor) to -30 dBm (excellent), 0 = unknown
  */
-static int8_t current_rssi = 0;
+typedef struct {
+    wifi_status_t status;       ///< Real-time connection state
+    int8_t rssi;                ///< Signal strength in dBm
+} wifi_link_state_t;
+
+static seqlock_t link_lock = SEQLOCK_INITIALIZER;
+static wifi_link_state_t link_state = { .status = WIFI_STATUS_DISCONNECTED, .rssi = 0 };
 
 /**
  * @brief Current connection retry attempt counter
@@ -119,6 +137,216 @@ static int8_t current_rssi = 0;
  */
 static int retry_count = 0;
 
+/**
+ * @brief One-shot timer that issues the next esp_wifi_connect()
+ * 
+ * Armed by the disconnect handler with a jittered exponential delay, so the
+ * event loop never sleeps and a failing AP is not hammered.
+ */
+static esp_timer_handle_t reconnect_timer = NULL;
+
+/**
+ * @brief Reconnect automatically after a disconnection
+ * 
+ * Cleared by wifi_manager_disconnect() so an intentional disconnect stays
+ * disconnected; set again by wifi_manager_connect() / _reconnect().
+ */
+static volatile bool auto_reconnect = true;
+
+/**
+ * @brief Station network interface (needed to apply a static IP)
+ */
+static esp_netif_t *sta_netif = NULL;
+
+/**
+ * @brief Access point of the last successful connection
+ * 
+ * Loaded from NVS at init and refreshed on every IP_EVENT_STA_GOT_IP.
+ * Only the event loop task touches it after init.
+ */
+static wifi_link_cache_t link_hint;
+static bool link_hint_valid = false;
+
+/**
+ * @brief The station config is pinned to link_hint (no channel scan)
+ */
+static bool directed_attempt = false;
+
+/**
+ * @brief Network name from the configuration, for log messages
+ * 
+ * Credentials are local-only settings (see device_config.h), so the copy
+ * taken at init stays current.
+ */
+static char station_ssid[DEVICE_CONFIG_SSID_SIZE];
+
+
+/**
+ * @brief Take a consistent snapshot of the link state (lock-free)
+ */
+static wifi_link_state_t get_link_state(void)
+{
+    wifi_link_state_t snapshot;
+    seqlock_load(&link_lock, &link_state, &snapshot, sizeof(snapshot));
+    return snapshot;
+}
+
+/**
+ * @brief Publish a new connection status, keeping the current RSSI
+ */
+static void set_link_status(wifi_status_t status)
+{
+    seqlock_write_begin(&link_lock);
+    link_state.status = status;
+    seqlock_write_end(&link_lock);
+}
+
+/**
+ * @brief Publish a new connection status and RSSI together
+ */
+static void set_link_state(wifi_status_t status, int8_t rssi)
+{
+    wifi_link_state_t state = { .status = status, .rssi = rssi };
+    seqlock_store(&link_lock, &link_state, &state, sizeof(state));
+}
+
+/**
+ * @brief Whether a disconnect reason points at configuration, not radio
+ * 
+ * Wrong password, unknown SSID or an AP that rejects our security mode will
+ * not fix themselves in a second, so these retry no faster than
+ * WIFI_BACKOFF_CONFIG_MIN_MS.
+ */
+static bool is_configuration_failure(uint8_t reason)
+{
+    switch (reason) 
+    {
+        case WIFI_REASON_AUTH_FAIL:
+        case WIFI_REASON_4WAY_HANDSHAKE_TIMEOUT:
+        case WIFI_REASON_HANDSHAKE_TIMEOUT:
+        case WIFI_REASON_NO_AP_FOUND:
+        case WIFI_REASON_NO_AP_FOUND_W_COMPATIBLE_SECURITY:
+        case WIFI_REASON_NO_AP_FOUND_IN_AUTHMODE_THRESHOLD:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Delay before reconnection attempt number @p attempt (1-based)
+ * 
+ * Exponential from WIFI_BACKOFF_BASE_MS, capped at WIFI_BACKOFF_MAX_MS, then
+ * drawn uniformly from the upper half of that window ("equal jitter") so
+ * several devices behind one rebooted AP do not retry in lockstep.
+ */
+static uint32_t backoff_delay_ms(int attempt, uint8_t reason)
+{
+    uint32_t window = WIFI_BACKOFF_MAX_MS;
+    if (attempt <= 16) 
+    {
+        uint64_t exponential = (uint64_t)WIFI_BACKOFF_BASE_MS << (attempt - 1);
+        if (exponential < window) 
+        {
+            window = (uint32_t)exponential;
+        }
+    }
+    if (is_configuration_failure(reason) && window < WIFI_BACKOFF_CONFIG_MIN_MS) 
+    {
+        window = WIFI_BACKOFF_CONFIG_MIN_MS;
+    }
+    
+    uint32_t half = window / 2;
+    return half + esp_random() % (window - half + 1);
+}
+
+/**
+ * @brief Aim the next association at the cached AP, or back at a full scan
+ * 
+ * A directed association skips the all-channel scan: with bssid_set and a
+ * channel the driver probes only that channel for that one AP.
+ */
+static void set_directed_association(bool directed)
+{
+    wifi_config_t config;
+    if (esp_wifi_get_config(WIFI_IF_STA, &config) != ESP_OK) 
+    {
+        return;
+    }
+    
+    config.sta.bssid_set = directed;
+    if (directed) 
+    {
+        memcpy(config.sta.bssid, link_hint.bssid, sizeof(config.sta.bssid));
+        config.sta.channel = link_hint.channel;
+    } 
+    else 
+    {
+        config.sta.channel = 0;
+    }
+    
+    if (esp_wifi_set_config(WIFI_IF_STA, &config) == ESP_OK) 
+    {
+        directed_attempt = directed;
+    }
+}
+
+/**
+ * @brief Replace DHCP with the address from wifi_config.h
+ * 
+ * Applied on WIFI_EVENT_STA_CONNECTED, before the DHCP client would start;
+ * esp_netif then posts IP_EVENT_STA_GOT_IP straight away.
+ */
+static void apply_static_ip(void)
+{
+#ifdef WIFI_STATIC_IP
+    esp_netif_dhcpc_stop(sta_netif);    // ESP_ERR_ESP_NETIF_DHCP_ALREADY_STOPPED after the first time
+    
+    esp_netif_ip_info_t ip_info = {
+        .ip.addr = esp_ip4addr_aton(WIFI_STATIC_IP),
+        .netmask.addr = esp_ip4addr_aton(WIFI_STATIC_NETMASK),
+        .gw.addr = esp_ip4addr_aton(WIFI_STATIC_GATEWAY),
+    };
+    esp_err_t ret = esp_netif_set_ip_info(sta_netif, &ip_info);
+    if (ret != ESP_OK) 
+    {
+        ESP_LOGE(TAG, "Failed to set static IP %s: %s", WIFI_STATIC_IP, esp_err_to_name(ret));
+        return;
+    }
+    
+    esp_netif_dns_info_t dns = {
+        .ip.u_addr.ip4.addr = esp_ip4addr_aton(WIFI_STATIC_DNS),
+        .ip.type = ESP_IPADDR_TYPE_V4,
+    };
+    esp_netif_set_dns_info(sta_netif, ESP_NETIF_DNS_MAIN, &dns);
+#endif
+}
+
+/**
+ * @brief Reconnect timer callback (esp_timer task context)
+ */
+static void reconnect_timer_callback(void *arg)
+{
+    if (!auto_reconnect) 
+    {
+        return;
+    }
+    esp_err_t ret = esp_wifi_connect();
+    if (ret != ESP_OK) 
+    {
+        ESP_LOGW(TAG, "Reconnection attempt could not start: %s", esp_err_to_name(ret));
+    }
+}
+
+/**
+ * @brief Arm the reconnect timer, replacing any pending attempt
+ */
+static void schedule_reconnect(uint32_t delay_ms)
+{
+    esp_timer_stop(reconnect_timer);    // ESP_ERR_INVALID_STATE if idle; harmless
+    esp_timer_start_once(reconnect_timer, (uint64_t)delay_ms * 1000);
+}
+
 /**
  * @brief WiFi Event Handler for Connection State Management
  * 
@@ -133,13 +361,16 @@ static int retry_count = 0;
  * 
  * State Transitions:
  * DISCONNECTED → CONNECTING → CONNECTED (success path)
- * DISCONNECTED → CONNECTING → ERROR (failure after max retries)
+ * DISCONNECTED → CONNECTING → ERROR (WIFI_RETRY_COUNT failures, still retrying)
  * CONNECTED → CONNECTING (on unexpected disconnection)
  * 
  * Retry Mechanism:
- * Automatically retries connection up to WIFI_RETRY_COUNT times before
- * marking the connection as failed. Provides exponential backoff behavior
- * through the underlying WiFi driver.
+ * Every unexpected disconnection schedules the next attempt on a one-shot
+ * timer with jittered exponential backoff (see backoff_delay_ms()). Retries
+ * never stop; after WIFI_RETRY_COUNT consecutive failures the status becomes
+ * ERROR and a blocked wifi_manager_connect() returns, but the timer keeps
+ * trying at up to WIFI_BACKOFF_MAX_MS intervals. Link up and link down both
+ * set WIFI_LINK_CHANGED_BIT so the WiFi task reacts at once.
  * 
  * Signal Strength Monitoring:
  * On successful connection, queries the access point information to obtain
@@ -161,27 +392,67 @@ static void wifi_event_handler(void* arg, esp_event_base_t event_base,
     {
         // WiFi station has started - initiate connection attempt
         esp_wifi_connect();
-        current_status = WIFI_STATUS_CONNECTING;
-        ESP_LOGI(TAG, "WiFi station started, initiating connection to '%s'...", WIFI_SSID);
+        set_link_status(WIFI_STATUS_CONNECTING);
+        ESP_LOGI(TAG, "WiFi station started, initiating connection to '%s'%s...", station_ssid,
+                 directed_attempt ? " (cached AP)" : "");
+        
+    } 
+    else if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_CONNECTED) 
+    {
+        // Associated; with a static IP there is no DHCP exchange to wait for
+        apply_static_ip();
         
     } 
     else if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_DISCONNECTED) 
     {
-        // WiFi disconnected - implement retry logic with backoff
+        wifi_event_sta_disconnected_t* event = (wifi_event_sta_disconnected_t*) event_data;
+        
+        // Any open upload connection died with the link
+        wifi_transport_link_down();
+        xEventGroupClearBits(wifi_event_group, WIFI_CONNECTED_BIT);
+        bool was_connected = (get_link_state().status == WIFI_STATUS_CONNECTED);
+        if (was_connected) 
+        {
+            EVENT_LOGW(TAG, "WiFi connection lost (reason %d)", event->reason);
+            xEventGroupSetBits(wifi_event_group, WIFI_LINK_CHANGED_BIT);
+        }
+        
+        if (!auto_reconnect) 
+        {
+            set_link_state(WIFI_STATUS_DISCONNECTED, 0);
+            return;
+        }
+        
+        // Try the AP we just lost directly first; if a directed attempt
+        // fails the AP may have moved, so go back to scanning all channels
+        if (was_connected && link_hint_valid) 
+        {
+            set_directed_association(true);
+        } 
+        else if (directed_attempt) 
+        {
+            EVENT_LOGW(TAG, "Cached AP not reachable (reason %d) - falling back to full scan", event->reason);
+            set_directed_association(false);
+        }
+        
+        // WiFi disconnected - schedule the next attempt with jittered backoff
+        retry_count++;
+        uint32_t delay_ms = backoff_delay_ms(retry_count, event->reason);
+        schedule_reconnect(delay_ms);
+        
         if (retry_count < WIFI_RETRY_COUNT) 
         {
-            esp_wifi_connect();
-            retry_count++;
-            current_status = WIFI_STATUS_CONNECTING;
-            ESP_LOGI(TAG, "WiFi disconnected, retry attempt %d/%d", retry_count, WIFI_RETRY_COUNT);
+            set_link_state(WIFI_STATUS_CONNECTING, 0);
+            EVENT_LOGI(TAG, "WiFi disconnected (reason %d), retry %d in %lu ms", 
+                       event->reason, retry_count, (unsigned long)delay_ms);
         } 
         else 
         {
-            // Max retries exceeded - mark as failed and signal waiting tasks
+            // Retry limit reached - report failure to waiting tasks, keep retrying
             xEventGroupSetBits(wifi_event_group, WIFI_FAIL_BIT);
-            current_status = WIFI_STATUS_ERROR;
-            current_rssi = 0;  // Clear signal strength on failure
-            ESP_LOGE(TAG, "WiFi connection failed after %d attempts - check credentials and signal", WIFI_RETRY_COUNT);
+            set_link_state(WIFI_STATUS_ERROR, 0);  // Clear signal strength on failure
+            EVENT_LOGE(TAG, "WiFi connection failed %d times (reason %d) - check credentials and signal; next retry in %lu ms", 
+                       retry_count, event->reason, (unsigned long)delay_ms);
         }
         
     } 
@@ -189,96 +460,53 @@ static void wifi_event_handler(void* arg, esp_event_base_t event_base,
     {
         // Successfully obtained IP address - connection complete
         ip_event_got_ip_t* event = (ip_event_got_ip_t*) event_data;
-        ESP_LOGI(TAG, "✓ WiFi connected successfully! IP: " IPSTR, IP2STR(&event->ip_info.ip));
+        EVENT_LOGI(TAG, "✓ WiFi connected successfully! IP: " IPSTR, IP2STR(&event->ip_info.ip));
         
         // Reset retry counter for future connection attempts
         retry_count = 0;
-        current_status = WIFI_STATUS_CONNECTED;
+        perf_monitor_boot_mark(PERF_BOOT_WIFI_CONNECTED);   // First connection only
         
-        // Signal waiting tasks that connection is ready
-        xEventGroupSetBits(wifi_event_group, WIFI_CONNECTED_BIT);
-        
-        // Query and store current signal strength for monitoring
+        // Query current signal strength for monitoring
+        int8_t rssi = 0;
         wifi_ap_record_t ap_info;
         if (esp_wifi_sta_get_ap_info(&ap_info) == ESP_OK) 
         {
-            current_rssi = ap_info.rssi;
-            ESP_LOGI(TAG, "✓ Signal strength: %d dBm (%s)", 
-                     current_rssi, 
-                     (current_rssi > -50) ? "Excellent" :
-                     (current_rssi > -60) ? "Good" :
-                     (current_rssi > -70) ? "Fair" : "Poor");
+            EVENT_LOGI(TAG, "✓ Associated on channel %d via %s", ap_info.primary,
+                       directed_attempt ? "cached AP (no scan)" : "full scan");
+            
+            // Remember this AP for the next boot or reconnect (NVS only written on change)
+            wifi_link_cache_t hint = { .channel = ap_info.primary };
+            memcpy(hint.bssid, ap_info.bssid, sizeof(hint.bssid));
+            if (!link_hint_valid || memcmp(&hint, &link_hint, sizeof(hint)) != 0) 
+            {
+                link_hint = hint;
+                link_hint_valid = true;
+                if (wifi_link_cache_store(&hint) != ESP_OK) 
+                {
+                    EVENT_LOGW(TAG, "Failed to cache AP for fast reconnect");
+                }
+            }
+            
+            rssi = ap_info.rssi;
+            EVENT_LOG_BANNER(TAG, "✓ Signal strength: %d dBm (%s)", 
+                             rssi, 
+                             (rssi > -50) ? "Excellent" :
+                             (rssi > -60) ? "Good" :
+                             (rssi > -70) ? "Fair" : "Poor");
         } 
         else 
         {
-            ESP_LOGW(TAG, "Unable to query signal strength information");
-            current_rssi = 0;
+            EVENT_LOGW(TAG, "Unable to query signal strength information");
         }
+        
+        // Publish status and RSSI together, then wake waiting tasks
+        set_link_state(WIFI_STATUS_CONNECTED, rssi);
+        wifi_transport_link_up();
+        xEventGroupClearBits(wifi_event_group, WIFI_FAIL_BIT);
+        xEventGroupSetBits(wifi_event_group, WIFI_CONNECTED_BIT | WIFI_LINK_CHANGED_BIT);
     }
 }
 
-/**
- * @brief HTTP Client Event Handler for Response Processing
- * 
- * Handles HTTP client events during data transmission operations.
- * Provides detailed logging and error reporting for network communication
- * debugging and monitoring purposes.
- * 
- * Event Types Handled:
- * - HTTP_EVENT_ERROR: Network or protocol errors during transmission
- * - HTTP_EVENT_ON_CONNECTED: Successful connection to HTTP server
- * - HTTP_EVENT_ON_DATA: Server response data reception
- * - HTTP_EVENT_DISCONNECTED: Clean disconnection from server
- * 
- * Logging Strategy:
- * Uses different log levels based on event importance:
- * - ERROR level for transmission failures
- * - DEBUG level for normal protocol events
- * - INFO level for important status updates
- * 
- * Response Data Handling:
- * Server responses are logged for debugging purposes but not processed
- * by the application. This can be extended to handle server confirmations
- * or error responses as needed.
- * 
- * @param evt HTTP client event structure containing event details
- * @return ESP_OK to continue processing, ESP_FAIL to abort
- * 
- * @note This function runs in HTTP client task context
- * @note Response data logging is limited to avoid excessive output
- * @see esp_http_client_init() for client configuration details
- */
-static esp_err_t http_event_handler(esp_http_client_event_t *evt) 
-{
-    switch(evt->event_id) 
-    {
-        case HTTP_EVENT_ERROR:
-            ESP_LOGE(TAG, "HTTP transmission error occurred");
-            break;
-            
-        case HTTP_EVENT_ON_CONNECTED:
-            ESP_LOGD(TAG, "HTTP connection established to server");
-            break;
-            
-        case HTTP_EVENT_ON_DATA:
-            ESP_LOGD(TAG, "HTTP server response: %.*s", evt->data_len, (char*)evt->data);
-            break;
-            
-        case HTTP_EVENT_DISCONNECTED:
-            ESP_LOGD(TAG, "HTTP connection closed cleanly");
-            break;
-            
-        case HTTP_EVENT_ON_HEADER:
-            ESP_LOGD(TAG, "HTTP header received: %s: %s", evt->header_key, evt->header_value);
-            break;
-            
-        default:
-            ESP_LOGD(TAG, "HTTP event: %d", evt->event_id);
-            break;
-    }
-    return ESP_OK;
-}
-
 /**
  * @brief Initialize WiFi Manager and Network Subsystem
  * 
@@ -305,30 +533,35 @@ static esp_err_t http_event_handler(esp_http_client_event_t *evt)
  * state transitions and provide real-time status updates to the application.
  * 
  * Network Configuration:
- * Configures the ESP32 as a WiFi station (client) using credentials
- * defined in wifi_config.h. WPA2-PSK authentication is required for
- * security compliance.
+ * Configures the ESP32 as a WiFi station (client) using the credentials
+ * of the runtime configuration (device_config_get()). WPA2-PSK
+ * authentication is required for security compliance.
  * 
  * @return ESP_OK on successful initialization
  * @return ESP_FAIL if critical components fail to initialize
  * 
  * @note This function must be called from application task context
- * @note WiFi credentials must be configured in wifi_config.h before compilation
+ * @note Call device_config_init() first, or the build-default credentials are used
  * @note Function will abort on critical errors using ESP_ERROR_CHECK
  * 
  * @see wifi_manager_connect() to establish network connection after initialization
  */
 esp_err_t wifi_manager_init(void) 
 {
-    ESP_LOGI(TAG, "========================================");
-    ESP_LOGI(TAG, "   WiFi Manager Initialization");
-    ESP_LOGI(TAG, "   Target Network: %s", WIFI_SSID);
-    ESP_LOGI(TAG, "   Security: WPA2-PSK");
-    ESP_LOGI(TAG, "========================================");
+    device_config_t config;
+    device_config_get(&config);
+    memcpy(station_ssid, config.ssid, sizeof(station_ssid));
+    
+    EVENT_LOG_BANNER(TAG, "========================================");
+    EVENT_LOG_BANNER(TAG, "   WiFi Manager Initialization");
+    EVENT_LOG_BANNER(TAG, "   Target Network: %s", station_ssid);
+    EVENT_LOG_BANNER(TAG, "   Security: WPA2-PSK");
+    EVENT_LOG_BANNER(TAG, "========================================");
     
     // === NVS FLASH INITIALIZATION ===
-    // Initialize non-volatile storage required for WiFi operation
-    ESP_LOGI(TAG, "Initializing NVS flash storage...");
+    // Initialize non-volatile storage required for WiFi operation (already
+    // done by device_config_init() in the application; repeating it is a no-op)
+    EVENT_LOG_BANNER(TAG, "Initializing NVS flash storage...");
     esp_err_t ret = nvs_flash_init();
     if (ret == ESP_ERR_NVS_NO_FREE_PAGES || ret == ESP_ERR_NVS_NEW_VERSION_FOUND) 
     {
@@ -337,61 +570,103 @@ esp_err_t wifi_manager_init(void)
         ret = nvs_flash_init();
     }
     ESP_ERROR_CHECK(ret);
-    ESP_LOGI(TAG, "✓ NVS flash storage initialized successfully");
+    EVENT_LOG_BANNER(TAG, "✓ NVS flash storage initialized successfully");
     
     // === EVENT GROUP CREATION ===
     // Create FreeRTOS event group for WiFi state synchronization
-    ESP_LOGI(TAG, "Creating WiFi event synchronization group...");
+    EVENT_LOG_BANNER(TAG, "Creating WiFi event synchronization group...");
     wifi_event_group = xEventGroupCreate();
     if (wifi_event_group == NULL) 
     {
         ESP_LOGE(TAG, "CRITICAL: Failed to create WiFi event group - insufficient memory");
         return ESP_FAIL;
     }
-    ESP_LOGI(TAG, "✓ WiFi event group created successfully");
+    EVENT_LOG_BANNER(TAG, "✓ WiFi event group created successfully");
+    
+    // Reconnection attempts are scheduled on a one-shot timer (jittered backoff)
+    const esp_timer_create_args_t reconnect_timer_args = {
+        .callback = reconnect_timer_callback,
+        .name = "wifi_reconnect",
+    };
+    ESP_ERROR_CHECK(esp_timer_create(&reconnect_timer_args, &reconnect_timer));
     
     // === TCP/IP STACK INITIALIZATION ===
     // Initialize network interface and event loop infrastructure
-    ESP_LOGI(TAG, "Initializing TCP/IP network stack...");
+    EVENT_LOG_BANNER(TAG, "Initializing TCP/IP network stack...");
     ESP_ERROR_CHECK(esp_netif_init());
     ESP_ERROR_CHECK(esp_event_loop_create_default());
-    esp_netif_create_default_wifi_sta();
-    ESP_LOGI(TAG, "✓ TCP/IP stack and network interfaces initialized");
+    sta_netif = esp_netif_create_default_wifi_sta();
+    EVENT_LOG_BANNER(TAG, "✓ TCP/IP stack and network interfaces initialized");
     
     // === WIFI DRIVER INITIALIZATION ===
     // Initialize WiFi driver with default ESP-IDF configuration
-    ESP_LOGI(TAG, "Initializing WiFi driver...");
+    EVENT_LOG_BANNER(TAG, "Initializing WiFi driver...");
     wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
     ESP_ERROR_CHECK(esp_wifi_init(&cfg));
-    ESP_LOGI(TAG, "✓ WiFi driver initialized with default configuration");
+    EVENT_LOG_BANNER(TAG, "✓ WiFi driver initialized with default configuration");
     
     // === EVENT HANDLER REGISTRATION ===
     // Register callbacks for WiFi and IP events
-    ESP_LOGI(TAG, "Registering WiFi event handlers...");
+    EVENT_LOG_BANNER(TAG, "Registering WiFi event handlers...");
     ESP_ERROR_CHECK(esp_event_handler_register(WIFI_EVENT, ESP_EVENT_ANY_ID, &wifi_event_handler, NULL));
     ESP_ERROR_CHECK(esp_event_handler_register(IP_EVENT, IP_EVENT_STA_GOT_IP, &wifi_event_handler, NULL));
-    ESP_LOGI(TAG, "✓ Event handlers registered for WiFi and IP events");
+    EVENT_LOG_BANNER(TAG, "✓ Event handlers registered for WiFi and IP events");
     
     // === WIFI STATION CONFIGURATION ===
     // Configure ESP32 as WiFi station with network credentials
-    ESP_LOGI(TAG, "Configuring WiFi station parameters...");
+    EVENT_LOG_BANNER(TAG, "Configuring WiFi station parameters...");
     wifi_config_t wifi_config = 
     {
         .sta = {
-            .ssid = WIFI_SSID,
-            .password = WIFI_PASSWORD,
             .threshold.authmode = WIFI_AUTH_WPA2_PSK,  // Require WPA2 security minimum
+            .listen_interval = WIFI_LISTEN_INTERVAL,   // Used by WIFI_PS_MAX_MODEM only
         },
     };
+    // Not strncpy: a 32-character SSID fills the field without a terminator
+    memcpy(wifi_config.sta.ssid, config.ssid, strlen(config.ssid));
+    memcpy(wifi_config.sta.password, config.password, strlen(config.password));
     
     ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_STA));
     ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_STA, &wifi_config));
-    ESP_LOGI(TAG, "✓ WiFi station configured for network '%s'", WIFI_SSID);
+    EVENT_LOG_BANNER(TAG, "✓ WiFi station configured for network '%s'", station_ssid);
+    
+    // === MODEM SLEEP ===
+    // The radio sleeps between beacons; this is what lets the chip enter
+    // automatic light sleep while the link is up
+    ret = esp_wifi_set_ps(WIFI_POWER_SAVE);
+    if (ret != ESP_OK) 
+    {
+        ESP_LOGW(TAG, "Failed to set WiFi power save mode: %s", esp_err_to_name(ret));
+    }
+    else 
+    {
+        EVENT_LOG_BANNER(TAG, "✓ Modem sleep: %s", WIFI_POWER_SAVE == WIFI_PS_NONE ? "off" :
+                         WIFI_POWER_SAVE == WIFI_PS_MIN_MODEM ? "DTIM" : "listen interval");
+    }
+    
+    // === FAST RECONNECT ===
+    // Associate directly with the last good AP if one is cached in NVS
+    if (wifi_link_cache_load(&link_hint) == ESP_OK) 
+    {
+        link_hint_valid = true;
+        set_directed_association(true);
+        EVENT_LOG_BANNER(TAG, "✓ Cached AP %02x:%02x:%02x:%02x:%02x:%02x on channel %d", 
+                         link_hint.bssid[0], link_hint.bssid[1], link_hint.bssid[2],
+                         link_hint.bssid[3], link_hint.bssid[4], link_hint.bssid[5], link_hint.channel);
+    }
+    
+    // Upload backend (HTTP or MQTT, see wifi_transport.h)
+    ret = wifi_transport_init();
+    if (ret != ESP_OK) 
+    {
+        ESP_LOGE(TAG, "Upload transport initialization failed: %s", esp_err_to_name(ret));
+        return ret;
+    }
     
-    ESP_LOGI(TAG, "========================================");
-    ESP_LOGI(TAG, "✓ WiFi Manager Initialization Complete");
-    ESP_LOGI(TAG, "✓ Ready for connection establishment");
-    ESP_LOGI(TAG, "========================================");
+    EVENT_LOG_BANNER(TAG, "========================================");
+    ESP_LOGI(TAG, "WiFi manager initialized for network '%s'", station_ssid);
+    EVENT_LOG_BANNER(TAG, "✓ Ready for connection establishment");
+    EVENT_LOG_BANNER(TAG, "========================================");
     return ESP_OK;
 }
 
@@ -409,9 +684,9 @@ esp_err_t wifi_manager_init(void)
  * 4. Return success/failure based on final connection state
  * 
  * Blocking Behavior:
- * This function blocks until connection succeeds or all retry attempts
- * are exhausted. Maximum wait time depends on WIFI_RETRY_COUNT and
- * network response times (typically 30-60 seconds total).
+ * This function blocks until connection succeeds or WIFI_RETRY_COUNT
+ * attempts have failed. With the default backoff that is roughly 10-20
+ * seconds. Reconnection continues in the background after ESP_FAIL.
  * 
  * Event Synchronization:
  * Uses FreeRTOS event groups to coordinate between this function and
@@ -434,26 +709,27 @@ esp_err_t wifi_manager_init(void)
  */
 esp_err_t wifi_manager_connect(void) 
 {
-    ESP_LOGI(TAG, "========================================");
-    ESP_LOGI(TAG, "   WiFi Connection Establishment");
-    ESP_LOGI(TAG, "   Target Network: %s", WIFI_SSID);
-    ESP_LOGI(TAG, "   Max Retry Attempts: %d", WIFI_RETRY_COUNT);
-    ESP_LOGI(TAG, "========================================");
+    EVENT_LOG_BANNER(TAG, "========================================");
+    EVENT_LOG_BANNER(TAG, "   WiFi Connection Establishment");
+    EVENT_LOG_BANNER(TAG, "   Target Network: %s", station_ssid);
+    EVENT_LOG_BANNER(TAG, "   Max Retry Attempts: %d", WIFI_RETRY_COUNT);
+    EVENT_LOG_BANNER(TAG, "========================================");
     
     // Reset connection state for fresh attempt
     retry_count = 0;
-    current_status = WIFI_STATUS_CONNECTING;
+    auto_reconnect = true;
+    set_link_status(WIFI_STATUS_CONNECTING);
     
     // Clear any previous event bits to ensure clean state
     xEventGroupClearBits(wifi_event_group, WIFI_CONNECTED_BIT | WIFI_FAIL_BIT);
     
     // Start WiFi driver - this triggers the connection process
-    ESP_LOGI(TAG, "Starting WiFi driver and connection sequence...");
+    EVENT_LOG_BANNER(TAG, "Starting WiFi driver and connection sequence...");
     ESP_ERROR_CHECK(esp_wifi_start());
     
     // Wait for connection result with indefinite timeout
     // The event handler will set one of these bits based on connection outcome
-    ESP_LOGI(TAG, "Waiting for connection result...");
+    EVENT_LOG_BANNER(TAG, "Waiting for connection result...");
     EventBits_t bits = xEventGroupWaitBits(wifi_event_group,
                                           WIFI_CONNECTED_BIT | WIFI_FAIL_BIT,
                                           pdFALSE,    // Don't clear bits on exit
@@ -463,21 +739,20 @@ esp_err_t wifi_manager_connect(void)
     // Analyze connection result and provide detailed feedback
     if (bits & WIFI_CONNECTED_BIT) 
     {
-        ESP_LOGI(TAG, "========================================");
-        ESP_LOGI(TAG, "✓ WiFi Connection Successful!");
-        ESP_LOGI(TAG, "✓ Network: %s", WIFI_SSID);
-        ESP_LOGI(TAG, "✓ Signal Strength: %d dBm", current_rssi);
-        ESP_LOGI(TAG, "✓ Ready for data transmission");
-        ESP_LOGI(TAG, "========================================");
+        EVENT_LOG_BANNER(TAG, "========================================");
+        EVENT_LOGI(TAG, "WiFi connection established, %d dBm", wifi_manager_get_rssi());
+        EVENT_LOG_BANNER(TAG, "✓ Network: %s", station_ssid);
+        EVENT_LOG_BANNER(TAG, "✓ Signal Strength: %d dBm", wifi_manager_get_rssi());
+        EVENT_LOG_BANNER(TAG, "✓ Ready for data transmission");
+        EVENT_LOG_BANNER(TAG, "========================================");
         return ESP_OK;
     } 
     else if (bits & WIFI_FAIL_BIT) 
     {
-        ESP_LOGE(TAG, "========================================");
-        ESP_LOGE(TAG, "✗ WiFi Connection Failed");
-        ESP_LOGE(TAG, "✗ Exhausted all %d retry attempts", WIFI_RETRY_COUNT);
-        ESP_LOGE(TAG, "✗ Check network credentials and signal strength");
-        ESP_LOGE(TAG, "========================================");
+        EVENT_LOG_BANNER(TAG, "========================================");
+        EVENT_LOGE(TAG, "WiFi connection failed after %d attempts", WIFI_RETRY_COUNT);
+        EVENT_LOG_BANNER(TAG, "✗ Check network credentials and signal strength");
+        EVENT_LOG_BANNER(TAG, "========================================");
         return ESP_FAIL;
     }
     
@@ -525,14 +800,17 @@ esp_err_t wifi_manager_disconnect(void)
 {
     ESP_LOGI(TAG, "Initiating WiFi disconnection...");
     
+    // Intentional: do not let the disconnect event schedule a reconnection
+    auto_reconnect = false;
+    esp_timer_stop(reconnect_timer);
+    
     // Issue disconnect command to WiFi driver
     esp_err_t ret = esp_wifi_disconnect();
     
     if (ret == ESP_OK) 
     {
         // Update internal state immediately for consistent API behavior
-        current_status = WIFI_STATUS_DISCONNECTED;
-        current_rssi = 0;  // Clear signal strength
+        set_link_state(WIFI_STATUS_DISCONNECTED, 0);  // Clear signal strength
         ESP_LOGI(TAG, "✓ WiFi disconnection command issued successfully");
         ESP_LOGI(TAG, "✓ Network services are now offline");
     } 
@@ -563,6 +841,10 @@ esp_err_t wifi_manager_disconnect(void)
  * - Network outage recovery  
  * - Periodic reconnection attempts in monitoring applications
  * 
+ * Reconnection normally happens on its own (see wifi_event_handler()); this
+ * skips whatever backoff delay is pending and re-enables automatic
+ * reconnection after wifi_manager_disconnect().
+ * 
  * Non-blocking Operation:
  * Unlike wifi_manager_connect(), this function returns immediately after
  * initiating the reconnection attempt. Use wifi_manager_get_status() to
@@ -582,11 +864,20 @@ esp_err_t wifi_manager_reconnect(void)
     
     // Reset retry counter to allow fresh connection attempts
     retry_count = 0;
+    auto_reconnect = true;
+    esp_timer_stop(reconnect_timer);
     
-    // Update status if currently in error state
-    if (current_status == WIFI_STATUS_ERROR) 
+    // Update status if currently in error state (test and set under the write side)
+    seqlock_write_begin(&link_lock);
+    bool was_error = (link_state.status == WIFI_STATUS_ERROR);
+    if (was_error) 
+    {
+        link_state.status = WIFI_STATUS_CONNECTING;
+    }
+    seqlock_write_end(&link_lock);
+    
+    if (was_error) 
     {
-        current_status = WIFI_STATUS_CONNECTING;
         ESP_LOGI(TAG, "Status updated from ERROR to CONNECTING for reconnection");
     }
     
@@ -599,7 +890,7 @@ esp_err_t wifi_manager_reconnect(void)
     else 
     {
         ESP_LOGE(TAG, "Failed to initiate WiFi reconnection: %s", esp_err_to_name(ret));
-        current_status = WIFI_STATUS_ERROR;
+        set_link_status(WIFI_STATUS_ERROR);
     }
     
     return ret;
@@ -631,7 +922,7 @@ esp_err_t wifi_manager_reconnect(void)
  */
 wifi_status_t wifi_manager_get_status(void) 
 {
-    return current_status;
+    return get_link_state().status;
 }
 
 /**
@@ -666,7 +957,7 @@ wifi_status_t wifi_manager_get_status(void)
  */
 int8_t wifi_manager_get_rssi(void) 
 {
-    return current_rssi;
+    return get_link_state().rssi;
 }
 
 /**
@@ -694,7 +985,21 @@ int8_t wifi_manager_get_rssi(void)
  */
 bool wifi_manager_is_ready(void) 
 {
-    return (current_status == WIFI_STATUS_CONNECTED);
+    return (get_link_state().status == WIFI_STATUS_CONNECTED);
+}
+
+/**
+ * @brief Block until the link goes up or down, or the timeout expires
+ * 
+ * Consumes WIFI_LINK_CHANGED_BIT, so each change wakes one wait.
+ */
+bool wifi_manager_wait_link_change(uint32_t timeout_ms) 
+{
+    EventBits_t bits = xEventGroupWaitBits(wifi_event_group, WIFI_LINK_CHANGED_BIT,
+                                          pdTRUE,     // Consume the change
+                                          pdFALSE,
+                                          pdMS_TO_TICKS(timeout_ms));
+    return (bits & WIFI_LINK_CHANGED_BIT) != 0;
 }
 
 /**
@@ -722,25 +1027,23 @@ bool wifi_manager_is_ready(void)
  * 
  * Buffer Safety:
  * The function performs bounds checking to prevent buffer overflows.
- * Minimum buffer size of 200 bytes is recommended to accommodate
- * the complete JSON structure with safety margin.
+ * The document is ~130 bytes; a buffer that is too small is reported as
+ * ESP_ERR_INVALID_SIZE rather than being truncated.
  * 
  * Error Handling:
  * - Validates all input parameters before processing
- * - Checks buffer size sufficiency before formatting
  * - Verifies JSON string length fits within buffer limits
  * - Returns specific error codes for different failure modes
  * 
  * @param data Pointer to sensor data structure to format
  * @param json_buffer Output buffer for formatted JSON string
- * @param buffer_size Size of output buffer in bytes (minimum 200)
+ * @param buffer_size Size of output buffer in bytes
  * 
  * @return ESP_OK on successful JSON formatting
- * @return ESP_ERR_INVALID_ARG if data pointer is NULL or buffer too small
+ * @return ESP_ERR_INVALID_ARG if a pointer is NULL or buffer_size is 0
  * @return ESP_ERR_INVALID_SIZE if formatted JSON exceeds buffer size
  * 
  * @note Formatted JSON string is null-terminated
- * @note Buffer size should be at least 200 bytes for safety
  * @note RSSI value is automatically included from current WiFi connection
  * 
  * @see sensor_data_t for input data structure definition
@@ -761,42 +1064,25 @@ esp_err_t wifi_manager_format_json(const sensor_data_t* data, char* json_buffer,
         return ESP_ERR_INVALID_ARG;
     }
     
-    if (buffer_size < 200) 
+    if (buffer_size == 0) 
     {
-        ESP_LOGE(TAG, "Invalid parameter: buffer size %zu too small (minimum 200 bytes)", buffer_size);
+        ESP_LOGE(TAG, "Invalid parameter: JSON buffer size is 0");
         return ESP_ERR_INVALID_ARG;
     }
     
-    // Format sensor data as JSON with proper structure and precision
-    int len = snprintf(json_buffer, buffer_size,
-        "{"
-        "\"device_id\":\"%s\","
-        "\"timestamp\":%lu,"
-        "\"temperature\":%.2f,"
-        "\"humidity\":%.2f,"
-        "\"rssi\":%d"
-        "}",
-        data->device_id,                    // Unique device identifier
-        (unsigned long)data->timestamp,     // Unix timestamp for data correlation
-        data->temperature,                  // Temperature in Celsius (2 decimal precision)
-        data->humidity,                     // Humidity percentage (2 decimal precision)
-        current_rssi                        // Current WiFi signal strength
-    );
-    
-    // Verify JSON formatting was successful and fits in buffer
-    if (len < 0) 
-    {
-        ESP_LOGE(TAG, "JSON formatting failed - snprintf error");
-        return ESP_ERR_INVALID_SIZE;
-    }
-    
-    if (len >= buffer_size) 
+    // Format sensor data as JSON with fixed two-decimal precision
+    wifi_payload_single_t payload = { .data = data, .rssi = wifi_manager_get_rssi() };
+    json_writer_t writer;
+    json_writer_init_buffer(&writer, json_buffer, buffer_size);
+    wifi_payload_emit_single_json(&writer, &payload);
+    if (json_writer_finish(&writer) != ESP_OK) 
     {
-        ESP_LOGE(TAG, "JSON string too long (%d bytes) for buffer (%zu bytes)", len, buffer_size);
+        ESP_LOGE(TAG, "JSON string too long (%u bytes) for buffer (%zu bytes)", 
+                 (unsigned)writer.length, buffer_size);
         return ESP_ERR_INVALID_SIZE;
     }
     
-    ESP_LOGD(TAG, "JSON formatted successfully: %d bytes", len);
+    ESP_LOGD(TAG, "JSON formatted successfully: %u bytes", (unsigned)writer.length);
     ESP_LOGD(TAG, "JSON content: %s", json_buffer);
     
     return ESP_OK;
@@ -812,18 +1098,16 @@ esp_err_t wifi_manager_format_json(const sensor_data_t* data, char* json_buffer,
  * Transmission Process:
  * 1. Verify WiFi connectivity is available
  * 2. Format sensor data as JSON payload
- * 3. Initialize and configure HTTP client
- * 4. Set appropriate HTTP headers for JSON transmission
- * 5. Execute POST request with sensor data
- * 6. Process server response and status codes
- * 7. Clean up HTTP client resources
+ * 3. Reuse the persistent HTTP client (created with headers on first use)
+ * 4. Execute POST request on the kept-alive connection
+ * 5. Process server response and status codes
  * 
  * HTTP Configuration:
  * - Method: POST for data submission
  * - Content-Type: application/json for proper server parsing
  * - User-Agent: ESP32-SensorMonitor/1.0 for server identification
  * - Timeout: Configurable via HTTP_TIMEOUT_MS
- * - URL: Configurable via HTTP_SERVER_URL in wifi_config.h
+ * - URL: server_url of the runtime configuration (device_config.h)
  * 
  * Error Handling:
  * The function handles multiple error conditions:
@@ -855,12 +1139,12 @@ esp_err_t wifi_manager_format_json(const sensor_data_t* data, char* json_buffer,
  * 
  * @note WiFi must be connected before calling this function
  * @note Function blocks until transmission completes or times out
- * @note Server URL and timeout configured in wifi_config.h
- * @note HTTP client resources are automatically cleaned up
+ * @note Server URL from device_config.h, timeout from wifi_config.h
+ * @note The HTTP client and its connection persist between calls
  * 
  * @see wifi_manager_is_ready() to check WiFi connectivity first
  * @see wifi_manager_format_json() for JSON formatting details
- * @see wifi_config.h for server configuration parameters
+ * @see device_config.h for the server URL
  */
 esp_err_t wifi_manager_send_data(const sensor_data_t* data) 
 {
@@ -868,8 +1152,7 @@ esp_err_t wifi_manager_send_data(const sensor_data_t* data)
     // Ensure WiFi is connected before attempting transmission
     if (!wifi_manager_is_ready()) 
     {
-        ESP_LOGW(TAG, "Cannot send data - WiFi not connected");
-        ESP_LOGW(TAG, "Current status: %d (CONNECTED=%d)", current_status, WIFI_STATUS_CONNECTED);
+        EVENT_LOGW(TAG, "Cannot send data - WiFi not connected (status %d)", wifi_manager_get_status());
         return ESP_FAIL;
     }
     
@@ -881,116 +1164,101 @@ esp_err_t wifi_manager_send_data(const sensor_data_t* data)
         return ESP_ERR_INVALID_ARG;
     }
     
-    ESP_LOGI(TAG, "========================================");
-    ESP_LOGI(TAG, "   HTTP Data Transmission");
-    ESP_LOGI(TAG, "   Server: %s", HTTP_SERVER_URL);
-    ESP_LOGI(TAG, "   Device: %s", data->device_id);
-    ESP_LOGI(TAG, "========================================");
+    EVENT_LOG_BANNER(TAG, "========================================");
+    EVENT_LOG_BANNER(TAG, "   Data Transmission");
+    EVENT_LOG_BANNER(TAG, "   Device: %s", data->device_id);
+    EVENT_LOG_BANNER(TAG, "========================================");
     
-    // === JSON PAYLOAD FORMATTING ===
-    // Convert sensor data to JSON format for HTTP transmission
-    char json_buffer[HTTP_BUFFER_SIZE];
-    esp_err_t ret = wifi_manager_format_json(data, json_buffer, sizeof(json_buffer));
-    if (ret != ESP_OK) 
+    perf_timestamp_t started = PERF_BEGIN();
+    esp_err_t ret = wifi_transport_send(data);
+    PERF_END(PERF_STAGE_UPLOAD, started);
+    return ret;
+}
+
+/**
+ * @brief Format a batch of buffered samples as one JSON document
+ * 
+ * Produces exactly the bytes that wifi_manager_send_batch() streams. A
+ * batch that would overflow the buffer is rejected, never truncated.
+ * 
+ * @see wifi_manager.h for the document layout
+ */
+esp_err_t wifi_manager_format_batch_json(const char* device_id, const sensor_sample_t* samples,
+                                         size_t count, char* json_buffer, size_t buffer_size)
+{
+    if (device_id == NULL || samples == NULL || json_buffer == NULL || count == 0)
     {
-        ESP_LOGE(TAG, "Failed to format sensor data as JSON: %s", esp_err_to_name(ret));
-        return ret;
+        ESP_LOGE(TAG, "Invalid parameter for batch JSON formatting");
+        return ESP_ERR_INVALID_ARG;
     }
-    
-    ESP_LOGI(TAG, "JSON payload prepared: %d bytes", strlen(json_buffer));
-    ESP_LOGD(TAG, "Payload content: %s", json_buffer);
-    
-    // === HTTP CLIENT INITIALIZATION ===
-    // Configure HTTP client for JSON POST transmission
-    ESP_LOGI(TAG, "Initializing HTTP client...");
-    esp_http_client_config_t config = 
-    {
-        .url = HTTP_SERVER_URL,              // Target server endpoint
-        .event_handler = http_event_handler, // Response processing callback
-        .timeout_ms = HTTP_TIMEOUT_MS,       // Network timeout configuration
-        .method = HTTP_METHOD_POST,          // POST method for data submission
+
+    wifi_payload_batch_t payload = {
+        .device_id = device_id,
+        .samples = samples,
+        .count = count,
+        .rssi = wifi_manager_get_rssi(),
     };
-    
-    esp_http_client_handle_t client = esp_http_client_init(&config);
-    if (client == NULL) 
+    json_writer_t writer;
+    json_writer_init_buffer(&writer, json_buffer, buffer_size);
+    wifi_payload_emit_batch_json(&writer, &payload);
+    if (json_writer_finish(&writer) != ESP_OK)
     {
-        ESP_LOGE(TAG, "Failed to initialize HTTP client - insufficient memory or invalid config");
-        return ESP_FAIL;
+        ESP_LOGE(TAG, "Batch JSON too long (%u bytes) for buffer (%zu bytes)",
+                 (unsigned)writer.length, buffer_size);
+        return ESP_ERR_INVALID_SIZE;
     }
-    ESP_LOGI(TAG, "✓ HTTP client initialized successfully");
-    
-    // === HTTP HEADERS CONFIGURATION ===
-    // Set appropriate headers for JSON data transmission
-    ESP_LOGI(TAG, "Configuring HTTP headers...");
-    esp_http_client_set_header(client, "Content-Type", "application/json");
-    esp_http_client_set_header(client, "User-Agent", "ESP32-SensorMonitor/1.0");
-    esp_http_client_set_header(client, "Accept", "application/json");
-    ESP_LOGI(TAG, "✓ HTTP headers configured for JSON transmission");
-    
-    // === PAYLOAD ATTACHMENT ===
-    // Attach JSON sensor data as POST request body
-    esp_http_client_set_post_field(client, json_buffer, strlen(json_buffer));
-    ESP_LOGI(TAG, "✓ JSON payload attached to POST request");
-    
-    // === HTTP REQUEST EXECUTION ===
-    // Perform the actual HTTP transmission
-    ESP_LOGI(TAG, "Executing HTTP POST request...");
-    ret = esp_http_client_perform(client);
-    
-    if (ret == ESP_OK) 
+
+    ESP_LOGD(TAG, "Batch JSON formatted: %zu readings, %u bytes", count, (unsigned)writer.length);
+    return ESP_OK;
+}
+
+/**
+ * @brief Upload a batch of buffered samples in a single HTTP POST
+ * 
+ * One request per batch instead of one per reading: the TCP connect and
+ * HTTP headers are paid once for up to WIFI_BATCH_MAX_SAMPLES readings.
+ */
+esp_err_t wifi_manager_send_batch(const char* device_id, const sensor_sample_t* samples, size_t count)
+{
+    if (!wifi_manager_is_ready())
     {
-        // === RESPONSE PROCESSING ===
-        // Analyze server response for transmission success
-        int status_code = esp_http_client_get_status_code(client);
-        int content_length = esp_http_client_get_content_length(client);
-        
-        ESP_LOGI(TAG, "HTTP transmission completed");
-        ESP_LOGI(TAG, "Response status: %d", status_code);
-        ESP_LOGI(TAG, "Response length: %d bytes", content_length);
-        
-        if (status_code >= 200 && status_code < 300) 
-        {
-            // Success response range (2xx status codes)
-            ESP_LOGI(TAG, "========================================");
-            ESP_LOGI(TAG, "✓ Data Transmission Successful!");
-            ESP_LOGI(TAG, "✓ Server accepted sensor data");
-            ESP_LOGI(TAG, "✓ HTTP Status: %d", status_code);
-            ESP_LOGI(TAG, "========================================");
-            ret = ESP_OK;
-        } 
-        else 
-        {
-            // Server error or client error response
-            ESP_LOGW(TAG, "========================================");
-            ESP_LOGW(TAG, "✗ Server Error Response");
-            ESP_LOGW(TAG, "✗ HTTP Status: %d", status_code);
-            if (status_code >= 400 && status_code < 500) 
-            {
-                ESP_LOGW(TAG, "✗ Client Error: Check request format and server configuration");
-            } 
-            else if (status_code >= 500) 
-            {
-                ESP_LOGW(TAG, "✗ Server Error: Remote server experiencing issues");
-            }
-            ESP_LOGW(TAG, "========================================");
-            ret = ESP_FAIL;
-        }
-    } 
-    else 
+        EVENT_LOGW(TAG, "Cannot send batch - WiFi not connected");
+        return ESP_FAIL;
+    }
+    if (device_id == NULL || samples == NULL || count == 0 || count > WIFI_BATCH_MAX_SAMPLES)
     {
-        // === NETWORK ERROR HANDLING ===
-        // Handle network-level transmission failures
-        ESP_LOGE(TAG, "========================================");
-        ESP_LOGE(TAG, "✗ HTTP Transmission Failed");
-        ESP_LOGE(TAG, "✗ Network Error: %s", esp_err_to_name(ret));
-        ESP_LOGE(TAG, "✗ Check network connectivity and server availability");
-        ESP_LOGE(TAG, "========================================");
+        return ESP_ERR_INVALID_ARG;
     }
-    
-    // === RESOURCE CLEANUP ===
-    // Always clean up HTTP client resources
-    esp_http_client_cleanup(client);
-    ESP_LOGD(TAG, "HTTP client resources cleaned up");
-    
+
+    perf_timestamp_t started = PERF_BEGIN();
+    esp_err_t ret = wifi_transport_send_batch(device_id, samples, count);
+    PERF_END(PERF_STAGE_UPLOAD, started);
     return ret;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Wait for the transport to confirm everything sent so far
+ */
+esp_err_t wifi_manager_flush(uint32_t timeout_ms)
+{
+    return wifi_transport_flush(timeout_ms);
+}
+
+/**
+ * @brief Upload a diagnostics record; not timed as PERF_STAGE_UPLOAD
+ */
+esp_err_t wifi_manager_send_diagnostics(const char* device_id, const perf_report_t* report,
+                                        const event_log_excerpt_t* log)
+{
+    if (!wifi_manager_is_ready())
+    {
+        EVENT_LOGW(TAG, "Cannot send diagnostics - WiFi not connected");
+        return ESP_FAIL;
+    }
+    if (device_id == NULL || report == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return wifi_transport_send_diagnostics(device_id, report, log);
+}
@@ -5,6 +5,9 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "wifi_config.h"
+#include "sample_ring.h"
+#include "perf_monitor.h"
+#include "event_log.h"
 
 /**
  * @file wifi_manager.h
@@ -24,8 +27,9 @@
  * - Easy integration with sensor data collection systems
  * 
  * Configuration:
- * WiFi network credentials and HTTP server settings are configured in wifi_config.h
- * This separation allows easy customization without modifying core functionality.
+ * WiFi network credentials and server addresses come from the runtime
+ * configuration in NVS (device_config.h); transport tuning (timeouts,
+ * keep-alive, payload format) is set at build time in wifi_config.h.
  * 
  * Supported Use Cases:
  * - Sensor data transmission to cloud platforms (AWS IoT, Google Cloud, etc.)
@@ -41,7 +45,8 @@
  * @author ESP32 Development Team
  * @version 1.0
  * @date 2025-10-01
- * @see wifi_config.h for network and server configuration
+ * @see device_config.h for network and server configuration
+ * @see wifi_config.h for transport settings
  */
 
 /**
@@ -108,8 +113,8 @@ typedef struct {
  * 5. Configure station mode with provided credentials
  * 
  * Configuration Source:
- * WiFi credentials (SSID, password) and security settings are loaded from
- * wifi_config.h. Modify that file to update network settings.
+ * WiFi credentials (SSID, password) are taken from device_config_get();
+ * call device_config_init() first. Security settings are fixed here.
  * 
  * Error Conditions:
  * - NVS initialization failure (corrupted flash, insufficient space)
@@ -129,7 +134,7 @@ esp_err_t wifi_manager_init(void);
 /**
  * @brief Establish connection to configured WiFi network
  * 
- * Attempts to connect to the WiFi network specified in wifi_config.h using
+ * Attempts to connect to the WiFi network of the runtime configuration using
  * the configured credentials and security settings. Implements automatic retry
  * logic with exponential backoff to handle temporary network issues.
  * 
@@ -141,8 +146,11 @@ esp_err_t wifi_manager_init(void);
  * 5. Update internal connection status based on result
  * 
  * Retry Strategy:
- * - Maximum retry attempts: Defined by WIFI_RETRY_COUNT in wifi_config.h
- * - Retry delay: Progressive delay between attempts for network stability
+ * - Failure reported after WIFI_RETRY_COUNT attempts (wifi_config.h);
+ *   reconnection then continues in the background without limit
+ * - Retry delay: jittered exponential backoff from WIFI_BACKOFF_BASE_MS up
+ *   to WIFI_BACKOFF_MAX_MS; credential / missing-AP failures wait at least
+ *   WIFI_BACKOFF_CONFIG_MIN_MS
  * - Automatic status updates: Internal state machine tracks progress
  * 
  * Blocking Behavior:
@@ -173,9 +181,8 @@ esp_err_t wifi_manager_connect(void);
  * 4. Let background event handlers manage the connection process
  * 
  * Use Cases:
- * - Router power cycle recovery
- * - Network outage recovery
- * - Periodic reconnection attempts in monitoring applications
+ * - Skip the pending backoff delay (e.g. on user request)
+ * - Resume automatic reconnection after wifi_manager_disconnect()
  * 
  * Non-blocking Operation:
  * Unlike wifi_manager_connect(), this function returns immediately after
@@ -324,6 +331,19 @@ esp_err_t wifi_manager_send_data(const sensor_data_t* data);
  */
 bool wifi_manager_is_ready(void);
 
+/**
+ * @brief Wait for the link to come up or go down
+ * 
+ * Lets the WiFi task sleep between uploads yet react the moment
+ * IP_EVENT_STA_GOT_IP fires (or the connection drops) instead of at its next
+ * polling interval. Each change wakes one wait.
+ * 
+ * @param timeout_ms Maximum time to wait
+ * 
+ * @return true if the link state changed, false on timeout
+ */
+bool wifi_manager_wait_link_change(uint32_t timeout_ms);
+
 /**
  * @brief Format sensor data into JSON string for HTTP transmission
  * 
@@ -339,8 +359,7 @@ bool wifi_manager_is_ready(void);
  * - rssi: Current WiFi signal strength for network quality assessment
  * 
  * Buffer Requirements:
- * Minimum buffer size should be 200 bytes to accommodate full JSON structure
- * with typical sensor data values and metadata.
+ * The document is ~130 bytes; HTTP_BUFFER_SIZE leaves ample headroom.
  * 
  * Error Conditions:
  * - NULL data pointer or buffer pointer
@@ -352,16 +371,100 @@ bool wifi_manager_is_ready(void);
  * @param buffer_size Size of output buffer in bytes
  * 
  * @return ESP_OK if JSON formatting completed successfully
- * @return ESP_ERR_INVALID_ARG if any pointer is NULL or buffer too small
+ * @return ESP_ERR_INVALID_ARG if any pointer is NULL or buffer_size is 0
  * @return ESP_ERR_INVALID_SIZE if formatted JSON exceeds buffer capacity
  * 
  * @pre data must point to valid sensor_data_t structure
  * @pre json_buffer must point to writable memory of buffer_size bytes
- * @pre buffer_size must be at least 200 bytes for typical data
  * @post json_buffer contains null-terminated JSON string on success
  * @note Generated JSON is always null-terminated
  * @warning Buffer overflow protection - verify buffer_size is adequate
  */
 esp_err_t wifi_manager_format_json(const sensor_data_t* data, char* json_buffer, size_t buffer_size);
 
+/**
+ * @brief Format a batch of buffered samples as one JSON document
+ * 
+ * Produces a single object carrying the device identity and the current
+ * RSSI once, followed by the readings in ring order:
+ * 
+ * @code
+ * {"device_id":"ESP32_SENSOR_01","rssi":-58,"readings":[
+ *   {"timestamp":1700000000,"temperature":23.00,"humidity":45.00}, ...]}
+ * @endcode
+ * 
+ * @param device_id Null-terminated device identifier
+ * @param samples Readings to include, oldest first
+ * @param count Number of readings (1 to WIFI_BATCH_MAX_SAMPLES)
+ * @param json_buffer Output buffer (null-terminated on success)
+ * @param buffer_size Size of json_buffer in bytes
+ * 
+ * @return ESP_OK on success
+ * @return ESP_ERR_INVALID_ARG on NULL pointers or a count of 0
+ * @return ESP_ERR_INVALID_SIZE if the document does not fit in the buffer
+ */
+esp_err_t wifi_manager_format_batch_json(const char* device_id, const sensor_sample_t* samples,
+                                         size_t count, char* json_buffer, size_t buffer_size);
+
+/**
+ * @brief Upload a batch of buffered samples in a single request or message
+ * 
+ * Same transport and success criteria as wifi_manager_send_data(), but one
+ * request carries up to WIFI_BATCH_MAX_SAMPLES readings. The body uses the
+ * format selected by WIFI_PAYLOAD_FORMAT. A server that answers 415 to the
+ * binary format is sent JSON from then on. The caller keeps
+ * the samples (see sample_ring_commit()) until this returns ESP_OK.
+ * 
+ * With WIFI_TRANSPORT_MQTT the batch is one QoS 1 publish and ESP_OK only
+ * means it was queued in the client's outbox: keep the samples until a
+ * following wifi_manager_flush() returns ESP_OK.
+ * 
+ * @param device_id Null-terminated device identifier
+ * @param samples Readings to send, oldest first
+ * @param count Number of readings (1 to WIFI_BATCH_MAX_SAMPLES)
+ * 
+ * @return ESP_OK if the server accepted the batch (2xx)
+ * @return ESP_FAIL if WiFi is not connected or the transmission failed
+ * @return ESP_ERR_INVALID_ARG / ESP_ERR_INVALID_SIZE on formatting errors
+ * 
+ * @note Not reentrant: formats into a static buffer. Call from one task only.
+ */
+esp_err_t wifi_manager_send_batch(const char* device_id, const sensor_sample_t* samples, size_t count);
+
+/**
+ * @brief Wait until every upload handed to the transport is acknowledged
+ * 
+ * With HTTP each request already completed inside wifi_manager_send_batch(),
+ * so this returns ESP_OK at once. With MQTT it waits for the broker's PUBACKs
+ * of the QoS 1 messages still in flight, and fails if any message sent since
+ * the previous flush expired from the outbox unacknowledged.
+ * 
+ * @param timeout_ms Maximum time to wait
+ * 
+ * @return ESP_OK if everything sent since the previous flush was delivered
+ * @return ESP_ERR_TIMEOUT if messages were still in flight at the deadline
+ * @return ESP_FAIL if a message was dropped unacknowledged
+ */
+esp_err_t wifi_manager_flush(uint32_t timeout_ms);
+
+/**
+ * @brief Upload a diagnostics record (perf_monitor.h)
+ * 
+ * Goes to the same endpoint as the readings (HTTP), or to
+ * <MQTT_TOPIC_PREFIX>/<device_id>/diagnostics (MQTT). The record is not
+ * buffered: a failed upload is dropped and the next interval sends a new one.
+ * 
+ * @param device_id Null-terminated device identifier
+ * @param report Snapshot from perf_monitor_snapshot()
+ * @param log Warnings and errors from event_log_peek() for a "log" member,
+ *            or NULL; commit them only after ESP_OK
+ * 
+ * @return ESP_OK if the transport accepted the record (with MQTT, delivered
+ *         once wifi_manager_flush() returns ESP_OK)
+ * @return ESP_FAIL if WiFi is not connected or the transmission failed
+ * @return ESP_ERR_INVALID_ARG on NULL pointers
+ */
+esp_err_t wifi_manager_send_diagnostics(const char* device_id, const perf_report_t* report,
+                                        const event_log_excerpt_t* log);
+
 #endif // WIFI_MANAGER_H
\ No newline at end of file
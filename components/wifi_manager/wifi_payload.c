@@ -0,0 +1,183 @@
+/**
+ * @file wifi_payload.c
+ * @brief JSON emitters for upload bodies, see wifi_payload.h
+ */
+
+#include "wifi_payload.h"
+
+void wifi_payload_emit_single_json(json_writer_t *w, const void *payload)
+{
+    const wifi_payload_single_t *p = payload;
+    json_writer_object_begin(w);
+    json_writer_key(w, "device_id");
+    json_writer_string(w, p->data->device_id);
+    json_writer_key(w, "timestamp");
+    json_writer_uint(w, p->data->timestamp);
+    json_writer_key(w, "temperature");
+    json_writer_fixed2(w, p->data->temperature);
+    json_writer_key(w, "humidity");
+    json_writer_fixed2(w, p->data->humidity);
+    json_writer_key(w, "rssi");
+    json_writer_int(w, p->rssi);
+    json_writer_object_end(w);
+}
+
+static void emit_range(json_writer_t *w, const char *key, int32_t min, int32_t max, int32_t mean)
+{
+    json_writer_key(w, key);
+    json_writer_object_begin(w);
+    json_writer_key(w, "min");
+    json_writer_fixed2(w, min / 100.0f);
+    json_writer_key(w, "max");
+    json_writer_fixed2(w, max / 100.0f);
+    json_writer_key(w, "mean");
+    json_writer_fixed2(w, mean / 100.0f);
+    json_writer_object_end(w);
+}
+
+static void emit_rollup(json_writer_t *w, const sample_rollup_t *rollup)
+{
+    json_writer_key(w, "rollup");
+    json_writer_object_begin(w);
+    json_writer_key(w, "count");
+    json_writer_uint(w, rollup->count);
+    emit_range(w, "temperature", rollup->temperature_min, rollup->temperature_max,
+               rollup->temperature_mean);
+    emit_range(w, "humidity", rollup->humidity_min, rollup->humidity_max, rollup->humidity_mean);
+    json_writer_object_end(w);
+}
+
+void wifi_payload_emit_batch_json(json_writer_t *w, const void *payload)
+{
+    const wifi_payload_batch_t *p = payload;
+    json_writer_object_begin(w);
+    json_writer_key(w, "device_id");
+    json_writer_string(w, p->device_id);
+    json_writer_key(w, "rssi");
+    json_writer_int(w, p->rssi);
+    json_writer_key(w, "readings");
+    json_writer_array_begin(w);
+    for (size_t i = 0; i < p->count; i++)
+    {
+        json_writer_object_begin(w);
+        json_writer_key(w, "timestamp");
+        json_writer_uint(w, p->samples[i].timestamp);
+        json_writer_key(w, "temperature");
+        json_writer_fixed2(w, p->samples[i].temperature);
+        json_writer_key(w, "humidity");
+        json_writer_fixed2(w, p->samples[i].humidity);
+        if (p->samples[i].rollup.count > 1)
+        {
+            emit_rollup(w, &p->samples[i].rollup);
+        }
+        json_writer_object_end(w);
+    }
+    json_writer_array_end(w);
+    json_writer_object_end(w);
+}
+
+static void emit_uint_member(json_writer_t *w, const char *key, uint32_t value)
+{
+    json_writer_key(w, key);
+    json_writer_uint(w, value);
+}
+
+static void emit_log(json_writer_t *w, const event_log_excerpt_t *log)
+{
+    if (log == NULL || (log->count == 0 && log->lost == 0))
+    {
+        return;
+    }
+
+    json_writer_key(w, "log");
+    json_writer_array_begin(w);
+    for (size_t i = 0; i < log->count; i++)
+    {
+        const event_log_record_t *record = &log->records[i];
+        char message[EVENT_LOG_MESSAGE_SIZE];
+        event_log_format(record, message, sizeof(message));
+
+        json_writer_object_begin(w);
+        emit_uint_member(w, "ms", record->timestamp_ms);
+        json_writer_key(w, "level");
+        json_writer_string(w, event_log_level_name((esp_log_level_t)record->level));
+        json_writer_key(w, "tag");
+        json_writer_string(w, record->tag);
+        json_writer_key(w, "msg");
+        json_writer_string(w, message);
+        json_writer_object_end(w);
+    }
+    json_writer_array_end(w);
+    if (log->lost > 0)
+    {
+        emit_uint_member(w, "log_lost", log->lost);
+    }
+}
+
+void wifi_payload_emit_diagnostics_json(json_writer_t *w, const void *payload)
+{
+    const wifi_payload_diagnostics_t *p = payload;
+    const perf_report_t *r = p->report;
+    json_writer_object_begin(w);
+    json_writer_key(w, "device_id");
+    json_writer_string(w, p->device_id);
+    json_writer_key(w, "rssi");
+    json_writer_int(w, p->rssi);
+    json_writer_key(w, "diagnostics");
+    json_writer_object_begin(w);
+    emit_uint_member(w, "uptime_s", r->uptime_s);
+    emit_uint_member(w, "window_s", r->window_s);
+
+    json_writer_key(w, "heap");
+    json_writer_object_begin(w);
+    emit_uint_member(w, "free", r->heap_free);
+    emit_uint_member(w, "min_free", r->heap_min_free);
+    emit_uint_member(w, "largest_block", r->heap_largest_block);
+    json_writer_object_end(w);
+
+    json_writer_key(w, "stages");
+    json_writer_object_begin(w);
+    for (int i = 0; i < PERF_STAGE_COUNT; i++)
+    {
+        const perf_stage_stats_t *s = &r->stages[i];
+        json_writer_key(w, perf_monitor_stage_name((perf_stage_t)i));
+        json_writer_object_begin(w);
+        emit_uint_member(w, "count", s->count);
+        emit_uint_member(w, "min_us", s->min_us);
+        emit_uint_member(w, "avg_us", s->avg_us);
+        emit_uint_member(w, "p99_us", s->p99_us);
+        emit_uint_member(w, "max_us", s->max_us);
+        json_writer_object_end(w);
+    }
+    json_writer_object_end(w);
+
+    json_writer_key(w, "stack_free");
+    json_writer_object_begin(w);
+    for (size_t i = 0; i < r->task_count; i++)
+    {
+        emit_uint_member(w, r->tasks[i].name, r->tasks[i].stack_free_min);
+    }
+    json_writer_object_end(w);
+
+    // Only the milestones reached so far
+    json_writer_key(w, "boot_ms");
+    json_writer_object_begin(w);
+    for (int i = 0; i < PERF_BOOT_COUNT; i++)
+    {
+        if (r->boot_ms[i] != 0)
+        {
+            emit_uint_member(w, perf_monitor_boot_name((perf_boot_mark_t)i), r->boot_ms[i]);
+        }
+    }
+    json_writer_object_end(w);
+
+    json_writer_object_end(w);
+    emit_log(w, p->log);
+    json_writer_object_end(w);
+}
+
+void wifi_payload_emit_raw(json_writer_t *w, const void *payload)
+{
+    const wifi_payload_raw_t *p = payload;
+    json_writer_raw(w, p->data, p->length);
+}
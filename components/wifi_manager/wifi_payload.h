@@ -0,0 +1,92 @@
+#ifndef WIFI_PAYLOAD_H
+#define WIFI_PAYLOAD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "json_writer.h"
+#include "sample_ring.h"
+#include "wifi_manager.h"
+#include "perf_monitor.h"
+#include "event_log.h"
+
+/**
+ * @file wifi_payload.h
+ * @brief Upload bodies shared by wifi_manager and the transport backends
+ *
+ * A body is never held in a dedicated buffer. An emitter writes it into a
+ * json_writer_t, which either counts, fills a buffer, or streams into a
+ * connection. An emitter may be run more than once for the same upload (the
+ * HTTP transport counts first for the Content-Length), so it must produce
+ * identical output every time; values that can change between runs, such as
+ * RSSI, are captured in the payload struct beforehand.
+ */
+
+typedef void (*wifi_payload_emitter_t)(json_writer_t *w, const void *payload);
+
+/**
+ * @brief One reading, as sent by wifi_manager_send_data()
+ */
+typedef struct {
+    const sensor_data_t *data;
+    int8_t rssi;
+} wifi_payload_single_t;
+
+/**
+ * @brief A batch of buffered readings, oldest first
+ */
+typedef struct {
+    const char *device_id;
+    const sensor_sample_t *samples;
+    size_t count;
+    int8_t rssi;
+} wifi_payload_batch_t;
+
+/**
+ * @brief A perf_monitor snapshot and the log records since the last one
+ */
+typedef struct {
+    const char *device_id;
+    const perf_report_t *report;
+    const event_log_excerpt_t *log;     ///< NULL or empty: no "log" member
+    int8_t rssi;
+} wifi_payload_diagnostics_t;
+
+/**
+ * @brief Pre-encoded bytes (e.g. a binary batch from telemetry_codec.h)
+ */
+typedef struct {
+    const uint8_t *data;
+    size_t length;
+} wifi_payload_raw_t;
+
+/**
+ * @brief {"device_id","timestamp","temperature","humidity","rssi"}
+ */
+void wifi_payload_emit_single_json(json_writer_t *w, const void *payload);
+
+/**
+ * @brief {"device_id","rssi","readings":[{"timestamp","temperature","humidity"},...]}
+ *
+ * A reading that stands for more than one (sample_rollup_t count above 1)
+ * also carries "rollup":{"count","temperature":{"min","max","mean"},
+ * "humidity":{"min","max","mean"}}.
+ */
+void wifi_payload_emit_batch_json(json_writer_t *w, const void *payload);
+
+/**
+ * @brief {"device_id","rssi","diagnostics":{"uptime_s","window_s","heap":{...},
+ *         "stages":{"<stage>":{"count","min_us","avg_us","p99_us","max_us"},...},
+ *         "stack_free":{"<task>":bytes,...}}}
+ *
+ * With log records (event_log_peek()) the document also carries
+ * "log":[{"ms","level","tag","msg"},...] and, if records were overwritten
+ * before they could be sent, "log_lost".
+ */
+void wifi_payload_emit_diagnostics_json(json_writer_t *w, const void *payload);
+
+/**
+ * @brief Copy a wifi_payload_raw_t verbatim
+ */
+void wifi_payload_emit_raw(json_writer_t *w, const void *payload);
+
+#endif // WIFI_PAYLOAD_H
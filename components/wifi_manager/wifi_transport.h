@@ -0,0 +1,88 @@
+#ifndef WIFI_TRANSPORT_H
+#define WIFI_TRANSPORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "sample_ring.h"
+#include "wifi_manager.h"
+#include "perf_monitor.h"
+
+/**
+ * @file wifi_transport.h
+ * @brief Upload transport used by wifi_manager once the WiFi link is up
+ *
+ * Separates "deliver this reading or batch to the backend" from the WiFi
+ * connection management in wifi_manager.c. Two interchangeable backends
+ * implement this interface, selected with WIFI_TRANSPORT in wifi_config.h:
+ *
+ * - HTTP (default): POST to the configured server_url over a persistent
+ *   keep-alive connection. Every call completes synchronously; ESP_OK means
+ *   the server answered 2xx. Responses may push configuration changes.
+ * - MQTT: publish to the configured mqtt_uri over a persistent session (esp-mqtt).
+ *   Publishes use QoS 1 with a bounded in-flight window; ESP_OK only means
+ *   the message is queued in the client's RAM outbox. Delivery is confirmed
+ *   by wifi_transport_flush(). A retained Last Will marks the device offline.
+ *   Needs CONFIG_MQTT_REPORT_DELETED_MESSAGES, so that messages expired
+ *   from the outbox are reported (and count as lost).
+ *
+ * Threading:
+ * wifi_transport_send() / _send_batch() / _send_diagnostics() / _flush()
+ * are called from the WiFi task only. wifi_transport_link_up() / _link_down() are called from
+ * the WiFi event handler and must not block.
+ */
+
+/**
+ * @brief Create the transport's resources
+ *
+ * Called once from wifi_manager_init(). No network traffic happens here.
+ */
+esp_err_t wifi_transport_init(void);
+
+/**
+ * @brief The station got an IP address
+ */
+void wifi_transport_link_up(void);
+
+/**
+ * @brief The station lost its association; open connections are dead
+ */
+void wifi_transport_link_down(void);
+
+/**
+ * @brief Deliver a single reading
+ */
+esp_err_t wifi_transport_send(const sensor_data_t *data);
+
+/**
+ * @brief Deliver a batch of readings (1 to WIFI_BATCH_MAX_SAMPLES), oldest first
+ *
+ * @return ESP_OK once the transport has accepted the batch (see the backend
+ *         descriptions above). The caller drops it only after a later
+ *         wifi_transport_flush() returns ESP_OK
+ */
+esp_err_t wifi_transport_send_batch(const char *device_id, const sensor_sample_t *samples,
+                                    size_t count);
+
+/**
+ * @brief Deliver a diagnostics record (JSON in both backends)
+ *
+ * @param log Log records to include, or NULL
+ */
+esp_err_t wifi_transport_send_diagnostics(const char *device_id, const perf_report_t *report,
+                                          const event_log_excerpt_t *log);
+
+/**
+ * @brief Wait until everything handed to the transport has been acknowledged
+ *
+ * @param timeout_ms Maximum time to wait
+ * Also reports messages that were given up since the previous flush, so
+ * ESP_OK means everything sent in between has been delivered.
+ *
+ * @return ESP_OK if nothing is left in flight and nothing was lost
+ * @return ESP_ERR_TIMEOUT if messages were still unacknowledged at the deadline
+ * @return ESP_FAIL if a message was dropped without acknowledgement
+ */
+esp_err_t wifi_transport_flush(uint32_t timeout_ms);
+
+#endif // WIFI_TRANSPORT_H
@@ -0,0 +1,454 @@
+/**
+ * @file wifi_transport_http.c
+ * @brief HTTP upload transport (default)
+ *
+ * POSTs every upload to the configured server_url over one kept-alive
+ * connection. The body is streamed from a wifi_payload emitter straight
+ * into the socket. Batches use the binary encoding when WIFI_PAYLOAD_FORMAT
+ * selects it, falling back to JSON if the server answers 415 Unsupported
+ * Media Type.
+ *
+ * Every request carries the active configuration version in an
+ * X-Config-Version header. A 2xx response body may push a new
+ * configuration (see device_config.h); it is applied after the upload,
+ * and the outcome of every upload is reported back so that a pushed
+ * server URL is confirmed or rolled back.
+ *
+ * Built only when WIFI_TRANSPORT is WIFI_TRANSPORT_HTTP; see wifi_transport.h.
+ */
+
+#include "wifi_transport.h"
+
+#if WIFI_TRANSPORT == WIFI_TRANSPORT_HTTP
+
+#include "wifi_payload.h"
+#include "telemetry_codec.h"
+#include "device_config.h"
+#include "event_log.h"
+#include "esp_http_client.h"
+#include "esp_log.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char *TAG = "WIFI_HTTP";
+
+/**
+ * @brief Persistent HTTP client shared by all uploads
+ * 
+ * Created on first use with the server URL and JSON headers already set,
+ * then reused for every POST so the TCP connection stays open between
+ * requests (HTTP/1.1 keep-alive). Only the WiFi task touches the handle.
+ * 
+ * The WiFi event handler cannot free the handle while an upload may be
+ * using it, so a disconnect only raises http_client_stale; the next upload
+ * drops the old client and builds a fresh one.
+ */
+static esp_http_client_handle_t http_client = NULL;
+static volatile bool http_client_stale = false;
+
+/**
+ * @brief Server URL the client was created for
+ * 
+ * Refreshed from the configuration whenever its generation changes; a new
+ * URL replaces the client.
+ */
+static char server_url[DEVICE_CONFIG_URL_SIZE];
+static uint32_t server_url_generation = 0;
+
+// Body of the last response, for configuration pushes (WiFi task only)
+static char response_body[HTTP_RESPONSE_MAX_SIZE];
+
+/**
+ * @brief HTTP Client Event Handler for Response Processing
+ * 
+ * Handles HTTP client events during data transmission operations.
+ * Provides detailed logging and error reporting for network communication
+ * debugging and monitoring purposes.
+ * 
+ * Event Types Handled:
+ * - HTTP_EVENT_ERROR: Network or protocol errors during transmission
+ * - HTTP_EVENT_ON_CONNECTED: Successful connection to HTTP server
+ * - HTTP_EVENT_ON_DATA: Server response data reception
+ * - HTTP_EVENT_DISCONNECTED: Clean disconnection from server
+ * 
+ * Logging Strategy:
+ * Uses different log levels based on event importance:
+ * - ERROR level for transmission failures
+ * - DEBUG level for normal protocol events
+ * - INFO level for important status updates
+ * 
+ * Response Data Handling:
+ * Response chunks are only logged here. http_post() reads the body itself
+ * after the status line and hands it to device_config_apply_json().
+ * 
+ * @param evt HTTP client event structure containing event details
+ * @return ESP_OK to continue processing, ESP_FAIL to abort
+ * 
+ * @note This function runs in HTTP client task context
+ * @note Response data logging is limited to avoid excessive output
+ * @see esp_http_client_init() for client configuration details
+ */
+static esp_err_t http_event_handler(esp_http_client_event_t *evt) 
+{
+    switch(evt->event_id) 
+    {
+        case HTTP_EVENT_ERROR:
+            EVENT_LOGE(TAG, "HTTP transmission error occurred");
+            break;
+            
+        case HTTP_EVENT_ON_CONNECTED:
+            ESP_LOGD(TAG, "HTTP connection established to server");
+            break;
+            
+        case HTTP_EVENT_ON_DATA:
+            ESP_LOGD(TAG, "HTTP server response: %.*s", evt->data_len, (char*)evt->data);
+            break;
+            
+        case HTTP_EVENT_DISCONNECTED:
+            ESP_LOGD(TAG, "HTTP connection closed cleanly");
+            break;
+            
+        case HTTP_EVENT_ON_HEADER:
+            ESP_LOGD(TAG, "HTTP header received: %s: %s", evt->header_key, evt->header_value);
+            break;
+            
+        default:
+            ESP_LOGD(TAG, "HTTP event: %d", evt->event_id);
+            break;
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Return the persistent HTTP client, creating it if needed
+ * 
+ * URL parsing and header setup happen once here. Headers set on the handle
+ * are kept across requests, so each upload only attaches its body.
+ * 
+ * @return Client handle, or NULL if the client could not be created
+ */
+static esp_http_client_handle_t http_client_acquire(void)
+{
+    uint32_t generation = device_config_generation();
+    if (generation != server_url_generation || server_url[0] == '\0') 
+    {
+        device_config_t config;
+        device_config_get(&config);
+        server_url_generation = generation;
+        if (strcmp(config.server_url, server_url) != 0) 
+        {
+            if (http_client != NULL) 
+            {
+                EVENT_LOGI(TAG, "Server URL changed - replacing persistent HTTP client");
+                esp_http_client_cleanup(http_client);
+                http_client = NULL;
+            }
+            memcpy(server_url, config.server_url, sizeof(server_url));
+        }
+    }
+    
+    if (http_client_stale) 
+    {
+        http_client_stale = false;
+        if (http_client != NULL) 
+        {
+            EVENT_LOGI(TAG, "WiFi link was lost - discarding persistent HTTP client");
+            esp_http_client_cleanup(http_client);
+            http_client = NULL;
+        }
+    }
+    
+    if (http_client != NULL) 
+    {
+        return http_client;
+    }
+    
+    esp_http_client_config_t config = 
+    {
+        .url = server_url,                   // Target server endpoint
+        .event_handler = http_event_handler, // Response processing callback
+        .timeout_ms = HTTP_TIMEOUT_MS,       // Network timeout configuration
+        .method = HTTP_METHOD_POST,          // POST method for data submission
+        .keep_alive_enable = true,           // TCP keep-alive probes on the idle connection
+        .keep_alive_idle = HTTP_KEEPALIVE_IDLE_S,
+        .keep_alive_interval = HTTP_KEEPALIVE_INTERVAL_S,
+        .keep_alive_count = HTTP_KEEPALIVE_COUNT,
+    };
+    
+    http_client = esp_http_client_init(&config);
+    if (http_client == NULL) 
+    {
+        ESP_LOGE(TAG, "Failed to initialize HTTP client - insufficient memory or invalid config");
+        return NULL;
+    }
+    
+    esp_http_client_set_header(http_client, "Content-Type", "application/json");
+    esp_http_client_set_header(http_client, "User-Agent", "ESP32-SensorMonitor/1.0");
+    esp_http_client_set_header(http_client, "Accept", "application/json");
+    esp_http_client_set_header(http_client, "Connection", "keep-alive");
+    ESP_LOGI(TAG, "✓ Persistent HTTP client created for %s", server_url);
+    
+    return http_client;
+}
+
+static esp_err_t http_client_sink(void *ctx, const char *data, size_t length)
+{
+    int written = esp_http_client_write((esp_http_client_handle_t)ctx, data, (int)length);
+    return (written == (int)length) ? ESP_OK : ESP_ERR_HTTP_WRITE_DATA;
+}
+
+/**
+ * @brief Send one request on the open client and read the response headers
+ * 
+ * @param body_sent Set once the whole body was written; from then on the
+ *                  server may have processed the request
+ * 
+ * @return ESP_OK once the response headers have arrived
+ * @return Connection, write or header error otherwise
+ */
+static esp_err_t http_exchange(esp_http_client_handle_t client, wifi_payload_emitter_t emit,
+                               const void *payload, size_t length, bool *body_sent)
+{
+    *body_sent = false;
+    esp_err_t ret = esp_http_client_open(client, (int)length);
+    if (ret != ESP_OK) 
+    {
+        return ret;
+    }
+    
+    char chunk[HTTP_BUFFER_SIZE];
+    json_writer_t writer;
+    json_writer_init_stream(&writer, chunk, sizeof(chunk), http_client_sink, client);
+    emit(&writer, payload);
+    ret = json_writer_finish(&writer);
+    if (ret != ESP_OK) 
+    {
+        return ret;
+    }
+    *body_sent = true;
+    
+    if (esp_http_client_fetch_headers(client) < 0) 
+    {
+        return ESP_ERR_HTTP_FETCH_HEADER;
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief POST a body to the configured server URL
+ * 
+ * Shared by the single-reading and batch senders. Reuses the persistent
+ * client; the TCP connection is opened on the first request and kept open
+ * afterwards. The body is streamed with esp_http_client_write() in
+ * HTTP_BUFFER_SIZE chunks. If writing the request fails because the server
+ * has closed the reused connection, it is retried once on a fresh one.
+ * Once the whole body went out there is no retry, whatever fails next:
+ * the server may already have stored the readings, and sending them again
+ * would store them twice. The caller keeps them for the next pass instead.
+ * A configuration push in a 2xx response is applied before returning.
+ * 
+ * @param emit Produces the body (run once to count, once to send)
+ * @param payload Argument for emit
+ * @param content_type MIME type of the body
+ * 
+ * @return ESP_OK if the server answered with a 2xx status
+ * @return ESP_ERR_NOT_SUPPORTED if the server rejected the content type (415)
+ * @return ESP_FAIL on client creation failure or other non-2xx status
+ * @return Network error code otherwise
+ */
+static esp_err_t http_post(wifi_payload_emitter_t emit, const void *payload, const char *content_type)
+{
+    json_writer_t counter;
+    json_writer_init_counter(&counter);
+    emit(&counter, payload);
+    size_t length = counter.length;
+    
+    esp_http_client_handle_t client = http_client_acquire();
+    if (client == NULL) 
+    {
+        device_config_upload_result(false);     // A pushed URL may not even parse
+        return ESP_FAIL;
+    }
+    
+    char config_version[12];
+    snprintf(config_version, sizeof(config_version), "%lu", (unsigned long)device_config_version());
+    esp_http_client_set_header(client, "Content-Type", content_type);
+    esp_http_client_set_header(client, "X-Config-Version", config_version);
+    
+    // === HTTP REQUEST EXECUTION ===
+    // Stream the body into the connection
+    EVENT_LOG_BANNER(TAG, "Executing HTTP POST request (%u bytes)...", (unsigned)length);
+    bool body_sent;
+    esp_err_t ret = http_exchange(client, emit, payload, length, &body_sent);
+    if (ret != ESP_OK && ret != ESP_ERR_HTTP_CONNECT && !body_sent) 
+    {
+        // The server may have dropped the idle keep-alive connection before
+        // it saw this request; close our end and retry once on a new one
+        EVENT_LOGW(TAG, "HTTP request failed (%s) - retrying on a new connection", esp_err_to_name(ret));
+        esp_http_client_close(client);
+        ret = http_exchange(client, emit, payload, length, &body_sent);
+    }
+    
+    if (ret == ESP_OK) 
+    {
+        // === RESPONSE PROCESSING ===
+        // Analyze server response for transmission success
+        int status_code = esp_http_client_get_status_code(client);
+        int content_length = (int)esp_http_client_get_content_length(client);
+        
+        // Keep the start of the body for a configuration push, then read
+        // the rest to its end so the connection can be reused
+        int body_length = esp_http_client_read_response(client, response_body, sizeof(response_body));
+        esp_http_client_flush_response(client, NULL);
+        
+        EVENT_LOG_BANNER(TAG, "HTTP transmission completed");
+        EVENT_LOG_BANNER(TAG, "Response status: %d", status_code);
+        EVENT_LOG_BANNER(TAG, "Response length: %d bytes", content_length);
+        
+        if (status_code >= 200 && status_code < 300) 
+        {
+            // Success response range (2xx status codes)
+            EVENT_LOG_BANNER(TAG, "========================================");
+            EVENT_LOGI(TAG, "✓ Server accepted upload (HTTP %d, %u bytes)", status_code, (unsigned)length);
+            EVENT_LOG_BANNER(TAG, "========================================");
+            ret = ESP_OK;
+            
+            device_config_upload_result(true);
+            if (body_length > 0) 
+            {
+                esp_err_t applied = device_config_apply_json(response_body, (size_t)body_length);
+                if (applied == ESP_ERR_INVALID_ARG) 
+                {
+                    EVENT_LOGW(TAG, "Configuration push in the response was rejected");
+                }
+            }
+        } 
+        else 
+        {
+            // Server error or client error response
+            EVENT_LOG_BANNER(TAG, "========================================");
+            EVENT_LOGW(TAG, "✗ Server rejected upload (HTTP %d)", status_code);
+            if (status_code >= 400 && status_code < 500) 
+            {
+                EVENT_LOG_BANNER(TAG, "✗ Client Error: Check request format and server configuration");
+            } 
+            else if (status_code >= 500) 
+            {
+                EVENT_LOG_BANNER(TAG, "✗ Server Error: Remote server experiencing issues");
+            }
+            EVENT_LOG_BANNER(TAG, "========================================");
+            ret = (status_code == 415) ? ESP_ERR_NOT_SUPPORTED : ESP_FAIL;
+            device_config_upload_result(false);
+        }
+    } 
+    else 
+    {
+        // === NETWORK ERROR HANDLING ===
+        // Handle network-level transmission failures
+        EVENT_LOG_BANNER(TAG, "========================================");
+        EVENT_LOGE(TAG, "✗ HTTP transmission failed: %s", esp_err_to_name(ret));
+        EVENT_LOG_BANNER(TAG, "✗ Check network connectivity and server availability");
+        EVENT_LOG_BANNER(TAG, "========================================");
+        
+        // Build a fresh client on the next upload instead of reusing this one
+        esp_http_client_cleanup(client);
+        http_client = NULL;
+        device_config_upload_result(false);
+    }
+    
+    return ret;
+}
+
+
+esp_err_t wifi_transport_send_batch(const char *device_id, const sensor_sample_t *samples,
+                                    size_t count)
+{
+#if WIFI_PAYLOAD_FORMAT == WIFI_PAYLOAD_BINARY
+    // Set when the server answers 415; JSON is used until the next reboot
+    static bool binary_rejected = false;
+#endif
+
+    int8_t rssi = wifi_manager_get_rssi();
+
+#if WIFI_PAYLOAD_FORMAT == WIFI_PAYLOAD_BINARY
+    if (!binary_rejected)
+    {
+        esp_err_t ret;
+        uint8_t encoded[TELEMETRY_BINARY_MAX_SIZE(WIFI_BATCH_MAX_SAMPLES)];
+        wifi_payload_raw_t raw = { .data = encoded };
+        ret = telemetry_codec_encode_binary(device_id, rssi, samples, count,
+                                            encoded, sizeof(encoded), &raw.length);
+        if (ret != ESP_OK)
+        {
+            ESP_LOGE(TAG, "Failed to encode batch: %s", esp_err_to_name(ret));
+            return ret;
+        }
+
+        EVENT_LOGI(TAG, "Sending binary batch of %zu readings (%zu bytes)", count, raw.length);
+        ret = http_post(wifi_payload_emit_raw, &raw, TELEMETRY_BINARY_CONTENT_TYPE);
+        if (ret != ESP_ERR_NOT_SUPPORTED)
+        {
+            return ret;
+        }
+        ESP_LOGW(TAG, "Server does not accept %s - falling back to JSON",
+                 TELEMETRY_BINARY_CONTENT_TYPE);
+        binary_rejected = true;
+    }
+#endif
+
+    wifi_payload_batch_t payload = {
+        .device_id = device_id,
+        .samples = samples,
+        .count = count,
+        .rssi = rssi,
+    };
+    EVENT_LOGI(TAG, "Sending batch of %zu readings", count);
+    return http_post(wifi_payload_emit_batch_json, &payload, "application/json");
+}
+
+esp_err_t wifi_transport_init(void)
+{
+    // The client is created on the first upload, once the link is up
+    device_config_t config;
+    device_config_get(&config);
+    ESP_LOGI(TAG, "HTTP transport: %s", config.server_url);
+    return ESP_OK;
+}
+
+void wifi_transport_link_up(void)
+{
+}
+
+void wifi_transport_link_down(void)
+{
+    // Any kept-alive connection died with the link
+    http_client_stale = true;
+}
+
+esp_err_t wifi_transport_send(const sensor_data_t *data)
+{
+    // The document is serialized straight into the HTTP connection
+    wifi_payload_single_t payload = { .data = data, .rssi = wifi_manager_get_rssi() };
+    return http_post(wifi_payload_emit_single_json, &payload, "application/json");
+}
+
+esp_err_t wifi_transport_send_diagnostics(const char *device_id, const perf_report_t *report,
+                                          const event_log_excerpt_t *log)
+{
+    wifi_payload_diagnostics_t payload = {
+        .device_id = device_id,
+        .report = report,
+        .log = log,
+        .rssi = wifi_manager_get_rssi(),
+    };
+    EVENT_LOGI(TAG, "Sending diagnostics record");
+    return http_post(wifi_payload_emit_diagnostics_json, &payload, "application/json");
+}
+
+esp_err_t wifi_transport_flush(uint32_t timeout_ms)
+{
+    // Every request completed synchronously; nothing is in flight
+    return ESP_OK;
+}
+
+#endif // WIFI_TRANSPORT == WIFI_TRANSPORT_HTTP
@@ -0,0 +1,322 @@
+/**
+ * @file wifi_transport_mqtt.c
+ * @brief MQTT upload transport (esp-mqtt)
+ *
+ * Publishes every upload as one QoS 1 message over a persistent session:
+ *
+ *   <MQTT_TOPIC_PREFIX>/<device_id>/telemetry/bin   binary batch (telemetry_codec.h)
+ *   <MQTT_TOPIC_PREFIX>/<device_id>/telemetry/json  JSON batch or single reading
+ *   <MQTT_TOPIC_PREFIX>/<device_id>/status          "online" / "offline", retained
+ *   <MQTT_TOPIC_PREFIX>/<device_id>/diagnostics     perf_monitor record (JSON)
+ *
+ * The broker (mqtt_uri) and device_id come from the runtime configuration
+ * (device_config.h). Both are local-only settings, so the topics are built
+ * once at init.
+ *
+ * The client id is the device id and the session is not cleaned on connect, so
+ * the broker keeps undelivered state across short outages. "offline" is the
+ * Last Will, published by the broker when the keep-alive lapses.
+ *
+ * In-flight window:
+ * A publish is queued in the esp-mqtt outbox and sent by the MQTT task; the
+ * caller does not wait for the PUBACK. Up to MQTT_MAX_INFLIGHT messages may
+ * be unacknowledged at once, tracked with a counting semaphore whose slots
+ * are returned on MQTT_EVENT_PUBLISHED (acknowledged) or MQTT_EVENT_DELETED
+ * (expired from the outbox). A batch upload therefore pipelines several
+ * messages per round trip instead of one request/response each. esp-mqtt
+ * only posts MQTT_EVENT_DELETED with CONFIG_MQTT_REPORT_DELETED_MESSAGES;
+ * without it every expiry would leak a slot and go unreported, so the
+ * build refuses to compile then.
+ *
+ * The outbox is RAM only, so a queued message is not yet delivered. The
+ * WiFi task keeps the readings until wifi_transport_flush() has seen every
+ * slot come back and no MQTT_EVENT_DELETED in between; a lost message fails
+ * the flush and its readings are sent again (at-least-once delivery).
+ *
+ * A publish waits up to MQTT_CONNECT_WAIT_MS for the broker session, which
+ * comes up just after the WiFi link. After that it is refused, so readings
+ * stay in the sample ring (and flash log) exactly as with a failed HTTP POST.
+ *
+ * Built only when WIFI_TRANSPORT is WIFI_TRANSPORT_MQTT; see wifi_transport.h.
+ */
+
+#include "wifi_transport.h"
+
+#if WIFI_TRANSPORT == WIFI_TRANSPORT_MQTT
+
+#include "wifi_payload.h"
+#include "telemetry_codec.h"
+#include "device_config.h"
+#include "event_log.h"
+#include "mqtt_client.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+#include "freertos/task.h"
+#include <stdio.h>
+
+#ifndef CONFIG_MQTT_REPORT_DELETED_MESSAGES
+#error "The MQTT transport needs CONFIG_MQTT_REPORT_DELETED_MESSAGES=y (in-flight slots are returned on MQTT_EVENT_DELETED)"
+#endif
+
+static const char *TAG = "WIFI_MQTT";
+
+#define MQTT_QOS                1
+
+// <prefix>/<device_id>/<longest suffix>
+#define MQTT_TOPIC_SIZE         (sizeof(MQTT_TOPIC_PREFIX) + DEVICE_CONFIG_DEVICE_ID_SIZE + \
+                                 sizeof("/telemetry/json"))
+
+static char topic_status[MQTT_TOPIC_SIZE];
+static char topic_json[MQTT_TOPIC_SIZE];
+static char topic_binary[MQTT_TOPIC_SIZE];
+static char topic_diagnostics[MQTT_TOPIC_SIZE];
+
+// Largest message body: a full JSON batch
+#define MQTT_PAYLOAD_SIZE       WIFI_BATCH_JSON_MAX_SIZE
+
+static esp_mqtt_client_handle_t mqtt_client = NULL;
+static SemaphoreHandle_t inflight_slots = NULL;
+static StaticSemaphore_t inflight_slots_storage;
+static EventGroupHandle_t broker_events = NULL;
+static StaticEventGroup_t broker_events_storage;
+static bool client_started = false;
+static bool message_lost = false;      ///< MQTT_EVENT_DELETED since the last flush, atomic
+
+#define BROKER_CONNECTED_BIT    BIT0
+
+// Message bodies are formatted here; esp-mqtt copies them into its outbox
+static char payload_buffer[MQTT_PAYLOAD_SIZE];
+
+static void mqtt_event_handler(void *arg, esp_event_base_t base, int32_t event_id, void *event_data)
+{
+    esp_mqtt_event_handle_t event = (esp_mqtt_event_handle_t)event_data;
+
+    switch ((esp_mqtt_event_id_t)event_id)
+    {
+        case MQTT_EVENT_CONNECTED:
+            EVENT_LOGI(TAG, "Broker connected (session %s)",
+                       event->session_present ? "resumed" : "new");
+            // Replaces the retained Last Will; QoS 0 so it never takes a window slot
+            esp_mqtt_client_publish(mqtt_client, topic_status, "online", 0, 0, 1);
+            xEventGroupSetBits(broker_events, BROKER_CONNECTED_BIT);
+            break;
+
+        case MQTT_EVENT_DISCONNECTED:
+            // Queued messages stay in the outbox and are resent on reconnect
+            xEventGroupClearBits(broker_events, BROKER_CONNECTED_BIT);
+            EVENT_LOGW(TAG, "Broker disconnected");
+            break;
+
+        case MQTT_EVENT_PUBLISHED:
+            ESP_LOGD(TAG, "PUBACK msg_id=%d", event->msg_id);
+            xSemaphoreGive(inflight_slots);
+            break;
+
+        case MQTT_EVENT_DELETED:
+            // Expired from the outbox before the broker acknowledged it
+            EVENT_LOGW(TAG, "Message %d dropped unacknowledged", event->msg_id);
+            __atomic_store_n(&message_lost, true, __ATOMIC_RELEASE);
+            xSemaphoreGive(inflight_slots);
+            break;
+
+        case MQTT_EVENT_ERROR:
+            EVENT_LOGW(TAG, "MQTT error event");
+            break;
+
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief Queue one QoS 1 message once a window slot is free
+ */
+static esp_err_t publish(const char *topic, const void *data, size_t length)
+{
+    // Right after the WiFi link comes up the MQTT session is still being set up
+    EventBits_t bits = xEventGroupWaitBits(broker_events, BROKER_CONNECTED_BIT, pdFALSE, pdFALSE,
+                                           pdMS_TO_TICKS(MQTT_CONNECT_WAIT_MS));
+    if ((bits & BROKER_CONNECTED_BIT) == 0)
+    {
+        EVENT_LOGW(TAG, "Cannot publish - broker not connected");
+        return ESP_FAIL;
+    }
+
+    if (xSemaphoreTake(inflight_slots, pdMS_TO_TICKS(MQTT_PUBLISH_TIMEOUT_MS)) != pdTRUE)
+    {
+        EVENT_LOGW(TAG, "No PUBACK within %d ms, %d messages in flight",
+                   MQTT_PUBLISH_TIMEOUT_MS, MQTT_MAX_INFLIGHT);
+        return ESP_ERR_TIMEOUT;
+    }
+
+    int msg_id = esp_mqtt_client_enqueue(mqtt_client, topic, (const char *)data, (int)length,
+                                         MQTT_QOS, 0, true);
+    if (msg_id < 0)
+    {
+        xSemaphoreGive(inflight_slots);
+        EVENT_LOGE(TAG, "Failed to queue %u bytes for %s", (unsigned)length, topic);
+        return ESP_FAIL;
+    }
+
+    EVENT_LOGI(TAG, "Queued msg_id=%d, %u bytes -> %s", msg_id, (unsigned)length, topic);
+    return ESP_OK;
+}
+
+/**
+ * @brief Run a JSON emitter into payload_buffer and publish the result
+ */
+static esp_err_t publish_json(const char *topic, wifi_payload_emitter_t emit, const void *payload)
+{
+    json_writer_t writer;
+    json_writer_init_buffer(&writer, payload_buffer, sizeof(payload_buffer));
+    emit(&writer, payload);
+    esp_err_t ret = json_writer_finish(&writer);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "JSON message too long (%u bytes)", (unsigned)writer.length);
+        return ret;
+    }
+    return publish(topic, payload_buffer, writer.length);
+}
+
+esp_err_t wifi_transport_init(void)
+{
+    broker_events = xEventGroupCreateStatic(&broker_events_storage);
+    inflight_slots = xSemaphoreCreateCountingStatic(MQTT_MAX_INFLIGHT, MQTT_MAX_INFLIGHT,
+                                                     &inflight_slots_storage);
+
+    device_config_t device;
+    device_config_get(&device);
+    snprintf(topic_status, sizeof(topic_status), "%s/%s/status", MQTT_TOPIC_PREFIX, device.device_id);
+    snprintf(topic_json, sizeof(topic_json), "%s/%s/telemetry/json", MQTT_TOPIC_PREFIX, device.device_id);
+    snprintf(topic_binary, sizeof(topic_binary), "%s/%s/telemetry/bin", MQTT_TOPIC_PREFIX, device.device_id);
+    snprintf(topic_diagnostics, sizeof(topic_diagnostics), "%s/%s/diagnostics",
+             MQTT_TOPIC_PREFIX, device.device_id);
+
+    // esp-mqtt copies the strings, so the snapshot may go out of scope
+    esp_mqtt_client_config_t config = {
+        .broker.address.uri = device.mqtt_uri,
+        .credentials.client_id = device.device_id,
+        .session = {
+            .disable_clean_session = true,
+            .keepalive = MQTT_KEEPALIVE_S,
+            .last_will = {
+                .topic = topic_status,
+                .msg = "offline",
+                .qos = 1,
+                .retain = 1,
+            },
+        },
+        // Outgoing messages are built in one piece; fit a full JSON batch
+        .buffer.out_size = MQTT_PAYLOAD_SIZE + 128,
+    };
+
+    mqtt_client = esp_mqtt_client_init(&config);
+    if (mqtt_client == NULL)
+    {
+        ESP_LOGE(TAG, "Failed to create MQTT client");
+        return ESP_FAIL;
+    }
+    esp_mqtt_client_register_event(mqtt_client, MQTT_EVENT_ANY, mqtt_event_handler, NULL);
+
+    ESP_LOGI(TAG, "MQTT transport: %s, topic %s/%s/telemetry", device.mqtt_uri,
+             MQTT_TOPIC_PREFIX, device.device_id);
+    return ESP_OK;
+}
+
+void wifi_transport_link_up(void)
+{
+    // Started once; esp-mqtt reconnects on its own after later outages
+    if (!client_started && mqtt_client != NULL)
+    {
+        client_started = (esp_mqtt_client_start(mqtt_client) == ESP_OK);
+    }
+}
+
+void wifi_transport_link_down(void)
+{
+    xEventGroupClearBits(broker_events, BROKER_CONNECTED_BIT);
+}
+
+esp_err_t wifi_transport_send(const sensor_data_t *data)
+{
+    wifi_payload_single_t payload = { .data = data, .rssi = wifi_manager_get_rssi() };
+    return publish_json(topic_json, wifi_payload_emit_single_json, &payload);
+}
+
+esp_err_t wifi_transport_send_batch(const char *device_id, const sensor_sample_t *samples,
+                                    size_t count)
+{
+#if WIFI_PAYLOAD_FORMAT == WIFI_PAYLOAD_BINARY
+    size_t length = 0;
+    esp_err_t ret = telemetry_codec_encode_binary(device_id, wifi_manager_get_rssi(), samples, count,
+                                                  (uint8_t *)payload_buffer, sizeof(payload_buffer),
+                                                  &length);
+    if (ret != ESP_OK)
+    {
+        ESP_LOGE(TAG, "Binary encoding failed: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    return publish(topic_binary, payload_buffer, length);
+#else
+    wifi_payload_batch_t payload = {
+        .device_id = device_id,
+        .samples = samples,
+        .count = count,
+        .rssi = wifi_manager_get_rssi(),
+    };
+    return publish_json(topic_json, wifi_payload_emit_batch_json, &payload);
+#endif
+}
+
+esp_err_t wifi_transport_send_diagnostics(const char *device_id, const perf_report_t *report,
+                                          const event_log_excerpt_t *log)
+{
+    wifi_payload_diagnostics_t payload = {
+        .device_id = device_id,
+        .report = report,
+        .log = log,
+        .rssi = wifi_manager_get_rssi(),
+    };
+    return publish_json(topic_diagnostics, wifi_payload_emit_diagnostics_json, &payload);
+}
+
+esp_err_t wifi_transport_flush(uint32_t timeout_ms)
+{
+    // Every free slot is a message the broker has acknowledged: collect them all
+    TickType_t deadline = xTaskGetTickCount() + pdMS_TO_TICKS(timeout_ms);
+    int taken = 0;
+    while (taken < MQTT_MAX_INFLIGHT)
+    {
+        TickType_t now = xTaskGetTickCount();
+        TickType_t wait = ((int32_t)(deadline - now) > 0) ? deadline - now : 0;
+        if (xSemaphoreTake(inflight_slots, wait) != pdTRUE)
+        {
+            break;
+        }
+        taken++;
+    }
+    for (int i = 0; i < taken; i++)
+    {
+        xSemaphoreGive(inflight_slots);
+    }
+
+    if (taken < MQTT_MAX_INFLIGHT)
+    {
+        EVENT_LOGW(TAG, "%d messages still unacknowledged after %u ms",
+                   MQTT_MAX_INFLIGHT - taken, (unsigned)timeout_ms);
+        return ESP_ERR_TIMEOUT;
+    }
+    // A slot also comes back when a message expires; that one never arrived
+    if (__atomic_exchange_n(&message_lost, false, __ATOMIC_ACQ_REL))
+    {
+        EVENT_LOGW(TAG, "Messages were dropped since the last flush - resending");
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+#endif // WIFI_TRANSPORT == WIFI_TRANSPORT_MQTT
@@ -0,0 +1,560 @@
+#!/usr/bin/env python3
+"""
+Fleet ingest server for ESP32 sensor monitors, plus a load generator.
+
+Serves the same contract as test_server.py, POST /api/sensor-data, in all
+body forms the firmware sends:
+- a single reading (JSON)
+- a JSON batch
+- a binary batch (application/vnd.home-monitor.telemetry.v2, or .v1 from
+  older firmware)
+- a diagnostics record
+
+Unlike test_server.py it stores what it receives and is meant to stay up
+with hundreds of devices.
+
+Usage:
+    python3 ingest_server.py serve [--port 3000] [--data-dir ingest-data] [--fsync]
+        [--config fleet.json] [--firmware-dir firmware
+         --firmware-cert ota_server_cert.pem --firmware-key ota_server_key.pem]
+    python3 ingest_server.py load --url http://HOST:3000/api/sensor-data \\
+        [--devices 200] [--interval 30] [--duration 60] [--batch 3] [--binary]
+
+Storage (all files append-only):
+    <data-dir>/readings.jsonl      one JSON object per reading, in arrival order
+                                   (with the device's "rollup" when it has one)
+    <data-dir>/index/<device>.idx  per-device index, 12 bytes per reading:
+                                   uint32 timestamp, uint64 offset in readings.jsonl
+    <data-dir>/diagnostics.jsonl   perf_monitor records, one per line, with the
+                                   device's warnings and errors in "log"
+
+A single writer thread owns the files. Request threads hand it their
+readings and wait for the append, so a 200 response means the data is
+in the log. Writes from concurrent requests are group-committed: one
+write (and one fsync with --fsync) per wakeup, however many devices
+posted. The index lets a device's history be read without scanning the
+shared log:
+
+    GET /api/devices                                   per-device count and last timestamp
+    GET /api/sensor-data?device_id=ID[&since=T][&limit=N]
+
+Configuration push (--config FILE):
+    FILE holds a device_config object with a "version", e.g.
+    {"version": 3, "transmit_ms": 60000, "temp_deadband": 0.3}. Every 2xx
+    answer to a device whose X-Config-Version header differs carries it as
+    "config". The file is re-read when it changes; bump "version" with
+    every edit.
+
+Firmware (--firmware-dir DIR --firmware-cert CERT --firmware-key KEY):
+    GET /firmware/<name> serves DIR/<name>, a container built by
+    ota_image.py, over HTTPS on --firmware-port (default 3443). Devices
+    only download over HTTPS from a server whose certificate they were
+    built with: copy CERT to ota_server_cert.pem in the project directory
+    before building. Point devices at it by pushing
+    "firmware_url": "https://HOST:3443/firmware/<name>" with --config.
+
+Requirements:
+- Python 3.7+
+- No additional dependencies (uses built-in modules)
+"""
+
+import argparse
+import http.client
+import json
+import os
+import queue
+import random
+import re
+import ssl
+import struct
+import sys
+import threading
+import time
+from datetime import datetime
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, urlsplit
+
+from test_server import (BINARY_CONTENT_TYPE, BINARY_CONTENT_TYPES, BINARY_DELTA_ESCAPE,
+                         decode_binary_batch, get_local_ip)
+
+INDEX_RECORD = struct.Struct('<IQ')
+DEVICE_ID_PATTERN = re.compile(r'^[A-Za-z0-9_.-]{1,64}$')
+FIRMWARE_NAME_PATTERN = re.compile(r'^[A-Za-z0-9_-][A-Za-z0-9_.-]{0,127}$')
+FIRMWARE_CHUNK_BYTES = 16 * 1024
+MAX_BODY_BYTES = 64 * 1024
+QUERY_DEFAULT_LIMIT = 1000
+
+class ReadingStore:
+    """Append-only reading log with per-device offset indexes."""
+
+    def __init__(self, data_dir, fsync=False):
+        self.fsync = fsync
+        self.index_dir = os.path.join(data_dir, 'index')
+        os.makedirs(self.index_dir, exist_ok=True)
+        self.log_path = os.path.join(data_dir, 'readings.jsonl')
+        self.log = open(self.log_path, 'ab')
+        self.diagnostics = open(os.path.join(data_dir, 'diagnostics.jsonl'), 'ab')
+        self.indexes = {}           # device_id -> open index file (writer thread only)
+        self.summary = {}           # device_id -> {"count", "last_timestamp"}
+        self.summary_lock = threading.Lock()
+        self.pending = queue.Queue()
+        self._load_summary()
+        threading.Thread(target=self._writer, name='ingest-writer', daemon=True).start()
+
+    def _index_path(self, device_id):
+        return os.path.join(self.index_dir, device_id + '.idx')
+
+    def _load_summary(self):
+        for name in os.listdir(self.index_dir):
+            if not name.endswith('.idx'):
+                continue
+            path = os.path.join(self.index_dir, name)
+            # Drop a torn last record from a crash mid-append so new records stay aligned
+            count = os.path.getsize(path) // INDEX_RECORD.size
+            os.truncate(path, count * INDEX_RECORD.size)
+            last = None
+            if count:
+                with open(path, 'rb') as index:
+                    index.seek((count - 1) * INDEX_RECORD.size)
+                    last, _ = INDEX_RECORD.unpack(index.read(INDEX_RECORD.size))
+            self.summary[name[:-4]] = {"count": count, "last_timestamp": last}
+
+    def append(self, device_id, rssi, readings, kind='readings'):
+        """Queue readings (or one diagnostics record); True once written."""
+        job = {"done": threading.Event(), "ok": False}
+        self.pending.put((kind, device_id, rssi, readings, job))
+        job["done"].wait()
+        return job["ok"]
+
+    def _writer(self):
+        while True:
+            jobs = [self.pending.get()]
+            while True:
+                try:
+                    jobs.append(self.pending.get_nowait())
+                except queue.Empty:
+                    break
+
+            try:
+                self._commit(jobs)
+                ok = True
+            except OSError as error:
+                # Disk full or similar: the devices keep their data and retry
+                print(f"[ERROR] Write failed: {error}", file=sys.stderr)
+                ok = False
+            for *_, job in jobs:
+                job["ok"] = ok
+                job["done"].set()
+
+    def _commit(self, jobs):
+        touched = set()
+        for kind, device_id, rssi, readings, _ in jobs:
+            if kind == 'diagnostics':
+                self.diagnostics.write(json.dumps(readings).encode() + b'\n')
+                continue
+            for reading in readings:
+                self._write_reading(device_id, rssi, reading)
+            touched.add(device_id)
+
+        # Log before index: an index entry never points past the log
+        self.log.flush()
+        self.diagnostics.flush()
+        if self.fsync:
+            os.fsync(self.log.fileno())
+        for device_id in touched:
+            self.indexes[device_id].flush()
+            if self.fsync:
+                os.fsync(self.indexes[device_id].fileno())
+
+    def _write_reading(self, device_id, rssi, reading):
+        received_at = int(time.time())
+        timestamp = int(reading.get('timestamp', received_at))
+        record = {
+            "device_id": device_id,
+            "timestamp": timestamp,
+            "temperature": reading.get('temperature'),
+            "humidity": reading.get('humidity'),
+            "rssi": rssi,
+            "received_at": received_at,
+        }
+        if isinstance(reading.get('rollup'), dict):
+            record["rollup"] = reading['rollup']
+        offset = self.log.tell()
+        self.log.write(json.dumps(record, separators=(',', ':')).encode() + b'\n')
+
+        index = self.indexes.get(device_id)
+        if index is None:
+            index = self.indexes[device_id] = open(self._index_path(device_id), 'ab')
+        index.write(INDEX_RECORD.pack(timestamp & 0xFFFFFFFF, offset))
+
+        with self.summary_lock:
+            entry = self.summary.setdefault(device_id, {"count": 0, "last_timestamp": None})
+            entry["count"] += 1
+            entry["last_timestamp"] = timestamp
+
+    def devices(self):
+        with self.summary_lock:
+            return {device: dict(entry) for device, entry in self.summary.items()}
+
+    def query(self, device_id, since=0, limit=QUERY_DEFAULT_LIMIT):
+        """Readings of one device with timestamp >= since, oldest first."""
+        path = self._index_path(device_id)
+        if not os.path.exists(path):
+            return []
+        results = []
+        with open(path, 'rb') as index, open(self.log_path, 'rb') as log:
+            while len(results) < limit:
+                raw = index.read(INDEX_RECORD.size)
+                if len(raw) < INDEX_RECORD.size:
+                    break
+                timestamp, offset = INDEX_RECORD.unpack(raw)
+                if timestamp < since:
+                    continue
+                log.seek(offset)
+                try:
+                    results.append(json.loads(log.readline()))
+                except ValueError:
+                    continue    # Line torn by a crash; its index entry outlived it
+        return results
+
+class FleetConfig:
+    """The --config file, re-read whenever its mtime changes."""
+
+    def __init__(self, path):
+        self.path = path
+        self.lock = threading.Lock()
+        self.mtime = None
+        self.config = None
+
+    def current(self):
+        try:
+            mtime = os.stat(self.path).st_mtime
+        except OSError:
+            return self.config
+        with self.lock:
+            if mtime != self.mtime:
+                self.mtime = mtime
+                try:
+                    with open(self.path) as config_file:
+                        config = json.load(config_file)
+                    if not isinstance(config, dict) or not isinstance(config.get('version'), int):
+                        raise ValueError('"version" must be an integer')
+                    self.config = config
+                    print(f"Pushing config version {config['version']} from {self.path}")
+                except (OSError, ValueError) as error:
+                    # Keep pushing the last good version
+                    print(f"Ignoring {self.path}: {error}")
+            return self.config
+
+class IngestHandler(BaseHTTPRequestHandler):
+    # HTTP/1.1 keeps the ESP32's connection open between uploads; every
+    # response therefore carries a Content-Length
+    protocol_version = 'HTTP/1.1'
+    store = None
+    fleet_config = None
+    firmware_dir = None
+    verbose = False
+
+    def send_json(self, status, document):
+        if 200 <= status < 300 and self.fleet_config is not None:
+            config = self.fleet_config.current()
+            if config is not None and self.headers.get('X-Config-Version') != str(config['version']):
+                document = dict(document, config=config)
+        body = json.dumps(document).encode()
+        self.send_response(status)
+        self.send_header('Content-Type', 'application/json')
+        self.send_header('Content-Length', str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
+    def parse_body(self):
+        length = int(self.headers.get('Content-Length', 0))
+        if length <= 0 or length > MAX_BODY_BYTES:
+            raise ValueError(f"unsupported Content-Length {length}")
+        body = self.rfile.read(length)
+        content_type = self.headers.get('Content-Type', 'application/json').split(';')[0].strip()
+        if content_type in BINARY_CONTENT_TYPES:
+            return decode_binary_batch(body)
+        if content_type != 'application/json':
+            return None
+        document = json.loads(body.decode('utf-8'))
+        if not isinstance(document, dict):
+            raise ValueError("body is not a JSON object")
+        return document
+
+    def do_POST(self):
+        if urlsplit(self.path).path != '/api/sensor-data':
+            self.send_json(404, {"status": "error", "message": "Endpoint not found"})
+            return
+        try:
+            document = self.parse_body()
+        except (ValueError, struct.error, UnicodeDecodeError) as error:
+            self.send_json(400, {"status": "error", "message": f"Invalid payload: {error}"})
+            return
+        if document is None:
+            # The firmware falls back from binary to JSON on 415
+            self.send_json(415, {"status": "error", "message": "Unsupported Content-Type"})
+            return
+
+        device_id = str(document.get('device_id', ''))
+        if not DEVICE_ID_PATTERN.match(device_id):
+            self.send_json(400, {"status": "error", "message": "Missing or invalid device_id"})
+            return
+        rssi = document.get('rssi')
+
+        if 'diagnostics' in document:
+            if not self.store.append(device_id, rssi, document, kind='diagnostics'):
+                self.send_json(503, {"status": "error", "message": "Storage unavailable"})
+                return
+            if self.verbose:
+                for record in document.get('log', []):
+                    print(f"[{datetime.now():%H:%M:%S}] {device_id}: {record.get('level')} "
+                          f"({record.get('ms')}) {record.get('tag')}: {record.get('msg')}")
+            self.send_json(200, {"status": "success", "message": "Diagnostics stored"})
+            return
+
+        # Batch form carries "readings"; the single form is itself the reading
+        readings = document.get('readings')
+        if readings is None:
+            readings = [document]
+        if not isinstance(readings, list) or not all(
+                isinstance(r, dict) and isinstance(r.get('timestamp', 0), (int, float))
+                for r in readings):
+            self.send_json(400, {"status": "error", "message": "Invalid readings"})
+            return
+
+        if not self.store.append(device_id, rssi, readings):
+            # Not 2xx, so the firmware keeps the readings buffered
+            self.send_json(503, {"status": "error", "message": "Storage unavailable"})
+            return
+        if self.verbose:
+            print(f"[{datetime.now():%H:%M:%S}] {device_id}: {len(readings)} reading(s)")
+        self.send_json(200, {"status": "success", "message": "Data received successfully",
+                             "readings_accepted": len(readings)})
+
+    def send_firmware(self, name):
+        if self.firmware_dir is None or not FIRMWARE_NAME_PATTERN.match(name):
+            self.send_json(404, {"status": "error", "message": "Firmware not found"})
+            return
+        try:
+            image = open(os.path.join(self.firmware_dir, name), 'rb')
+        except OSError:
+            self.send_json(404, {"status": "error", "message": "Firmware not found"})
+            return
+        with image:
+            size = os.fstat(image.fileno()).st_size
+            self.send_response(200)
+            self.send_header('Content-Type', 'application/octet-stream')
+            self.send_header('Content-Length', str(size))
+            self.end_headers()
+            # Devices throttle their reads, so this blocks on the socket
+            # rather than buffering the image
+            while True:
+                chunk = image.read(FIRMWARE_CHUNK_BYTES)
+                if not chunk:
+                    break
+                self.wfile.write(chunk)
+        if self.verbose:
+            print(f"[{datetime.now():%H:%M:%S}] firmware {name} sent ({size} bytes)")
+
+    def do_GET(self):
+        url = urlsplit(self.path)
+        params = parse_qs(url.query)
+        if url.path.startswith('/firmware/'):
+            self.send_firmware(url.path[len('/firmware/'):])
+        elif url.path == '/api/devices':
+            self.send_json(200, self.store.devices())
+        elif url.path == '/api/sensor-data':
+            device_id = params.get('device_id', [''])[0]
+            if not DEVICE_ID_PATTERN.match(device_id):
+                self.send_json(400, {"status": "error", "message": "device_id required"})
+                return
+            try:
+                since = int(params.get('since', ['0'])[0])
+                limit = min(int(params.get('limit', [QUERY_DEFAULT_LIMIT])[0]), 100000)
+            except ValueError:
+                self.send_json(400, {"status": "error", "message": "since/limit must be integers"})
+                return
+            self.send_json(200, {"device_id": device_id,
+                                 "readings": self.store.query(device_id, since, limit)})
+        else:
+            self.send_json(404, {"status": "error", "message": "Endpoint not found"})
+
+    def log_message(self, format, *args):
+        # Per-request logging does not scale to a fleet; see --verbose
+        pass
+
+class FirmwareHandler(IngestHandler):
+    """IngestHandler on the TLS port, the only one that serves /firmware/."""
+    pass
+
+class IngestServer(ThreadingHTTPServer):
+    # One thread per kept-alive connection; devices hold theirs open
+    daemon_threads = True
+    allow_reuse_address = True
+    request_queue_size = 128
+
+def serve(args):
+    IngestHandler.store = ReadingStore(args.data_dir, fsync=args.fsync)
+    IngestHandler.verbose = args.verbose
+    if args.config:
+        IngestHandler.fleet_config = FleetConfig(args.config)
+        IngestHandler.fleet_config.current()
+    local_ip = get_local_ip()
+    if args.firmware_dir:
+        # Uploads are answered on this port too
+        FirmwareHandler.firmware_dir = args.firmware_dir
+        context = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+        context.load_cert_chain(args.firmware_cert, args.firmware_key)
+        firmware_server = IngestServer(("", args.firmware_port), FirmwareHandler)
+        firmware_server.socket = context.wrap_socket(firmware_server.socket, server_side=True)
+        threading.Thread(target=firmware_server.serve_forever, daemon=True).start()
+    print("=" * 60)
+    print("ESP32 Sensor Fleet Ingest Server")
+    print("=" * 60)
+    print(f"Listening on {local_ip}:{args.port}, storing in {os.path.abspath(args.data_dir)}")
+    print(f"{len(IngestHandler.store.devices())} devices already on record")
+    print(f'server_url,data,string,http://{local_ip}:{args.port}/api/sensor-data')
+    if args.firmware_dir:
+        print(f"Firmware from {os.path.abspath(args.firmware_dir)} at "
+              f"https://{local_ip}:{args.firmware_port}/firmware/<name>")
+    print("=" * 60)
+    try:
+        with IngestServer(("", args.port), IngestHandler) as httpd:
+            httpd.serve_forever()
+    except KeyboardInterrupt:
+        print("\nServer stopped by user")
+    return 0
+
+def encode_binary_batch(device_id, rssi, readings):
+    """Binary batch as produced by telemetry_codec_encode_binary()."""
+    encoded_id = device_id.encode('ascii')
+    body = struct.pack('<2sBBbB', b'HM', 2, len(readings), rssi, len(encoded_id)) + encoded_id
+    previous = readings[0]['timestamp']
+    body += struct.pack('<I', previous)
+    for reading in readings:
+        delta = reading['timestamp'] - previous
+        temperature = round(reading['temperature'] * 100)
+        humidity = round(reading['humidity'] * 100)
+        rollup = reading.get('rollup')
+        count = rollup['count'] if rollup else 0
+        escaped = not 0 <= delta < BINARY_DELTA_ESCAPE
+        body += struct.pack('<HhHH', BINARY_DELTA_ESCAPE if escaped else delta,
+                            temperature, humidity, count)
+        if escaped:
+            body += struct.pack('<I', reading['timestamp'])
+        if count > 1:
+            t, h = rollup['temperature'], rollup['humidity']
+            body += struct.pack('<hhhHHH', *(round(v * 100) for v in (
+                t['min'], t['max'], t['mean'], h['min'], h['max'], h['mean'])))
+        previous = reading['timestamp']
+    return body
+
+def simulate_device(number, args, deadline, stats, lock):
+    """One simulated monitor posting every interval over a kept-alive connection."""
+    url = urlsplit(args.url)
+    device_id = f"LOAD_{number:04d}"
+    connection = None
+    next_post = time.monotonic() + random.uniform(0, args.interval)   # Spread the fleet out
+    while True:
+        now = time.monotonic()
+        if next_post >= deadline:
+            break
+        if next_post > now:
+            time.sleep(next_post - now)
+        next_post += args.interval
+
+        wall = int(time.time())
+        readings = [{"timestamp": wall - 10 * (args.batch - 1 - i),
+                     "temperature": round(random.uniform(18, 26), 1),
+                     "humidity": float(random.randint(30, 70))} for i in range(args.batch)]
+        if args.binary:
+            body = encode_binary_batch(device_id, -60, readings)
+            content_type = BINARY_CONTENT_TYPE
+        else:
+            body = json.dumps({"device_id": device_id, "rssi": -60, "readings": readings}).encode()
+            content_type = 'application/json'
+
+        started = time.monotonic()
+        ok = False
+        try:
+            if connection is None:
+                connection = http.client.HTTPConnection(url.hostname, url.port or 80, timeout=10)
+            connection.request('POST', url.path, body, {'Content-Type': content_type})
+            response = connection.getresponse()
+            response.read()
+            ok = 200 <= response.status < 300
+        except (OSError, http.client.HTTPException):
+            if connection is not None:
+                connection.close()
+            connection = None   # Reconnect on the next post, as the firmware does
+        with lock:
+            stats['latencies'].append(time.monotonic() - started)
+            stats['ok' if ok else 'failed'] += 1
+    if connection is not None:
+        connection.close()
+
+def load(args):
+    stats = {'ok': 0, 'failed': 0, 'latencies': []}
+    lock = threading.Lock()
+    started = time.monotonic()
+    deadline = started + args.duration
+    threads = [threading.Thread(target=simulate_device, args=(n, args, deadline, stats, lock),
+                                daemon=True) for n in range(args.devices)]
+    print(f"Simulating {args.devices} devices, one {args.batch}-reading "
+          f"{'binary' if args.binary else 'JSON'} batch every {args.interval}s, "
+          f"for {args.duration}s -> {args.url}")
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+
+    elapsed = time.monotonic() - started
+    latencies = sorted(stats['latencies'])
+    total = len(latencies)
+    if total == 0:
+        print("No requests were sent (duration shorter than the interval spread?)")
+        return 1
+
+    def percentile(p):
+        return latencies[min(total - 1, int(total * p))] * 1000
+
+    print(f"{total} requests in {elapsed:.1f}s ({total / elapsed:.1f} req/s, "
+          f"{total * args.batch / elapsed:.1f} readings/s), {stats['failed']} failed")
+    print(f"latency ms: p50 {percentile(0.50):.1f}  p95 {percentile(0.95):.1f}  "
+          f"p99 {percentile(0.99):.1f}  max {latencies[-1] * 1000:.1f}")
+    return 1 if stats['failed'] else 0
+
+def main():
+    parser = argparse.ArgumentParser(description="ESP32 sensor fleet ingest server")
+    commands = parser.add_subparsers(dest='command', required=True)
+
+    serve_parser = commands.add_parser('serve', help='run the ingest server')
+    serve_parser.add_argument('--port', type=int, default=3000)
+    serve_parser.add_argument('--data-dir', default='ingest-data')
+    serve_parser.add_argument('--fsync', action='store_true',
+                              help='fsync every group commit before answering')
+    serve_parser.add_argument('--verbose', action='store_true', help='log every upload')
+    serve_parser.add_argument('--config', help='device_config JSON pushed to every device')
+    serve_parser.add_argument('--firmware-dir', help='serve ota_image.py containers at /firmware/')
+    serve_parser.add_argument('--firmware-cert', help='TLS certificate for --firmware-dir (PEM), '
+                              'also built into the firmware as ota_server_cert.pem')
+    serve_parser.add_argument('--firmware-key', help='private key of --firmware-cert (PEM)')
+    serve_parser.add_argument('--firmware-port', type=int, default=3443)
+
+    load_parser = commands.add_parser('load', help='simulate a fleet of monitors')
+    load_parser.add_argument('--url', default='http://localhost:3000/api/sensor-data')
+    load_parser.add_argument('--devices', type=int, default=200)
+    load_parser.add_argument('--interval', type=float, default=30.0,
+                             help='seconds between uploads of one device')
+    load_parser.add_argument('--duration', type=float, default=60.0)
+    load_parser.add_argument('--batch', type=int, default=3, help='readings per upload')
+    load_parser.add_argument('--binary', action='store_true', help='send binary batches')
+
+    args = parser.parse_args()
+    if args.command == 'serve' and args.firmware_dir and not (args.firmware_cert and args.firmware_key):
+        parser.error('--firmware-dir needs --firmware-cert and --firmware-key: devices only update over HTTPS')
+    return serve(args) if args.command == 'serve' else load(args)
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,235 @@
+#!/usr/bin/env python3
+"""
+Build firmware containers for ota_manager (components/ota_manager/ota_image.h).
+
+A container is an 80-byte header followed by a zlib stream. A full image
+carries the application binary; a delta carries the operations that turn
+the firmware a unit runs now into the new one, usually a small fraction
+of the full image:
+
+    python3 ota_image.py pack build/home-monitor.bin -o firmware/v3.hmota
+    python3 ota_image.py delta --base v2.bin build/home-monitor.bin -o firmware/v2-v3.hmota
+    python3 ota_image.py info firmware/v2-v3.hmota
+    python3 ota_image.py apply firmware/v2-v3.hmota --base v2.bin -o check.bin
+
+"apply" rebuilds the image exactly like the device does and checks its
+digest, so a delta can be verified before it is published. Keep the .bin
+of every released build: it is the base of the next delta.
+
+A unit only installs a delta built for the image it runs (the header
+carries both digests) and ignores it otherwise, so publish a full image
+for units that may be further behind.
+
+Requirements: Python 3.6+, no additional dependencies.
+"""
+
+import argparse
+import hashlib
+import struct
+import sys
+import zlib
+
+MAGIC = 0x544F4D48              # "HMOT"
+FORMAT = 1
+KIND_FULL = 0
+KIND_DELTA = 1
+HEADER = struct.Struct('<IBBHII32s32s')
+
+OP_END = 0x00
+OP_COPY = 0x01
+OP_ADD = 0x02
+OP_INSERT = 0x03
+
+ESP_IMAGE_MAGIC = 0xE9
+ESP_IMAGE_HASH_APPENDED = 23    # esp_image_header_t.hash_appended
+BLOCK = 16                      # Bytes that must match exactly to anchor a delta operation
+GIVE_UP = 256                   # Bytes past the best ADD length before the extension stops
+
+def image_digest(image):
+    """The SHA-256 esp_partition_get_sha256() reports for this image in an app slot."""
+    if len(image) < 24 or image[0] != ESP_IMAGE_MAGIC:
+        raise ValueError('not an ESP-IDF application image')
+    if image[ESP_IMAGE_HASH_APPENDED] == 1:
+        return image[-32:]
+    return hashlib.sha256(image).digest()
+
+def extend(new, base, i, j):
+    """Length of new[i:] to cover with base[j:], allowing up to half the bytes to differ."""
+    limit = min(len(new) - i, len(base) - j)
+    matched = score = best_score = best = 0
+    for k in range(limit):
+        if new[i + k] == base[j + k]:
+            matched += 1
+        score = 2 * matched - (k + 1)
+        if score > best_score:
+            best_score, best = score, k + 1
+        elif k + 1 - best > GIVE_UP:
+            break
+    return best
+
+def diff(base, new):
+    """Delta operations (bytes, without END) that rebuild new from base."""
+    index = {}
+    for j in range(0, len(base) - BLOCK + 1, 4):
+        index.setdefault(base[j:j + BLOCK], j)
+
+    ops = bytearray()
+    def insert(start, end):
+        if end > start:
+            ops.extend(struct.pack('<BI', OP_INSERT, end - start))
+            ops.extend(new[start:end])
+
+    pending = i = 0
+    while i <= len(new) - BLOCK:
+        j = index.get(new[i:i + BLOCK])
+        if j is None:
+            i += 1
+            continue
+        n = extend(new, base, i, j)
+        insert(pending, i)
+        if new[i:i + n] == base[j:j + n]:
+            ops.extend(struct.pack('<BII', OP_COPY, j, n))
+        else:
+            ops.extend(struct.pack('<BII', OP_ADD, j, n))
+            ops.extend((a - b) & 0xFF for a, b in zip(new[i:i + n], base[j:j + n]))
+        i += n
+        pending = i
+    insert(pending, len(new))
+    return bytes(ops)
+
+def patch(base, ops):
+    """Apply delta operations; the reference for the device's decoder."""
+    out = bytearray()
+    pos = 0
+    while True:
+        op = ops[pos]
+        if op == OP_END:
+            if pos + 1 != len(ops):
+                raise ValueError('data after END')
+            return bytes(out)
+        if op in (OP_COPY, OP_ADD):
+            offset, length = struct.unpack_from('<II', ops, pos + 1)
+            pos += 9
+            if offset + length > len(base):
+                raise ValueError(f'base range 0x{offset:x}+{length} out of bounds')
+            chunk = base[offset:offset + length]
+            if op == OP_ADD:
+                chunk = bytes((a + b) & 0xFF for a, b in zip(chunk, ops[pos:pos + length]))
+                pos += length
+            out.extend(chunk)
+        elif op == OP_INSERT:
+            (length,) = struct.unpack_from('<I', ops, pos + 1)
+            pos += 5
+            out.extend(ops[pos:pos + length])
+            pos += length
+        else:
+            raise ValueError(f'unknown operation 0x{op:02x}')
+
+def container(kind, image, payload, base_digest=bytes(32)):
+    stream = zlib.compress(payload, 9)
+    header = HEADER.pack(MAGIC, FORMAT, kind, 0, len(image), len(stream),
+                         image_digest(image), base_digest)
+    return header + stream
+
+def parse(data):
+    if len(data) < HEADER.size:
+        raise ValueError('shorter than a container header')
+    magic, fmt, kind, _, image_size, payload_size, target, base = HEADER.unpack_from(data)
+    if magic != MAGIC or fmt != FORMAT or kind not in (KIND_FULL, KIND_DELTA):
+        raise ValueError('not a firmware container')
+    if len(data) != HEADER.size + payload_size:
+        raise ValueError(f'payload is {len(data) - HEADER.size} bytes, header says {payload_size}')
+    return kind, image_size, target, base, data[HEADER.size:]
+
+def read(path):
+    with open(path, 'rb') as f:
+        return f.read()
+
+def write(path, data):
+    with open(path, 'wb') as f:
+        f.write(data)
+
+def cmd_pack(args):
+    image = read(args.image)
+    out = container(KIND_FULL, image, image)
+    write(args.output, out)
+    print(f'{args.output}: full image, {len(image)} bytes -> {len(out)} '
+          f'({100 * len(out) / len(image):.0f}%)')
+    return 0
+
+def cmd_delta(args):
+    base = read(args.base)
+    image = read(args.image)
+    ops = diff(base, image) + bytes([OP_END])
+    if patch(base, ops) != image:
+        print('internal error: delta does not rebuild the image', file=sys.stderr)
+        return 1
+    out = container(KIND_DELTA, image, ops, image_digest(base))
+    write(args.output, out)
+    full = len(zlib.compress(image, 9)) + HEADER.size
+    print(f'{args.output}: delta from {args.base}, {len(image)} bytes -> {len(out)} '
+          f'({100 * len(out) / len(image):.0f}%, full container {full})')
+    return 0
+
+def cmd_info(args):
+    kind, image_size, target, base, stream = parse(read(args.container))
+    print(f'kind:     {"delta" if kind == KIND_DELTA else "full"}')
+    print(f'image:    {image_size} bytes, sha256 {target.hex()}')
+    print(f'payload:  {len(stream)} bytes')
+    if kind == KIND_DELTA:
+        print(f'base:     sha256 {base.hex()}')
+    return 0
+
+def cmd_apply(args):
+    kind, image_size, target, base_digest, stream = parse(read(args.container))
+    payload = zlib.decompress(stream)
+    if kind == KIND_DELTA:
+        if not args.base:
+            print('a delta needs --base', file=sys.stderr)
+            return 1
+        base = read(args.base)
+        if image_digest(base) != base_digest:
+            print(f'{args.base} is not the base of this delta', file=sys.stderr)
+            return 1
+        image = patch(base, payload)
+    else:
+        image = payload
+    if len(image) != image_size or image_digest(image) != target:
+        print('rebuilt image does not match the header', file=sys.stderr)
+        return 1
+    if args.output:
+        write(args.output, image)
+    print(f'OK: {len(image)} bytes, sha256 {target.hex()}')
+    return 0
+
+def main():
+    parser = argparse.ArgumentParser(description="Firmware containers for ota_manager")
+    commands = parser.add_subparsers(dest='command', required=True)
+
+    pack_parser = commands.add_parser('pack', help='compressed full image')
+    pack_parser.add_argument('image', help='application .bin from the build')
+    pack_parser.add_argument('-o', '--output', required=True)
+
+    delta_parser = commands.add_parser('delta', help='compressed delta against a released image')
+    delta_parser.add_argument('--base', required=True, help='.bin the units run now')
+    delta_parser.add_argument('image', help='application .bin from the build')
+    delta_parser.add_argument('-o', '--output', required=True)
+
+    info_parser = commands.add_parser('info', help='show a container header')
+    info_parser.add_argument('container')
+
+    apply_parser = commands.add_parser('apply', help='rebuild and verify an image')
+    apply_parser.add_argument('container')
+    apply_parser.add_argument('--base', help='base .bin for a delta')
+    apply_parser.add_argument('-o', '--output', help='write the rebuilt .bin')
+
+    args = parser.parse_args()
+    try:
+        return {'pack': cmd_pack, 'delta': cmd_delta, 'info': cmd_info,
+                'apply': cmd_apply}[args.command](args)
+    except (OSError, ValueError, zlib.error) as error:
+        print(f'error: {error}', file=sys.stderr)
+        return 1
+
+if __name__ == '__main__':
+    sys.exit(main())
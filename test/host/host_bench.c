@@ -0,0 +1,502 @@
+/**
+ * @file host_bench.c
+ * @brief Host benchmarks of the hardware-independent modules
+ *
+ * The same sources as the firmware, compiled for the build machine
+ * against the stand-ins in stubs/ and a counting ST7789 transport
+ * (mock_st7789_transport.h). Each benchmark checks its results and prints
+ * one line in the format of the on-device benchmarks (benchmark.h), so
+ * two host runs compare with bench_compare.py:
+ *
+ *   BENCH {"build":"1a2b3c4d","name":"dht11_decode","iterations":20000,
+ *          "per_op_ns":41,"throughput":24390243,"unit":"frames/s","failures":0}
+ *
+ * "build" is the git commit the harness was configured at. The exit status
+ * is 1 if any benchmark produced wrong results, so ctest doubles as a unit
+ * test of the decoders and encoders.
+ */
+
+#include "st7789.h"
+#include "mock_st7789_transport.h"
+#include "dht11_capture.h"
+#include "wifi_payload.h"
+#include "telemetry_codec.h"
+#include "sample_aggregator.h"
+#include "ota_image.h"
+#include "esp_timer.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+
+#ifndef HOST_BENCH_BUILD_ID
+#define HOST_BENCH_BUILD_ID     "host"
+#endif
+
+#define BENCH_DEVICE_ID         "HOME_MONITOR_BENCH"
+
+static uint32_t total_failures = 0;
+
+/**
+ * @brief Print one result line, see benchmark.c
+ */
+static void report(const char *name, uint32_t iterations, int64_t total_us,
+                   uint32_t work_per_op, const char *unit, uint32_t failures)
+{
+    if (total_us <= 0)
+    {
+        total_us = 1;
+    }
+    uint64_t per_op_ns = (uint64_t)total_us * 1000 / iterations;
+    uint64_t throughput = (uint64_t)work_per_op * iterations * 1000000 / (uint64_t)total_us;
+
+    printf("BENCH {\"build\":\"%s\",\"name\":\"%s\",\"iterations\":%" PRIu32
+           ",\"per_op_ns\":%" PRIu64 ",\"throughput\":%" PRIu64 ",\"unit\":\"%s\""
+           ",\"failures\":%" PRIu32 "}\n",
+           HOST_BENCH_BUILD_ID, name, iterations, per_op_ns, throughput, unit, failures);
+    total_failures += failures;
+}
+
+/*----------------------------------------------------------------------------*/
+/* Display, through the counting transport */
+
+#define BENCH_RECT_SIZE         120
+#define BENCH_STRING            "23.5C"
+#define BENCH_DRAW_ITERATIONS   2000
+#define BENCH_PANEL_ITERATIONS  500
+#define BENCH_SCREEN_PIXELS     (240 * 240)
+
+static uint16_t bench_color(uint32_t i)
+{
+    return (i & 1) ? ST7789_BLUE : ST7789_RED;
+}
+
+static void draw_rect(uint32_t i)
+{
+    st7789_fill_rect(60, 60, BENCH_RECT_SIZE, BENCH_RECT_SIZE, bench_color(i));
+}
+
+static void draw_clear(uint32_t i)
+{
+    st7789_clear_screen(bench_color(i));
+}
+
+static void draw_string(uint32_t i)
+{
+    st7789_draw_large_string(40, 50, BENCH_STRING, bench_color(i), ST7789_BLACK);
+}
+
+static void draw_text_32(uint32_t i)
+{
+    st7789_draw_text(40, 100, BENCH_STRING, ST7789_FONT_32, bench_color(i), ST7789_BLACK);
+}
+
+/**
+ * @brief "<name>" renders only; "<name>_panel" also flushes every iteration
+ *
+ * A panel iteration fails if the transport saw fewer pixels than were drawn.
+ */
+static void bench_display(const char *name, void (*draw)(uint32_t), uint32_t pixels)
+{
+    char panel_name[40];
+
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCH_DRAW_ITERATIONS; i++)
+    {
+        draw(i);
+    }
+    report(name, BENCH_DRAW_ITERATIONS, esp_timer_get_time() - start, pixels, "px/s", 0);
+    st7789_flush();
+
+    uint32_t failures = 0;
+    snprintf(panel_name, sizeof(panel_name), "%s_panel", name);
+    start = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCH_PANEL_ITERATIONS; i++)
+    {
+        mock_st7789_reset();
+        draw(i);
+        st7789_flush();
+        failures += (mock_st7789_stats()->pixels < pixels);
+    }
+    report(panel_name, BENCH_PANEL_ITERATIONS, esp_timer_get_time() - start, pixels, "px/s",
+           failures);
+}
+
+static void bench_displays(void)
+{
+    if (st7789_init() != ESP_OK)
+    {
+        report("st7789_init", 1, 1, 0, "px/s", 1);
+        return;
+    }
+    bench_display("st7789_fill_rect", draw_rect, BENCH_RECT_SIZE * BENCH_RECT_SIZE);
+    bench_display("st7789_clear_screen", draw_clear, BENCH_SCREEN_PIXELS);
+    bench_display("st7789_draw_large_string", draw_string,
+                  (uint32_t)strlen(BENCH_STRING) * ST7789_LARGE_FONT_WIDTH * ST7789_LARGE_FONT_HEIGHT);
+    bench_display("st7789_draw_text_32", draw_text_32,
+                  (uint32_t)strlen(BENCH_STRING) * ST7789_FONT_32_ADVANCE * 32);
+}
+
+/*----------------------------------------------------------------------------*/
+/* DHT11 decode */
+
+#define BENCH_DECODE_ITERATIONS 20000
+
+/**
+ * @brief RMT capture of a frame as the receiver records it, see benchmark.c
+ */
+static size_t build_trace(const uint8_t frame[DHT11_FRAME_BYTES], rmt_symbol_word_t *trace)
+{
+    static const int8_t jitter[] = { 0, 3, -2, 1, -3, 2, -1 };
+    size_t n = 0;
+
+    trace[n++] = (rmt_symbol_word_t) { .level0 = 0, .duration0 = 80, .level1 = 1, .duration1 = 80 };
+    for (int bit = 0; bit < DHT11_FRAME_BITS; bit++)
+    {
+        bool one = (frame[bit / 8] >> (7 - bit % 8)) & 1;
+        uint16_t high = (uint16_t)((one ? 70 : 27) + jitter[bit % sizeof(jitter)]);
+        trace[n++] = (rmt_symbol_word_t) { .level0 = 0, .duration0 = 50, .level1 = 1, .duration1 = high };
+    }
+    trace[n++] = (rmt_symbol_word_t) { .level0 = 0, .duration0 = 50, .level1 = 1, .duration1 = 0 };
+    return n;
+}
+
+static void bench_decode(void)
+{
+    // 55 % RH, 23.5 °C, checksum
+    static const uint8_t frame[DHT11_FRAME_BYTES] = { 0x37, 0x00, 0x17, 0x05, 0x53 };
+    rmt_symbol_word_t trace[DHT11_FRAME_BITS + 2];
+    size_t symbols = build_trace(frame, trace);
+    uint8_t raw[DHT11_FRAME_BYTES];
+    uint32_t failures = 0;
+
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCH_DECODE_ITERATIONS; i++)
+    {
+        if (dht11_capture_decode_symbols(trace, symbols, raw) != ESP_OK ||
+            memcmp(raw, frame, sizeof(raw)) != 0)
+        {
+            failures++;
+        }
+    }
+
+    // A frame cut short must be rejected, not decoded from the acknowledge
+    failures += (dht11_capture_decode_symbols(trace, symbols - 8, raw) == ESP_OK);
+    report("dht11_decode", BENCH_DECODE_ITERATIONS, esp_timer_get_time() - start,
+           1, "frames/s", failures);
+}
+
+/*----------------------------------------------------------------------------*/
+/* Payload encoding */
+
+#define BENCH_ENCODE_ITERATIONS 20000
+
+static sensor_sample_t bench_samples[WIFI_BATCH_MAX_SAMPLES];
+
+static void fill_samples(void)
+{
+    for (int i = 0; i < WIFI_BATCH_MAX_SAMPLES; i++)
+    {
+        bench_samples[i] = (sensor_sample_t) {
+            .timestamp = 1760000000u + (uint32_t)i * 300,
+            .temperature = 21.0f + (float)(i % 7) * 0.5f,
+            .humidity = 40.0f + (float)(i % 5),
+        };
+        // Every other sample stands for a 5-minute window, as the aggregator sends them
+        if (i & 1)
+        {
+            bench_samples[i].rollup = (sample_rollup_t) {
+                .count = 30,
+                .temperature_min = 2050, .temperature_max = 2150, .temperature_mean = 2100,
+                .humidity_min = 3900, .humidity_max = 4400, .humidity_mean = 4120,
+            };
+        }
+    }
+}
+
+static esp_err_t format(char *buffer, size_t size, wifi_payload_emitter_t emit, const void *payload)
+{
+    json_writer_t writer;
+    json_writer_init_buffer(&writer, buffer, size);
+    emit(&writer, payload);
+    return json_writer_finish(&writer);
+}
+
+static void bench_encode(void)
+{
+    static char json[WIFI_BATCH_JSON_MAX_SIZE];
+    static uint8_t binary[TELEMETRY_BINARY_MAX_SIZE(WIFI_BATCH_MAX_SAMPLES)];
+
+    sensor_data_t data = { .temperature = 23.5f, .humidity = 55.0f, .timestamp = 1760000000u };
+    strncpy(data.device_id, BENCH_DEVICE_ID, sizeof(data.device_id) - 1);
+    wifi_payload_single_t single = { .data = &data, .rssi = -60 };
+    uint32_t failures = 0;
+
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCH_ENCODE_ITERATIONS; i++)
+    {
+        failures += (format(json, sizeof(json), wifi_payload_emit_single_json, &single) != ESP_OK);
+    }
+    failures += (strstr(json, "\"temperature\":23.50") == NULL);
+    report("format_json", BENCH_ENCODE_ITERATIONS, esp_timer_get_time() - start,
+           (uint32_t)strlen(json), "B/s", failures);
+
+    wifi_payload_batch_t batch = {
+        .device_id = BENCH_DEVICE_ID,
+        .samples = bench_samples,
+        .count = WIFI_BATCH_MAX_SAMPLES,
+        .rssi = -60,
+    };
+    failures = 0;
+    start = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCH_ENCODE_ITERATIONS / 10; i++)
+    {
+        failures += (format(json, sizeof(json), wifi_payload_emit_batch_json, &batch) != ESP_OK);
+    }
+    failures += (strstr(json, "\"rollup\":{\"count\":30") == NULL);
+    report("format_batch_json", BENCH_ENCODE_ITERATIONS / 10, esp_timer_get_time() - start,
+           WIFI_BATCH_MAX_SAMPLES, "samples/s", failures);
+
+    failures = 0;
+    size_t length = 0;
+    start = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCH_ENCODE_ITERATIONS; i++)
+    {
+        failures += (telemetry_codec_encode_binary(BENCH_DEVICE_ID, -60, bench_samples,
+                                                   WIFI_BATCH_MAX_SAMPLES, binary,
+                                                   sizeof(binary), &length) != ESP_OK);
+    }
+    failures += (memcmp(binary, "HM", 2) != 0 || binary[2] != TELEMETRY_BINARY_VERSION);
+    report("encode_binary_batch", BENCH_ENCODE_ITERATIONS, esp_timer_get_time() - start,
+           WIFI_BATCH_MAX_SAMPLES, "samples/s", failures);
+}
+
+/*----------------------------------------------------------------------------*/
+/* Aggregation */
+
+#define BENCH_AGGREGATE_READINGS    100000
+
+/**
+ * @brief Feed a slowly drifting room through the default deadbands
+ *
+ * Fails unless every reading is accounted for in exactly one report,
+ * the last of them the one sample_aggregator_flush() closes the open
+ * window into.
+ */
+static void bench_aggregate(void)
+{
+    uint32_t accounted = 0;
+    sensor_sample_t report_sample;
+
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCH_AGGREGATE_READINGS; i++)
+    {
+        sensor_sample_t reading = {
+            .timestamp = 1760000000u + i * 10,
+            .temperature = 21.0f + (float)((i / 40) % 8) * 0.1f + (float)(i % 3) * 0.1f,
+            .humidity = 45.0f + (float)((i / 90) % 6),
+        };
+        if (sample_aggregator_add(&reading, &report_sample))
+        {
+            accounted += (report_sample.rollup.count > 1) ? report_sample.rollup.count : 1;
+        }
+    }
+    int64_t elapsed = esp_timer_get_time() - start;
+
+    if (sample_aggregator_flush(&report_sample))
+    {
+        accounted += report_sample.rollup.count;
+    }
+    uint32_t failures = (accounted != BENCH_AGGREGATE_READINGS || sample_aggregator_pending() != 0);
+    report("sample_aggregator_add", BENCH_AGGREGATE_READINGS, elapsed, 1, "readings/s", failures);
+}
+
+/*----------------------------------------------------------------------------*/
+/* Firmware image decoding */
+
+#define BENCH_IMAGE_SIZE        (256 * 1024)
+#define BENCH_IMAGE_ITERATIONS  20
+#define BENCH_IMAGE_PIECE       1460        ///< One TCP segment per feed, as downloaded
+
+typedef struct {
+    const uint8_t *expected;
+    const uint8_t *base;
+    size_t written;
+    bool mismatch;
+} image_check_t;
+
+static esp_err_t check_write(void *ctx, const uint8_t *data, size_t length)
+{
+    image_check_t *check = ctx;
+    if (memcmp(check->expected + check->written, data, length) != 0)
+    {
+        check->mismatch = true;
+    }
+    check->written += length;
+    return ESP_OK;
+}
+
+static esp_err_t check_read_base(void *ctx, uint32_t offset, uint8_t *data, size_t length)
+{
+    image_check_t *check = ctx;
+    memcpy(data, check->base + offset, length);
+    return ESP_OK;
+}
+
+static void put_u32(uint8_t *p, uint32_t value)
+{
+    p[0] = (uint8_t)value;
+    p[1] = (uint8_t)(value >> 8);
+    p[2] = (uint8_t)(value >> 16);
+    p[3] = (uint8_t)(value >> 24);
+}
+
+/**
+ * @brief Build a container the way ota_image.py does: header, then zlib stream
+ */
+static uint8_t *build_container(ota_image_kind_t kind, uint32_t image_size,
+                                const uint8_t *payload, size_t payload_length, size_t *length)
+{
+    uLongf bound = compressBound((uLong)payload_length);
+    uint8_t *container = calloc(1, OTA_IMAGE_HEADER_SIZE + bound);
+    compress2(container + OTA_IMAGE_HEADER_SIZE, &bound, payload, (uLong)payload_length, 9);
+
+    put_u32(&container[0], OTA_IMAGE_MAGIC);
+    container[4] = OTA_IMAGE_FORMAT;
+    container[5] = (uint8_t)kind;
+    put_u32(&container[8], image_size);
+    put_u32(&container[12], (uint32_t)bound);
+    *length = OTA_IMAGE_HEADER_SIZE + bound;
+    return container;
+}
+
+static bool decode_container(const uint8_t *container, size_t length, image_check_t *check,
+                             uint32_t base_size)
+{
+    ota_image_header_t header;
+    ota_image_decoder_t *decoder = NULL;
+    if (ota_image_parse_header(container, length, &header) != ESP_OK)
+    {
+        return false;
+    }
+    ota_image_sink_t sink = {
+        .write = check_write,
+        .read_base = check_read_base,
+        .base_size = base_size,
+        .ctx = check,
+    };
+    if (ota_image_decoder_create(&header, &sink, &decoder) != ESP_OK)
+    {
+        return false;
+    }
+
+    check->written = 0;
+    check->mismatch = false;
+    esp_err_t ret = ESP_OK;
+    for (size_t pos = OTA_IMAGE_HEADER_SIZE; pos < length && ret == ESP_OK; pos += BENCH_IMAGE_PIECE)
+    {
+        size_t n = (length - pos < BENCH_IMAGE_PIECE) ? length - pos : BENCH_IMAGE_PIECE;
+        ret = ota_image_decoder_feed(decoder, container + pos, n);
+    }
+    if (ret == ESP_OK)
+    {
+        ret = ota_image_decoder_finish(decoder);
+    }
+    ota_image_decoder_free(decoder);
+    return ret == ESP_OK && !check->mismatch && check->written == header.image_size;
+}
+
+static void bench_image(const char *name, const uint8_t *container, size_t length,
+                        image_check_t *check, uint32_t base_size)
+{
+    uint32_t failures = 0;
+    int64_t start = esp_timer_get_time();
+    for (uint32_t i = 0; i < BENCH_IMAGE_ITERATIONS; i++)
+    {
+        failures += !decode_container(container, length, check, base_size);
+    }
+    report(name, BENCH_IMAGE_ITERATIONS, esp_timer_get_time() - start, BENCH_IMAGE_SIZE, "B/s",
+           failures);
+}
+
+static void bench_images(void)
+{
+    // Compresses roughly like firmware: repeated instruction patterns and
+    // literal pools between stretches of noise
+    uint8_t *base = malloc(BENCH_IMAGE_SIZE);
+    uint32_t seed = 12345;
+    for (size_t i = 0; i < BENCH_IMAGE_SIZE; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        base[i] = ((i / 64) % 4 == 0) ? (uint8_t)(seed >> 16) : (uint8_t)(i * 7 % 61);
+    }
+
+    // The new image: first half unchanged, 512 bytes inserted, then the
+    // second half with every 97th byte shifted by one (relocated addresses)
+    const size_t half = BENCH_IMAGE_SIZE / 2;
+    const size_t inserted = 512;
+    const size_t tail = BENCH_IMAGE_SIZE - half - inserted;
+    uint8_t *target = malloc(BENCH_IMAGE_SIZE);
+    memcpy(target, base, half);
+    for (size_t i = 0; i < inserted; i++)
+    {
+        target[half + i] = (uint8_t)(i * 13);
+    }
+    uint8_t *ops = calloc(1, 64 + inserted + tail);
+    size_t n = 0;
+    ops[n++] = 0x01;                            // COPY first half
+    put_u32(&ops[n], 0);
+    put_u32(&ops[n + 4], (uint32_t)half);
+    n += 8;
+    ops[n++] = 0x03;                            // INSERT
+    put_u32(&ops[n], (uint32_t)inserted);
+    memcpy(&ops[n + 4], &target[half], inserted);
+    n += 4 + inserted;
+    ops[n++] = 0x02;                            // ADD rest of the base
+    put_u32(&ops[n], (uint32_t)half);
+    put_u32(&ops[n + 4], (uint32_t)tail);
+    n += 8;
+    for (size_t i = 0; i < tail; i++)
+    {
+        uint8_t diff = (i % 97 == 0) ? 1 : 0;
+        ops[n++] = diff;
+        target[half + inserted + i] = (uint8_t)(base[half + i] + diff);
+    }
+    ops[n++] = 0x00;                            // END
+
+    size_t length = 0;
+    image_check_t check = { .expected = base, .base = base };
+    uint8_t *full = build_container(OTA_IMAGE_FULL, BENCH_IMAGE_SIZE, base, BENCH_IMAGE_SIZE, &length);
+    bench_image("ota_image_full", full, length, &check, 0);
+    free(full);
+
+    check.expected = target;
+    uint8_t *delta = build_container(OTA_IMAGE_DELTA, BENCH_IMAGE_SIZE, ops, n, &length);
+    bench_image("ota_image_delta", delta, length, &check, BENCH_IMAGE_SIZE);
+    free(delta);
+
+    free(ops);
+    free(target);
+    free(base);
+}
+
+/*----------------------------------------------------------------------------*/
+
+int main(void)
+{
+    fill_samples();
+
+    bench_displays();
+    bench_decode();
+    bench_encode();
+    bench_aggregate();
+    bench_images();
+
+    if (total_failures > 0)
+    {
+        fprintf(stderr, "%" PRIu32 " benchmark results were wrong\n", total_failures);
+        return 1;
+    }
+    return 0;
+}
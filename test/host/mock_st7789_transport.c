@@ -0,0 +1,70 @@
+/**
+ * @file mock_st7789_transport.c
+ * @brief Counting ST7789 transport, see mock_st7789_transport.h
+ */
+
+#include "mock_st7789_transport.h"
+#include "st7789_transport.h"
+#include <stdlib.h>
+#include <string.h>
+
+static mock_st7789_stats_t stats;
+
+const mock_st7789_stats_t *mock_st7789_stats(void)
+{
+    return &stats;
+}
+
+void mock_st7789_reset(void)
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+esp_err_t st7789_transport_init(void)
+{
+    mock_st7789_reset();
+    return ESP_OK;
+}
+
+void st7789_transport_write_command(uint8_t cmd)
+{
+    stats.commands++;
+    stats.checksum += cmd;
+}
+
+void st7789_transport_write_data(const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        stats.checksum += data[i];
+    }
+    stats.data_bytes += (uint32_t)len;
+}
+
+void st7789_transport_write_pixels(const uint16_t *pixels, size_t count)
+{
+    uint32_t sum = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        sum += pixels[i];
+    }
+    stats.checksum += sum;
+    stats.pixel_writes++;
+    stats.pixels += count;
+}
+
+void st7789_transport_fill(uint16_t color, uint32_t count)
+{
+    stats.checksum += (uint32_t)color * count;
+    stats.fills++;
+    stats.pixels += count;
+}
+
+void st7789_transport_wait_idle(void)
+{
+}
+
+uint16_t *st7789_transport_alloc_pixels(size_t count)
+{
+    return malloc(count * sizeof(uint16_t));
+}
@@ -0,0 +1,35 @@
+#ifndef MOCK_ST7789_TRANSPORT_H
+#define MOCK_ST7789_TRANSPORT_H
+
+#include <stdint.h>
+
+/**
+ * @file mock_st7789_transport.h
+ * @brief Counting implementation of st7789_transport.h for the host harness
+ *
+ * Links in place of the SPI and bit-bang backends. Every call is counted
+ * and every pixel handed over is read once (folded into a checksum), so
+ * the "_panel" benchmarks pay for walking the framebuffer bands and the
+ * address-window commands exactly as on the device, only without the bus.
+ */
+
+typedef struct {
+    uint32_t commands;          ///< st7789_transport_write_command() calls
+    uint32_t data_bytes;        ///< Bytes through st7789_transport_write_data()
+    uint32_t pixel_writes;      ///< st7789_transport_write_pixels() calls
+    uint64_t pixels;            ///< Pixels written or filled
+    uint32_t fills;             ///< st7789_transport_fill() calls
+    uint32_t checksum;          ///< Sum over every pixel value, keeps the reads live
+} mock_st7789_stats_t;
+
+/**
+ * @brief Counters since the last mock_st7789_reset()
+ */
+const mock_st7789_stats_t *mock_st7789_stats(void);
+
+/**
+ * @brief Zero the counters
+ */
+void mock_st7789_reset(void);
+
+#endif // MOCK_ST7789_TRANSPORT_H
@@ -0,0 +1,92 @@
+#ifndef RMT_RX_H
+#define RMT_RX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "driver/gpio.h"
+#include "driver/rmt_types.h"
+
+/**
+ * @file rmt_rx.h
+ * @brief Host stand-in: enough of the RMT receiver API to compile the
+ *        capture backend; there is no receiver, so every call fails
+ */
+
+typedef struct rmt_channel_t *rmt_channel_handle_t;
+
+typedef int rmt_clock_source_t;
+#define RMT_CLK_SRC_DEFAULT     0
+
+typedef struct {
+    gpio_num_t gpio_num;
+    rmt_clock_source_t clk_src;
+    uint32_t resolution_hz;
+    size_t mem_block_symbols;
+} rmt_rx_channel_config_t;
+
+typedef struct {
+    uint32_t signal_range_min_ns;
+    uint32_t signal_range_max_ns;
+} rmt_receive_config_t;
+
+typedef struct {
+    rmt_symbol_word_t *received_symbols;
+    size_t num_symbols;
+} rmt_rx_done_event_data_t;
+
+typedef bool (*rmt_rx_done_callback_t)(rmt_channel_handle_t channel,
+                                       const rmt_rx_done_event_data_t *edata, void *user_data);
+
+typedef struct {
+    rmt_rx_done_callback_t on_recv_done;
+} rmt_rx_event_callbacks_t;
+
+static inline esp_err_t rmt_new_rx_channel(const rmt_rx_channel_config_t *config,
+                                           rmt_channel_handle_t *channel)
+{
+    (void)config;
+    *channel = NULL;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+static inline esp_err_t rmt_rx_register_event_callbacks(rmt_channel_handle_t channel,
+                                                        const rmt_rx_event_callbacks_t *callbacks,
+                                                        void *user_data)
+{
+    (void)channel;
+    (void)callbacks;
+    (void)user_data;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+static inline esp_err_t rmt_receive(rmt_channel_handle_t channel, void *buffer, size_t size,
+                                    const rmt_receive_config_t *config)
+{
+    (void)channel;
+    (void)buffer;
+    (void)size;
+    (void)config;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+static inline esp_err_t rmt_enable(rmt_channel_handle_t channel)
+{
+    (void)channel;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+static inline esp_err_t rmt_disable(rmt_channel_handle_t channel)
+{
+    (void)channel;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+static inline esp_err_t rmt_del_channel(rmt_channel_handle_t channel)
+{
+    (void)channel;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif // RMT_RX_H
@@ -0,0 +1,21 @@
+#ifndef RMT_TYPES_H
+#define RMT_TYPES_H
+
+#include <stdint.h>
+
+/**
+ * @file rmt_types.h
+ * @brief Host stand-in: the RMT symbol layout the DHT11 decoder reads
+ */
+
+typedef union {
+    struct {
+        uint16_t duration0 : 15;
+        uint16_t level0 : 1;
+        uint16_t duration1 : 15;
+        uint16_t level1 : 1;
+    };
+    uint32_t val;
+} rmt_symbol_word_t;
+
+#endif // RMT_TYPES_H
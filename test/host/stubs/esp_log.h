@@ -0,0 +1,31 @@
+#ifndef ESP_LOG_H
+#define ESP_LOG_H
+
+#include <stdio.h>
+#include "esp_err.h"
+
+/**
+ * @file esp_log.h
+ * @brief Host stand-in: errors, warnings and info go to stderr so that
+ *        stdout carries only the BENCH lines; debug output is compiled out
+ */
+
+typedef enum {
+    ESP_LOG_NONE = 0,
+    ESP_LOG_ERROR,
+    ESP_LOG_WARN,
+    ESP_LOG_INFO,
+    ESP_LOG_DEBUG,
+    ESP_LOG_VERBOSE,
+} esp_log_level_t;
+
+#define HOST_LOG(letter, tag, format, ...) \
+    fprintf(stderr, letter " (%s) " format "\n", tag, ##__VA_ARGS__)
+
+#define ESP_LOGE(tag, format, ...)  HOST_LOG("E", tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...)  HOST_LOG("W", tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...)  HOST_LOG("I", tag, format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...)  do { if (0) HOST_LOG("D", tag, format, ##__VA_ARGS__); } while (0)
+#define ESP_LOGV(tag, format, ...)  do { if (0) HOST_LOG("V", tag, format, ##__VA_ARGS__); } while (0)
+
+#endif // ESP_LOG_H
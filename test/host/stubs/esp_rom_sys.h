@@ -0,0 +1,16 @@
+#ifndef ESP_ROM_SYS_H
+#define ESP_ROM_SYS_H
+
+#include <stdint.h>
+
+/**
+ * @file esp_rom_sys.h
+ * @brief Host stand-in: busy-wait delays only pace the panel, so they are free
+ */
+
+static inline void esp_rom_delay_us(uint32_t us)
+{
+    (void)us;
+}
+
+#endif // ESP_ROM_SYS_H
@@ -0,0 +1,16 @@
+#ifndef ESP_SYSTEM_H
+#define ESP_SYSTEM_H
+
+#include <stdlib.h>
+
+/**
+ * @file esp_system.h
+ * @brief Host stand-in: restart ends the process
+ */
+
+static inline void esp_restart(void)
+{
+    exit(1);
+}
+
+#endif // ESP_SYSTEM_H
@@ -0,0 +1,19 @@
+#ifndef ESP_TIMER_H
+#define ESP_TIMER_H
+
+#include <stdint.h>
+#include <time.h>
+
+/**
+ * @file esp_timer.h
+ * @brief Host stand-in: microseconds of the monotonic clock
+ */
+
+static inline int64_t esp_timer_get_time(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+#endif // ESP_TIMER_H
@@ -0,0 +1,32 @@
+#ifndef FREERTOS_H
+#define FREERTOS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @file FreeRTOS.h
+ * @brief Host stand-in: the harness is single-threaded, so critical
+ *        sections are empty and ticks are milliseconds
+ */
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+
+#define pdTRUE                  1
+#define pdFALSE                 0
+#define pdPASS                  pdTRUE
+#define portMAX_DELAY           0xFFFFFFFFu
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(ms))
+#define pdTICKS_TO_MS(ticks)    ((uint32_t)(ticks))
+
+typedef struct {
+    uint32_t unused;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED    { 0 }
+#define taskENTER_CRITICAL(mux)         ((void)(mux))
+#define taskEXIT_CRITICAL(mux)          ((void)(mux))
+
+#endif // FREERTOS_H
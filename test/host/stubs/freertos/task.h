@@ -0,0 +1,18 @@
+#ifndef TASK_H
+#define TASK_H
+
+#include "freertos/FreeRTOS.h"
+
+/**
+ * @file task.h
+ * @brief Host stand-in: no tasks, and panel reset delays return at once
+ */
+
+typedef struct host_task *TaskHandle_t;
+
+static inline void vTaskDelay(TickType_t ticks)
+{
+    (void)ticks;
+}
+
+#endif // TASK_H
@@ -0,0 +1,70 @@
+/**
+ * @file host_stubs.c
+ * @brief Out-of-line parts of the ESP-IDF stand-ins in this directory
+ */
+
+#include "esp_err.h"
+#include "rom/miniz.h"
+#include <stdio.h>
+#include <string.h>
+
+const char *esp_err_to_name(esp_err_t code)
+{
+    switch (code)
+    {
+        case ESP_OK:                    return "ESP_OK";
+        case ESP_FAIL:                  return "ESP_FAIL";
+        case ESP_ERR_NO_MEM:            return "ESP_ERR_NO_MEM";
+        case ESP_ERR_INVALID_ARG:       return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_STATE:     return "ESP_ERR_INVALID_STATE";
+        case ESP_ERR_INVALID_SIZE:      return "ESP_ERR_INVALID_SIZE";
+        case ESP_ERR_NOT_FOUND:         return "ESP_ERR_NOT_FOUND";
+        case ESP_ERR_NOT_SUPPORTED:     return "ESP_ERR_NOT_SUPPORTED";
+        case ESP_ERR_TIMEOUT:           return "ESP_ERR_TIMEOUT";
+        case ESP_ERR_INVALID_RESPONSE:  return "ESP_ERR_INVALID_RESPONSE";
+        case ESP_ERR_INVALID_CRC:       return "ESP_ERR_INVALID_CRC";
+        case ESP_ERR_INVALID_VERSION:   return "ESP_ERR_INVALID_VERSION";
+        default:                        return "UNKNOWN ERROR";
+    }
+}
+
+tinfl_status tinfl_decompress(tinfl_decompressor *decompressor, const mz_uint8 *in_next,
+                              size_t *in_size, mz_uint8 *out_start, mz_uint8 *out_next,
+                              size_t *out_size, mz_uint32 flags)
+{
+    (void)out_start;
+    (void)flags;
+
+    z_stream *stream = &decompressor->stream;
+    if (!decompressor->started)
+    {
+        memset(stream, 0, sizeof(*stream));
+        if (inflateInit(stream) != Z_OK)
+        {
+            return TINFL_STATUS_FAILED;
+        }
+        decompressor->started = 1;
+    }
+
+    stream->next_in = (Bytef *)in_next;
+    stream->avail_in = (uInt)*in_size;
+    stream->next_out = out_next;
+    stream->avail_out = (uInt)*out_size;
+    int ret = inflate(stream, Z_NO_FLUSH);
+    *in_size -= stream->avail_in;
+    *out_size -= stream->avail_out;
+
+    if (ret == Z_STREAM_END)
+    {
+        inflateEnd(stream);
+        decompressor->started = 0;
+        return TINFL_STATUS_DONE;
+    }
+    if (ret != Z_OK && ret != Z_BUF_ERROR)
+    {
+        inflateEnd(stream);
+        decompressor->started = 0;
+        return TINFL_STATUS_FAILED;
+    }
+    return (stream->avail_out == 0) ? TINFL_STATUS_HAS_MORE_OUTPUT : TINFL_STATUS_NEEDS_MORE_INPUT;
+}
@@ -0,0 +1,42 @@
+#ifndef MINIZ_H
+#define MINIZ_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zlib.h>
+
+/**
+ * @file miniz.h
+ * @brief Host stand-in for the ROM tinfl decoder, implemented on zlib
+ *
+ * Covers the one way ota_image.c calls it: a zlib stream into a
+ * TINFL_LZ_DICT_SIZE circular window. zlib keeps its own window, so output
+ * may go straight to out_next.
+ */
+
+typedef uint8_t mz_uint8;
+typedef uint32_t mz_uint32;
+
+#define TINFL_LZ_DICT_SIZE              32768
+#define TINFL_FLAG_PARSE_ZLIB_HEADER    1
+#define TINFL_FLAG_HAS_MORE_INPUT       2
+
+typedef enum {
+    TINFL_STATUS_FAILED = -1,
+    TINFL_STATUS_DONE = 0,
+    TINFL_STATUS_NEEDS_MORE_INPUT = 1,
+    TINFL_STATUS_HAS_MORE_OUTPUT = 2,
+} tinfl_status;
+
+typedef struct {
+    z_stream stream;
+    int started;
+} tinfl_decompressor;
+
+#define tinfl_init(decompressor)    ((decompressor)->started = 0)
+
+tinfl_status tinfl_decompress(tinfl_decompressor *decompressor, const mz_uint8 *in_next,
+                              size_t *in_size, mz_uint8 *out_start, mz_uint8 *out_next,
+                              size_t *out_size, mz_uint32 flags);
+
+#endif // MINIZ_H
@@ -0,0 +1,9 @@
+#ifndef SDKCONFIG_H
+#define SDKCONFIG_H
+
+/**
+ * @file sdkconfig.h
+ * @brief Host stand-in: every "Home Monitor" option at its default (off)
+ */
+
+#endif // SDKCONFIG_H
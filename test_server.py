@@ -9,7 +9,7 @@ Requirements:
 
 Usage:
 1. Run: python3 test_server.py
-2. Update wifi_config.h with this server's IP address
+2. Point the device's server_url at this server's IP address (device_config)
 3. Flash and run your ESP32
 
 Example URL: http://192.168.1.100:3000/api/sensor-data
@@ -17,11 +17,91 @@ Example URL: http://192.168.1.100:3000/api/sensor-data
 
 import json
 import socketserver
+import struct
 from http.server import BaseHTTPRequestHandler
 from datetime import datetime
 import socket
 
+# Compact binary batch format, see components/wifi_manager/telemetry_codec.h.
+# Version 2 (current firmware) adds rollups; version 1 is still accepted.
+BINARY_CONTENT_TYPE = 'application/vnd.home-monitor.telemetry.v2'
+BINARY_CONTENT_TYPES = ('application/vnd.home-monitor.telemetry.v1', BINARY_CONTENT_TYPE)
+BINARY_DELTA_ESCAPE = 0xFFFF
+
+def print_diagnostics(timestamp, device_id, diagnostics):
+    """Print a perf_monitor record, see components/perf_monitor/perf_monitor.h."""
+    heap = diagnostics.get('heap', {})
+    print(f"\n[{timestamp}] Diagnostics from {device_id} "
+          f"(uptime {diagnostics.get('uptime_s')}s, last {diagnostics.get('window_s')}s):")
+    print(f"  {'stage':<15} {'count':>7} {'min_us':>9} {'avg_us':>9} {'p99_us':>9} {'max_us':>9}")
+    for name, stage in diagnostics.get('stages', {}).items():
+        print(f"  {name:<15} {stage.get('count', 0):>7} {stage.get('min_us', 0):>9} "
+              f"{stage.get('avg_us', 0):>9} {stage.get('p99_us', 0):>9} {stage.get('max_us', 0):>9}")
+    print(f"  Heap: {heap.get('free')} free, {heap.get('min_free')} lowest, "
+          f"{heap.get('largest_block')} largest block")
+    for task, free in diagnostics.get('stack_free', {}).items():
+        print(f"  Stack {task}: {free} bytes never used")
+    boot = diagnostics.get('boot_ms', {})
+    if boot:
+        print("  Boot: " + ", ".join(f"{name} {ms} ms" for name, ms in boot.items()))
+    print("-" * 50)
+
+def decode_binary_batch(body):
+    """Decode a binary batch into the same dict shape as the JSON batch form."""
+    magic, version, count, rssi, id_len = struct.unpack_from('<2sBBbB', body, 0)
+    if magic != b'HM' or version not in (1, 2):
+        raise ValueError(f"unsupported binary payload (magic={magic!r}, version={version})")
+    offset = 6
+    device_id = body[offset:offset + id_len].decode('ascii')
+    offset += id_len
+    (timestamp,) = struct.unpack_from('<I', body, offset)
+    offset += 4
+    
+    readings = []
+    for _ in range(count):
+        delta, temp_centi, hum_centi = struct.unpack_from('<HhH', body, offset)
+        offset += 6
+        rolled_up = 0
+        if version >= 2:
+            (rolled_up,) = struct.unpack_from('<H', body, offset)
+            offset += 2
+        if delta == BINARY_DELTA_ESCAPE:
+            (timestamp,) = struct.unpack_from('<I', body, offset)
+            offset += 4
+        else:
+            timestamp += delta
+        reading = {
+            "timestamp": timestamp,
+            "temperature": temp_centi / 100.0,
+            "humidity": hum_centi / 100.0,
+        }
+        if rolled_up > 1:
+            t_min, t_max, t_mean, h_min, h_max, h_mean = struct.unpack_from('<hhhHHH', body, offset)
+            offset += 12
+            reading["rollup"] = {
+                "count": rolled_up,
+                "temperature": {"min": t_min / 100.0, "max": t_max / 100.0, "mean": t_mean / 100.0},
+                "humidity": {"min": h_min / 100.0, "max": h_max / 100.0, "mean": h_mean / 100.0},
+            }
+        readings.append(reading)
+    if offset != len(body):
+        raise ValueError(f"{len(body) - offset} trailing bytes in binary payload")
+    return {"device_id": device_id, "rssi": rssi, "readings": readings}
+
 class SensorDataHandler(BaseHTTPRequestHandler):
+    # HTTP/1.1 so the ESP32 can keep its connection open between uploads.
+    # Every response must then carry a Content-Length.
+    protocol_version = 'HTTP/1.1'
+    
+    def send_body(self, status, content_type, body, extra_headers=None):
+        self.send_response(status)
+        self.send_header('Content-type', content_type)
+        self.send_header('Content-Length', str(len(body)))
+        for key, value in (extra_headers or {}).items():
+            self.send_header(key, value)
+        self.end_headers()
+        self.wfile.write(body)
+    
     def do_POST(self):
         if self.path == '/api/sensor-data':
             # Read the request body
@@ -29,56 +109,75 @@ class SensorDataHandler(BaseHTTPRequestHandler):
             post_data = self.rfile.read(content_length)
             
             try:
-                # Parse JSON data
-                sensor_data = json.loads(post_data.decode('utf-8'))
+                # Parse the body according to its Content-Type
+                content_type = self.headers.get('Content-Type', 'application/json')
+                if content_type.split(';')[0].strip() in BINARY_CONTENT_TYPES:
+                    sensor_data = decode_binary_batch(post_data)
+                    encoding = f"binary, {len(post_data)} bytes"
+                else:
+                    sensor_data = json.loads(post_data.decode('utf-8'))
+                    encoding = f"JSON, {len(post_data)} bytes"
                 
                 # Print received data with timestamp
                 timestamp = datetime.now().strftime('%Y-%m-%d %H:%M:%S')
-                print(f"\n[{timestamp}] Sensor Data Received:")
-                print(f"  Device ID: {sensor_data.get('device_id', 'Unknown')}")
-                print(f"  Temperature: {sensor_data.get('temperature', 'N/A')}°C")
-                print(f"  Humidity: {sensor_data.get('humidity', 'N/A')}%")
-                print(f"  WiFi Signal: {sensor_data.get('rssi', 'N/A')} dBm")
-                print(f"  Timestamp: {sensor_data.get('timestamp', 'N/A')}")
+                device_id = sensor_data.get('device_id', 'Unknown')
+                rssi = sensor_data.get('rssi', 'N/A')
+                
+                # Diagnostics form: {"device_id", "rssi", "diagnostics": {...}}
+                if 'diagnostics' in sensor_data:
+                    print_diagnostics(timestamp, device_id, sensor_data['diagnostics'])
+                    response = {"status": "success", "message": "Diagnostics received",
+                                "received_at": timestamp}
+                    self.send_body(200, 'application/json', json.dumps(response).encode(),
+                                   {'Access-Control-Allow-Origin': '*'})
+                    return
+                
+                # Batch form: {"device_id", "rssi", "readings": [{...}, ...]}
+                # Single form: {"device_id", "timestamp", "temperature", "humidity", "rssi"}
+                readings = sensor_data.get('readings')
+                if readings is None:
+                    readings = [sensor_data]
+                
+                print(f"\n[{timestamp}] Sensor Data Received ({len(readings)} reading(s), {encoding}):")
+                print(f"  Device ID: {device_id}")
+                print(f"  WiFi Signal: {rssi} dBm")
+                for reading in readings:
+                    line = (f"  {reading.get('timestamp', 'N/A')}: "
+                            f"{reading.get('temperature', 'N/A')}°C, "
+                            f"{reading.get('humidity', 'N/A')}%")
+                    rollup = reading.get('rollup')
+                    if rollup:
+                        t, h = rollup.get('temperature', {}), rollup.get('humidity', {})
+                        line += (f"  [{rollup.get('count')} readings: "
+                                 f"{t.get('min')}..{t.get('max')}°C mean {t.get('mean')}, "
+                                 f"{h.get('min')}..{h.get('max')}% mean {h.get('mean')}]")
+                    print(line)
                 print("-" * 50)
                 
                 # Send success response
-                self.send_response(200)
-                self.send_header('Content-type', 'application/json')
-                self.send_header('Access-Control-Allow-Origin', '*')
-                self.end_headers()
-                
                 response = {
                     "status": "success",
                     "message": "Data received successfully",
+                    "readings_accepted": len(readings),
                     "received_at": timestamp
                 }
-                self.wfile.write(json.dumps(response).encode())
+                self.send_body(200, 'application/json', json.dumps(response).encode(),
+                               {'Access-Control-Allow-Origin': '*'})
                 
-            except json.JSONDecodeError:
-                # Handle invalid JSON
-                self.send_response(400)
-                self.send_header('Content-type', 'application/json')
-                self.end_headers()
-                error_response = {"status": "error", "message": "Invalid JSON data"}
-                self.wfile.write(json.dumps(error_response).encode())
-                print(f"[ERROR] Invalid JSON received: {post_data}")
+            except (ValueError, AttributeError, struct.error):
+                # Handle invalid JSON or a malformed binary batch
+                error_response = {"status": "error", "message": "Invalid payload"}
+                self.send_body(400, 'application/json', json.dumps(error_response).encode())
+                print(f"[ERROR] Invalid payload received: {post_data}")
                 
         else:
             # Handle unknown endpoints
-            self.send_response(404)
-            self.send_header('Content-type', 'application/json')
-            self.end_headers()
             error_response = {"status": "error", "message": "Endpoint not found"}
-            self.wfile.write(json.dumps(error_response).encode())
+            self.send_body(404, 'application/json', json.dumps(error_response).encode())
     
     def do_GET(self):
         if self.path == '/':
             # Simple status page
-            self.send_response(200)
-            self.send_header('Content-type', 'text/html')
-            self.end_headers()
-            
             html = f"""
             <!DOCTYPE html>
             <html>
@@ -97,21 +196,27 @@ class SensorDataHandler(BaseHTTPRequestHandler):
                 <p><strong>Endpoint:</strong> POST /api/sensor-data</p>
                 <h2>Configuration for ESP32:</h2>
                 <pre>
-#define HTTP_SERVER_URL "http://{get_local_ip()}:3000/api/sensor-data"
+server_url,data,string,http://{get_local_ip()}:3000/api/sensor-data
                 </pre>
-                <p>Update your wifi_config.h file with the URL above.</p>
+                <p>Provision this server_url into the device_config NVS namespace,
+                or set DEVICE_CONFIG_DEFAULT_SERVER_URL in device_config.h.</p>
             </body>
             </html>
             """
-            self.wfile.write(html.encode())
+            self.send_body(200, 'text/html; charset=utf-8', html.encode())
         else:
-            self.send_response(404)
-            self.end_headers()
+            self.send_body(404, 'text/plain', b'Not found')
     
     def log_message(self, format, *args):
         # Suppress default request logging
         pass
 
+class SensorDataServer(socketserver.ThreadingTCPServer):
+    # One thread per connection: a kept-alive ESP32 connection must not
+    # block other clients such as the status page
+    daemon_threads = True
+    allow_reuse_address = True
+
 def get_local_ip():
     """Get the local IP address of this machine"""
     try:
@@ -134,13 +239,13 @@ def main():
     print(f"Server starting on {local_ip}:{port}")
     print(f"Endpoint: POST /api/sensor-data")
     print(f"Web interface: http://{local_ip}:{port}")
-    print("\nUpdate your ESP32 wifi_config.h with:")
-    print(f'#define HTTP_SERVER_URL "http://{local_ip}:{port}/api/sensor-data"')
+    print("\nProvision your ESP32's device_config with:")
+    print(f'server_url,data,string,http://{local_ip}:{port}/api/sensor-data')
     print("\nPress Ctrl+C to stop the server")
     print("=" * 60)
     
     try:
-        with socketserver.TCPServer(("", port), SensorDataHandler) as httpd:
+        with SensorDataServer(("", port), SensorDataHandler) as httpd:
             httpd.serve_forever()
     except KeyboardInterrupt:
         print("\n\nServer stopped by user")